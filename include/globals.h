@@ -60,6 +60,11 @@
     #endif
   #endif // UNIT_ENV_IV_MODULE
 
+  // Automation: the fan follows the SHT4X temperature
+  #if defined(SHT4X_MODULE) && defined(MINI_FAN_MODULE)
+    #define FAN_CONTROL_MODULE
+  #endif
+
   // Define Pin
   #ifdef YOLO_UNO
     #define SDA_PIN          GPIO_NUM_11
@@ -93,12 +98,16 @@
   // Display
   #ifdef LCD_MODULE
     #include "lcd_16x2.h"
-extern LCD_I2C lcd;
+    #include "lcd_pages.h"
+extern LCD_I2C  lcd;
+extern LcdPages lcdPages;
   #endif // LCD_MODULE
 
   #ifdef LED_RGB_MODULE
     #include <Adafruit_NeoPixel.h>
+    #include "led_effects.h"
 extern Adafruit_NeoPixel rgb;
+extern LedEffects        ledEffects;
   #endif
 
   #ifdef SHT4X_MODULE
@@ -116,6 +125,9 @@ extern BMP280 bmp280;
 extern LightSensor lightSensor;
   #endif // LIGHT_SENSOR_MODULE
 
+  #include "sensor_snapshot.h"
+extern SensorSnapshotStore sensorSnapshot;
+
   // Motor
   #ifdef MINI_FAN_MODULE
     #include "mini_fan.h"
@@ -124,7 +136,9 @@ extern MiniFan miniFan;
 
   #ifdef SERVO_MODULE
     #include "ESP32Servo.h"
-extern Servo doorServo;
+    #include "servo_motion.h"
+extern Servo       doorServo;
+extern ServoMotion doorMotion;
   #endif
 
   // Misc
@@ -143,8 +157,10 @@ extern ButtonHandler button;
 // RTOS
   #include "../src/tasks/actuators_task.h"
   #include "../src/tasks/button_task.h"
+  #include "../src/tasks/fan_control_task.h"
   #include "../src/tasks/iot_server_task.h"
   #include "../src/tasks/lcd_task.h"
+  #include "../src/tasks/led_task.h"
   #include "../src/tasks/sensors_task.h"
   #include "../src/tasks/wifi_task.h"
 
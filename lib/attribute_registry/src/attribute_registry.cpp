@@ -0,0 +1,186 @@
+/**
+ * @file       attribute_registry.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-24
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Attribute Registry library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "attribute_registry.h"
+
+#include <math.h>
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Class method definitions ------------------------------------------- */
+AttributeRegistry::AttributeRegistry(const attr_handler_t *handlers, uint8_t count)
+    : _handlers(handlers), _count((count < ATTR_REGISTRY_MAX_HANDLERS) ? count : ATTR_REGISTRY_MAX_HANDLERS),
+      _rejected(0), _unknown(0)
+{
+  // Insertion sort of the indexes by hash, once, the table is short
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    uint8_t j = i;
+    while (j > 0 && _handlers[_byHash[j - 1]].hash > _handlers[i].hash)
+    {
+      _byHash[j] = _byHash[j - 1];
+      j--;
+    }
+    _byHash[j] = i;
+  }
+}
+
+uint8_t AttributeRegistry::apply(const JsonObjectConst &data, void *context)
+{
+  uint8_t applied = 0;
+  for (JsonPairConst pair : data)
+  {
+    if (applyOne(pair.key().c_str(), pair.value(), context) == ATTR_REGISTRY_OK)
+    {
+      applied++;
+    }
+  }
+  return applied;
+}
+
+attr_registry_error_t AttributeRegistry::applyOne(const char *key, const JsonVariantConst &value,
+                                                  void *context)
+{
+  const attr_handler_t *handler = find(key);
+  if (handler == nullptr)
+  {
+    _unknown++;
+    return ATTR_REGISTRY_ERR_UNKNOWN_KEY;
+  }
+
+  attr_value_t          converted;
+  attr_registry_error_t error = convert(*handler, value, converted);
+  if (error == ATTR_REGISTRY_OK && !handler->setter(converted, context))
+  {
+    error = ATTR_REGISTRY_ERR;
+  }
+  if (error != ATTR_REGISTRY_OK)
+  {
+    _rejected++;
+  }
+  return error;
+}
+
+const attr_handler_t *AttributeRegistry::find(const char *key) const
+{
+  if (key == nullptr)
+  {
+    return nullptr;
+  }
+
+  uint32_t hash = fnv1a(key);
+  int      low  = 0;
+  int      high = (int) _count - 1;
+  while (low <= high)
+  {
+    int                   mid     = (low + high) / 2;
+    const attr_handler_t &handler = _handlers[_byHash[mid]];
+    if (handler.hash == hash)
+    {
+      // Unique hashes within the table, the comparison only rejects a foreign key with the same hash
+      return (strcmp(handler.key, key) == 0) ? &handler : nullptr;
+    }
+    if (handler.hash < hash)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid - 1;
+    }
+  }
+  return nullptr;
+}
+
+/* Private definitions ------------------------------------------------ */
+attr_registry_error_t AttributeRegistry::convert(const attr_handler_t &handler, const JsonVariantConst &value,
+                                                 attr_value_t &converted)
+{
+  switch (handler.type)
+  {
+    case ATTR_TYPE_BOOL:
+      if (!value.is<bool>() && !value.is<long>())
+      {
+        return ATTR_REGISTRY_ERR_TYPE;
+      }
+      converted.b = value.as<bool>();
+      return ATTR_REGISTRY_OK;
+
+    case ATTR_TYPE_INT:
+    case ATTR_TYPE_FLOAT:
+    {
+      // Integers sent as 50.0 are accepted, a fraction is not
+      if (!value.is<float>())
+      {
+        return ATTR_REGISTRY_ERR_TYPE;
+      }
+      float number = value.as<float>();
+      if (!isfinite(number) || (handler.type == ATTR_TYPE_INT && number != floorf(number)))
+      {
+        return ATTR_REGISTRY_ERR_TYPE;
+      }
+      if (number < handler.min || number > handler.max)
+      {
+        if (!handler.clamp)
+        {
+          return ATTR_REGISTRY_ERR_RANGE;
+        }
+        number = constrain(number, handler.min, handler.max);
+      }
+      if (handler.type == ATTR_TYPE_INT)
+      {
+        converted.i = (int32_t) number;
+      }
+      else
+      {
+        converted.f = number;
+      }
+      return ATTR_REGISTRY_OK;
+    }
+
+    case ATTR_TYPE_STRING:
+    {
+      const char *text = value.as<const char *>();
+      if (text == nullptr)
+      {
+        return ATTR_REGISTRY_ERR_TYPE;
+      }
+      if (handler.max > 0.0f && strlen(text) > handler.max)
+      {
+        return ATTR_REGISTRY_ERR_RANGE;
+      }
+      converted.s = text;
+      return ATTR_REGISTRY_OK;
+    }
+
+    case ATTR_TYPE_OBJECT:
+      if (!value.is<JsonObjectConst>())
+      {
+        return ATTR_REGISTRY_ERR_TYPE;
+      }
+      converted.o = &value;
+      return ATTR_REGISTRY_OK;
+
+    default:
+      return ATTR_REGISTRY_ERR_TYPE;
+  }
+}
+
+/* End of file -------------------------------------------------------- */
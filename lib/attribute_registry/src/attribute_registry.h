@@ -0,0 +1,208 @@
+/**
+ * @file       attribute_registry.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-24
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Attribute Registry library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef ATTRIBUTE_REGISTRY_H
+  #define ATTRIBUTE_REGISTRY_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include "utility.h"
+
+  #include <ArduinoJson.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define ATTRIBUTE_REGISTRY_LIB_VERSION (F("0.1.0"))
+
+  #define ATTR_REGISTRY_MAX_HANDLERS     16
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  ATTR_REGISTRY_OK = 0,          /* No error */
+  ATTR_REGISTRY_ERR,             /* Generic error, the setter refused the value */
+  ATTR_REGISTRY_ERR_TYPE,        /* Value of the wrong type */
+  ATTR_REGISTRY_ERR_RANGE,       /* Value out of range */
+  ATTR_REGISTRY_ERR_UNKNOWN_KEY  /* No handler for the key */
+} attr_registry_error_t;
+
+typedef enum
+{
+  ATTR_TYPE_BOOL = 0, /* `true`/`false` or an integer, non-zero is `true` */
+  ATTR_TYPE_INT,      /* Integer within [min, max] */
+  ATTR_TYPE_FLOAT,    /* Finite number within [min, max] */
+  ATTR_TYPE_STRING,   /* String of at most `max` characters, `0` for no limit */
+  ATTR_TYPE_OBJECT    /* JSON object, checked by the setter */
+} attr_type_t;
+
+/**
+ * @brief Converted value handed to a setter. A string or an object points into the JSON document, it is not
+ * copied and is only valid during the setter.
+ */
+typedef union
+{
+  bool                    b;
+  int32_t                 i;
+  float                   f;
+  const char             *s;
+  const JsonVariantConst *o;
+} attr_value_t;
+
+/**
+ * @brief Applies one attribute.
+ *
+ * @param[in] value   Value, already converted and range-checked.
+ * @param[in] context Passed through from `apply()`, e.g. settings gathered over the whole update.
+ *
+ * @return bool `false` to reject the value.
+ */
+typedef bool (*attr_setter_t)(const attr_value_t &value, void *context);
+
+typedef struct
+{
+  const char   *key;    /**< Attribute name */
+  uint32_t      hash;   /**< `fnv1a(key)`, computed at compile time by `ATTR_HANDLER()` */
+  attr_type_t   type;
+  float         min;    /**< Lowest value, unused for bool, string and object */
+  float         max;    /**< Highest value, or longest string */
+  bool          clamp;  /**< Out-of-range numbers are clamped instead of rejected */
+  attr_setter_t setter;
+} attr_handler_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define ATTR_HANDLER(key, type, min, max, setter)                                                          \
+    {                                                                                                        \
+      (key), fnv1a(key), (type), (min), (max), false, (setter)                                               \
+    }
+
+  #define ATTR_HANDLER_CLAMPED(key, type, min, max, setter)                                                  \
+    {                                                                                                        \
+      (key), fnv1a(key), (type), (min), (max), true, (setter)                                                \
+    }
+
+  #define ATTR_HANDLER_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+/* Public variables --------------------------------------------------- */
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Checks at compile time that no handler after `i` shares the hash of handler `i`.
+ */
+constexpr bool attrHashUniqueAfter(const attr_handler_t *handlers, size_t count, size_t i, size_t j)
+{
+  return (j >= count) ||
+         (handlers[i].hash != handlers[j].hash && attrHashUniqueAfter(handlers, count, i, j + 1));
+}
+
+/**
+ * @brief Checks at compile time that no two keys of a table share a hash, for a `static_assert()`.
+ */
+constexpr bool attrHashesUnique(const attr_handler_t *handlers, size_t count, size_t i = 0)
+{
+  return (i >= count) ||
+         (attrHashUniqueAfter(handlers, count, i, i + 1) && attrHashesUnique(handlers, count, i + 1));
+}
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Dispatcher of attribute updates over a constant table of typed setters.
+ *
+ * The `AttributeRegistry` class replaces a chain of `strcmp()` per key by a table declared `constexpr`: each
+ * entry gives the key, its hash computed by the compiler, the expected type, the accepted range and the
+ * setter. `apply()` hashes each incoming key once and finds its handler by a binary search over the hashes,
+ * so an update costs O(keys), and converts and checks the value before the setter sees it.
+ *
+ * ### Features:
+ *
+ * - Type and range validation in one place, a setter only receives valid values.
+ *
+ * - Clamped or strict ranges, per attribute.
+ *
+ * - Strings and objects are handed over as pointers into the document, nothing is copied or allocated.
+ *
+ * - Counters of rejected and unknown keys.
+ *
+ * ### Usage:
+ *
+ * ```
+ * constexpr attr_handler_t ATTRS[] = { ATTR_HANDLER_CLAMPED("fanSpeed", ATTR_TYPE_INT, 0, 100, setSpeed) };
+ * static_assert(attrHashesUnique(ATTRS, ATTR_HANDLER_COUNT(ATTRS)), "Attribute hash collision");
+ * AttributeRegistry registry(ATTRS, ATTR_HANDLER_COUNT(ATTRS));
+ * registry.apply(data, nullptr);
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - ArduinoJson 6 and `fnv1a()` from `utility.h`. Not thread-safe, one task applies the updates.
+ */
+class AttributeRegistry
+{
+public:
+  /**
+   * @param[in] handlers Handler table, kept by reference.
+   * @param[in] count    Number of handlers, at most `ATTR_REGISTRY_MAX_HANDLERS`. Extra handlers are ignored.
+   */
+  AttributeRegistry(const attr_handler_t *handlers, uint8_t count);
+
+  /**
+   * @brief Applies every key of an update that has a handler.
+   *
+   * @param[in] data    Attributes received.
+   * @param[in] context Passed to each setter.
+   *
+   * @return uint8_t Number of attributes applied.
+   */
+  uint8_t apply(const JsonObjectConst &data, void *context);
+
+  /**
+   * @brief Applies a single attribute.
+   *
+   * @return
+   *  - `ATTR_REGISTRY_OK`: Applied
+   *
+   *  - `ATTR_REGISTRY_ERR_UNKNOWN_KEY`: No handler for `key`
+   *
+   *  - `ATTR_REGISTRY_ERR_TYPE`, `ATTR_REGISTRY_ERR_RANGE`: Value rejected before the setter
+   *
+   *  - `ATTR_REGISTRY_ERR`: Value refused by the setter
+   */
+  attr_registry_error_t applyOne(const char *key, const JsonVariantConst &value, void *context);
+
+  /**
+   * @brief Finds the handler of a key.
+   *
+   * @return const attr_handler_t* The handler, `nullptr` if the key is unknown.
+   */
+  const attr_handler_t *find(const char *key) const;
+
+  uint32_t getRejectedCount() const { return _rejected; }
+  uint32_t getUnknownCount() const { return _unknown; }
+
+private:
+  const attr_handler_t *_handlers;
+  uint8_t               _count;
+  uint8_t               _byHash[ATTR_REGISTRY_MAX_HANDLERS]; /** Handler indexes sorted by hash */
+  uint32_t              _rejected;
+  uint32_t              _unknown;
+
+  static attr_registry_error_t convert(const attr_handler_t &handler, const JsonVariantConst &value,
+                                       attr_value_t &converted);
+};
+
+#endif // ATTRIBUTE_REGISTRY_H
+
+/* End of file -------------------------------------------------------- */
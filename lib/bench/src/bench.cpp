@@ -0,0 +1,201 @@
+/**
+ * @file       bench.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-08
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Bench library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef HAL_NATIVE
+  #include <chrono>
+#endif
+
+/* Private defines ---------------------------------------------------- */
+#define BENCH_HISTORY_HEADER "timestamp,label,suite,kernel,ns_per_op,iterations"
+#define BENCH_LINE_LENGTH    160
+
+/* Private function prototypes ---------------------------------------- */
+static void benchSort(uint64_t *samples, uint8_t length);
+#ifdef HAL_NATIVE
+static float benchFindPrevious(FILE *file, const char *suite, const char *name);
+#endif
+
+/* Function definitions ----------------------------------------------- */
+uint64_t benchNowNs()
+{
+#ifdef HAL_NATIVE
+  return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#else
+  // Extend the 32-bit cycle counter, it is read at least once per wrap by any batch
+  static uint32_t lastCycles = 0;
+  static uint64_t highCycles = 0;
+
+  uint32_t cycles = ESP.getCycleCount();
+  if (cycles < lastCycles)
+  {
+    highCycles += (1ULL << 32);
+  }
+  lastCycles = cycles;
+  return ((highCycles | cycles) * 1000ULL) / ESP.getCpuFreqMHz();
+#endif
+}
+
+/* Class method definitions ------------------------------------------- */
+Bench::Bench(const char *suite) : suite(suite), count(0) {}
+
+void Bench::report(Print &out)
+{
+  out.printf("%-28s %12s %12s %10s\n", suite, "ns/op (min)", "ns/op (med)", "iterations");
+  for (size_t i = 0; i < count; i++)
+  {
+    out.printf("  %-26s %12.1f %12.1f %10lu\n", results[i].name, results[i].nsPerOp, results[i].nsMedian,
+               (unsigned long) results[i].iterations);
+  }
+  for (size_t i = 0; i < count; i++)
+  {
+    out.printf("bench,%s,%s,%s,%.1f,%lu\n", getLabel(), suite, results[i].name, results[i].nsPerOp,
+               (unsigned long) results[i].iterations);
+  }
+}
+
+bench_error_t Bench::appendHistory(const char *path, Print &out)
+{
+#ifdef HAL_NATIVE
+  if (path == nullptr)
+  {
+    return BENCH_ERR_IO;
+  }
+
+  float previous[BENCH_MAX_RESULTS];
+  bool  isNew = true;
+  FILE *file  = fopen(path, "r");
+  if (file != nullptr)
+  {
+    isNew = false;
+    for (size_t i = 0; i < count; i++)
+    {
+      previous[i] = benchFindPrevious(file, suite, results[i].name);
+    }
+    fclose(file);
+  }
+
+  file = fopen(path, "a");
+  if (file == nullptr)
+  {
+    return BENCH_ERR_IO;
+  }
+  if (isNew)
+  {
+    fprintf(file, "%s\n", BENCH_HISTORY_HEADER);
+  }
+
+  long timestamp = (long) time(nullptr);
+  out.printf("History %s\n", path);
+  for (size_t i = 0; i < count; i++)
+  {
+    fprintf(file, "%ld,%s,%s,%s,%.1f,%lu\n", timestamp, getLabel(), suite, results[i].name,
+            results[i].nsPerOp, (unsigned long) results[i].iterations);
+
+    if (!isNew && previous[i] > 0.0f)
+    {
+      out.printf("  %-26s %12.1f -> %12.1f  %+6.1f %%\n", results[i].name, previous[i], results[i].nsPerOp,
+                 (results[i].nsPerOp - previous[i]) * 100.0f / previous[i]);
+    }
+    else
+    {
+      out.printf("  %-26s %12s -> %12.1f\n", results[i].name, "-", results[i].nsPerOp);
+    }
+  }
+  fclose(file);
+  return BENCH_OK;
+#else
+  return BENCH_ERR_IO;
+#endif
+}
+
+/* Private definitions ------------------------------------------------ */
+bench_error_t Bench::addResult(const char *name, uint32_t iterations, uint64_t *samples)
+{
+  benchSort(samples, BENCH_REPEATS);
+
+  bench_result_t &result = results[count++];
+  result.name            = name;
+  result.iterations      = iterations;
+  result.nsPerOp         = (float) samples[0] / (float) iterations;
+  result.nsMedian        = (float) samples[BENCH_REPEATS / 2] / (float) iterations;
+  return BENCH_OK;
+}
+
+const char *Bench::getLabel()
+{
+#ifdef HAL_NATIVE
+  const char *label = getenv("BENCH_LABEL");
+  if (label != nullptr && label[0] != '\0')
+  {
+    return label;
+  }
+#endif
+  return BENCH_LABEL;
+}
+
+static void benchSort(uint64_t *samples, uint8_t length)
+{
+  // Insertion sort, a handful of samples
+  for (uint8_t i = 1; i < length; i++)
+  {
+    uint64_t value = samples[i];
+    int8_t   j     = (int8_t) (i - 1);
+    while (j >= 0 && samples[j] > value)
+    {
+      samples[j + 1] = samples[j];
+      j--;
+    }
+    samples[j + 1] = value;
+  }
+}
+
+#ifdef HAL_NATIVE
+static float benchFindPrevious(FILE *file, const char *suite, const char *name)
+{
+  // Last row of the same suite and kernel, whatever its label
+  char  line[BENCH_LINE_LENGTH];
+  float previous = 0.0f;
+
+  rewind(file);
+  while (fgets(line, sizeof(line), file) != nullptr)
+  {
+    char *fields[6];
+    char *cursor = line;
+    int   n      = 0;
+    while (n < 6 && cursor != nullptr)
+    {
+      fields[n++] = cursor;
+      cursor      = strchr(cursor, ',');
+      if (cursor != nullptr)
+      {
+        *cursor++ = '\0';
+      }
+    }
+    if (n == 6 && strcmp(fields[2], suite) == 0 && strcmp(fields[3], name) == 0)
+    {
+      previous = strtof(fields[4], nullptr);
+    }
+  }
+  return previous;
+}
+#endif
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,197 @@
+/**
+ * @file       bench.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-08
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Bench library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef BENCH_H
+  #define BENCH_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  /* Public defines ----------------------------------------------------- */
+  #define BENCH_LIB_VERSION     (F("0.1.0"))
+
+  #define BENCH_MAX_RESULTS     16
+  #define BENCH_REPEATS         7            // Timed batches per kernel, the fastest one is reported
+  #define BENCH_MIN_BATCH_NS    20000000ULL  // A batch is grown until it lasts at least 20 ms
+  #define BENCH_MAX_ITERATIONS  (1UL << 24)
+
+  // Tag of the CSV rows, set with -D BENCH_LABEL=\"...\" (or the BENCH_LABEL environment variable on host)
+  #ifndef BENCH_LABEL
+    #define BENCH_LABEL "dev"
+  #endif
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  BENCH_OK = 0,   /* No error */
+  BENCH_ERR,      /* Generic error */
+  BENCH_ERR_FULL, /* No room left for another result */
+  BENCH_ERR_IO    /* History file could not be opened */
+} bench_error_t;
+
+/**
+ * @brief Measurement of one kernel.
+ */
+typedef struct
+{
+  const char *name;       /**< Kernel name, must outlive the suite */
+  uint32_t    iterations; /**< Calls per timed batch */
+  float       nsPerOp;    /**< Best batch, ns per call */
+  float       nsMedian;   /**< Median batch, ns per call */
+} bench_result_t;
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Reads the benchmark clock.
+ *
+ * `std::chrono::steady_clock` on the host (HAL_NATIVE), the CPU cycle counter scaled by the CPU frequency on
+ * the ESP32. The cycle counter wraps every 2^32 cycles (about 17 s at 240 MHz), batches stay far below that.
+ *
+ * @return uint64_t A monotonic time in ns.
+ */
+uint64_t benchNowNs();
+
+/**
+ * @brief Keeps a value alive so the compiler cannot drop the computation that produced it.
+ *
+ * @param value The result of the kernel.
+ */
+template <typename T> inline void benchKeep(const T &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Microbenchmark harness for short, pure kernels such as sensor compensation or CRC.
+ *
+ * ### Features:
+ *
+ * - Calibrates the number of calls per batch by doubling it until a batch lasts `BENCH_MIN_BATCH_NS`, so
+ * the clock resolution and the loop overhead vanish against the kernel.
+ *
+ * - Runs `BENCH_REPEATS` batches and reports the fastest one (least disturbed by interrupts, other tasks or
+ * the host scheduler) together with the median.
+ *
+ * - Prints a table and `bench,<label>,<suite>,<kernel>,<ns/op>,<iterations>` CSV rows.
+ *
+ * - On the host, appends the rows with a timestamp to a history file and shows the change against the last
+ * recorded run of the same kernel, so an optimisation is proven by the numbers it moves.
+ *
+ * ### Usage:
+ *
+ * The kernel receives the call index, used to pick its input from a table so the compiler cannot hoist the
+ * computation out of the loop. Its result must go through `benchKeep()`.
+ *
+ * ```
+ * Bench bench("sensors");
+ * bench.run("crc8", [](uint32_t i) { benchKeep(crc8(frames[i & 15], 2)); });
+ * bench.report(Serial);
+ * ```
+ */
+class Bench
+{
+public:
+  /**
+   * @brief Constructor of the `Bench` class.
+   *
+   * @param suite Name of the suite, must outlive the object.
+   */
+  explicit Bench(const char *suite);
+
+  /**
+   * @brief Measures a kernel and stores its result.
+   *
+   * @param name Kernel name, must outlive the object.
+   * @param kernel Callable taking the call index (`uint32_t`).
+   *
+   * @return
+   *  - `BENCH_OK`: The kernel was measured.
+   *
+   *  - `BENCH_ERR_FULL`: `BENCH_MAX_RESULTS` kernels were already measured.
+   */
+  template <typename Kernel> bench_error_t run(const char *name, Kernel kernel)
+  {
+    if (count >= BENCH_MAX_RESULTS)
+    {
+      return BENCH_ERR_FULL;
+    }
+
+    // Warm-up and batch size calibration
+    uint32_t iterations = 1;
+    while (timeBatch(kernel, iterations) < BENCH_MIN_BATCH_NS && iterations < BENCH_MAX_ITERATIONS)
+    {
+      iterations <<= 1;
+    }
+
+    uint64_t samples[BENCH_REPEATS];
+    for (uint8_t repeat = 0; repeat < BENCH_REPEATS; repeat++)
+    {
+      samples[repeat] = timeBatch(kernel, iterations);
+    }
+
+    return addResult(name, iterations, samples);
+  }
+
+  /**
+   * @brief Prints the results as a table followed by CSV rows.
+   *
+   * @param out Destination, usually `Serial`.
+   */
+  void report(Print &out);
+
+  /**
+   * @brief Appends the results to a CSV history file and prints the change against the previous run.
+   *
+   * Only available on the host, the target reports through `report()` and the serial log is the history.
+   *
+   * @param path History file, created with a header row if missing.
+   * @param out Destination of the comparison.
+   *
+   * @return
+   *  - `BENCH_OK`: The results were appended.
+   *
+   *  - `BENCH_ERR_IO`: The file could not be opened, or the target has no file system for it.
+   */
+  bench_error_t appendHistory(const char *path, Print &out);
+
+  size_t                getCount() { return count; }
+  const bench_result_t &getResult(size_t index) { return results[index]; }
+
+private:
+  const char    *suite;
+  bench_result_t results[BENCH_MAX_RESULTS];
+  size_t         count;
+
+  template <typename Kernel> uint64_t timeBatch(Kernel &kernel, uint32_t iterations)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+      kernel(i);
+    }
+    return benchNowNs() - start;
+  }
+
+  bench_error_t addResult(const char *name, uint32_t iterations, uint64_t *samples);
+  const char   *getLabel();
+};
+
+#endif // BENCH_H
+
+/* End of file -------------------------------------------------------- */
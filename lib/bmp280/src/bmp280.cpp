@@ -40,10 +40,24 @@ bmp280_error_t BMP280::begin()
 
 bmp280_error_t BMP280::update()
 {
-  readTemperature();
-  readPressure();
-  readAltitude();
-  return BMP280_OK;
+  // Pressure (0xF7-0xF9) and temperature (0xFA-0xFC) in one transfer, so both come from the same sample
+  uint8_t buffer[BMP280_BURST_LEN];
+  if (bspI2CReadBytes(BMP280_I2C_ADDR, BMP280_REGISTER_PRESSUREDATA, buffer, sizeof(buffer)) != BSP_I2C_OK)
+  {
+    return BMP280_ERR_I2C;
+  }
+
+  int32_t adc_P = (uint32_t(buffer[0]) << 16 | uint32_t(buffer[1]) << 8 | uint32_t(buffer[2])) >> 4;
+  int32_t adc_T = (uint32_t(buffer[3]) << 16 | uint32_t(buffer[4]) << 8 | uint32_t(buffer[5])) >> 4;
+
+  return compensate(adc_T, adc_P);
+}
+
+bmp280_error_t BMP280::compensate(int32_t adc_T, int32_t adc_P)
+{
+  // Temperature first, it sets t_fine for the pressure formula
+  compensateTemperature(adc_T);
+  return compensatePressure(adc_P);
 }
 
 bmp280_error_t BMP280::reset(void)
@@ -61,63 +75,27 @@ uint8_t BMP280::getStatus(void)
 
 bmp280_error_t BMP280::readPressure()
 {
-  int64_t var1, var2, p;
-
   // Must be done first to get the t_fine variable set up
 
   int32_t adc_P = read24(BMP280_REGISTER_PRESSUREDATA);
   adc_P >>= 4;
 
-  var1 = ((int64_t) t_fine) - 128000;
-  var2 = var1 * var1 * (int64_t) _bmp280_calib.dig_P6;
-  var2 = var2 + ((var1 * (int64_t) _bmp280_calib.dig_P5) << 17);
-  var2 = var2 + (((int64_t) _bmp280_calib.dig_P4) << 35);
-  var1 =
-  ((var1 * var1 * (int64_t) _bmp280_calib.dig_P3) >> 8) + ((var1 * (int64_t) _bmp280_calib.dig_P2) << 12);
-  var1 = (((((int64_t) 1) << 47) + var1)) * ((int64_t) _bmp280_calib.dig_P1) >> 33;
-
-  if (var1 == 0)
-  {
-    return BMP280_ERR_DIV_ZERO; // avoid exception caused by division by zero
-  }
-  p    = 1048576 - adc_P;
-  p    = (((p << 31) - var2) * 3125) / var1;
-  var1 = (((int64_t) _bmp280_calib.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-  var2 = (((int64_t) _bmp280_calib.dig_P8) * p) >> 19;
-
-  p              = ((p + var1 + var2) >> 8) + (((int64_t) _bmp280_calib.dig_P7) << 4);
-  sensorValue[0] = p / 256;
-
-  return BMP280_OK;
+  return compensatePressure(adc_P);
 }
 
 bmp280_error_t BMP280::readTemperature()
 {
-  int32_t var1, var2;
-
   int32_t adc_T = read24(BMP280_REGISTER_TEMPDATA);
   adc_T >>= 4;
 
-  var1 = ((((adc_T >> 3) - ((int32_t) _bmp280_calib.dig_T1 << 1))) * ((int32_t) _bmp280_calib.dig_T2)) >> 11;
-
-  var2 =
-  (((((adc_T >> 4) - ((int32_t) _bmp280_calib.dig_T1)) * ((adc_T >> 4) - ((int32_t) _bmp280_calib.dig_T1))) >>
-    12) *
-   ((int32_t) _bmp280_calib.dig_T3)) >>
-  14;
-
-  t_fine = var1 + var2;
-
-  float T        = (t_fine * 5 + 128) >> 8;
-  sensorValue[1] = T / 100;
+  compensateTemperature(adc_T);
   return BMP280_OK;
 }
 
 bmp280_error_t BMP280::readAltitude()
 {
-  float pressure = getPressure(); // in SI units for Pascal
-  pressure /= 100;
-  sensorValue[2] = 44330 * (1.0 - pow(pressure / _seaLevelhPa, 0.1903));
+  sensorValue[2] = altitudeFromPressure(getPressure(), _seaLevelhPa);
+  _altitudeValid = true;
   return BMP280_OK;
 }
 
@@ -125,14 +103,34 @@ float BMP280::getPressure() { return sensorValue[0]; }
 
 float BMP280::getTemperature() { return sensorValue[1]; }
 
-float BMP280::getAltitude() { return sensorValue[2]; }
+float BMP280::getAltitude()
+{
+  // Computed on demand, the pow() is wasted work for callers that only need pressure
+  if (!_altitudeValid)
+  {
+    readAltitude();
+  }
+  return sensorValue[2];
+}
+
+float BMP280::altitudeFromPressure(float pressure, float seaLevelhPa)
+{
+  // Pressure in SI units for Pascal, the formula takes hPa
+  return 44330 * (1.0 - pow((pressure / 100) / seaLevelhPa, 0.1903));
+}
 
 float BMP280::seaLevelForAltitude(float altitude, float atmospheric)
 {
   return atmospheric / pow(1.0 - (altitude / 44330.0), 5.255);
 }
 
-void BMP280::setSeaLevelPressure(float pressure) { _seaLevelhPa = pressure; }
+void BMP280::setSeaLevelPressure(float pressure)
+{
+  _seaLevelhPa   = pressure;
+  _altitudeValid = false;
+}
+
+float BMP280::getSeaLevelPressure() { return _seaLevelhPa; }
 
 float BMP280::waterBoilingPoint(float pressure)
 {
@@ -171,6 +169,52 @@ bmp280_error_t BMP280::setSampling(bmp280_mode_t mode, bmp280_sampling_t tempSam
   return BMP280_OK;
 }
 
+bmp280_error_t BMP280::compensatePressure(int32_t adc_P)
+{
+  int64_t var1, var2, p;
+
+  var1 = ((int64_t) t_fine) - 128000;
+  var2 = var1 * var1 * (int64_t) _bmp280_calib.dig_P6;
+  var2 = var2 + ((var1 * (int64_t) _bmp280_calib.dig_P5) << 17);
+  var2 = var2 + (((int64_t) _bmp280_calib.dig_P4) << 35);
+  var1 =
+  ((var1 * var1 * (int64_t) _bmp280_calib.dig_P3) >> 8) + ((var1 * (int64_t) _bmp280_calib.dig_P2) << 12);
+  var1 = (((((int64_t) 1) << 47) + var1)) * ((int64_t) _bmp280_calib.dig_P1) >> 33;
+
+  if (var1 == 0)
+  {
+    return BMP280_ERR_DIV_ZERO; // avoid exception caused by division by zero
+  }
+  p    = 1048576 - adc_P;
+  p    = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t) _bmp280_calib.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t) _bmp280_calib.dig_P8) * p) >> 19;
+
+  p              = ((p + var1 + var2) >> 8) + (((int64_t) _bmp280_calib.dig_P7) << 4);
+  sensorValue[0] = p / 256;
+  _altitudeValid = false;
+
+  return BMP280_OK;
+}
+
+void BMP280::compensateTemperature(int32_t adc_T)
+{
+  int32_t var1, var2;
+
+  var1 = ((((adc_T >> 3) - ((int32_t) _bmp280_calib.dig_T1 << 1))) * ((int32_t) _bmp280_calib.dig_T2)) >> 11;
+
+  var2 =
+  (((((adc_T >> 4) - ((int32_t) _bmp280_calib.dig_T1)) * ((adc_T >> 4) - ((int32_t) _bmp280_calib.dig_T1))) >>
+    12) *
+   ((int32_t) _bmp280_calib.dig_T3)) >>
+  14;
+
+  t_fine = var1 + var2;
+
+  float T        = (t_fine * 5 + 128) >> 8;
+  sensorValue[1] = T / 100;
+}
+
 bmp280_error_t BMP280::readCoefficients()
 {
   _bmp280_calib.dig_T1 = read16_LE(BMP280_REGISTER_DIG_T1);
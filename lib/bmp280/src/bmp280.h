@@ -21,9 +21,12 @@
   #endif
 
   /* Public defines ----------------------------------------------------- */
-  #define BMP280_LIB_VERSION (F("0.1.0"))
+  #define BMP280_LIB_VERSION   (F("0.1.0"))
 
-  #define BMP280_I2C_ADDR    0x76
+  #define BMP280_I2C_ADDR      0x76
+
+  #define BMP280_BURST_LEN     6       /**< Pressure + temperature data registers (0xF7-0xFC) */
+  #define BMP280_SEA_LEVEL_HPA 1013.25f /**< Standard sea level pressure */
 /* Public enumerate/structure ----------------------------------------- */
 typedef enum
 {
@@ -185,7 +188,8 @@ public:
   /**
    * @brief Updates all sensor measurements.
    *
-   * Reads temperature, pressure, and altitude in sequence, storing results in the internal sensor array.
+   * Burst-reads the pressure and temperature data registers (0xF7–0xFC) in a single I2C transfer and
+   * compensates both values from that same sample. Altitude is not computed here, see `getAltitude()`.
    *
    * @param[in] None
    *
@@ -193,9 +197,31 @@ public:
    *
    * @return
    *  - `BMP280_OK`: Success
+   *
+   *  - `BMP280_ERR_I2C`: Data registers could not be read
+   *
+   *  - `BMP280_ERR_DIV_ZERO`: Division by zero error during pressure compensation
    */
   bmp280_error_t update();
 
+  /**
+   * @brief Compensates raw ADC readings into temperature and pressure.
+   *
+   * This is the arithmetic half of `update()`, usable on a sample read by other means (e.g. a queued burst
+   * transfer) and on its own for benchmarking.
+   *
+   * @param[in] adc_T 20-bit temperature ADC output.
+   * @param[in] adc_P 20-bit pressure ADC output.
+   *
+   * @attention Requires the calibration coefficients, read by `begin()`.
+   *
+   * @return
+   *  - `BMP280_OK`: Success
+   *
+   *  - `BMP280_ERR_DIV_ZERO`: Division by zero error during pressure compensation
+   */
+  bmp280_error_t compensate(int32_t adc_T, int32_t adc_P);
+
   /**
    * @brief Resets the BMP280 sensor.
    *
@@ -300,16 +326,29 @@ public:
   /**
    * @brief Retrieves the altitude value.
    *
-   * Returns the previously calculated altitude value stored in the internal sensor array, in meters.
+   * Returns the altitude in meters derived from the last pressure reading. The value is computed lazily on
+   * the first call after a new pressure sample or a sea level pressure change, and cached afterwards.
    *
    * @param[in] None
    *
-   * @attention Requires a prior successful call to `readAltitude()` or `update()`.
+   * @attention Requires a prior successful call to `readPressure()` or `update()`.
    *
    * @return float The altitude value in meters.
    */
   float getAltitude();
 
+  /**
+   * @brief Converts a pressure to an altitude, for consumers that only keep the pressure.
+   *
+   * @param[in] pressure    The pressure in Pascals.
+   * @param[in] seaLevelhPa The sea level pressure in hPa.
+   *
+   * @attention Costs a `pow()`, cache the result while the pressure does not change.
+   *
+   * @return float The altitude in meters.
+   */
+  static float altitudeFromPressure(float pressure, float seaLevelhPa = BMP280_SEA_LEVEL_HPA);
+
   /**
    * @brief Calculates sea level pressure for a given altitude and atmospheric pressure.
    *
@@ -336,6 +375,15 @@ public:
    */
   void setSeaLevelPressure(float pressure);
 
+  /**
+   * @brief Retrieves the sea level pressure used for altitude calculations.
+   *
+   * @param[in] None
+   *
+   * @return float The sea level pressure in hPa, `BMP280_SEA_LEVEL_HPA` unless set otherwise.
+   */
+  float getSeaLevelPressure();
+
   /**
    * @brief Calculates the water boiling point based on pressure.
    *
@@ -392,7 +440,8 @@ private:
                                 // Index 1: Temperature
                                 // Index 2: Altitude
 
-  float _seaLevelhPa = 1013.25f;
+  float _seaLevelhPa   = BMP280_SEA_LEVEL_HPA;
+  bool  _altitudeValid = false; // Altitude matches the current pressure and sea level pressure
 
   /** Encapsulates the config register */
   struct config
@@ -427,6 +476,8 @@ private:
   };
 
   bmp280_error_t readCoefficients(void);
+  bmp280_error_t compensatePressure(int32_t adc_P);
+  void           compensateTemperature(int32_t adc_T);
   uint16_t       read16(byte reg);
   uint32_t       read24(byte reg);
   int16_t        readS16(byte reg);
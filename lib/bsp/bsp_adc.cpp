@@ -0,0 +1,179 @@
+/**
+ * @file       bsp_adc.cpp
+ * @license    This project is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-12
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for bsp_adc
+ *
+ * @note       Uses the continuous-mode driver of the Arduino-ESP32 2.x core (ESP-IDF 4.4, driver/adc.h).
+ * @example    None
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "bsp_adc.h"
+
+#ifdef HAL_NATIVE
+  #include "hal_native.h"
+#else
+  #include "driver/adc.h"
+#endif
+
+/* Private defines ---------------------------------------------------- */
+#ifndef HAL_NATIVE
+  #define BSP_ADC_MAX_FRAME_BYTES (BSP_ADC_MAX_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+  #define BSP_ADC_DRIVER_FRAMES   4 // Frames buffered by the driver if the reader lags
+#endif
+
+/* Private variables -------------------------------------------------- */
+static bool bspAdcRunning = false;
+
+#ifndef HAL_NATIVE
+static TaskHandle_t       bspAdcReader     = NULL;
+static uint8_t            bspAdcChannel    = 0;
+static uint32_t           bspAdcFrameBytes = 0;
+static bsp_adc_callback_t bspAdcCallback   = NULL;
+static void              *bspAdcArg        = NULL;
+#endif
+
+/* Private function prototypes ---------------------------------------- */
+#ifndef HAL_NATIVE
+static void bspAdcReaderTask(void *pvParameters);
+#endif
+
+/* Function definitions ----------------------------------------------- */
+bsp_adc_error_t bspAdcContinuousBegin(uint8_t pin, uint32_t sampleRateHz, bsp_adc_callback_t callback,
+                                      void *arg, uint16_t frameSamples)
+{
+  if (bspAdcRunning)
+  {
+    return BSP_ADC_ERR_BUSY;
+  }
+  if (sampleRateHz < BSP_ADC_MIN_SAMPLE_RATE || sampleRateHz > BSP_ADC_MAX_SAMPLE_RATE)
+  {
+    return BSP_ADC_ERR_RATE;
+  }
+  if (frameSamples == 0 || frameSamples > BSP_ADC_MAX_FRAME_SAMPLES)
+  {
+    return BSP_ADC_ERR_FRAME;
+  }
+  if (callback == NULL)
+  {
+    return BSP_ADC_ERR;
+  }
+
+#ifdef HAL_NATIVE
+  if (!halAdcContinuousStart(pin, sampleRateHz, frameSamples, callback, arg))
+  {
+    return BSP_ADC_ERR_PIN;
+  }
+#else
+  // Only ADC1 is usable by the DMA controller on the S3
+  int8_t channel = digitalPinToAnalogChannel(pin);
+  if (channel < 0 || channel >= SOC_ADC_CHANNEL_NUM(0))
+  {
+    return BSP_ADC_ERR_PIN;
+  }
+
+  // One interrupt, and one wake-up of the reader, per frame
+  bspAdcFrameBytes                  = (uint32_t) frameSamples * SOC_ADC_DIGI_RESULT_BYTES;
+  adc_digi_init_config_t initConfig = {};
+  initConfig.max_store_buf_size     = bspAdcFrameBytes * BSP_ADC_DRIVER_FRAMES;
+  initConfig.conv_num_each_intr     = bspAdcFrameBytes;
+  initConfig.adc1_chan_mask         = BIT(channel);
+  initConfig.adc2_chan_mask         = 0;
+  if (adc_digi_initialize(&initConfig) != ESP_OK)
+  {
+    return BSP_ADC_ERR;
+  }
+
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten                     = ADC_ATTEN_DB_11; // Same full scale as analogRead()
+  pattern.channel                   = channel;
+  pattern.unit                      = 0; // ADC1
+  pattern.bit_width                 = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_digi_configuration_t digiConfig = {};
+  digiConfig.conv_limit_en            = false;
+  digiConfig.conv_limit_num           = 250;
+  digiConfig.pattern_num              = 1;
+  digiConfig.adc_pattern              = &pattern;
+  digiConfig.sample_freq_hz           = sampleRateHz;
+  digiConfig.conv_mode                = ADC_CONV_SINGLE_UNIT_1;
+  digiConfig.format                   = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+  if (adc_digi_controller_configure(&digiConfig) != ESP_OK)
+  {
+    adc_digi_deinitialize();
+    return BSP_ADC_ERR;
+  }
+
+  bspAdcChannel  = (uint8_t) channel;
+  bspAdcCallback = callback;
+  bspAdcArg      = arg;
+  if (xTaskCreate(bspAdcReaderTask, "ADC Reader Task", BSP_ADC_READER_STACK_SIZE, NULL,
+                  BSP_ADC_READER_PRIORITY, &bspAdcReader) != pdPASS)
+  {
+    adc_digi_deinitialize();
+    return BSP_ADC_ERR;
+  }
+  adc_digi_start();
+#endif
+
+  bspAdcRunning = true;
+  return BSP_ADC_OK;
+}
+
+void bspAdcContinuousEnd()
+{
+  if (!bspAdcRunning)
+  {
+    return;
+  }
+
+#ifdef HAL_NATIVE
+  halAdcContinuousStop();
+#else
+  vTaskDelete(bspAdcReader);
+  bspAdcReader = NULL;
+  adc_digi_stop();
+  adc_digi_deinitialize();
+#endif
+  bspAdcRunning = false;
+}
+
+/* Private definitions ------------------------------------------------ */
+#ifndef HAL_NATIVE
+static void bspAdcReaderTask(void *pvParameters)
+{
+  static uint8_t  frame[BSP_ADC_MAX_FRAME_BYTES];
+  static uint16_t samples[BSP_ADC_MAX_FRAME_SAMPLES];
+
+  for (;;)
+  {
+    // Blocks until the DMA completed a frame, ESP_ERR_INVALID_STATE only reports a driver buffer overflow
+    uint32_t  length = 0;
+    esp_err_t err    = adc_digi_read_bytes(frame, bspAdcFrameBytes, &length, ADC_MAX_DELAY);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+    {
+      continue;
+    }
+
+    size_t count = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES)
+    {
+      const adc_digi_output_data_t *result = (const adc_digi_output_data_t *) &frame[i];
+      if (result->type2.unit == 0 && result->type2.channel == bspAdcChannel)
+      {
+        samples[count++] = result->type2.data;
+      }
+    }
+    if (count > 0)
+    {
+      bspAdcCallback(samples, count, bspAdcArg);
+    }
+  }
+}
+#endif
+
+/* End of file -------------------------------------------------------- */
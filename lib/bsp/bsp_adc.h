@@ -0,0 +1,93 @@
+/**
+ * @file       bsp_adc.h
+ * @license    This project is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-12
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for bsp_adc
+ *
+ * @note       Continuous (DMA) conversions on one ADC1 pin. One-shot reads stay in bsp_gpio.
+ * @example    None
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef BSP_ADC_H
+  #define BSP_ADC_H
+
+  /* Includes --------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+/* Public defines ----------------------------------------------------- */
+  #define BSP_ADC_FRAME_SAMPLES     64    /**< Default conversions handed to the callback at once */
+  #define BSP_ADC_MAX_FRAME_SAMPLES 512   /**< Largest frame, 2 KB of DMA results on the S3 */
+  #define BSP_ADC_MIN_SAMPLE_RATE   1000  /**< Hz, the DMA controller cannot run slower (611 Hz on S3) */
+  #define BSP_ADC_MAX_SAMPLE_RATE   80000 /**< Hz */
+  #define BSP_ADC_READER_STACK_SIZE 3072  /**< Stack size of the task draining the DMA frames */
+  #define BSP_ADC_READER_PRIORITY   2     /**< Priority of the task draining the DMA frames */
+
+/* Public enumerate/structure ----------------------------------------- */
+
+// Error codes for the continuous ADC
+typedef enum
+{
+  BSP_ADC_OK = 0,
+  BSP_ADC_ERR,       /**< Driver or task could not be started */
+  BSP_ADC_ERR_PIN,   /**< Pin is not an ADC1 channel */
+  BSP_ADC_ERR_RATE,  /**< Sample rate out of range */
+  BSP_ADC_ERR_FRAME, /**< Frame size out of range */
+  BSP_ADC_ERR_BUSY   /**< A stream already runs */
+} bsp_adc_error_t;
+
+/**
+ * @brief Frame callback of the continuous ADC. Runs in the reader task (the simulated clock on the host),
+ * keep it short. `samples` are 12-bit raw counts, only valid during the call.
+ */
+typedef void (*bsp_adc_callback_t)(const uint16_t *samples, size_t count, void *arg);
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Public function prototypes ----------------------------------------- */
+
+/**
+ * @brief  Starts converting one pin continuously at a fixed rate.
+ *
+ * The ADC DMA engine fills frames of `frameSamples` conversions without the CPU, a reader task wakes once per
+ * frame and hands the raw counts to the callback. The CPU wakes `sampleRateHz / frameSamples` times per
+ * second: a consumer that does not need every conversion at once should ask for large frames. On the host the
+ * `halAdcContinuousStart()` model produces the same frames on the virtual clock.
+ *
+ * @param[in]     pin           GPIO of an ADC1 channel.
+ * @param[in]     sampleRateHz  Conversions per second, `BSP_ADC_MIN_SAMPLE_RATE` to
+ * `BSP_ADC_MAX_SAMPLE_RATE`.
+ * @param[in]     callback      Called with each frame.
+ * @param[in]     arg           Passed to the callback.
+ * @param[in]     frameSamples  Conversions per callback, 1 to `BSP_ADC_MAX_FRAME_SAMPLES`.
+ *
+ * @attention  While the stream runs, `bspGpioAnalogRead()` must not be used: the ADC belongs to the DMA.
+ *
+ * @return
+ *  - `BSP_ADC_OK`       : Stream started
+ *  - `BSP_ADC_ERR_PIN`  : Not an ADC1 pin
+ *  - `BSP_ADC_ERR_RATE` : Sample rate out of range
+ *  - `BSP_ADC_ERR_FRAME`: Frame size out of range
+ *  - `BSP_ADC_ERR_BUSY` : A stream already runs, there is one DMA engine
+ *  - `BSP_ADC_ERR`      : Driver or reader task could not be started
+ */
+bsp_adc_error_t bspAdcContinuousBegin(uint8_t pin, uint32_t sampleRateHz, bsp_adc_callback_t callback,
+                                      void *arg, uint16_t frameSamples = BSP_ADC_FRAME_SAMPLES);
+
+/**
+ * @brief  Stops the stream started with `bspAdcContinuousBegin()` and releases the driver.
+ */
+void bspAdcContinuousEnd();
+
+#endif // BSP_ADC_H
+
+/* End of file -------------------------------------------------------- */
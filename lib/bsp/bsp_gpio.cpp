@@ -13,6 +13,11 @@
 
 /* Includes ----------------------------------------------------------- */
 #include "bsp_gpio.h"
+
+#ifndef HAL_NATIVE
+  #include "soc/gpio_reg.h"
+  #include "soc/soc.h"
+#endif
 /* Private defines ---------------------------------------------------- */
 
 /* Private enumerate/structure ---------------------------------------- */
@@ -70,6 +75,21 @@ void bspGpioDigitalWrite(uint8_t pin, uint8_t state)
 
 bool bspGpioDigitalRead(uint8_t pin) { return digitalRead(pin) == 1 ? true : false; }
 
+uint64_t bspGpioReadInputs()
+{
+#ifdef HAL_NATIVE
+  uint64_t levels = 0;
+  for (uint8_t pin = 0; pin < HAL_GPIO_PIN_COUNT; pin++)
+  {
+    levels |= (uint64_t) (digitalRead(pin) == HIGH) << pin;
+  }
+  return levels;
+#else
+  // GPIO 0-31, then GPIO 32 and up
+  return ((uint64_t) REG_READ(GPIO_IN1_REG) << 32) | REG_READ(GPIO_IN_REG);
+#endif
+}
+
 /* Analog Pin --------------------------------------------------------- */
 
 int  bspGpioAnalogRead(uint8_t pin) { return analogRead(pin); }
@@ -101,5 +121,13 @@ void bspGpioTone(uint8_t pin, unsigned int frequency, unsigned long duration)
 }
 void bspGpioNoTone(uint8_t pin) { noTone(pin); }
 
+/* Interrupts --------------------------------------------------------- */
+
+void bspGpioAttachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode)
+{
+  attachInterruptArg(digitalPinToInterrupt(pin), handler, arg, mode);
+}
+void bspGpioDetachInterrupt(uint8_t pin) { detachInterrupt(digitalPinToInterrupt(pin)); }
+
 /* Private definitions ------------------------------------------------ */
 /* End of file -------------------------------------------------------- */
@@ -75,6 +75,20 @@ void bspGpioDigitalWrite(uint8_t pin, uint8_t state);
  */
 bool bspGpioDigitalRead(uint8_t pin);
 
+/**
+ * @brief This function reads the level of every GPIO pin at once
+ *
+ * @attention
+ * One read of the GPIO input registers instead of one bspGpioDigitalRead() per pin, so the levels of several
+ * buttons are sampled at the same instant.
+ *
+ * @return
+ * - Bit n is the level of GPIO n (1 - HIGH, 0 - LOW)
+ *
+ * - Data type: uint64_t
+ */
+uint64_t bspGpioReadInputs();
+
 /* Analog Pin -------------------------------------------------------- */
 
 /**
@@ -238,6 +252,34 @@ void bspGpioTone(uint8_t pin, unsigned int frequency, unsigned long duration);
  */
 void bspGpioNoTone(uint8_t pin);
 
+/* Interrupts --------------------------------------------------------- */
+
+/**
+ * @brief This function attaches an interrupt handler to a digital pin. The handler receives `arg`.
+ *
+ * @param[in] pin           The pin to watch.
+ * @param[in] handler       The function to call, it runs in interrupt context and must be marked IRAM_ATTR.
+ * @param[in] arg           The argument passed to the handler, e.g. the object owning the pin.
+ * @param[in] mode          When the interrupt fires: RISING, FALLING, CHANGE, ONLOW or ONHIGH.
+ *
+ * @attention
+ * The handler must be short and must not block: no Serial, no I2C, only FromISR variants of FreeRTOS calls.
+ *
+ * @return
+ * None
+ */
+void bspGpioAttachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode);
+
+/**
+ * @brief This function detaches the interrupt handler of a digital pin.
+ *
+ * @param[in] pin           The pin to stop watching.
+ *
+ * @return
+ * None
+ */
+void bspGpioDetachInterrupt(uint8_t pin);
+
 
 
 
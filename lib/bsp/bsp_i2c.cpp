@@ -16,6 +16,10 @@
 #include "config.h" // Global config file
 #include <Wire.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
 /* Private defines ---------------------------------------------------- */
 
 /* Private enumerate/structure ---------------------------------------- */
@@ -26,8 +30,19 @@
 static TwoWire *i2cWire = &Wire;
 
 /* Private variables -------------------------------------------------- */
+static QueueHandle_t          i2cQueue     = nullptr;
+static TaskHandle_t           i2cOwnerTask = nullptr;
+static bsp_i2c_device_stats_t i2cStats[BSP_I2C_MAX_DEVICES];
 
 /* Private function prototypes ---------------------------------------- */
+static SemaphoreHandle_t bspI2CGetMutex(void);
+static bsp_i2c_error_t   bspI2CExecute(bsp_i2c_transaction_t *txn);
+static bsp_i2c_error_t   bspI2CDispatch(bsp_i2c_transaction_t *txn);
+static void              bspI2CRecord(const bsp_i2c_transaction_t *txn, bool coalesced);
+static void              bspI2CComplete(bsp_i2c_transaction_t *txn);
+static bool              bspI2CIsSameRead(const bsp_i2c_transaction_t *a, const bsp_i2c_transaction_t *b);
+static void              bspI2CTransferDone(bsp_i2c_transaction_t *txn);
+static void              bspI2CEngineTask(void *pvParameters);
 
 /* Function definitions ----------------------------------------------- */
 bsp_i2c_error_t bspI2CBegin()
@@ -114,112 +129,370 @@ bsp_i2c_error_t bspI2CFlush(void)
 
 bsp_i2c_error_t bspI2CReadByte(int address, uint8_t reg, uint8_t &byte)
 {
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_READ;
+  txn.address               = address;
+  txn.hasRegister           = true;
+  txn.reg                   = reg;
+  txn.buffer                = &byte;
+  txn.len                   = 1;
+  return bspI2CDispatch(&txn);
+}
+
+bsp_i2c_error_t bspI2CReadByte(int address, uint8_t &byte)
+{
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_READ;
+  txn.address               = address;
+  txn.buffer                = &byte;
+  txn.len                   = 1;
+  return bspI2CDispatch(&txn);
+}
+
+bsp_i2c_error_t bspI2CReadBytes(int address, uint8_t reg, uint8_t *bytes, uint32_t len)
+{
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_READ;
+  txn.address               = address;
+  txn.hasRegister           = true;
+  txn.reg                   = reg;
+  txn.buffer                = bytes;
+  txn.len                   = len;
+  return bspI2CDispatch(&txn);
+}
+
+bsp_i2c_error_t bspI2CReadBytes(int address, uint8_t *bytes, uint32_t len)
+{
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_READ;
+  txn.address               = address;
+  txn.buffer                = bytes;
+  txn.len                   = len;
+  return bspI2CDispatch(&txn);
+}
+
+bsp_i2c_error_t bspI2CWriteByte(int address, uint8_t reg, uint8_t byte)
+{
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_WRITE;
+  txn.address               = address;
+  txn.hasRegister           = true;
+  txn.reg                   = reg;
+  txn.buffer                = &byte;
+  txn.len                   = 1;
+  return bspI2CDispatch(&txn);
+}
+
+bsp_i2c_error_t bspI2CWriteBytes(int address, uint8_t reg, uint8_t *bytes, uint32_t len)
+{
+  bsp_i2c_transaction_t txn = {};
+  txn.type                  = BSP_I2C_TXN_WRITE;
+  txn.address               = address;
+  txn.hasRegister           = true;
+  txn.reg                   = reg;
+  txn.buffer                = bytes;
+  txn.len                   = len;
+  return bspI2CDispatch(&txn);
+}
+
+bool bspI2CExist(uint8_t address)
+{
+  bspI2CLock();
   i2cWire->beginTransmission(address);
-  i2cWire->write(reg);
-  i2cWire->endTransmission();
+  bool exist = (i2cWire->endTransmission() == 0) ? true : false;
+  bspI2CUnlock();
+  return exist;
+}
 
-  int cnt = 0;
-  i2cWire->requestFrom(address, 1);
+void bspI2CSetWire(TwoWire *wire) { i2cWire = wire; }
+
+bsp_i2c_error_t bspI2CLock(TickType_t timeout)
+{
+  return (xSemaphoreTakeRecursive(bspI2CGetMutex(), timeout) == pdTRUE) ? BSP_I2C_OK : BSP_I2C_TIMEOUT;
+}
 
-  while (1 != i2cWire->available())
+void bspI2CUnlock(void) { xSemaphoreGiveRecursive(bspI2CGetMutex()); }
+
+bsp_i2c_error_t bspI2CEngineBegin(uint32_t queueLength, UBaseType_t priority, bool startTask)
+{
+  if (i2cQueue != nullptr)
   {
-    cnt++;
-    if (cnt >= 10)
-    {
-      return BSP_I2C_ERR_READ;
-    }
-    DELAY(1);
+    return BSP_I2C_OK;
+  }
+
+  i2cQueue = xQueueCreate(queueLength, sizeof(bsp_i2c_transaction_t *));
+  if (i2cQueue == nullptr)
+  {
+    return BSP_I2C_ERR;
+  }
+
+  if (startTask && xTaskCreate(bspI2CEngineTask, "I2C Engine Task", BSP_I2C_ENGINE_STACK_SIZE, NULL,
+                               priority, &i2cOwnerTask) != pdPASS)
+  {
+    // Nobody would serve the queue, keep running transactions inline
+    vQueueDelete(i2cQueue);
+    i2cQueue     = nullptr;
+    i2cOwnerTask = nullptr;
+    return BSP_I2C_ERR;
   }
-  byte = i2cWire->read();
   return BSP_I2C_OK;
 }
 
-bsp_i2c_error_t bspI2CReadByte(int address, uint8_t &byte)
+uint8_t bspI2CEngineStep(TickType_t timeout)
 {
-  int cnt = 0;
-  i2cWire->requestFrom(address, 1);
-  while (1 != i2cWire->available())
+  bsp_i2c_transaction_t *batch[BSP_I2C_ENGINE_BATCH_SIZE];
+  uint8_t                count     = 0;
+  uint8_t                completed = 0;
+
+  // Wait for the first request, then drain whatever else is already waiting
+  if (i2cQueue == nullptr || xQueueReceive(i2cQueue, &batch[count], timeout) != pdTRUE)
   {
-    cnt++;
-    if (cnt >= 10)
+    return 0;
+  }
+  count++;
+  while (count < BSP_I2C_ENGINE_BATCH_SIZE && xQueueReceive(i2cQueue, &batch[count], 0) == pdTRUE)
+  {
+    count++;
+  }
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    bsp_i2c_transaction_t *txn = batch[i];
+    if (txn == nullptr)
     {
-      return BSP_I2C_ERR_READ;
+      continue; // Already served by a coalesced read
     }
-    DELAY(1);
+
+    bspI2CLock();
+    bspI2CExecute(txn);
+    bspI2CRecord(txn, false);
+
+    // Serve identical reads queued behind this one, until something writes to the same device
+    for (uint8_t j = i + 1; txn->type == BSP_I2C_TXN_READ && j < count; j++)
+    {
+      bsp_i2c_transaction_t *other = batch[j];
+      if (other == nullptr)
+      {
+        continue;
+      }
+      if (other->address == txn->address && other->type == BSP_I2C_TXN_WRITE)
+      {
+        break;
+      }
+      if (bspI2CIsSameRead(txn, other))
+      {
+        memcpy(other->buffer, txn->buffer, txn->len);
+        other->result = txn->result;
+        bspI2CRecord(other, true);
+        batch[j] = nullptr;
+        bspI2CComplete(other);
+        completed++;
+      }
+    }
+    bspI2CUnlock();
+
+    bspI2CComplete(txn);
+    completed++;
   }
-  byte = i2cWire->read();
-  return BSP_I2C_OK;
+  return completed;
 }
 
-bsp_i2c_error_t bspI2CReadBytes(int address, uint8_t reg, uint8_t *bytes, uint32_t len)
+bsp_i2c_error_t bspI2CSubmit(bsp_i2c_transaction_t *txn, TickType_t timeout)
 {
-  i2cWire->beginTransmission(address);
-  i2cWire->write(reg);
-  i2cWire->endTransmission();
+  if (txn == nullptr || (txn->buffer == nullptr && txn->len > 0) || txn->address >= BSP_I2C_MAX_DEVICES)
+  {
+    return BSP_I2C_ERR;
+  }
 
-  int cnt = 0;
-  i2cWire->requestFrom(address, len);
+  txn->submitTime = micros();
 
-  while (len != i2cWire->available())
+  // No queue (or we are the owner task): run it right here
+  if (i2cQueue == nullptr || xTaskGetCurrentTaskHandle() == i2cOwnerTask)
   {
-    cnt++;
-    if (cnt >= 10)
-    {
-      return BSP_I2C_ERR_READ;
-    }
-    DELAY(1);
+    bspI2CLock();
+    bspI2CExecute(txn);
+    bspI2CRecord(txn, false);
+    bspI2CUnlock();
+    bspI2CComplete(txn);
+    return BSP_I2C_OK;
   }
-  for (int i = 0; i < len; i++)
+
+  return (xQueueSendToBack(i2cQueue, &txn, timeout) == pdTRUE) ? BSP_I2C_OK : BSP_I2C_TIMEOUT;
+}
+
+bsp_i2c_error_t bspI2CTransfer(bsp_i2c_transaction_t *txn, TickType_t timeout)
+{
+  if (txn == nullptr)
+  {
+    return BSP_I2C_ERR;
+  }
+  if (i2cOwnerTask == nullptr || xTaskGetCurrentTaskHandle() == i2cOwnerTask)
+  {
+    // Nobody else would complete it, e.g. an engine served with bspI2CEngineStep()
+    return bspI2CDispatch(txn);
+  }
+
+  // A semaphore of this call, the task notification value may belong to someone else (e.g. a wake-up)
+  StaticSemaphore_t doneBuffer;
+  SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&doneBuffer);
+
+  txn->callback   = bspI2CTransferDone;
+  txn->arg        = done;
+  txn->notifyTask = nullptr;
+
+  bsp_i2c_error_t err = bspI2CSubmit(txn, timeout);
+  if (err == BSP_I2C_OK)
+  {
+    // No timeout once queued, the owner task still holds the descriptor until it completes
+    xSemaphoreTake(done, portMAX_DELAY);
+    err = txn->result;
+  }
+  vSemaphoreDelete(done);
+  return err;
+}
+
+bsp_i2c_error_t bspI2CGetDeviceStats(uint8_t address, bsp_i2c_device_stats_t &stats)
+{
+  if (address >= BSP_I2C_MAX_DEVICES)
   {
-    bytes[i] = i2cWire->read();
+    return BSP_I2C_ERR;
   }
+  bspI2CLock();
+  stats = i2cStats[address];
+  bspI2CUnlock();
   return BSP_I2C_OK;
 }
 
-bsp_i2c_error_t bspI2CReadBytes(int address, uint8_t *bytes, uint32_t len)
+void bspI2CResetStats(void)
+{
+  bspI2CLock();
+  memset(i2cStats, 0, sizeof(i2cStats));
+  bspI2CUnlock();
+}
+
+/* Private definitions ------------------------------------------------ */
+static SemaphoreHandle_t bspI2CGetMutex(void)
+{
+  // Function-local static: created once, on first use, by whichever task gets here first
+  static SemaphoreHandle_t mutex = xSemaphoreCreateRecursiveMutex();
+  return mutex;
+}
+
+static bsp_i2c_error_t bspI2CExecute(bsp_i2c_transaction_t *txn)
 {
+  if (txn->type == BSP_I2C_TXN_WRITE)
+  {
+    i2cWire->beginTransmission(txn->address);
+    if (txn->hasRegister)
+    {
+      i2cWire->write(txn->reg);
+    }
+    for (uint16_t i = 0; i < txn->len; i++)
+    {
+      i2cWire->write(txn->buffer[i]);
+    }
+    txn->result = (i2cWire->endTransmission() == 0) ? BSP_I2C_OK : BSP_I2C_ERR_WRITE;
+    return txn->result;
+  }
+
+  if (txn->hasRegister)
+  {
+    i2cWire->beginTransmission(txn->address);
+    i2cWire->write(txn->reg);
+    i2cWire->endTransmission();
+  }
+
   int cnt = 0;
-  i2cWire->requestFrom(address, len);
-  while (len != i2cWire->available())
+  i2cWire->requestFrom((int) txn->address, (int) txn->len);
+
+  while (txn->len != i2cWire->available())
   {
     cnt++;
     if (cnt >= 10)
     {
-      return BSP_I2C_ERR_READ;
+      txn->result = BSP_I2C_ERR_READ;
+      return txn->result;
     }
     DELAY(1);
   }
-  for (int i = 0; i < len; i++)
+  for (uint16_t i = 0; i < txn->len; i++)
   {
-    bytes[i] = i2cWire->read();
+    txn->buffer[i] = i2cWire->read();
   }
-  return BSP_I2C_OK;
+  txn->result = BSP_I2C_OK;
+  return txn->result;
 }
 
-bsp_i2c_error_t bspI2CWriteByte(int address, uint8_t reg, uint8_t byte)
+static bsp_i2c_error_t bspI2CDispatch(bsp_i2c_transaction_t *txn)
 {
-  i2cWire->beginTransmission(address);
-  i2cWire->write(reg);
-  i2cWire->write(byte);
-  return (i2cWire->endTransmission() == 0) ? BSP_I2C_OK : BSP_I2C_ERR_WRITE;
+  if (i2cOwnerTask == nullptr || xTaskGetCurrentTaskHandle() == i2cOwnerTask)
+  {
+    txn->submitTime = micros();
+    bspI2CLock();
+    bspI2CExecute(txn);
+    bspI2CRecord(txn, false);
+    bspI2CUnlock();
+    return txn->result;
+  }
+  return bspI2CTransfer(txn);
 }
 
-bsp_i2c_error_t bspI2CWriteBytes(int address, uint8_t reg, uint8_t *bytes, uint32_t len)
+static void bspI2CRecord(const bsp_i2c_transaction_t *txn, bool coalesced)
 {
-  i2cWire->beginTransmission(address);
-  i2cWire->write(reg);
-  for (int i = 0; i < len; i++)
+  bsp_i2c_device_stats_t &stats   = i2cStats[txn->address & (BSP_I2C_MAX_DEVICES - 1)];
+  uint32_t                latency = micros() - txn->submitTime;
+
+  stats.transactions++;
+  stats.lastLatencyUs = latency;
+  stats.totalLatencyUs += latency;
+  if (latency > stats.maxLatencyUs)
+  {
+    stats.maxLatencyUs = latency;
+  }
+  if (txn->result != BSP_I2C_OK)
   {
-    i2cWire->write(bytes[i]);
+    stats.errors++;
+  }
+  if (coalesced)
+  {
+    stats.coalesced++;
   }
-  return (i2cWire->endTransmission() == 0) ? BSP_I2C_OK : BSP_I2C_ERR_WRITE;
 }
 
-bool bspI2CExist(uint8_t address)
+static void bspI2CComplete(bsp_i2c_transaction_t *txn)
 {
-  i2cWire->beginTransmission(address);
-  return (i2cWire->endTransmission() == 0) ? true : false;
+  // Copy out first, the descriptor may be released as soon as the owner is told
+  bsp_i2c_callback_t callback   = txn->callback;
+  TaskHandle_t       notifyTask = txn->notifyTask;
+
+  if (callback != nullptr)
+  {
+    callback(txn);
+  }
+  if (notifyTask != nullptr && notifyTask != xTaskGetCurrentTaskHandle())
+  {
+    xTaskNotifyGive(notifyTask);
+  }
+}
+
+static bool bspI2CIsSameRead(const bsp_i2c_transaction_t *a, const bsp_i2c_transaction_t *b)
+{
+  return a->type == BSP_I2C_TXN_READ && b->type == BSP_I2C_TXN_READ && a->address == b->address &&
+         a->hasRegister == b->hasRegister && (!a->hasRegister || a->reg == b->reg) && a->len == b->len;
+}
+
+static void bspI2CTransferDone(bsp_i2c_transaction_t *txn)
+{
+  // Last access to the descriptor, the caller returns as soon as it is given
+  xSemaphoreGive((SemaphoreHandle_t) txn->arg);
+}
+
+static void bspI2CEngineTask(void *pvParameters)
+{
+  for (;;)
+  {
+    bspI2CEngineStep(portMAX_DELAY);
+  }
 }
 
-/* Private definitions ------------------------------------------------ */
 /* End of file -------------------------------------------------------- */
@@ -22,7 +22,14 @@
     #include "WProgram.h"
   #endif
 
+  #include <Wire.h>
+
 /* Public defines ----------------------------------------------------- */
+  #define BSP_I2C_ENGINE_QUEUE_LENGTH 16   /**< Default depth of the transaction queue */
+  #define BSP_I2C_ENGINE_BATCH_SIZE   8    /**< Max transactions drained from the queue per pass */
+  #define BSP_I2C_ENGINE_STACK_SIZE   4096 /**< Stack size of the I2C owner task */
+  #define BSP_I2C_ENGINE_PRIORITY     3    /**< Priority of the I2C owner task */
+  #define BSP_I2C_MAX_DEVICES         128  /**< One statistics entry per 7-bit address */
 
 /* Public enumerate/structure ----------------------------------------- */
 
@@ -36,6 +43,48 @@ typedef enum
   BSP_I2C_TIMEOUT
 } bsp_i2c_error_t;
 
+// Kind of bus transaction carried by a descriptor
+typedef enum
+{
+  BSP_I2C_TXN_READ = 0, /**< Optional register write, then read `len` bytes */
+  BSP_I2C_TXN_WRITE     /**< Optional register byte followed by `len` bytes */
+} bsp_i2c_txn_type_t;
+
+struct bsp_i2c_transaction;
+
+/**
+ * @brief Completion callback of an asynchronous transaction. Runs in the I2C owner task, keep it short and
+ * never submit a synchronous transaction from it.
+ */
+typedef void (*bsp_i2c_callback_t)(struct bsp_i2c_transaction *txn);
+
+// Transaction descriptor posted to the I2C owner task
+typedef struct bsp_i2c_transaction
+{
+  bsp_i2c_txn_type_t type;        /**< Read or write */
+  uint8_t            address;     /**< 7-bit device address */
+  bool               hasRegister; /**< Send `reg` before the data phase */
+  uint8_t            reg;         /**< Register address */
+  uint8_t           *buffer;      /**< Destination (read) or source (write) buffer */
+  uint16_t           len;         /**< Number of data bytes */
+  bsp_i2c_callback_t callback;    /**< Called on completion (optional) */
+  void              *arg;         /**< User argument for the callback */
+  TaskHandle_t       notifyTask;  /**< Task notified on completion (optional) */
+  bsp_i2c_error_t    result;      /**< Filled in by the engine */
+  uint32_t           submitTime;  /**< micros() at submission, filled in by the engine */
+} bsp_i2c_transaction_t;
+
+// Per-device bus statistics
+typedef struct
+{
+  uint32_t transactions;   /**< Completed transactions, including coalesced ones */
+  uint32_t errors;         /**< Transactions that did not return `BSP_I2C_OK` */
+  uint32_t coalesced;      /**< Reads served from an identical read in the same batch */
+  uint32_t lastLatencyUs;  /**< Submit-to-completion latency of the last transaction */
+  uint32_t maxLatencyUs;   /**< Worst submit-to-completion latency */
+  uint64_t totalLatencyUs; /**< Sum of all latencies, divide by `transactions` for the mean */
+} bsp_i2c_device_stats_t;
+
 /* Public macros ------------------------------------------------------ */
 
 /* Public variables --------------------------------------------------- */
@@ -220,6 +269,120 @@ bsp_i2c_error_t bspI2CWriteBytes(int address, uint8_t reg, uint8_t *bytes, uint3
  */
 bool bspI2CExist(uint8_t address);
 
+/**
+ * @brief  Selects the TwoWire bus used by every bspI2C function.
+ *
+ * @param[in]     wire    Bus to use (defaults to `Wire`).
+ *
+ * @attention  Call before any transaction is issued. Mainly used to plug a simulated bus on the host.
+ */
+void bspI2CSetWire(TwoWire *wire);
+
+/**
+ * @brief  Takes exclusive ownership of the bus.
+ *
+ * The helpers above and the transaction engine take this recursive mutex around every transaction. Drivers
+ * that talk to `Wire` directly (or chain `bspI2CBeginTransmission`/`bspI2CWrite`/`bspI2CEndTransmission`)
+ * must hold it for the whole sequence.
+ *
+ * @param[in]     timeout Ticks to wait for the bus.
+ *
+ * @return
+ *  - `BSP_I2C_OK`      : Bus acquired
+ *  - `BSP_I2C_TIMEOUT` : Bus still busy after `timeout`
+ */
+bsp_i2c_error_t bspI2CLock(TickType_t timeout = portMAX_DELAY);
+
+/**
+ * @brief  Releases the bus taken with `bspI2CLock()`.
+ */
+void bspI2CUnlock(void);
+
+/**
+ * @brief  Starts the I2C owner task and its transaction queue.
+ *
+ * Once started, all the register helpers above are routed through the owner task, so transactions from
+ * different tasks are serialized, measured and identical reads are coalesced.
+ *
+ * @param[in]     queueLength Depth of the transaction queue.
+ * @param[in]     priority    Priority of the owner task.
+ * @param[in]     startTask   `false` to only create the queue, the caller then serves it with
+ *                            `bspI2CEngineStep()`, e.g. a host test. Synchronous helpers keep running inline.
+ *
+ * @return
+ *  - `BSP_I2C_OK`  : Engine running
+ *  - `BSP_I2C_ERR` : Queue or task could not be created
+ */
+bsp_i2c_error_t bspI2CEngineBegin(uint32_t queueLength = BSP_I2C_ENGINE_QUEUE_LENGTH,
+                                  UBaseType_t priority = BSP_I2C_ENGINE_PRIORITY, bool startTask = true);
+
+/**
+ * @brief  Serves one batch of queued transactions, the body of the owner task.
+ *
+ * Waits for a first transaction, drains up to `BSP_I2C_ENGINE_BATCH_SIZE` waiting behind it, then executes
+ * them in order. A read is also served to the identical reads queued behind it until a write to the same
+ * device, which are then completed without touching the bus.
+ *
+ * @param[in]     timeout Ticks to wait for the first transaction.
+ *
+ * @attention  Only call it directly for an engine begun with `startTask = false`.
+ *
+ * @return
+ *  - Number of transactions completed, coalesced ones included, `0` if the queue stayed empty.
+ */
+uint8_t bspI2CEngineStep(TickType_t timeout = portMAX_DELAY);
+
+/**
+ * @brief  Posts a transaction to the owner task without waiting for it.
+ *
+ * Completion is reported through `txn->callback` and/or a notification to `txn->notifyTask`, after
+ * `txn->result` has been written.
+ *
+ * @param[in,out] txn     Descriptor. It and its buffer must stay valid until completion.
+ * @param[in]     timeout Ticks to wait for room in the queue.
+ *
+ * @attention  Without an engine the transaction is executed immediately in the caller's context.
+ *
+ * @return
+ *  - `BSP_I2C_OK`      : Transaction queued (or executed)
+ *  - `BSP_I2C_ERR`     : Invalid descriptor
+ *  - `BSP_I2C_TIMEOUT` : Queue full
+ */
+bsp_i2c_error_t bspI2CSubmit(bsp_i2c_transaction_t *txn, TickType_t timeout = portMAX_DELAY);
+
+/**
+ * @brief  Posts a transaction and blocks the calling task until it completes.
+ *
+ * @param[in,out] txn     Descriptor, `callback`, `arg` and `notifyTask` are overwritten.
+ * @param[in]     timeout Ticks to wait for room in the queue.
+ *
+ * @attention  Once queued, the call waits for the completion without timeout: the descriptor usually lives on
+ * the caller's stack and the owner task writes the result into it. Every transaction completes, a stuck bus
+ * ends in the `Wire` timeout. Completion is signalled with a semaphore of the call, the task notification
+ * value is left alone.
+ *
+ * @return
+ *  - The transaction result, or `BSP_I2C_TIMEOUT` if the queue stayed full.
+ */
+bsp_i2c_error_t bspI2CTransfer(bsp_i2c_transaction_t *txn, TickType_t timeout = portMAX_DELAY);
+
+/**
+ * @brief  Retrieves the bus statistics of a device.
+ *
+ * @param[in]     address Device's 7-bit I2C address.
+ * @param[out]    stats   Copy of the statistics.
+ *
+ * @return
+ *  - `BSP_I2C_OK`  : Success
+ *  - `BSP_I2C_ERR` : Address out of range
+ */
+bsp_i2c_error_t bspI2CGetDeviceStats(uint8_t address, bsp_i2c_device_stats_t &stats);
+
+/**
+ * @brief  Clears the bus statistics of every device.
+ */
+void bspI2CResetStats(void);
+
 #endif /* BSP_I2C_H */
 
 /* End of file -------------------------------------------------------- */
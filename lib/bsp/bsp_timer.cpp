@@ -0,0 +1,177 @@
+/**
+ * @file       bsp_timer.cpp
+ * @license    This project is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-14
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for bsp_timer
+ *
+ * @note       Uses esp_timer with task dispatch, callbacks may call the Arduino and FreeRTOS APIs.
+ * @example    None
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "bsp_timer.h"
+
+#ifdef HAL_NATIVE
+  #include "hal_native.h"
+#else
+  #include "esp_timer.h"
+#endif
+
+/* Private enumerate/structure ---------------------------------------- */
+typedef struct
+{
+  bsp_timer_callback_t callback;
+  void                *arg;
+  bool                 running;
+#ifdef HAL_NATIVE
+  uint32_t periodUs;
+  uint32_t event; // Pending tick on the simulated clock
+#else
+  esp_timer_handle_t handle;
+#endif
+} bsp_timer_slot_t;
+
+/* Private variables -------------------------------------------------- */
+static bsp_timer_slot_t bspTimers[BSP_TIMER_MAX];
+static uint8_t          bspTimerCount = 0;
+static portMUX_TYPE     bspTimerLock  = portMUX_INITIALIZER_UNLOCKED; // `running`, driver start and stop
+
+/* Private function prototypes ---------------------------------------- */
+static void bspTimerStopLocked(bsp_timer_slot_t &timer);
+#ifdef HAL_NATIVE
+static void bspTimerTick(uint8_t id);
+#else
+static void bspTimerDispatch(void *arg);
+#endif
+
+/* Function definitions ----------------------------------------------- */
+bsp_timer_error_t bspTimerCreate(bsp_timer_callback_t callback, void *arg, const char *name, uint8_t *id)
+{
+  if (callback == NULL || id == NULL)
+  {
+    return BSP_TIMER_ERR;
+  }
+  if (bspTimerCount >= BSP_TIMER_MAX)
+  {
+    return BSP_TIMER_ERR_FULL;
+  }
+
+  bsp_timer_slot_t &timer = bspTimers[bspTimerCount];
+  timer.callback          = callback;
+  timer.arg               = arg;
+  timer.running           = false;
+
+#ifdef HAL_NATIVE
+  timer.periodUs = 0;
+  timer.event    = 0;
+#else
+  esp_timer_create_args_t args = {};
+  args.callback                = bspTimerDispatch;
+  args.arg                     = &timer;
+  args.dispatch_method         = ESP_TIMER_TASK;
+  args.name                    = name;
+  if (esp_timer_create(&args, &timer.handle) != ESP_OK)
+  {
+    return BSP_TIMER_ERR;
+  }
+#endif
+
+  *id = bspTimerCount++;
+  return BSP_TIMER_OK;
+}
+
+bsp_timer_error_t bspTimerStartPeriodic(uint8_t id, uint32_t periodUs)
+{
+  if (id >= bspTimerCount)
+  {
+    return BSP_TIMER_ERR_ID;
+  }
+  if (periodUs < BSP_TIMER_MIN_PERIOD_US)
+  {
+    return BSP_TIMER_ERR_PERIOD;
+  }
+
+  // Stop and restart as one step, a start or stop from another task cannot interleave with the driver calls
+  bsp_timer_slot_t &timer  = bspTimers[id];
+  bsp_timer_error_t result = BSP_TIMER_OK;
+  portENTER_CRITICAL(&bspTimerLock);
+  bspTimerStopLocked(timer);
+
+#ifdef HAL_NATIVE
+  timer.periodUs = periodUs;
+  timer.event    = halSimScheduleIn(periodUs, [id]() { bspTimerTick(id); });
+  timer.running  = true;
+#else
+  timer.running = (esp_timer_start_periodic(timer.handle, periodUs) == ESP_OK);
+  if (!timer.running)
+  {
+    result = BSP_TIMER_ERR;
+  }
+#endif
+
+  portEXIT_CRITICAL(&bspTimerLock);
+  return result;
+}
+
+void bspTimerStop(uint8_t id)
+{
+  if (id >= bspTimerCount)
+  {
+    return;
+  }
+
+  portENTER_CRITICAL(&bspTimerLock);
+  bspTimerStopLocked(bspTimers[id]);
+  portEXIT_CRITICAL(&bspTimerLock);
+}
+
+bool bspTimerIsRunning(uint8_t id)
+{
+  if (id >= bspTimerCount)
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&bspTimerLock);
+  bool running = bspTimers[id].running;
+  portEXIT_CRITICAL(&bspTimerLock);
+  return running;
+}
+
+/* Private definitions ------------------------------------------------ */
+static void bspTimerStopLocked(bsp_timer_slot_t &timer)
+{
+  // Caller holds bspTimerLock
+  if (!timer.running)
+  {
+    return;
+  }
+
+#ifdef HAL_NATIVE
+  halSimCancel(timer.event);
+#else
+  esp_timer_stop(timer.handle);
+#endif
+  timer.running = false;
+}
+
+#ifdef HAL_NATIVE
+static void bspTimerTick(uint8_t id)
+{
+  // Next tick first, so a callback stopping its timer cancels it
+  bsp_timer_slot_t &timer = bspTimers[id];
+  timer.event             = halSimScheduleIn(timer.periodUs, [id]() { bspTimerTick(id); });
+  timer.callback(timer.arg);
+}
+#else
+static void bspTimerDispatch(void *arg)
+{
+  bsp_timer_slot_t *timer = (bsp_timer_slot_t *) arg;
+  timer->callback(timer->arg);
+}
+#endif
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,102 @@
+/**
+ * @file       bsp_timer.h
+ * @license    This project is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-14
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for bsp_timer
+ *
+ * @note       Periodic software timers for short control ticks (ramps, effects), backed by esp_timer.
+ * @example    None
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef BSP_TIMER_H
+  #define BSP_TIMER_H
+
+  /* Includes --------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+/* Public defines ----------------------------------------------------- */
+  #define BSP_TIMER_MAX           8    /**< Timers that can be created, they are never deleted */
+  #define BSP_TIMER_MIN_PERIOD_US 1000 /**< Shorter ticks would starve the esp_timer task */
+
+/* Public enumerate/structure ----------------------------------------- */
+
+// Error codes for the timers
+typedef enum
+{
+  BSP_TIMER_OK = 0,
+  BSP_TIMER_ERR,        /**< Driver error or null callback */
+  BSP_TIMER_ERR_FULL,   /**< `BSP_TIMER_MAX` timers already created */
+  BSP_TIMER_ERR_ID,     /**< Unknown timer */
+  BSP_TIMER_ERR_PERIOD  /**< Period below `BSP_TIMER_MIN_PERIOD_US` */
+} bsp_timer_error_t;
+
+/**
+ * @brief Tick callback. Runs in the esp_timer task (the simulated clock on the host), keep it short and do
+ * not block.
+ */
+typedef void (*bsp_timer_callback_t)(void *arg);
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Public function prototypes ----------------------------------------- */
+
+/**
+ * @brief  Creates a stopped periodic timer.
+ *
+ * @param[in]     callback  Called on every tick.
+ * @param[in]     arg       Passed to the callback.
+ * @param[in]     name      Shown by the esp_timer dump, must outlive the timer.
+ * @param[out]    id        Identifier of the timer.
+ *
+ * @return
+ *  - `BSP_TIMER_OK`      : Timer created
+ *  - `BSP_TIMER_ERR_FULL`: `BSP_TIMER_MAX` timers already created
+ *  - `BSP_TIMER_ERR`     : Null callback or driver error
+ */
+bsp_timer_error_t bspTimerCreate(bsp_timer_callback_t callback, void *arg, const char *name, uint8_t *id);
+
+/**
+ * @brief  Starts, or restarts with a new period, a timer created with `bspTimerCreate()`. Safe from any task,
+ * the stop and the restart are one step.
+ *
+ * @param[in]     id        Identifier of the timer.
+ * @param[in]     periodUs  Tick period, at least `BSP_TIMER_MIN_PERIOD_US`. The first tick comes one period
+ * after the call.
+ *
+ * @return
+ *  - `BSP_TIMER_OK`        : Timer running
+ *  - `BSP_TIMER_ERR_ID`    : Unknown timer
+ *  - `BSP_TIMER_ERR_PERIOD`: Period too short
+ *  - `BSP_TIMER_ERR`       : Driver error
+ */
+bsp_timer_error_t bspTimerStartPeriodic(uint8_t id, uint32_t periodUs);
+
+/**
+ * @brief  Stops a timer. Safe from any task and from its own callback, no tick follows.
+ *
+ * @param[in]     id        Identifier of the timer.
+ */
+void bspTimerStop(uint8_t id);
+
+/**
+ * @brief  Tells if a timer is ticking.
+ *
+ * @param[in]     id        Identifier of the timer.
+ *
+ * @return bool `true` between `bspTimerStartPeriodic()` and `bspTimerStop()`.
+ */
+bool bspTimerIsRunning(uint8_t id);
+
+#endif // BSP_TIMER_H
+
+/* End of file -------------------------------------------------------- */
@@ -4,9 +4,11 @@
 ButtonHandler::ButtonHandler(int pin, bool isActiveLow, bool usePullup)
     : buttonPin(pin), activeLow(isActiveLow), debounceDuration(50), doubleClickInterval(400),
       holdDuration(800), singleClickCallback(nullptr), doubleClickCallback(nullptr),
-      holdStartCallback(nullptr), holdReleaseCallback(nullptr), lastButtonState(false), lastDebounceTime(0),
-      lastClickTime(0), isHolding(false), holdStartTime(0), clickCount(0)
+      holdStartCallback(nullptr), holdReleaseCallback(nullptr), lastButtonState(false), rawButtonState(false),
+      lastDebounceTime(0), isHolding(false), clickCount(0), edgeHead(0), edgeTail(0), droppedEdges(0),
+      seenDroppedEdges(0), interruptMode(false), notifyTask(nullptr)
 {
+  resetFSM();
   if (pin >= 0)
   {
     bspGpioPinMode(pin, usePullup ? INPUT_PULLUP : INPUT);
@@ -83,11 +85,169 @@ button_handler_error_t ButtonHandler::attachHoldReleaseCallback(ButtonCallback c
   return BUTTON_OK;
 }
 
+button_handler_error_t ButtonHandler::beginInterrupt(TaskHandle_t notifyTask)
+{
+  if (buttonPin < 0)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+
+  this->notifyTask = notifyTask;
+  edgeTail.store(edgeHead.load(std::memory_order_acquire), std::memory_order_relaxed);
+  interruptMode = true;
+  bspGpioAttachInterruptArg(buttonPin, onEdge, this, CHANGE);
+
+  // An edge before the interrupt was attached would be missed, start from the current level
+  button_edge_t edge = { (uint32_t) micros(), bspGpioDigitalRead(buttonPin) == (activeLow ? LOW : HIGH) };
+  processEdge(edge);
+  return BUTTON_OK;
+}
+
+void ButtonHandler::endInterrupt()
+{
+  if (interruptMode)
+  {
+    bspGpioDetachInterrupt(buttonPin);
+    interruptMode = false;
+  }
+}
+
+void IRAM_ATTR ButtonHandler::onEdge(void *arg)
+{
+  ButtonHandler *self = (ButtonHandler *) arg;
+
+  // digitalRead() and micros() are IRAM safe, the bsp wrappers are not
+  bool          pressed = digitalRead(self->buttonPin) == (self->activeLow ? LOW : HIGH);
+  button_edge_t edge    = { (uint32_t) micros(), pressed };
+
+  // Single producer: only this handler moves the head
+  uint32_t head = self->edgeHead.load(std::memory_order_relaxed);
+  if (head - self->edgeTail.load(std::memory_order_acquire) < BUTTON_EDGE_QUEUE_LENGTH)
+  {
+    self->edgeQueue[head & (BUTTON_EDGE_QUEUE_LENGTH - 1)] = edge;
+    self->edgeHead.store(head + 1, std::memory_order_release);
+  }
+  else
+  {
+    self->droppedEdges.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (self->notifyTask != nullptr)
+  {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(self->notifyTask, &woken);
+    if (woken == pdTRUE)
+    {
+      portYIELD_FROM_ISR();
+    }
+  }
+}
+
 void ButtonHandler::update()
 {
-  bool          isButtonPressed = bspGpioDigitalRead(buttonPin) == (activeLow ? LOW : HIGH);
-  unsigned long currentTime     = millis();
+  if (interruptMode)
+  {
+    // Single consumer: only update() moves the tail
+    uint32_t tail    = edgeTail.load(std::memory_order_relaxed);
+    uint32_t head    = edgeHead.load(std::memory_order_acquire);
+    uint32_t dropped = droppedEdges.load(std::memory_order_relaxed);
+    while (tail != head)
+    {
+      button_edge_t edge = edgeQueue[tail & (BUTTON_EDGE_QUEUE_LENGTH - 1)];
+      edgeTail.store(++tail, std::memory_order_release);
+      processEdge(edge);
+    }
+
+    if (dropped != seenDroppedEdges)
+    {
+      // Edges were lost, the queued levels may be stale: trust the pin
+      seenDroppedEdges   = dropped;
+      button_edge_t edge = { (uint32_t) micros(), bspGpioDigitalRead(buttonPin) == (activeLow ? LOW : HIGH) };
+      processEdge(edge);
+    }
+  }
+  else
+  {
+    bool isButtonPressed = bspGpioDigitalRead(buttonPin) == (activeLow ? LOW : HIGH);
+    if (isButtonPressed != rawButtonState)
+    {
+      button_edge_t edge = { (uint32_t) micros(), isButtonPressed };
+      processEdge(edge);
+    }
+  }
+
+  uint32_t currentTime = micros();
+  settle(currentTime);
+  step(lastButtonState, currentTime);
+}
+
+uint32_t ButtonHandler::nextTimeout()
+{
+  uint32_t deadline = 0;
+  bool     pending  = false;
+
+  if (rawButtonState != lastButtonState)
+  {
+    deadline = lastDebounceTime + debounceDuration * 1000UL;
+    pending  = true;
+  }
+
+  uint32_t stateDeadline = 0;
+  bool     statePending  = true;
+  switch (currentState)
+  {
+    case STATE_BUTTON_DOWN:
+      stateDeadline = stateStartTime + holdDuration * 1000UL;
+      break;
+    case STATE_WAIT_FOR_SECOND_CLICK:
+      stateDeadline = stateStartTime + doubleClickInterval * 1000UL;
+      break;
+    default:
+      statePending = false;
+      break;
+  }
+
+  uint32_t currentTime = micros();
+  if (statePending && (!pending || (int32_t) (stateDeadline - deadline) < 0))
+  {
+    deadline = stateDeadline;
+    pending  = true;
+  }
+  if (!pending)
+  {
+    return BUTTON_NO_TIMEOUT;
+  }
+
+  int32_t remaining = (int32_t) (deadline - currentTime);
+  return (remaining <= 0) ? 0 : ((uint32_t) remaining + 999U) / 1000U;
+}
+
+/* Private definitions ------------------------------------------------ */
+void ButtonHandler::processEdge(const button_edge_t &edge)
+{
+  // The level re-read after beginInterrupt() or a loss may be stamped before a queued edge
+  uint32_t edgeTime = ((int32_t) (edge.timeUs - lastDebounceTime) < 0) ? lastDebounceTime : edge.timeUs;
+
+  // A level that lasted the debounce duration before this edge is a real change
+  settle(edgeTime);
+  rawButtonState   = edge.pressed;
+  lastDebounceTime = edgeTime;
+}
 
+void ButtonHandler::settle(uint32_t currentTime)
+{
+  if (rawButtonState != lastButtonState && hasElapsed(lastDebounceTime, currentTime, debounceDuration))
+  {
+    // Stable long enough: deadlines of the old level expire first, then the change is applied at the time
+    // of its edge, however late update() runs
+    step(lastButtonState, lastDebounceTime);
+    lastButtonState = rawButtonState;
+    step(lastButtonState, lastDebounceTime);
+  }
+}
+
+void ButtonHandler::step(bool isButtonPressed, uint32_t currentTime)
+{
   // FSM for state handling
   switch (currentState)
   {
@@ -108,7 +268,7 @@ void ButtonHandler::update()
         currentState   = STATE_WAIT_FOR_SECOND_CLICK;
         stateStartTime = currentTime;
       }
-      else if (hasElapsed(stateStartTime, holdDuration))
+      else if (hasElapsed(stateStartTime, currentTime, holdDuration))
       {
         // Button held long enough, move to HOLDING
         currentState = STATE_HOLDING;
@@ -126,7 +286,7 @@ void ButtonHandler::update()
         currentState   = STATE_BUTTON_DOWN;
         stateStartTime = currentTime;
       }
-      else if (hasElapsed(stateStartTime, doubleClickInterval))
+      else if (hasElapsed(stateStartTime, currentTime, doubleClickInterval))
       {
         // Timeout, determine single/double click
         if (clickCount == 1 && singleClickCallback)
@@ -144,25 +304,17 @@ void ButtonHandler::update()
     case STATE_HOLDING:
       if (!isButtonPressed)
       {
-        // Button released after holding, move to HOLD_RELEASE
-        currentState   = STATE_HOLD_RELEASE;
-        stateStartTime = currentTime;
-      }
-      break;
-
-    case STATE_HOLD_RELEASE:
-      if (holdReleaseCallback)
-      {
-        holdReleaseCallback();
+        // Button released after holding
+        if (holdReleaseCallback)
+        {
+          holdReleaseCallback();
+        }
+        resetFSM();
       }
-      resetFSM();
       break;
 
     default:
       resetFSM(); // Safety fallback for undefined states
       break;
   }
-
-  // Track the last known state of the button
-  lastButtonState = isButtonPressed;
 }
@@ -3,17 +3,30 @@
 
 #include "Arduino.h"
 
+#include <atomic>
+
+#define BUTTON_EDGE_QUEUE_LENGTH 16         // Edges buffered between two update() calls, power of two
+#define BUTTON_NO_TIMEOUT        UINT32_MAX // nextTimeout(): only an edge can change the state
+
 // Define error codes for button operations
 typedef enum
 {
   BUTTON_OK                = 0,
   BUTTON_ERR_INVALID_PARAM = 1,
   BUTTON_ERR_UNINITIALIZED = 2,
+  BUTTON_ERR_FULL          = 3,
 } button_handler_error_t;
 
 // Callback function type
 typedef void (*ButtonCallback)(void);
 
+// Level change of the button pin, stamped by the interrupt handler
+typedef struct
+{
+  uint32_t timeUs;  // micros() when the edge was seen
+  bool     pressed; // Button level after the edge
+} button_edge_t;
+
 /**
  * @brief Manages button presses, handling debouncing, click detection, and hold events.
  *
@@ -36,6 +49,22 @@ typedef void (*ButtonCallback)(void);
  * After instantiating the class, users should call the `update()` method periodically to process
  * button states. Callback functions can be attached for various button events to respond dynamically.
  *
+ * With `beginInterrupt()`, a GPIO interrupt stamps every level change and pushes it into a lock-free queue
+ * instead. `update()` then only consumes the queued edges, and debounce, double-click and hold timing are
+ * computed from the edge timestamps rather than from when `update()` happens to run. The caller sleeps
+ * until the interrupt notifies it or until `nextTimeout()` elapses:
+ *
+ * ```
+ * button.beginInterrupt(xTaskGetCurrentTaskHandle());
+ * for (;;)
+ * {
+ *   button.update();
+ *   uint32_t timeoutMs = button.nextTimeout();
+ *   ulTaskNotifyTake(pdTRUE, (timeoutMs == BUTTON_NO_TIMEOUT) ? portMAX_DELAY
+ *                                                             : pdMS_TO_TICKS(timeoutMs) + 1);
+ * }
+ * ```
+ *
  * ### Dependencies:
  *
  * - Requires connection to a digital input pin.
@@ -146,10 +175,45 @@ public:
   button_handler_error_t attachHoldReleaseCallback(ButtonCallback callback);
 
   /**
-   * @brief  Periodically process the button state.
+   * @brief  Switch from polling the pin to interrupt-driven edges.
+   *
+   * @param[in]     notifyTask    Task notified (`vTaskNotifyGiveFromISR`) on every edge, may be null.
+   *
+   * @return
+   *  - BUTTON_OK: Interrupt attached, `update()` consumes the edge queue from now on.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Invalid pin number.
+   */
+  button_handler_error_t beginInterrupt(TaskHandle_t notifyTask = nullptr);
+
+  /**
+   * @brief  Detach the interrupt and go back to polling the pin in `update()`.
+   */
+  void endInterrupt();
+
+  /**
+   * @brief  Process the button state: the queued edges in interrupt mode, the pin level otherwise, then the
+   * pending timeouts (debounce, double-click window, hold).
    */
   void update();
 
+  /**
+   * @brief  Time until `update()` must run again even if no edge arrives.
+   *
+   * In polling mode `update()` still has to be called periodically to see the pin change.
+   *
+   * @return
+   *  - Milliseconds until the next debounce, double-click or hold deadline, rounded up (`0` if one is due).
+   *
+   *  - BUTTON_NO_TIMEOUT: Nothing pending, the button is idle or held.
+   */
+  uint32_t nextTimeout();
+
+  /**
+   * @brief  Number of edges lost because the queue was full. The level is re-read after a loss.
+   */
+  uint32_t getDroppedEdges() { return droppedEdges.load(std::memory_order_relaxed); }
+
 private:
   int          buttonPin;           // Pin connected to the button.
   bool         activeLow;           // True if button is active low.
@@ -162,30 +226,43 @@ private:
   ButtonCallback holdStartCallback;   // Hold-start callback function.
   ButtonCallback holdReleaseCallback; // Hold-release callback function.
 
-  bool          lastButtonState;  // Last known button state.
-  unsigned long lastDebounceTime; // Last time button state changed.
-  unsigned long lastClickTime;    // Time of the last button release.
-  bool          isHolding;        // True if button is currently held.
-  unsigned long holdStartTime;    // Start time of the hold action.
-  int           clickCount;       // Count of consecutive clicks.
+  bool     lastButtonState;  // Debounced button state.
+  bool     rawButtonState;   // Level after the last edge, not debounced yet.
+  uint32_t lastDebounceTime; // Time of the last edge in microseconds.
+  bool     isHolding;        // True if button is currently held.
+  int      clickCount;       // Count of consecutive clicks.
+
+  // Edge queue, written by the interrupt handler (head) and read by update() (tail)
+  button_edge_t         edgeQueue[BUTTON_EDGE_QUEUE_LENGTH];
+  std::atomic<uint32_t> edgeHead;
+  std::atomic<uint32_t> edgeTail;
+  std::atomic<uint32_t> droppedEdges;
+  uint32_t              seenDroppedEdges; // droppedEdges when the level was last re-read
+  bool                  interruptMode; // True once beginInterrupt() succeeded
+  TaskHandle_t          notifyTask;    // Woken by the interrupt handler
 
   typedef enum
   {
     STATE_IDLE,
     STATE_BUTTON_DOWN,
     STATE_WAIT_FOR_SECOND_CLICK,
-    STATE_HOLDING,
-    STATE_HOLD_RELEASE
+    STATE_HOLDING
   } ButtonState;
 
   ButtonState currentState; // Current state of the FSM
 
   // Additional helper variables
-  unsigned long stateStartTime; // Time when the state started
+  uint32_t stateStartTime; // Time when the state started in microseconds
+
+  static void onEdge(void *arg);
+
+  void processEdge(const button_edge_t &edge);
+  void settle(uint32_t currentTime);
+  void step(bool isButtonPressed, uint32_t currentTime);
 
-  inline bool hasElapsed(unsigned long start, unsigned long duration)
+  inline bool hasElapsed(uint32_t start, uint32_t now, unsigned long duration)
   {
-    return (millis() - start) >= duration;
+    return (now - start) >= duration * 1000UL;
   }
 
   // Reset FSM state
@@ -0,0 +1,274 @@
+#include "button_group.h"
+#include "bsp_gpio.h"
+
+#include <string.h>
+
+ButtonGroup::ButtonGroup()
+    : debounceDuration(50), doubleClickInterval(400), holdDuration(800), callback(nullptr), buttonCount(0),
+      activeLowMask(0), rawMask(0), stableMask(0), busyMask(0), chordCount(0), chordDownMask(0),
+      chordHeldMask(0)
+{
+  memset(pins, 0, sizeof(pins));
+  memset(states, STATE_IDLE, sizeof(states));
+  memset(clickCounts, 0, sizeof(clickCounts));
+  memset(rawTimes, 0, sizeof(rawTimes));
+  memset(stateTimes, 0, sizeof(stateTimes));
+  memset(chordMasks, 0, sizeof(chordMasks));
+  memset(chordTimes, 0, sizeof(chordTimes));
+}
+
+button_handler_error_t ButtonGroup::addButton(int pin, bool isActiveLow, bool usePullup, uint8_t *id)
+{
+  if (pin < 0 || pin >= 64)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+  if (buttonCount >= BUTTON_GROUP_MAX)
+  {
+    return BUTTON_ERR_FULL;
+  }
+
+  bspGpioPinMode(pin, usePullup ? INPUT_PULLUP : INPUT);
+  pins[buttonCount] = (uint8_t) pin;
+  if (isActiveLow)
+  {
+    activeLowMask |= (uint8_t) (1U << buttonCount);
+  }
+  if (id != nullptr)
+  {
+    *id = buttonCount;
+  }
+  buttonCount++;
+  return BUTTON_OK;
+}
+
+button_handler_error_t ButtonGroup::addChord(uint8_t mask, uint8_t *id)
+{
+  uint8_t known = (uint8_t) ((1U << buttonCount) - 1U);
+  if ((mask & (mask - 1)) == 0 || (mask & ~known) != 0)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+  if (chordCount >= BUTTON_GROUP_MAX_CHORDS)
+  {
+    return BUTTON_ERR_FULL;
+  }
+
+  chordMasks[chordCount] = mask;
+  if (id != nullptr)
+  {
+    *id = chordCount;
+  }
+  chordCount++;
+  return BUTTON_OK;
+}
+
+button_handler_error_t ButtonGroup::setDebounceDuration(unsigned int ms)
+{
+  if (ms < 1)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+  debounceDuration = ms;
+  return BUTTON_OK;
+}
+
+button_handler_error_t ButtonGroup::setDoubleClickInterval(unsigned int ms)
+{
+  if (ms < 1)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+  doubleClickInterval = ms;
+  return BUTTON_OK;
+}
+
+button_handler_error_t ButtonGroup::setHoldDuration(unsigned int ms)
+{
+  if (ms < 1)
+  {
+    return BUTTON_ERR_INVALID_PARAM;
+  }
+  holdDuration = ms;
+  return BUTTON_OK;
+}
+
+button_handler_error_t ButtonGroup::attachCallback(ButtonGroupCallback callback)
+{
+  if (callback == nullptr)
+  {
+    return BUTTON_ERR_UNINITIALIZED;
+  }
+  this->callback = callback;
+  return BUTTON_OK;
+}
+
+void ButtonGroup::update()
+{
+  if (buttonCount == 0)
+  {
+    return;
+  }
+
+  // One read for every pin, then bit n of sample is button n pressed
+  uint64_t levels      = bspGpioReadInputs();
+  uint32_t currentTime = millis();
+  uint8_t  sample      = 0;
+  for (uint8_t id = 0; id < buttonCount; id++)
+  {
+    sample |= (uint8_t) (((levels >> pins[id]) & 1U) << id);
+  }
+  sample ^= activeLowMask;
+
+  // Debounce all buttons at once: a raw level stable for the debounce duration becomes the pressed state
+  for (uint8_t bits = sample ^ rawMask; bits != 0; bits &= (uint8_t) (bits - 1))
+  {
+    rawTimes[__builtin_ctz(bits)] = currentTime;
+  }
+  rawMask = sample;
+  for (uint8_t bits = rawMask ^ stableMask; bits != 0; bits &= (uint8_t) (bits - 1))
+  {
+    uint8_t id = (uint8_t) __builtin_ctz(bits);
+    if (hasElapsed(rawTimes[id], currentTime, debounceDuration))
+    {
+      stableMask ^= (uint8_t) (1U << id);
+    }
+  }
+
+  // Nothing pressed and no FSM waiting for a timeout
+  if ((stableMask | busyMask | chordDownMask) == 0)
+  {
+    return;
+  }
+
+  updateChords(currentTime);
+  for (uint8_t bits = stableMask | busyMask; bits != 0; bits &= (uint8_t) (bits - 1))
+  {
+    uint8_t id = (uint8_t) __builtin_ctz(bits);
+    step(id, (stableMask >> id) & 1U, currentTime);
+  }
+}
+
+/* Private definitions ------------------------------------------------ */
+void ButtonGroup::updateChords(uint32_t currentTime)
+{
+  for (uint8_t chord = 0; chord < chordCount; chord++)
+  {
+    uint8_t bit  = (uint8_t) (1U << chord);
+    uint8_t mask = chordMasks[chord];
+
+    if ((chordDownMask & bit) == 0)
+    {
+      if (stableMask == mask)
+      {
+        // Exactly the chord is pressed: its buttons stop counting clicks until released
+        chordDownMask |= bit;
+        chordHeldMask &= (uint8_t) ~bit;
+        chordTimes[chord] = currentTime;
+        for (uint8_t bits = mask; bits != 0; bits &= (uint8_t) (bits - 1))
+        {
+          uint8_t id      = (uint8_t) __builtin_ctz(bits);
+          states[id]      = STATE_CHORD;
+          clickCounts[id] = 0;
+        }
+        busyMask |= mask;
+        notify(chord, BUTTON_EVENT_CHORD);
+      }
+    }
+    else if ((stableMask & mask) != mask)
+    {
+      chordDownMask &= (uint8_t) ~bit;
+    }
+    else if ((chordHeldMask & bit) == 0 && hasElapsed(chordTimes[chord], currentTime, holdDuration))
+    {
+      chordHeldMask |= bit;
+      notify(chord, BUTTON_EVENT_CHORD_HOLD);
+    }
+  }
+}
+
+void ButtonGroup::step(uint8_t id, bool isButtonPressed, uint32_t currentTime)
+{
+  // Same FSM as ButtonHandler, one slot of the arrays per button
+  switch (states[id])
+  {
+    case STATE_IDLE:
+      if (isButtonPressed)
+      {
+        states[id]      = STATE_BUTTON_DOWN;
+        stateTimes[id]  = currentTime;
+        clickCounts[id] = 1;
+      }
+      break;
+
+    case STATE_BUTTON_DOWN:
+      if (!isButtonPressed)
+      {
+        states[id]     = STATE_WAIT_FOR_SECOND_CLICK;
+        stateTimes[id] = currentTime;
+      }
+      else if (hasElapsed(stateTimes[id], currentTime, holdDuration))
+      {
+        states[id] = STATE_HOLDING;
+        notify(id, BUTTON_EVENT_HOLD_START);
+      }
+      break;
+
+    case STATE_WAIT_FOR_SECOND_CLICK:
+      if (isButtonPressed)
+      {
+        clickCounts[id]++;
+        states[id]     = STATE_BUTTON_DOWN;
+        stateTimes[id] = currentTime;
+      }
+      else if (hasElapsed(stateTimes[id], currentTime, doubleClickInterval))
+      {
+        if (clickCounts[id] == 1)
+        {
+          notify(id, BUTTON_EVENT_SINGLE_CLICK);
+        }
+        else if (clickCounts[id] == 2)
+        {
+          notify(id, BUTTON_EVENT_DOUBLE_CLICK);
+        }
+        states[id] = STATE_IDLE;
+      }
+      break;
+
+    case STATE_HOLDING:
+      if (!isButtonPressed)
+      {
+        notify(id, BUTTON_EVENT_HOLD_RELEASE);
+        states[id] = STATE_IDLE;
+      }
+      break;
+
+    case STATE_CHORD:
+      if (!isButtonPressed)
+      {
+        states[id] = STATE_IDLE;
+      }
+      break;
+
+    default:
+      states[id] = STATE_IDLE; // Safety fallback for undefined states
+      break;
+  }
+
+  if (states[id] == STATE_IDLE)
+  {
+    busyMask &= (uint8_t) ~(1U << id);
+  }
+  else
+  {
+    busyMask |= (uint8_t) (1U << id);
+  }
+}
+
+void ButtonGroup::notify(uint8_t id, button_event_t event)
+{
+  if (callback)
+  {
+    callback(id, event);
+  }
+}
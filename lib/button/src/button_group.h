@@ -0,0 +1,206 @@
+#ifndef BUTTON_GROUP_H
+#define BUTTON_GROUP_H
+
+#include "Arduino.h"
+#include "button.h"
+
+#define BUTTON_GROUP_MAX        8 // Buttons per group, one bit each in the masks
+#define BUTTON_GROUP_MAX_CHORDS 4
+
+// Events reported by a ButtonGroup
+typedef enum
+{
+  BUTTON_EVENT_SINGLE_CLICK,
+  BUTTON_EVENT_DOUBLE_CLICK,
+  BUTTON_EVENT_HOLD_START,
+  BUTTON_EVENT_HOLD_RELEASE,
+  BUTTON_EVENT_CHORD,      // All buttons of a chord pressed together
+  BUTTON_EVENT_CHORD_HOLD, // ... and kept pressed for the hold duration
+} button_event_t;
+
+// Callback function type, id is the button for click and hold events, the chord for chord events
+typedef void (*ButtonGroupCallback)(uint8_t id, button_event_t event);
+
+/**
+ * @brief Scans several buttons in one pass and runs one click/hold FSM per button, plus chords.
+ *
+ * The `ButtonGroup` class replaces one `ButtonHandler` (and one task) per button when a board has several
+ * of them. All pins are sampled with a single read of the GPIO input registers, debounced together with
+ * bit masks, and the per-button FSM state is kept as a struct of arrays so an idle scan touches only a few
+ * words.
+ *
+ * ### Features:
+ *
+ * - Single-click, double-click, hold start and hold release per button, with the same timing rules as
+ * `ButtonHandler`.
+ *
+ * - Chords: a set of buttons pressed together reports `BUTTON_EVENT_CHORD`, then `BUTTON_EVENT_CHORD_HOLD`
+ * once held for the hold duration. The buttons of a chord report nothing on their own until released.
+ *
+ * - When every button is released and settled, `update()` returns right after the register read.
+ *
+ * ### Usage:
+ *
+ * ```
+ * uint8_t up, down, both;
+ * buttons.addButton(UP_PIN, true, true, &up);
+ * buttons.addButton(DOWN_PIN, true, true, &down);
+ * buttons.addChord((1 << up) | (1 << down), &both);
+ * buttons.attachCallback([](uint8_t id, button_event_t event) { ... });
+ * // In the button task, every DELAY_BUTTON ms
+ * buttons.update();
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - `bspGpioReadInputs()` for the one-shot read of the pins.
+ */
+class ButtonGroup
+{
+public:
+  /**
+   * @brief  Initialize an empty ButtonGroup.
+   */
+  ButtonGroup();
+
+  /**
+   * @brief  Add a button to the group.
+   *
+   * @param[in]     pin             Digital pin connected to the button.
+   * @param[in]     isActiveLow     True if the button's active state is LOW.
+   * @param[in]     usePullup       True to enable internal pull-up resistor.
+   * @param[out]    id              Index of the button in the group, may be null.
+   *
+   * @return
+   *  - BUTTON_OK: Button added.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Invalid pin number.
+   *
+   *  - BUTTON_ERR_FULL: `BUTTON_GROUP_MAX` buttons already added.
+   */
+  button_handler_error_t addButton(int pin, bool isActiveLow = true, bool usePullup = true,
+                                   uint8_t *id = nullptr);
+
+  /**
+   * @brief  Add a chord, reported when exactly these buttons are pressed together.
+   *
+   * @param[in]     mask    Bit n set for button n, at least two buttons.
+   * @param[out]    id      Index of the chord, may be null.
+   *
+   * @return
+   *  - BUTTON_OK: Chord added.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Less than two buttons, or a button that was not added.
+   *
+   *  - BUTTON_ERR_FULL: `BUTTON_GROUP_MAX_CHORDS` chords already added.
+   */
+  button_handler_error_t addChord(uint8_t mask, uint8_t *id = nullptr);
+
+  /**
+   * @brief  Set debounce duration in milliseconds, for all buttons.
+   *
+   * @param[in]     ms    Debounce duration.
+   *
+   * @return
+   *  - BUTTON_OK: Parameter set successfully.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Invalid duration value.
+   */
+  button_handler_error_t setDebounceDuration(unsigned int ms);
+
+  /**
+   * @brief  Set double-click maximum interval in milliseconds, for all buttons.
+   *
+   * @param[in]     ms    Maximum time between clicks.
+   *
+   * @return
+   *  - BUTTON_OK: Parameter set successfully.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Invalid duration value.
+   */
+  button_handler_error_t setDoubleClickInterval(unsigned int ms);
+
+  /**
+   * @brief  Set hold duration in milliseconds, for all buttons and chords.
+   *
+   * @param[in]     ms    Hold duration.
+   *
+   * @return
+   *  - BUTTON_OK: Parameter set successfully.
+   *
+   *  - BUTTON_ERR_INVALID_PARAM: Invalid duration value.
+   */
+  button_handler_error_t setHoldDuration(unsigned int ms);
+
+  /**
+   * @brief  Attach the callback receiving every event of the group.
+   *
+   * @param[in]     callback   Function to be called on each event.
+   *
+   * @return
+   *  - BUTTON_OK: Callback attached successfully.
+   *
+   *  - BUTTON_ERR_UNINITIALIZED: Null callback.
+   */
+  button_handler_error_t attachCallback(ButtonGroupCallback callback);
+
+  /**
+   * @brief  Scan all buttons and process their state. Call periodically.
+   */
+  void update();
+
+  /**
+   * @brief  Debounced state of the buttons, bit n set while button n is pressed.
+   */
+  uint8_t getPressedMask() { return stableMask; }
+
+  uint8_t getButtonCount() { return buttonCount; }
+
+private:
+  typedef enum
+  {
+    STATE_IDLE,
+    STATE_BUTTON_DOWN,
+    STATE_WAIT_FOR_SECOND_CLICK,
+    STATE_HOLDING,
+    STATE_CHORD // Part of a chord, ignored until released
+  } ButtonState;
+
+  unsigned int debounceDuration;    // Debounce duration in milliseconds.
+  unsigned int doubleClickInterval; // Maximum interval for double click.
+  unsigned int holdDuration;        // Duration to trigger hold event.
+
+  ButtonGroupCallback callback; // Event callback function.
+
+  // Per button, struct of arrays indexed by button id
+  uint8_t  buttonCount;
+  uint8_t  pins[BUTTON_GROUP_MAX];
+  uint8_t  states[BUTTON_GROUP_MAX];      // ButtonState
+  uint8_t  clickCounts[BUTTON_GROUP_MAX]; // Count of consecutive clicks
+  uint32_t rawTimes[BUTTON_GROUP_MAX];    // Last raw level change in milliseconds
+  uint32_t stateTimes[BUTTON_GROUP_MAX];  // Time when the state started in milliseconds
+
+  // Bit n for button n
+  uint8_t activeLowMask; // Button is active low
+  uint8_t rawMask;       // Pressed, not debounced
+  uint8_t stableMask;    // Pressed, debounced
+  uint8_t busyMask;      // FSM not idle
+
+  // Chords
+  uint8_t  chordCount;
+  uint8_t  chordMasks[BUTTON_GROUP_MAX_CHORDS];
+  uint32_t chordTimes[BUTTON_GROUP_MAX_CHORDS]; // Time when the chord was pressed
+  uint8_t  chordDownMask;                       // Bit c set while chord c is pressed
+  uint8_t  chordHeldMask;                       // Bit c set once chord c reported its hold
+
+  void updateChords(uint32_t currentTime);
+  void step(uint8_t id, bool isButtonPressed, uint32_t currentTime);
+  void notify(uint8_t id, button_event_t event);
+
+  inline bool hasElapsed(uint32_t start, uint32_t now, unsigned long duration)
+  {
+    return (now - start) >= duration;
+  }
+};
+
+#endif // BUTTON_GROUP_H
@@ -0,0 +1,119 @@
+/**
+ * @file       fan_control.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-16
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Fan Control library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "fan_control.h"
+
+#include <math.h>
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Class method definitions ------------------------------------------- */
+FanController::FanController()
+    : _integral(0.0f), _output(0.0f), _lastTemperature(0.0f), _lastTimestamp(0), _hasLast(false),
+      _running(false)
+{
+  fan_control_config_t config = FAN_CONTROL_CONFIG_DEFAULT;
+  _config                     = config;
+}
+
+fan_control_error_t FanController::configure(const fan_control_config_t &config)
+{
+  if (!validate(config))
+  {
+    return FAN_CONTROL_ERR_INVALID_ARG;
+  }
+
+  _config   = config;
+  _integral = constrain(_integral, -_config.maxOutput, _config.maxOutput);
+  return FAN_CONTROL_OK;
+}
+
+bool FanController::validate(const fan_control_config_t &config)
+{
+  // NaN fails every comparison, infinities are caught explicitly
+  return isfinite(config.setpoint) && isfinite(config.kp) && isfinite(config.ki) && isfinite(config.kd) &&
+         isfinite(config.hysteresis) && isfinite(config.rateLimit) && config.kp >= 0.0f &&
+         config.ki >= 0.0f && config.kd >= 0.0f && config.hysteresis >= 0.0f && config.rateLimit >= 0.0f &&
+         config.minOutput >= 0.0f && config.maxOutput >= config.minOutput && config.maxOutput <= 100.0f;
+}
+
+float FanController::update(float temperature, uint32_t timestamp)
+{
+  if (!isfinite(temperature))
+  {
+    return _output;
+  }
+
+  float dt    = _hasLast ? (uint32_t) (timestamp - _lastTimestamp) / 1000.0f : 0.0f;
+  float error = temperature - _config.setpoint;
+
+  // On/off with hysteresis, a stopped fan starts from a clean integral
+  if (!_running && error >= _config.hysteresis)
+  {
+    _running = true;
+  }
+  else if (_running && error <= -_config.hysteresis)
+  {
+    _running  = false;
+    _integral = 0.0f;
+  }
+
+  float target = 0.0f;
+  if (_running)
+  {
+    float proportional = _config.kp * error;
+    // On the measurement: a rising temperature asks for more fan, a setpoint change does not kick it
+    float derivative = (dt > 0.0f) ? _config.kd * (temperature - _lastTemperature) / dt : 0.0f;
+
+    // Anti-windup: integrate unless the output is already saturated in the direction the error pushes
+    float integral  = _integral + _config.ki * error * dt;
+    float unclamped = proportional + integral + derivative;
+    bool  saturated = (unclamped > _config.maxOutput && error > 0.0f) ||
+                      (unclamped < _config.minOutput && error < 0.0f);
+    if (!saturated)
+    {
+      _integral = constrain(integral, -_config.maxOutput, _config.maxOutput);
+    }
+
+    target = constrain(proportional + _integral + derivative, _config.minOutput, _config.maxOutput);
+  }
+
+  if (_config.rateLimit > 0.0f && _hasLast)
+  {
+    float maxStep = _config.rateLimit * dt;
+    target        = constrain(target, _output - maxStep, _output + maxStep);
+  }
+
+  _output          = target;
+  _lastTemperature = temperature;
+  _lastTimestamp   = timestamp;
+  _hasLast         = true;
+  return _output;
+}
+
+void FanController::reset()
+{
+  _integral = 0.0f;
+  _output   = 0.0f;
+  _hasLast  = false;
+  _running  = false;
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,157 @@
+/**
+ * @file       fan_control.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-16
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Fan Control library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef FAN_CONTROL_H
+  #define FAN_CONTROL_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  /* Public defines ----------------------------------------------------- */
+  #define FAN_CONTROL_LIB_VERSION (F("0.1.0"))
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  FAN_CONTROL_OK = 0,          /* No error */
+  FAN_CONTROL_ERR,             /* Generic error */
+  FAN_CONTROL_ERR_INVALID_ARG  /* Negative gain, empty output range or non-finite value */
+} fan_control_error_t;
+
+/**
+ * @brief Controller settings. Temperatures in °C, outputs in percent of full speed.
+ */
+typedef struct
+{
+  float setpoint;   /**< Temperature to hold */
+  float kp;         /**< Proportional gain, % per °C above the setpoint */
+  float ki;         /**< Integral gain, % per °C and second */
+  float kd;         /**< Derivative gain on the measurement, % per °C/s */
+  float hysteresis; /**< Fan starts above `setpoint + hysteresis`, stops below `setpoint - hysteresis` */
+  float minOutput;  /**< Lowest speed while running, below it the fan stalls */
+  float maxOutput;  /**< Highest speed */
+  float rateLimit;  /**< Largest output change in % per second, `0` for no limit */
+} fan_control_config_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define FAN_CONTROL_CONFIG_DEFAULT                                                                         \
+    {                                                                                                        \
+      28.0f, 10.0f, 0.05f, 0.0f, 0.5f, 20.0f, 100.0f, 2.0f                                                   \
+    }
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief PID controller turning a temperature into a fan speed.
+ *
+ * The `FanController` class closes the loop between a temperature sensor and a fan: above the setpoint the
+ * fan speeds up, below it the fan slows down and eventually stops. It only computes, the caller feeds it the
+ * measurements and applies the output, so it runs unchanged against a simulated plant on the host.
+ *
+ * ### Features:
+ *
+ * - Hysteresis on/off: the fan starts once the temperature exceeds the setpoint by `hysteresis` and stops
+ * once it falls below it by as much, it does not chatter around the setpoint. While running, the output
+ * stays between `minOutput` and `maxOutput`.
+ *
+ * - PID while running, the derivative acts on the measurement so a setpoint change does not kick the fan.
+ *
+ * - Anti-windup: the integral stops growing while the output is saturated in the direction it pushes, and it
+ * is cleared when the fan stops. A long heat wave does not leave the fan at full speed long after it ended.
+ *
+ * - Rate limit on the output, on top of the ramp of the fan itself.
+ *
+ * - The time step comes from the sample timestamps, irregular sampling is handled.
+ *
+ * ### Usage:
+ *
+ * ```
+ * FanController controller;
+ * fan_control_config_t config = FAN_CONTROL_CONFIG_DEFAULT;
+ * controller.configure(config);
+ * // On every new temperature sample
+ * miniFan.setFanSpeedPercentage((int) lroundf(controller.update(temperature, sampledAt)));
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - None, the class is pure C++ and not thread-safe: one task owns it.
+ */
+class FanController
+{
+public:
+  FanController();
+
+  /**
+   * @brief Applies new settings. The state is kept, the integral is clamped to the new output range.
+   *
+   * @param[in] config New settings.
+   *
+   * @return
+   *  - `FAN_CONTROL_OK`: Success
+   *
+   *  - `FAN_CONTROL_ERR_INVALID_ARG`: Settings rejected by `validate()`, the previous ones are kept
+   */
+  fan_control_error_t configure(const fan_control_config_t &config);
+
+  /**
+   * @brief Checks settings without applying them.
+   *
+   * @param[in] config Settings to check.
+   *
+   * @return bool `true` if the values are finite, the gains, hysteresis and rate limit are not negative and
+   * `0 <= minOutput <= maxOutput <= 100`.
+   */
+  static bool validate(const fan_control_config_t &config);
+
+  /**
+   * @brief Runs the controller on a new temperature sample.
+   *
+   * The first sample after a `reset()` only primes the derivative and the rate limit, they need two
+   * samples.
+   *
+   * @param[in] temperature Measured temperature. A non-finite value is ignored.
+   * @param[in] timestamp   millis() of the measurement.
+   *
+   * @return float The fan speed to apply, in percent.
+   */
+  float update(float temperature, uint32_t timestamp);
+
+  /**
+   * @brief Stops the fan output and clears the integral and the sample history.
+   */
+  void reset();
+
+  const fan_control_config_t &getConfig() { return _config; }
+  float                       getOutput() { return _output; }
+  float                       getIntegral() { return _integral; }
+  bool                        isRunning() { return _running; }
+
+private:
+  fan_control_config_t _config;
+  float                _integral;        /** Integral term, in percent */
+  float                _output;          /** Last output, in percent */
+  float                _lastTemperature; /** Previous sample, for the derivative */
+  uint32_t             _lastTimestamp;
+  bool                 _hasLast;         /** A previous sample exists */
+  bool                 _running;         /** Hysteresis state */
+};
+
+#endif // FAN_CONTROL_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,210 @@
+/**
+ * @file       Arduino.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 core header
+ *
+ * Only the subset of the core used by the libraries in lib/ is provided. Pin modes, interrupt modes and
+ * constants keep their Arduino-ESP32 values so driver code behaves the same on both targets.
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_ARDUINO_H
+  #define HAL_NATIVE_ARDUINO_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <math.h>
+  #include <stdarg.h>
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+
+  #include <algorithm>
+  #include <cmath>
+
+  #include "freertos/FreeRTOS.h"
+  #include "freertos/queue.h"
+  #include "freertos/semphr.h"
+  #include "freertos/task.h"
+
+  #include "HardwareSerial.h"
+  #include "Print.h"
+  #include "Stream.h"
+  #include "WString.h"
+
+  #include "hal_native.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define HIGH              0x1
+  #define LOW               0x0
+
+  #define INPUT             0x01
+  #define OUTPUT            0x03
+  #define PULLUP            0x04
+  #define INPUT_PULLUP      0x05
+  #define PULLDOWN          0x08
+  #define INPUT_PULLDOWN    0x09
+  #define OPEN_DRAIN        0x10
+  #define OUTPUT_OPEN_DRAIN 0x13
+  #define ANALOG            0xC0
+
+  #define RISING            0x01
+  #define FALLING           0x02
+  #define CHANGE            0x03
+  #define ONLOW             0x04
+  #define ONHIGH            0x05
+
+  #define LSBFIRST          0
+  #define MSBFIRST          1
+
+  #define PI                3.1415926535897932384626433832795
+  #define HALF_PI           1.5707963267948966192313216916398
+  #define TWO_PI            6.283185307179586476925286766559
+  #define DEG_TO_RAD        0.017453292519943295769236907684886
+  #define RAD_TO_DEG        57.295779513082320876798154814105
+
+  #define IRAM_ATTR
+  #define ARDUINO_ISR_ATTR
+  #define PROGMEM
+  #define F(string_literal) (string_literal)
+  #define PSTR(s)           (s)
+
+  #define LED_BUILTIN       48
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  GPIO_NUM_NC = -1,
+  GPIO_NUM_0  = 0,
+  GPIO_NUM_1  = 1,
+  GPIO_NUM_2  = 2,
+  GPIO_NUM_3  = 3,
+  GPIO_NUM_4  = 4,
+  GPIO_NUM_5  = 5,
+  GPIO_NUM_6  = 6,
+  GPIO_NUM_7  = 7,
+  GPIO_NUM_8  = 8,
+  GPIO_NUM_9  = 9,
+  GPIO_NUM_10 = 10,
+  GPIO_NUM_11 = 11,
+  GPIO_NUM_12 = 12,
+  GPIO_NUM_13 = 13,
+  GPIO_NUM_14 = 14,
+  GPIO_NUM_15 = 15,
+  GPIO_NUM_16 = 16,
+  GPIO_NUM_17 = 17,
+  GPIO_NUM_18 = 18,
+  GPIO_NUM_19 = 19,
+  GPIO_NUM_20 = 20,
+  GPIO_NUM_21 = 21,
+  GPIO_NUM_22 = 22,
+  GPIO_NUM_23 = 23,
+  GPIO_NUM_24 = 24,
+  GPIO_NUM_25 = 25,
+  GPIO_NUM_26 = 26,
+  GPIO_NUM_27 = 27,
+  GPIO_NUM_28 = 28,
+  GPIO_NUM_29 = 29,
+  GPIO_NUM_30 = 30,
+  GPIO_NUM_31 = 31,
+  GPIO_NUM_32 = 32,
+  GPIO_NUM_33 = 33,
+  GPIO_NUM_34 = 34,
+  GPIO_NUM_35 = 35,
+  GPIO_NUM_36 = 36,
+  GPIO_NUM_37 = 37,
+  GPIO_NUM_38 = 38,
+  GPIO_NUM_39 = 39,
+  GPIO_NUM_40 = 40,
+  GPIO_NUM_41 = 41,
+  GPIO_NUM_42 = 42,
+  GPIO_NUM_43 = 43,
+  GPIO_NUM_44 = 44,
+  GPIO_NUM_45 = 45,
+  GPIO_NUM_46 = 46,
+  GPIO_NUM_47 = 47,
+  GPIO_NUM_48 = 48,
+  GPIO_NUM_MAX
+} gpio_num_t;
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+
+/* Public macros ------------------------------------------------------ */
+  #define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+  #define radians(deg)              ((deg) * DEG_TO_RAD)
+  #define degrees(rad)              ((rad) * RAD_TO_DEG)
+  #define sq(x)                     ((x) * (x))
+
+  #define lowByte(w)                ((uint8_t) ((w) & 0xff))
+  #define highByte(w)               ((uint8_t) ((w) >> 8))
+  #define bitRead(value, bit)       (((value) >> (bit)) & 0x01)
+  #define bitSet(value, bit)        ((value) |= (1UL << (bit)))
+  #define bitClear(value, bit)      ((value) &= ~(1UL << (bit)))
+  #define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+  #define bit(b)                         (1UL << (b))
+  #ifndef _BV
+    #define _BV(b) (1UL << (b))
+  #endif
+
+  #define digitalPinToInterrupt(p)  (((p) < HAL_GPIO_PIN_COUNT) ? (p) : -1)
+
+  #define interrupts()
+  #define noInterrupts()
+
+/* Public variables --------------------------------------------------- */
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+/* Function Declaration ----------------------------------------------- */
+/* Time --------------------------------------------------------------- */
+unsigned long millis();
+unsigned long micros();
+void          delay(uint32_t ms);
+void          delayMicroseconds(uint32_t us);
+void          yield();
+
+/* Digital / analog I/O ----------------------------------------------- */
+void     pinMode(uint8_t pin, uint8_t mode);
+void     digitalWrite(uint8_t pin, uint8_t val);
+int      digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void     analogReadResolution(uint8_t bits);
+void     analogWrite(uint8_t pin, int value);
+void     analogWriteResolution(uint8_t bits);
+void     analogWriteFrequency(uint32_t freq);
+
+/* Interrupts --------------------------------------------------------- */
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+/* Advanced I/O ------------------------------------------------------- */
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout = 1000000UL);
+unsigned long pulseInLong(uint8_t pin, uint8_t state, unsigned long timeout = 1000000UL);
+uint8_t       shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+void          shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
+void          tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void          noTone(uint8_t pin);
+
+/* Math --------------------------------------------------------------- */
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+  #include "esp32-hal-ledc.h"
+
+#endif // HAL_NATIVE_ARDUINO_H
+
+/* End of file -------------------------------------------------------- */
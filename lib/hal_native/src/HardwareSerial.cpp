@@ -0,0 +1,198 @@
+/**
+ * @file       HardwareSerial.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 HardwareSerial class
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "HardwareSerial.h"
+#include "hal_native.h"
+
+#include <stdio.h>
+
+/* Private defines ---------------------------------------------------- */
+#define HAL_UART_CONSOLE       0  // UART whose output goes to stdout
+#define HAL_UART_USB_CDC       -1 // `Serial` (USB CDC on the board)
+#define HAL_UART_RX_BUFFER_LEN 256
+
+/* Public variables --------------------------------------------------- */
+HardwareSerial Serial(HAL_UART_USB_CDC);
+HardwareSerial Serial0(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+/* Private variables -------------------------------------------------- */
+static bool consoleEcho = true;
+
+/* Class method definitions ------------------------------------------- */
+HardwareSerial::HardwareSerial(int uart_nr)
+    : _uart_nr(uart_nr), _baud(0), _rxBufferSize(HAL_UART_RX_BUFFER_LEN)
+{
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin, bool invert,
+                           unsigned long timeout_ms, uint8_t rxfifo_full_thrhd)
+{
+  _baud = baud;
+}
+
+void HardwareSerial::end() { _rx.clear(); }
+
+void HardwareSerial::updateBaudRate(unsigned long baud) { _baud = baud; }
+
+bool HardwareSerial::setRxTimeout(uint8_t symbols_timeout) { return true; }
+
+bool HardwareSerial::setRxFIFOFull(uint8_t fifoBytes) { return true; }
+
+void HardwareSerial::onReceive(OnReceiveCb function, bool onlyOnTimeout) { _onReceive = function; }
+
+void HardwareSerial::onReceiveError(OnReceiveErrorCb function) {}
+
+void HardwareSerial::eventQueueReset() {}
+
+int HardwareSerial::available(void) { return (int) _rx.size(); }
+
+int HardwareSerial::availableForWrite(void) { return 128; }
+
+int HardwareSerial::peek(void) { return _rx.empty() ? -1 : _rx.front(); }
+
+int HardwareSerial::read(void)
+{
+  if (_rx.empty())
+  {
+    return -1;
+  }
+  uint8_t c = _rx.front();
+  _rx.pop_front();
+  return c;
+}
+
+size_t HardwareSerial::read(uint8_t *buffer, size_t size)
+{
+  size_t count = 0;
+  while (count < size && !_rx.empty())
+  {
+    buffer[count++] = _rx.front();
+    _rx.pop_front();
+  }
+  return count;
+}
+
+size_t HardwareSerial::readBytes(uint8_t *buffer, size_t length)
+{
+  return Stream::readBytes((char *) buffer, length);
+}
+
+void HardwareSerial::flush(void) { flush(true); }
+
+void HardwareSerial::flush(bool txOnly)
+{
+  if (!txOnly)
+  {
+    _rx.clear();
+  }
+  if (consoleEcho && (_uart_nr == HAL_UART_CONSOLE || _uart_nr == HAL_UART_USB_CDC))
+  {
+    fflush(stdout);
+  }
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+  if (consoleEcho && (_uart_nr == HAL_UART_CONSOLE || _uart_nr == HAL_UART_USB_CDC))
+  {
+    fwrite(buffer, 1, size, stdout);
+  }
+  else
+  {
+    _tx.append((const char *) buffer, size);
+  }
+
+  // Virtual time the frame spends on the wire: 10 bits per byte (8N1)
+  if (_baud != 0 && _uart_nr != HAL_UART_USB_CDC)
+  {
+    halSimAdvanceMicros((uint64_t) size * 10U * 1000000U / _baud);
+  }
+  return size;
+}
+
+uint32_t HardwareSerial::baudRate() { return (uint32_t) _baud; }
+
+void HardwareSerial::setDebugOutput(bool enable) {}
+
+void HardwareSerial::setRxInvert(bool invert) {}
+
+bool HardwareSerial::setPins(int8_t rxPin, int8_t txPin, int8_t ctsPin, int8_t rtsPin) { return true; }
+
+bool HardwareSerial::setHwFlowCtrlMode(SerialHwFlowCtrl mode, uint8_t threshold) { return true; }
+
+bool HardwareSerial::setMode(SerialMode mode) { return true; }
+
+size_t HardwareSerial::setRxBufferSize(size_t new_size)
+{
+  _rxBufferSize = new_size;
+  return new_size;
+}
+
+size_t HardwareSerial::setTxBufferSize(size_t new_size) { return new_size; }
+
+void HardwareSerial::inject(const uint8_t *data, size_t len)
+{
+  for (size_t i = 0; i < len && _rx.size() < _rxBufferSize; i++)
+  {
+    _rx.push_back(data[i]);
+  }
+  if (_onReceive)
+  {
+    _onReceive();
+  }
+}
+
+std::string HardwareSerial::takeTx()
+{
+  std::string tx;
+  tx.swap(_tx);
+  return tx;
+}
+
+/* Function definitions ----------------------------------------------- */
+static HardwareSerial *halUartGet(uint8_t uart_nr)
+{
+  switch (uart_nr)
+  {
+    case 0:
+      return &Serial0;
+    case 1:
+      return &Serial1;
+    case 2:
+      return &Serial2;
+    default:
+      return nullptr;
+  }
+}
+
+void halUartInject(uint8_t uart_nr, const uint8_t *data, size_t len)
+{
+  HardwareSerial *uart = halUartGet(uart_nr);
+  if (uart != nullptr && data != nullptr)
+  {
+    uart->inject(data, len);
+  }
+}
+
+std::string halUartTakeTx(uint8_t uart_nr)
+{
+  HardwareSerial *uart = halUartGet(uart_nr);
+  return (uart != nullptr) ? uart->takeTx() : std::string();
+}
+
+void halUartEchoConsole(bool enable) { consoleEcho = enable; }
+
+/* End of file -------------------------------------------------------- */
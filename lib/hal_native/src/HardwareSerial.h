@@ -0,0 +1,131 @@
+/**
+ * @file       HardwareSerial.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 HardwareSerial class
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_HARDWARE_SERIAL_H
+  #define HAL_NATIVE_HARDWARE_SERIAL_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <deque>
+  #include <functional>
+  #include <string>
+
+  #include "Stream.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define SERIAL_8N1 0x800001c
+  #define SERIAL_8E1 0x800001e
+  #define SERIAL_8O1 0x800001f
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  UART_NO_ERROR,
+  UART_BREAK_ERROR,
+  UART_BUFFER_FULL_ERROR,
+  UART_FIFO_OVF_ERROR,
+  UART_FRAME_ERROR,
+  UART_PARITY_ERROR
+} hardwareSerial_error_t;
+
+typedef enum
+{
+  UART_HW_FLOWCTRL_DISABLE = 0x0,
+  UART_HW_FLOWCTRL_RTS     = 0x1,
+  UART_HW_FLOWCTRL_CTS     = 0x2,
+  UART_HW_FLOWCTRL_CTS_RTS = 0x3
+} SerialHwFlowCtrl;
+
+typedef enum
+{
+  UART_MODE_UART                   = 0x00,
+  UART_MODE_RS485_HALF_DUPLEX      = 0x01,
+  UART_MODE_IRDA                   = 0x02,
+  UART_MODE_RS485_COLLISION_DETECT = 0x03,
+  UART_MODE_RS485_APP_CTRL         = 0x04
+} SerialMode;
+
+typedef std::function<void(void)>                   OnReceiveCb;
+typedef std::function<void(hardwareSerial_error_t)> OnReceiveErrorCb;
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief UART model. Transmitted bytes are captured (and echoed to stdout for the console UART), received
+ * bytes come from `halUartInject()`.
+ */
+class HardwareSerial : public Stream
+{
+public:
+  HardwareSerial(int uart_nr);
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1,
+             bool invert = false, unsigned long timeout_ms = 20000UL, uint8_t rxfifo_full_thrhd = 112);
+  void end();
+  void updateBaudRate(unsigned long baud);
+  bool setRxTimeout(uint8_t symbols_timeout);
+  bool setRxFIFOFull(uint8_t fifoBytes);
+  void onReceive(OnReceiveCb function, bool onlyOnTimeout = false);
+  void onReceiveError(OnReceiveErrorCb function);
+  void eventQueueReset();
+
+  int    available(void) override;
+  int    availableForWrite(void) override;
+  int    peek(void) override;
+  int    read(void) override;
+  size_t read(uint8_t *buffer, size_t size);
+  size_t read(char *buffer, size_t size) { return read((uint8_t *) buffer, size); }
+  size_t readBytes(uint8_t *buffer, size_t length) override;
+  size_t readBytes(char *buffer, size_t length) override { return readBytes((uint8_t *) buffer, length); }
+  void   flush(void) override;
+  void   flush(bool txOnly);
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  uint32_t baudRate();
+  operator bool() const { return true; }
+  void     setDebugOutput(bool enable);
+  void     setRxInvert(bool invert);
+  bool     setPins(int8_t rxPin, int8_t txPin, int8_t ctsPin = -1, int8_t rtsPin = -1);
+  bool     setHwFlowCtrlMode(SerialHwFlowCtrl mode = UART_HW_FLOWCTRL_CTS_RTS, uint8_t threshold = 64);
+  bool     setMode(SerialMode mode);
+  size_t   setRxBufferSize(size_t new_size);
+  size_t   setTxBufferSize(size_t new_size);
+
+  /**
+   * @brief Model side: queues bytes as if received on the RX pin and fires the `onReceive()` callback.
+   */
+  void inject(const uint8_t *data, size_t len);
+
+  /**
+   * @brief Model side: retrieves and clears the transmitted bytes.
+   */
+  std::string takeTx();
+
+private:
+  int                 _uart_nr;
+  unsigned long       _baud;
+  size_t              _rxBufferSize;
+  std::deque<uint8_t> _rx;
+  std::string         _tx;
+  OnReceiveCb         _onReceive;
+};
+
+/* Public variables --------------------------------------------------- */
+extern HardwareSerial Serial;
+extern HardwareSerial Serial0;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif // HAL_NATIVE_HARDWARE_SERIAL_H
+
+/* End of file -------------------------------------------------------- */
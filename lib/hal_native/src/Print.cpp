@@ -0,0 +1,199 @@
+/**
+ * @file       Print.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino Print class
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Print.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <vector>
+
+/* Class method definitions ------------------------------------------- */
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+  while (size--)
+  {
+    if (write(*buffer++) == 0)
+    {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+  char    stackBuffer[64];
+  va_list args;
+
+  va_start(args, format);
+  int len = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+  va_end(args);
+
+  if (len < 0)
+  {
+    return 0;
+  }
+  if ((size_t) len < sizeof(stackBuffer))
+  {
+    return write((const uint8_t *) stackBuffer, len);
+  }
+
+  std::vector<char> heapBuffer(len + 1);
+  va_start(args, format);
+  vsnprintf(heapBuffer.data(), heapBuffer.size(), format, args);
+  va_end(args);
+  return write((const uint8_t *) heapBuffer.data(), len);
+}
+
+size_t Print::print(const String &s) { return write((const uint8_t *) s.c_str(), s.length()); }
+
+size_t Print::print(const char str[]) { return write(str); }
+
+size_t Print::print(char c) { return write((uint8_t) c); }
+
+size_t Print::print(unsigned char value, int base) { return print((unsigned long) value, base); }
+
+size_t Print::print(int value, int base) { return print((long) value, base); }
+
+size_t Print::print(unsigned int value, int base) { return print((unsigned long) value, base); }
+
+size_t Print::print(long value, int base) { return print((long long) value, base); }
+
+size_t Print::print(unsigned long value, int base) { return print((unsigned long long) value, base); }
+
+size_t Print::print(long long value, int base)
+{
+  if (base == 0)
+  {
+    return write((uint8_t) value);
+  }
+  if (base == 10 && value < 0)
+  {
+    return print('-') + printNumber((unsigned long long) (-(value + 1)) + 1, 10);
+  }
+  return printNumber((unsigned long long) value, base);
+}
+
+size_t Print::print(unsigned long long value, int base)
+{
+  if (base == 0)
+  {
+    return write((uint8_t) value);
+  }
+  return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits) { return printFloat(value, digits); }
+
+size_t Print::print(const Printable &x) { return x.printTo(*this); }
+
+size_t Print::println(void) { return write("\r\n"); }
+
+size_t Print::println(const String &s) { return print(s) + println(); }
+
+size_t Print::println(const char str[]) { return print(str) + println(); }
+
+size_t Print::println(char c) { return print(c) + println(); }
+
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(long long value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(unsigned long long value, int base) { return print(value, base) + println(); }
+
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+
+size_t Print::println(const Printable &x) { return print(x) + println(); }
+
+/* Private definitions ------------------------------------------------ */
+size_t Print::printNumber(unsigned long long value, uint8_t base)
+{
+  char  buffer[8 * sizeof(value) + 1];
+  char *str = &buffer[sizeof(buffer) - 1];
+  *str      = '\0';
+
+  if (base < 2)
+  {
+    base = 10;
+  }
+
+  do
+  {
+    char digit = (char) (value % base);
+    value /= base;
+    *--str = (char) (digit < 10 ? digit + '0' : digit + 'A' - 10);
+  } while (value);
+
+  return write(str);
+}
+
+size_t Print::printFloat(double value, uint8_t digits)
+{
+  // Same limits and rounding as the Arduino core
+  if (isnan(value))
+  {
+    return print("nan");
+  }
+  if (isinf(value))
+  {
+    return print("inf");
+  }
+  if (value > 4294967040.0 || value < -4294967040.0)
+  {
+    return print("ovf");
+  }
+
+  size_t n = 0;
+  if (value < 0.0)
+  {
+    n += print('-');
+    value = -value;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i)
+  {
+    rounding /= 10.0;
+  }
+  value += rounding;
+
+  unsigned long intPart   = (unsigned long) value;
+  double        remainder = value - (double) intPart;
+  n += print(intPart);
+
+  if (digits > 0)
+  {
+    n += print('.');
+  }
+  while (digits-- > 0)
+  {
+    remainder *= 10.0;
+    unsigned int toPrint = (unsigned int) remainder;
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+  return n;
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,86 @@
+/**
+ * @file       Print.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino Print class
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_PRINT_H
+  #define HAL_NATIVE_PRINT_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <string.h>
+
+  #include "Printable.h"
+  #include "WString.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define DEC 10
+  #define HEX 16
+  #define OCT 8
+  #define BIN 2
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief Arduino `Print`: formatting on top of a single virtual `write(uint8_t)`.
+ *
+ * Numbers and floats are formatted exactly like the Arduino core (`print(1.5)` prints `1.50`), so text
+ * rendered by the drivers (LCD, logs) matches the target byte for byte.
+ */
+class Print
+{
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual int    availableForWrite() { return 0; }
+  virtual void   flush() {}
+
+  size_t write(const char *str) { return (str == nullptr) ? 0 : write((const uint8_t *) str, strlen(str)); }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *) buffer, size); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+  size_t print(const String &s);
+  size_t print(const char str[]);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = DEC);
+  size_t print(int value, int base = DEC);
+  size_t print(unsigned int value, int base = DEC);
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(long long value, int base = DEC);
+  size_t print(unsigned long long value, int base = DEC);
+  size_t print(double value, int digits = 2);
+  size_t print(const Printable &x);
+
+  size_t println(const String &s);
+  size_t println(const char str[]);
+  size_t println(char c);
+  size_t println(unsigned char value, int base = DEC);
+  size_t println(int value, int base = DEC);
+  size_t println(unsigned int value, int base = DEC);
+  size_t println(long value, int base = DEC);
+  size_t println(unsigned long value, int base = DEC);
+  size_t println(long long value, int base = DEC);
+  size_t println(unsigned long long value, int base = DEC);
+  size_t println(double value, int digits = 2);
+  size_t println(const Printable &x);
+  size_t println(void);
+
+private:
+  size_t printNumber(unsigned long long value, uint8_t base);
+  size_t printFloat(double value, uint8_t digits);
+};
+
+#endif // HAL_NATIVE_PRINT_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,34 @@
+/**
+ * @file       Printable.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino Printable interface
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_PRINTABLE_H
+  #define HAL_NATIVE_PRINTABLE_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stddef.h>
+
+class Print;
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief Interface of objects that know how to print themselves with `Print::print()`.
+ */
+class Printable
+{
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+#endif // HAL_NATIVE_PRINTABLE_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,55 @@
+/**
+ * @file       Stream.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino Stream class
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Stream.h"
+#include "hal_native.h"
+
+/* Class method definitions ------------------------------------------- */
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length)
+  {
+    int c = timedRead();
+    if (c < 0)
+    {
+      break;
+    }
+    *buffer++ = (char) c;
+    count++;
+  }
+  return count;
+}
+
+String Stream::readString()
+{
+  String result;
+  int    c = timedRead();
+  while (c >= 0)
+  {
+    result += (char) c;
+    c = timedRead();
+  }
+  return result;
+}
+
+/* Private definitions ------------------------------------------------ */
+int Stream::timedRead()
+{
+  if (!halSimWait([this]() { return available() > 0; }, (uint32_t) _timeout))
+  {
+    return -1;
+  }
+  return read();
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,48 @@
+/**
+ * @file       Stream.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino Stream class
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_STREAM_H
+  #define HAL_NATIVE_STREAM_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include "Print.h"
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief Arduino `Stream`. Blocking reads wait on the virtual clock, so scripted input can arrive while a
+ * driver is waiting for it.
+ */
+class Stream : public Print
+{
+public:
+  Stream() : _timeout(1000) {}
+
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+
+  void          setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout(void) { return _timeout; }
+
+  virtual size_t readBytes(char *buffer, size_t length);
+  virtual size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *) buffer, length); }
+  String         readString();
+
+protected:
+  unsigned long _timeout; /**< Milliseconds to wait for data in blocking reads */
+
+  int timedRead();
+};
+
+#endif // HAL_NATIVE_STREAM_H
+
+/* End of file -------------------------------------------------------- */
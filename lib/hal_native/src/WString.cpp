@@ -0,0 +1,376 @@
+/**
+ * @file       WString.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino String class
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+/* Private function prototypes ---------------------------------------- */
+static std::string formatInteger(unsigned long long value, unsigned char base, bool negative);
+static std::string formatFloat(double value, unsigned int decimalPlaces);
+
+/* Class method definitions ------------------------------------------- */
+String::String(const char *cstr) : _buffer(cstr != nullptr ? cstr : "") {}
+
+String::String(const std::string &str) : _buffer(str) {}
+
+String::String(char c) : _buffer(1, c) {}
+
+String::String(unsigned char value, unsigned char base) : _buffer(formatInteger(value, base, false)) {}
+
+String::String(int value, unsigned char base)
+    : _buffer((base == 10 && value < 0) ? formatInteger(-(long long) value, base, true)
+                                        : formatInteger((unsigned int) value, base, false))
+{
+}
+
+String::String(unsigned int value, unsigned char base) : _buffer(formatInteger(value, base, false)) {}
+
+String::String(long value, unsigned char base)
+    : _buffer((base == 10 && value < 0) ? formatInteger(-(long long) value, base, true)
+                                        : formatInteger((unsigned long) value, base, false))
+{
+}
+
+String::String(unsigned long value, unsigned char base) : _buffer(formatInteger(value, base, false)) {}
+
+String::String(float value, unsigned int decimalPlaces) : _buffer(formatFloat(value, decimalPlaces)) {}
+
+String::String(double value, unsigned int decimalPlaces) : _buffer(formatFloat(value, decimalPlaces)) {}
+
+String &String::operator=(const char *cstr)
+{
+  _buffer = (cstr != nullptr) ? cstr : "";
+  return *this;
+}
+
+bool String::reserve(unsigned int size)
+{
+  _buffer.reserve(size);
+  return true;
+}
+
+bool String::concat(const String &str)
+{
+  _buffer += str._buffer;
+  return true;
+}
+
+bool String::concat(const char *cstr)
+{
+  if (cstr == nullptr)
+  {
+    return false;
+  }
+  _buffer += cstr;
+  return true;
+}
+
+bool String::concat(char c)
+{
+  _buffer += c;
+  return true;
+}
+
+String &String::operator+=(const String &rhs)
+{
+  concat(rhs);
+  return *this;
+}
+
+String &String::operator+=(const char *cstr)
+{
+  concat(cstr);
+  return *this;
+}
+
+String &String::operator+=(char c)
+{
+  concat(c);
+  return *this;
+}
+
+String &String::operator+=(int value) { return *this += String(value); }
+
+String &String::operator+=(unsigned int value) { return *this += String(value); }
+
+String &String::operator+=(long value) { return *this += String(value); }
+
+String &String::operator+=(unsigned long value) { return *this += String(value); }
+
+String &String::operator+=(float value) { return *this += String(value); }
+
+String &String::operator+=(double value) { return *this += String(value); }
+
+int String::compareTo(const String &str) const { return _buffer.compare(str._buffer); }
+
+bool String::equals(const String &str) const { return _buffer == str._buffer; }
+
+bool String::equals(const char *cstr) const { return cstr != nullptr && _buffer == cstr; }
+
+bool String::equalsIgnoreCase(const String &str) const
+{
+  if (_buffer.size() != str._buffer.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < _buffer.size(); i++)
+  {
+    if (tolower((unsigned char) _buffer[i]) != tolower((unsigned char) str._buffer[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool String::startsWith(const String &prefix) const
+{
+  return _buffer.compare(0, prefix._buffer.size(), prefix._buffer) == 0;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+  return _buffer.size() >= suffix._buffer.size() &&
+         _buffer.compare(_buffer.size() - suffix._buffer.size(), suffix._buffer.size(), suffix._buffer) == 0;
+}
+
+char String::charAt(unsigned int index) const { return (*this)[index]; }
+
+void String::setCharAt(unsigned int index, char c)
+{
+  if (index < _buffer.size())
+  {
+    _buffer[index] = c;
+  }
+}
+
+char String::operator[](unsigned int index) const { return (index < _buffer.size()) ? _buffer[index] : '\0'; }
+
+char &String::operator[](unsigned int index)
+{
+  static char dummy;
+  if (index >= _buffer.size())
+  {
+    dummy = '\0';
+    return dummy;
+  }
+  return _buffer[index];
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const
+{
+  if (buf == nullptr || bufsize == 0)
+  {
+    return;
+  }
+  if (index >= _buffer.size())
+  {
+    buf[0] = '\0';
+    return;
+  }
+  size_t n = std::min<size_t>(bufsize - 1, _buffer.size() - index);
+  memcpy(buf, _buffer.data() + index, n);
+  buf[n] = '\0';
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const
+{
+  getBytes((unsigned char *) buf, bufsize, index);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+  size_t pos = _buffer.find(ch, fromIndex);
+  return (pos == std::string::npos) ? -1 : (int) pos;
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const
+{
+  size_t pos = _buffer.find(str._buffer, fromIndex);
+  return (pos == std::string::npos) ? -1 : (int) pos;
+}
+
+int String::lastIndexOf(char ch) const
+{
+  size_t pos = _buffer.rfind(ch);
+  return (pos == std::string::npos) ? -1 : (int) pos;
+}
+
+int String::lastIndexOf(const String &str) const
+{
+  size_t pos = _buffer.rfind(str._buffer);
+  return (pos == std::string::npos) ? -1 : (int) pos;
+}
+
+String String::substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+  if (beginIndex > endIndex)
+  {
+    std::swap(beginIndex, endIndex);
+  }
+  if (beginIndex >= _buffer.size())
+  {
+    return String();
+  }
+  if (endIndex > _buffer.size())
+  {
+    endIndex = (unsigned int) _buffer.size();
+  }
+  return String(_buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(char find, char replace)
+{
+  for (size_t i = 0; i < _buffer.size(); i++)
+  {
+    if (_buffer[i] == find)
+    {
+      _buffer[i] = replace;
+    }
+  }
+}
+
+void String::replace(const String &find, const String &replace)
+{
+  if (find._buffer.empty())
+  {
+    return;
+  }
+  size_t pos = 0;
+  while ((pos = _buffer.find(find._buffer, pos)) != std::string::npos)
+  {
+    _buffer.replace(pos, find._buffer.size(), replace._buffer);
+    pos += replace._buffer.size();
+  }
+}
+
+void String::remove(unsigned int index)
+{
+  if (index < _buffer.size())
+  {
+    _buffer.erase(index);
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+  if (index < _buffer.size())
+  {
+    _buffer.erase(index, count);
+  }
+}
+
+void String::toLowerCase()
+{
+  for (size_t i = 0; i < _buffer.size(); i++)
+  {
+    _buffer[i] = (char) tolower((unsigned char) _buffer[i]);
+  }
+}
+
+void String::toUpperCase()
+{
+  for (size_t i = 0; i < _buffer.size(); i++)
+  {
+    _buffer[i] = (char) toupper((unsigned char) _buffer[i]);
+  }
+}
+
+void String::trim()
+{
+  size_t begin = 0;
+  size_t end   = _buffer.size();
+  while (begin < end && isspace((unsigned char) _buffer[begin]))
+  {
+    begin++;
+  }
+  while (end > begin && isspace((unsigned char) _buffer[end - 1]))
+  {
+    end--;
+  }
+  _buffer = _buffer.substr(begin, end - begin);
+}
+
+long String::toInt() const { return atol(_buffer.c_str()); }
+
+float String::toFloat() const { return (float) atof(_buffer.c_str()); }
+
+double String::toDouble() const { return atof(_buffer.c_str()); }
+
+/* Function definitions ----------------------------------------------- */
+String operator+(const String &lhs, const String &rhs)
+{
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const String &lhs, const char *rhs) { return lhs + String(rhs); }
+
+String operator+(const char *lhs, const String &rhs) { return String(lhs) + rhs; }
+
+String operator+(const String &lhs, char rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, int rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, unsigned int rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, long rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, unsigned long rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, float rhs) { return lhs + String(rhs); }
+
+String operator+(const String &lhs, double rhs) { return lhs + String(rhs); }
+
+/* Private definitions ------------------------------------------------ */
+static std::string formatInteger(unsigned long long value, unsigned char base, bool negative)
+{
+  if (base < 2 || base > 36)
+  {
+    base = 10;
+  }
+
+  char  buffer[72];
+  char *p = &buffer[sizeof(buffer) - 1];
+  *p      = '\0';
+
+  do
+  {
+    unsigned digit = (unsigned) (value % base);
+    *--p           = (char) (digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= base;
+  } while (value != 0);
+
+  if (negative)
+  {
+    *--p = '-';
+  }
+  return std::string(p);
+}
+
+static std::string formatFloat(double value, unsigned int decimalPlaces)
+{
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int) decimalPlaces, value);
+  return std::string(buffer);
+}
+
+/* End of file -------------------------------------------------------- */
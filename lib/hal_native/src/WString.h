@@ -0,0 +1,124 @@
+/**
+ * @file       WString.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino String class
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_WSTRING_H
+  #define HAL_NATIVE_WSTRING_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stddef.h>
+  #include <stdint.h>
+
+  #include <string>
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief Arduino `String` backed by `std::string`.
+ *
+ * Indexing past the end returns `'\0'` and `substring()` clamps its bounds, as the Arduino implementation
+ * does, so parsing code written against the core behaves identically.
+ */
+class String
+{
+public:
+  String(const char *cstr = "");
+  String(const std::string &str);
+  String(const String &str) = default;
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimalPlaces = 2);
+  explicit String(double value, unsigned int decimalPlaces = 2);
+
+  String &operator=(const String &rhs) = default;
+  String &operator=(const char *cstr);
+
+  bool reserve(unsigned int size);
+
+  unsigned int length() const { return (unsigned int) _buffer.size(); }
+  bool         isEmpty() const { return _buffer.empty(); }
+  const char  *c_str() const { return _buffer.c_str(); }
+
+  bool    concat(const String &str);
+  bool    concat(const char *cstr);
+  bool    concat(char c);
+  String &operator+=(const String &rhs);
+  String &operator+=(const char *cstr);
+  String &operator+=(char c);
+  String &operator+=(int value);
+  String &operator+=(unsigned int value);
+  String &operator+=(long value);
+  String &operator+=(unsigned long value);
+  String &operator+=(float value);
+  String &operator+=(double value);
+
+  int  compareTo(const String &str) const;
+  bool equals(const String &str) const;
+  bool equals(const char *cstr) const;
+  bool equalsIgnoreCase(const String &str) const;
+  bool startsWith(const String &prefix) const;
+  bool endsWith(const String &suffix) const;
+
+  bool operator==(const String &rhs) const { return equals(rhs); }
+  bool operator==(const char *cstr) const { return equals(cstr); }
+  bool operator!=(const String &rhs) const { return !equals(rhs); }
+  bool operator!=(const char *cstr) const { return !equals(cstr); }
+  bool operator<(const String &rhs) const { return compareTo(rhs) < 0; }
+  bool operator>(const String &rhs) const { return compareTo(rhs) > 0; }
+
+  char  charAt(unsigned int index) const;
+  void  setCharAt(unsigned int index, char c);
+  char  operator[](unsigned int index) const;
+  char &operator[](unsigned int index);
+  void  getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
+  void  toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const;
+
+  int    indexOf(char ch, unsigned int fromIndex = 0) const;
+  int    indexOf(const String &str, unsigned int fromIndex = 0) const;
+  int    lastIndexOf(char ch) const;
+  int    lastIndexOf(const String &str) const;
+  String substring(unsigned int beginIndex) const;
+  String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+  void replace(char find, char replace);
+  void replace(const String &find, const String &replace);
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long   toInt() const;
+  float  toFloat() const;
+  double toDouble() const;
+
+private:
+  std::string _buffer;
+};
+
+/* Function Declaration ----------------------------------------------- */
+String operator+(const String &lhs, const String &rhs);
+String operator+(const String &lhs, const char *rhs);
+String operator+(const char *lhs, const String &rhs);
+String operator+(const String &lhs, char rhs);
+String operator+(const String &lhs, int rhs);
+String operator+(const String &lhs, unsigned int rhs);
+String operator+(const String &lhs, long rhs);
+String operator+(const String &lhs, unsigned long rhs);
+String operator+(const String &lhs, float rhs);
+String operator+(const String &lhs, double rhs);
+
+#endif // HAL_NATIVE_WSTRING_H
+
+/* End of file -------------------------------------------------------- */
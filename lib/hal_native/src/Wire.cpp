@@ -0,0 +1,232 @@
+/**
+ * @file       Wire.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 TwoWire class and the simulated I2C bus
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Wire.h"
+#include "hal_native.h"
+
+#include <string.h>
+
+/* Private defines ---------------------------------------------------- */
+#define I2C_DEFAULT_FREQUENCY 100000UL
+#define I2C_BITS_PER_BYTE     9 // 8 data bits + ACK
+
+/* Public variables --------------------------------------------------- */
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+/* Private variables -------------------------------------------------- */
+static HalI2CDevice   *i2cDevices[HAL_I2C_MAX_DEVICES] = { nullptr };
+static hal_i2c_stats_t i2cStats                        = {};
+
+/* Class method definitions ------------------------------------------- */
+TwoWire::TwoWire(uint8_t bus_num)
+    : _bus_num(bus_num), _frequency(I2C_DEFAULT_FREQUENCY), _timeOutMillis(50), _transmitting(false),
+      _txAddress(0), _txLength(0), _rxIndex(0), _rxLength(0)
+{
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency)
+{
+  if (frequency != 0)
+  {
+    _frequency = frequency;
+  }
+  return true;
+}
+
+bool TwoWire::begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency)
+{
+  // Slave mode is not modelled, the bus is still usable as a master
+  return begin(sda, scl, frequency);
+}
+
+bool TwoWire::end() { return true; }
+
+bool TwoWire::setClock(uint32_t frequency)
+{
+  if (frequency == 0)
+  {
+    return false;
+  }
+  _frequency = frequency;
+  return true;
+}
+
+uint32_t TwoWire::getClock() { return _frequency; }
+
+void TwoWire::beginTransmission(uint16_t address)
+{
+  _transmitting = true;
+  _txAddress    = address;
+  _txLength     = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+  if (!_transmitting)
+  {
+    return I2C_ERROR_OTHER;
+  }
+  _transmitting = false;
+
+  i2cStats.transactions++;
+  busTime(_txLength);
+
+  HalI2CDevice *device = halI2CGetDevice((uint8_t) _txAddress);
+  if (device == nullptr)
+  {
+    i2cStats.nacks++;
+    return I2C_ERROR_ADDRESS;
+  }
+  if (!device->onWrite(_txBuffer, _txLength))
+  {
+    i2cStats.nacks++;
+    return (_txLength == 0) ? I2C_ERROR_ADDRESS : I2C_ERROR_DATA;
+  }
+
+  i2cStats.bytesWritten += (uint32_t) _txLength;
+  return I2C_ERROR_OK;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop)
+{
+  _rxIndex  = 0;
+  _rxLength = 0;
+  if (size > I2C_BUFFER_LENGTH)
+  {
+    size = I2C_BUFFER_LENGTH;
+  }
+
+  i2cStats.transactions++;
+  busTime(size);
+
+  HalI2CDevice *device = halI2CGetDevice((uint8_t) address);
+  if (device == nullptr || size == 0)
+  {
+    i2cStats.nacks++;
+    return 0;
+  }
+
+  _rxLength = device->onRead(_rxBuffer, size);
+  if (_rxLength == 0)
+  {
+    i2cStats.nacks++;
+  }
+  i2cStats.bytesRead += (uint32_t) _rxLength;
+  return _rxLength;
+}
+
+uint8_t TwoWire::requestFrom(uint16_t address, uint8_t size, bool sendStop)
+{
+  return (uint8_t) requestFrom(address, (size_t) size, sendStop);
+}
+
+uint8_t TwoWire::requestFrom(uint16_t address, uint8_t size, uint8_t sendStop)
+{
+  return (uint8_t) requestFrom(address, (size_t) size, (bool) sendStop);
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t len, bool stopBit)
+{
+  return requestFrom((uint16_t) address, len, stopBit);
+}
+
+uint8_t TwoWire::requestFrom(uint16_t address, uint8_t size) { return requestFrom(address, size, true); }
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t size, uint8_t sendStop)
+{
+  return requestFrom((uint16_t) address, size, (bool) sendStop);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t size)
+{
+  return requestFrom((uint16_t) address, size, true);
+}
+
+uint8_t TwoWire::requestFrom(int address, int size, int sendStop)
+{
+  return (uint8_t) requestFrom((uint16_t) address, (size_t) size, (bool) sendStop);
+}
+
+uint8_t TwoWire::requestFrom(int address, int size) { return requestFrom(address, size, 1); }
+
+size_t TwoWire::write(uint8_t data)
+{
+  if (!_transmitting || _txLength >= I2C_BUFFER_LENGTH)
+  {
+    return 0;
+  }
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+  size_t count = 0;
+  while (count < quantity && write(data[count]) == 1)
+  {
+    count++;
+  }
+  return count;
+}
+
+int TwoWire::available(void) { return (int) (_rxLength - _rxIndex); }
+
+int TwoWire::read(void) { return (_rxIndex < _rxLength) ? _rxBuffer[_rxIndex++] : -1; }
+
+int TwoWire::peek(void) { return (_rxIndex < _rxLength) ? _rxBuffer[_rxIndex] : -1; }
+
+void TwoWire::flush(void)
+{
+  _rxIndex  = 0;
+  _rxLength = 0;
+  _txLength = 0;
+}
+
+/* Private definitions ------------------------------------------------ */
+void TwoWire::busTime(size_t bytes)
+{
+  // START + address byte + payload, each byte followed by its ACK bit
+  uint64_t us = ((uint64_t) (1 + bytes) * I2C_BITS_PER_BYTE * 1000000ULL + _frequency - 1) / _frequency;
+  i2cStats.busTimeUs += us;
+  halSimAdvanceMicros(us);
+}
+
+/* Function definitions ----------------------------------------------- */
+bool halI2CAttach(uint8_t address, HalI2CDevice *device)
+{
+  if (address >= HAL_I2C_MAX_DEVICES || device == nullptr || i2cDevices[address] != nullptr)
+  {
+    return false;
+  }
+  i2cDevices[address] = device;
+  return true;
+}
+
+void halI2CDetach(uint8_t address)
+{
+  if (address < HAL_I2C_MAX_DEVICES)
+  {
+    i2cDevices[address] = nullptr;
+  }
+}
+
+HalI2CDevice *halI2CGetDevice(uint8_t address)
+{
+  return (address < HAL_I2C_MAX_DEVICES) ? i2cDevices[address] : nullptr;
+}
+
+hal_i2c_stats_t halI2CGetStats() { return i2cStats; }
+
+void halI2CResetStats() { memset(&i2cStats, 0, sizeof(i2cStats)); }
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,107 @@
+/**
+ * @file       Wire.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 TwoWire class
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_WIRE_H
+  #define HAL_NATIVE_WIRE_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include "Arduino.h"
+  #include "Stream.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define I2C_BUFFER_LENGTH 128
+
+/* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief Result codes of `endTransmission()`, same values as the Arduino core.
+ */
+typedef enum
+{
+  I2C_ERROR_OK      = 0,
+  I2C_ERROR_LENGTH  = 1,
+  I2C_ERROR_ADDRESS = 2, /**< Address NACK */
+  I2C_ERROR_DATA    = 3, /**< Data NACK */
+  I2C_ERROR_OTHER   = 4,
+  I2C_ERROR_TIMEOUT = 5
+} i2c_err_t;
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief I2C master on the simulated bus. Transactions are routed to the `HalI2CDevice` attached at the
+ * address and the virtual clock advances by the time the frame takes at the configured bus speed.
+ *
+ * The overload set of `requestFrom()` matches the Arduino-ESP32 core so calls resolve the same way.
+ */
+class TwoWire : public Stream
+{
+public:
+  TwoWire(uint8_t bus_num);
+
+  bool begin(int sda, int scl, uint32_t frequency = 0);
+  bool begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency);
+  bool begin(uint8_t addr) { return begin(addr, -1, -1, 0); }
+  bool begin(int addr) { return begin((uint8_t) addr, -1, -1, 0); }
+  bool begin() { return begin(-1, -1, (uint32_t) 0); }
+  bool end();
+
+  bool     setClock(uint32_t frequency);
+  uint32_t getClock();
+  void     setTimeOut(uint16_t timeOutMillis) { _timeOutMillis = timeOutMillis; }
+  uint16_t getTimeOut() { return _timeOutMillis; }
+
+  void    beginTransmission(uint16_t address);
+  void    beginTransmission(uint8_t address) { beginTransmission((uint16_t) address); }
+  void    beginTransmission(int address) { beginTransmission((uint16_t) address); }
+  uint8_t endTransmission(bool sendStop);
+  uint8_t endTransmission(void) { return endTransmission(true); }
+
+  size_t  requestFrom(uint16_t address, size_t size, bool sendStop);
+  uint8_t requestFrom(uint16_t address, uint8_t size, bool sendStop);
+  uint8_t requestFrom(uint16_t address, uint8_t size, uint8_t sendStop);
+  size_t  requestFrom(uint8_t address, size_t len, bool stopBit);
+  uint8_t requestFrom(uint16_t address, uint8_t size);
+  uint8_t requestFrom(uint8_t address, uint8_t size, uint8_t sendStop);
+  uint8_t requestFrom(uint8_t address, uint8_t size);
+  uint8_t requestFrom(int address, int size, int sendStop);
+  uint8_t requestFrom(int address, int size);
+
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t *data, size_t quantity) override;
+  using Print::write;
+
+  int  available(void) override;
+  int  read(void) override;
+  int  peek(void) override;
+  void flush(void) override;
+
+private:
+  uint8_t  _bus_num;
+  uint32_t _frequency;
+  uint16_t _timeOutMillis;
+  bool     _transmitting;
+  uint16_t _txAddress;
+  uint8_t  _txBuffer[I2C_BUFFER_LENGTH];
+  size_t   _txLength;
+  uint8_t  _rxBuffer[I2C_BUFFER_LENGTH];
+  size_t   _rxIndex;
+  size_t   _rxLength;
+
+  void busTime(size_t bytes);
+};
+
+/* Public variables --------------------------------------------------- */
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // HAL_NATIVE_WIRE_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,40 @@
+/**
+ * @file       esp32-hal-ledc.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the Arduino-ESP32 LEDC (PWM) API
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_ESP32_HAL_LEDC_H
+  #define HAL_NATIVE_ESP32_HAL_LEDC_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stdint.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define LEDC_CHANNELS 16
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Configures a channel. Duty written to the channel is mirrored on every attached pin, so it can be
+ * read back with `halAnalogGetOutput()`.
+ *
+ * @return uint32_t The frequency set, `0` if the channel is invalid.
+ */
+uint32_t ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolution_bits);
+void     ledcWrite(uint8_t channel, uint32_t duty);
+uint32_t ledcRead(uint8_t channel);
+uint32_t ledcReadFreq(uint8_t channel);
+uint32_t ledcWriteTone(uint8_t channel, uint32_t freq);
+uint32_t ledcChangeFrequency(uint8_t channel, uint32_t freq, uint8_t resolution_bits);
+void     ledcAttachPin(uint8_t pin, uint8_t channel);
+void     ledcDetachPin(uint8_t pin);
+
+#endif // HAL_NATIVE_ESP32_HAL_LEDC_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,75 @@
+/**
+ * @file       FreeRTOS.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the FreeRTOS kernel header
+ *
+ * The native build runs on a single thread: there is one (main) task, the tick is 1 ms of virtual time and
+ * blocking calls let the virtual clock run until the condition holds, so scripted events can unblock them.
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_FREERTOS_H
+  #define HAL_NATIVE_FREERTOS_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <sched.h>
+  #include <stddef.h>
+  #include <stdint.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define configTICK_RATE_HZ       1000
+  #define configMAX_PRIORITIES     25
+  #define configMINIMAL_STACK_SIZE 768
+
+  #define pdFALSE                  ((BaseType_t) 0)
+  #define pdTRUE                   ((BaseType_t) 1)
+  #define pdPASS                   (pdTRUE)
+  #define pdFAIL                   (pdFALSE)
+  #define errQUEUE_EMPTY           ((BaseType_t) 0)
+  #define errQUEUE_FULL            ((BaseType_t) 0)
+
+  #define portMAX_DELAY            ((TickType_t) 0xffffffffUL)
+  #define portTICK_PERIOD_MS       ((TickType_t) 1000 / configTICK_RATE_HZ)
+  #define portTICK_RATE_MS         portTICK_PERIOD_MS
+  #define portNUM_PROCESSORS       1
+
+  #define tskNO_AFFINITY           0x7FFFFFFF
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef uint32_t     TickType_t;
+typedef int          BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t     StackType_t;
+
+/**
+ * @brief Spinlock placeholder, critical sections are no-ops on a single thread.
+ */
+typedef struct
+{
+  uint32_t owner;
+  uint32_t count;
+} portMUX_TYPE;
+
+/* Public macros ------------------------------------------------------ */
+  #define pdMS_TO_TICKS(xTimeInMs)     ((TickType_t) (((TickType_t) (xTimeInMs) * configTICK_RATE_HZ) / 1000U))
+  #define pdTICKS_TO_MS(xTicks)        ((TickType_t) (((TickType_t) (xTicks) * 1000U) / configTICK_RATE_HZ))
+
+  #define portMUX_INITIALIZER_UNLOCKED { 0, 0 }
+  #define portENTER_CRITICAL(mux)      ((void) (mux))
+  #define portEXIT_CRITICAL(mux)       ((void) (mux))
+  #define portENTER_CRITICAL_ISR(mux)  ((void) (mux))
+  #define portEXIT_CRITICAL_ISR(mux)   ((void) (mux))
+  #define taskENTER_CRITICAL(mux)      ((void) (mux))
+  #define taskEXIT_CRITICAL(mux)       ((void) (mux))
+  #define portYIELD_FROM_ISR(...)
+  #define portYIELD()                  sched_yield() // Only host tests running real threads notice it
+
+  #define configASSERT(x)              ((void) (x))
+
+#endif // HAL_NATIVE_FREERTOS_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,325 @@
+/**
+ * @file       freertos.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Single-task model of the FreeRTOS task, queue and semaphore APIs
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "../hal_native.h"
+
+#include <string.h>
+
+#include <deque>
+#include <vector>
+
+/* Private enumerate/structure ---------------------------------------- */
+struct tskTaskControlBlock
+{
+  uint32_t notifyValue;
+};
+
+/**
+ * @brief Queue storage. Semaphores are queues of zero-sized items, only the count matters.
+ */
+struct QueueDefinition
+{
+  UBaseType_t                       length;
+  UBaseType_t                       itemSize;
+  std::deque<std::vector<uint8_t> > items;
+  bool                              isMutex;
+  UBaseType_t                       recursion; /**< Nested takes of a recursive mutex */
+};
+
+/* Private variables -------------------------------------------------- */
+static tskTaskControlBlock mainTask = { 0 };
+
+/* Private function prototypes ---------------------------------------- */
+static BaseType_t queueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait,
+                            bool front);
+static BaseType_t queueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait, bool remove);
+
+/* Function definitions ----------------------------------------------- */
+/* Tasks -------------------------------------------------------------- */
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char *const pcName, const uint32_t usStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pvCreatedTask)
+{
+  return pdFAIL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *const pcName,
+                                   const uint32_t usStackDepth, void *const pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t *const pvCreatedTask,
+                                   const BaseType_t xCoreID)
+{
+  return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {}
+
+void vTaskDelay(const TickType_t xTicksToDelay) { halSimAdvance(xTicksToDelay); }
+
+BaseType_t xTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+  TickType_t wakeTime = *pxPreviousWakeTime + xTimeIncrement;
+  TickType_t now      = xTaskGetTickCount();
+  *pxPreviousWakeTime = wakeTime;
+
+  // Signed difference, same roll-over handling as the kernel
+  if ((int32_t) (wakeTime - now) <= 0)
+  {
+    return pdFALSE;
+  }
+  halSimAdvance(wakeTime - now);
+  return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+  xTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement);
+}
+
+TickType_t xTaskGetTickCount(void) { return (TickType_t) (halSimMicros() / 1000U); }
+
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return &mainTask; }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) { return configMINIMAL_STACK_SIZE; }
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  if (!halSimWait([task]() { return task->notifyValue != 0; }, xTicksToWait))
+  {
+    return 0;
+  }
+
+  uint32_t value    = task->notifyValue;
+  task->notifyValue = (xClearCountOnExit != pdFALSE) ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+  if (xTaskToNotify != nullptr)
+  {
+    xTaskToNotify->notifyValue++;
+  }
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  xTaskNotifyGive(xTaskToNotify);
+  if (pxHigherPriorityTaskWoken != nullptr)
+  {
+    *pxHigherPriorityTaskWoken = pdFALSE;
+  }
+}
+
+/* Queues ------------------------------------------------------------- */
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+  if (uxQueueLength == 0)
+  {
+    return nullptr;
+  }
+  QueueHandle_t queue = new QueueDefinition();
+  queue->length       = uxQueueLength;
+  queue->itemSize     = uxItemSize;
+  queue->isMutex      = false;
+  queue->recursion    = 0;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t xQueue) { delete xQueue; }
+
+BaseType_t xQueueReset(QueueHandle_t xQueue)
+{
+  xQueue->items.clear();
+  return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+  return queueSend(xQueue, pvItemToQueue, xTicksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+  return queueSend(xQueue, pvItemToQueue, xTicksToWait, true);
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t xQueue, const void *pvItemToQueue,
+                                   BaseType_t *pxHigherPriorityTaskWoken)
+{
+  if (pxHigherPriorityTaskWoken != nullptr)
+  {
+    *pxHigherPriorityTaskWoken = pdFALSE;
+  }
+  return queueSend(xQueue, pvItemToQueue, 0, false);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void *pvItemToQueue)
+{
+  xQueue->items.clear();
+  return queueSend(xQueue, pvItemToQueue, 0, false);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+  return queueReceive(xQueue, pvBuffer, xTicksToWait, true);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  if (pxHigherPriorityTaskWoken != nullptr)
+  {
+    *pxHigherPriorityTaskWoken = pdFALSE;
+  }
+  return queueReceive(xQueue, pvBuffer, 0, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+  return queueReceive(xQueue, pvBuffer, xTicksToWait, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) { return (UBaseType_t) xQueue->items.size(); }
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
+{
+  return xQueue->length - (UBaseType_t) xQueue->items.size();
+}
+
+/* Semaphores --------------------------------------------------------- */
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return xQueueCreate(1, 0); }
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer)
+{
+  return xSemaphoreCreateBinary();
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount)
+{
+  SemaphoreHandle_t semaphore = xQueueCreate(uxMaxCount, 0);
+  for (UBaseType_t i = 0; semaphore != nullptr && i < uxInitialCount && i < uxMaxCount; i++)
+  {
+    xSemaphoreGive(semaphore);
+  }
+  return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  // A mutex starts available
+  SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+  mutex->isMutex          = true;
+  xSemaphoreGive(mutex);
+  return mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) { return xSemaphoreCreateMutex(); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait)
+{
+  return queueReceive(xSemaphore, nullptr, xTicksToWait, true);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) { return queueSend(xSemaphore, nullptr, 0, false); }
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait)
+{
+  // There is only one task, so a held mutex is always held by the caller
+  if (xMutex->recursion > 0)
+  {
+    xMutex->recursion++;
+    return pdTRUE;
+  }
+  if (xSemaphoreTake(xMutex, xTicksToWait) != pdTRUE)
+  {
+    return pdFALSE;
+  }
+  xMutex->recursion = 1;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex)
+{
+  if (xMutex->recursion == 0)
+  {
+    return pdFALSE;
+  }
+  if (--xMutex->recursion == 0)
+  {
+    return xSemaphoreGive(xMutex);
+  }
+  return pdTRUE;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) { return uxQueueMessagesWaiting(xSemaphore); }
+
+/* Private definitions ------------------------------------------------ */
+static BaseType_t queueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait,
+                            bool front)
+{
+  if (xQueue == nullptr)
+  {
+    return errQUEUE_FULL;
+  }
+  if (!halSimWait([xQueue]() { return xQueue->items.size() < xQueue->length; }, xTicksToWait))
+  {
+    return errQUEUE_FULL;
+  }
+
+  const uint8_t       *src = (const uint8_t *) pvItemToQueue;
+  std::vector<uint8_t> item;
+  if (src != nullptr)
+  {
+    item.assign(src, src + xQueue->itemSize);
+  }
+
+  if (front)
+  {
+    xQueue->items.push_front(item);
+  }
+  else
+  {
+    xQueue->items.push_back(item);
+  }
+  return pdPASS;
+}
+
+static BaseType_t queueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait, bool remove)
+{
+  if (xQueue == nullptr)
+  {
+    return errQUEUE_EMPTY;
+  }
+  if (!halSimWait([xQueue]() { return !xQueue->items.empty(); }, xTicksToWait))
+  {
+    return errQUEUE_EMPTY;
+  }
+
+  if (pvBuffer != nullptr && xQueue->itemSize > 0)
+  {
+    memcpy(pvBuffer, xQueue->items.front().data(), xQueue->itemSize);
+  }
+  if (remove)
+  {
+    xQueue->items.pop_front();
+  }
+  return pdPASS;
+}
+
+/* End of file -------------------------------------------------------- */
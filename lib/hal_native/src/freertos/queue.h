@@ -0,0 +1,48 @@
+/**
+ * @file       queue.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the FreeRTOS queue API
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_FREERTOS_QUEUE_H
+  #define HAL_NATIVE_FREERTOS_QUEUE_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include "FreeRTOS.h"
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef struct QueueDefinition *QueueHandle_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define xQueueSend(xQueue, pvItemToQueue, xTicksToWait)                                                    \
+    xQueueSendToBack((xQueue), (pvItemToQueue), (xTicksToWait))
+  #define xQueueSendFromISR(xQueue, pvItemToQueue, pxHigherPriorityTaskWoken)                                 \
+    xQueueSendToBackFromISR((xQueue), (pvItemToQueue), (pxHigherPriorityTaskWoken))
+
+/* Function Declaration ----------------------------------------------- */
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+void          vQueueDelete(QueueHandle_t xQueue);
+BaseType_t    xQueueReset(QueueHandle_t xQueue);
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t xQueue, const void *pvItemToQueue,
+                                   BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void *pvItemToQueue);
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue);
+
+#endif // HAL_NATIVE_FREERTOS_QUEUE_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,51 @@
+/**
+ * @file       semphr.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the FreeRTOS semaphore API
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_FREERTOS_SEMPHR_H
+  #define HAL_NATIVE_FREERTOS_SEMPHR_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include "FreeRTOS.h"
+  #include "queue.h"
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef QueueHandle_t SemaphoreHandle_t;
+
+/**
+ * @brief Storage of a statically allocated semaphore. The host model allocates anyway, delete it when done.
+ */
+typedef struct
+{
+  uint8_t unused;
+} StaticSemaphore_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define xSemaphoreTakeFromISR(xSemaphore, pxHigherPriorityTaskWoken) xSemaphoreTake((xSemaphore), 0)
+  #define xSemaphoreGiveFromISR(xSemaphore, pxHigherPriorityTaskWoken) xSemaphoreGive((xSemaphore))
+  #define vSemaphoreDelete(xSemaphore)                                 vQueueDelete((xSemaphore))
+
+/* Function Declaration ----------------------------------------------- */
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+
+BaseType_t  xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+BaseType_t  xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+BaseType_t  xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait);
+BaseType_t  xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore);
+
+#endif // HAL_NATIVE_FREERTOS_SEMPHR_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,56 @@
+/**
+ * @file       task.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host replacement of the FreeRTOS task API
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_FREERTOS_TASK_H
+  #define HAL_NATIVE_FREERTOS_TASK_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include "FreeRTOS.h"
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef struct tskTaskControlBlock *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+/* Public macros ------------------------------------------------------ */
+  #define taskYIELD() portYIELD()
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Task creation is not supported on the host, the call fails so callers take their single-task
+ * fallback (e.g. `bspI2CEngineBegin()` runs transactions inline).
+ *
+ * @return BaseType_t Always `pdFAIL`.
+ */
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char *const pcName, const uint32_t usStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pvCreatedTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *const pcName,
+                                   const uint32_t usStackDepth, void *const pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t *const pvCreatedTask,
+                                   const BaseType_t xCoreID);
+void       vTaskDelete(TaskHandle_t xTaskToDelete);
+
+void       vTaskDelay(const TickType_t xTicksToDelay);
+BaseType_t xTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+void       vTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+
+uint32_t   ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void       vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif // HAL_NATIVE_FREERTOS_TASK_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,624 @@
+/**
+ * @file       hal_native.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Virtual clock, event scheduler and pin models of the host HAL
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "hal_native.h"
+#include "Arduino.h"
+
+#include <map>
+#include <vector>
+
+/* Private defines ---------------------------------------------------- */
+#define HAL_ADC_MAX_VALUE     ((1U << HAL_ADC_MAX_RESOLUTION) - 1)
+#define HAL_ADC_REF_MV        3300U
+#define HAL_PWM_DEFAULT_BITS  8
+#define HAL_WAIT_FOREVER      0xFFFFFFFFUL
+#define HAL_LEDC_NO_CHANNEL   -1
+
+/* Private enumerate/structure ---------------------------------------- */
+typedef struct
+{
+  uint32_t              id;
+  std::function<void()> callback;
+} hal_sim_event_t;
+
+typedef struct
+{
+  uint8_t mode;
+  uint8_t output;     /**< Level driven when configured as an output */
+  uint8_t input;      /**< Level applied by the script */
+  bool    driven;     /**< `input` was set by the script, otherwise the pull resistor decides */
+  int     isrMode;
+  void (*isr)(void);
+  void (*isrArg)(void *);
+  void    *arg;
+  uint16_t analogIn;
+  uint32_t analogOut;
+  uint32_t analogWrites;
+  int8_t   ledcChannel;
+} hal_pin_t;
+
+typedef struct
+{
+  uint32_t freq;
+  uint8_t  bits;
+  uint32_t duty;
+} hal_ledc_channel_t;
+
+/* Private variables -------------------------------------------------- */
+static uint64_t                                 simNowUs     = 0;
+static bool                                     simInAdvance = false;
+static uint32_t                                 simNextId    = 1;
+static std::multimap<uint64_t, hal_sim_event_t> simEvents;
+
+static hal_pin_t          pins[HAL_GPIO_PIN_COUNT];
+static hal_ledc_channel_t ledcChannels[LEDC_CHANNELS];
+static uint8_t            adcResolution = HAL_ADC_MAX_RESOLUTION;
+static uint8_t            pwmResolution = HAL_PWM_DEFAULT_BITS;
+
+// Continuous ADC model, one stream like the single DMA engine
+static bool                     adcStreamRunning     = false;
+static uint8_t                  adcStreamPin         = 0;
+static uint64_t                 adcStreamPeriodUs    = 0;
+static uint16_t                 adcStreamFrame       = 0;
+static hal_adc_frame_callback_t adcStreamCallback    = nullptr;
+static void                    *adcStreamArg         = nullptr;
+static uint32_t                 adcStreamEvent       = 0;
+static uint32_t                 adcStreamConversions = 0;
+static std::vector<uint16_t>    adcStreamSamples;
+
+/* Private function prototypes ---------------------------------------- */
+static void    halPinsReset();
+static uint8_t halPinLevel(uint8_t pin);
+static void    halPwmOutput(uint8_t pin, uint32_t duty);
+static void    halAdcConvert();
+
+/* Function definitions ----------------------------------------------- */
+/* Virtual clock ------------------------------------------------------ */
+uint64_t halSimMicros() { return simNowUs; }
+
+void halSimAdvanceMicros(uint64_t us)
+{
+  uint64_t target = simNowUs + us;
+
+  // An event callback that sleeps (or talks on a timed bus) only moves the clock, events keep firing in order
+  if (simInAdvance)
+  {
+    simNowUs = target;
+    return;
+  }
+
+  simInAdvance = true;
+  while (!simEvents.empty() && simEvents.begin()->first <= target)
+  {
+    std::multimap<uint64_t, hal_sim_event_t>::iterator next = simEvents.begin();
+    std::function<void()>                              cb   = next->second.callback;
+    if (next->first > simNowUs)
+    {
+      simNowUs = next->first;
+    }
+    simEvents.erase(next);
+    cb();
+  }
+  if (target > simNowUs)
+  {
+    simNowUs = target;
+  }
+  simInAdvance = false;
+}
+
+void halSimAdvance(uint32_t ms) { halSimAdvanceMicros((uint64_t) ms * 1000U); }
+
+uint32_t halSimSchedule(uint32_t atMs, std::function<void()> callback)
+{
+  hal_sim_event_t event = { simNextId++, callback };
+  simEvents.insert(std::make_pair((uint64_t) atMs * 1000U, event));
+  return event.id;
+}
+
+uint32_t halSimScheduleIn(uint64_t afterUs, std::function<void()> callback)
+{
+  hal_sim_event_t event = { simNextId++, callback };
+  simEvents.insert(std::make_pair(simNowUs + afterUs, event));
+  return event.id;
+}
+
+void halSimCancel(uint32_t id)
+{
+  for (std::multimap<uint64_t, hal_sim_event_t>::iterator it = simEvents.begin(); it != simEvents.end(); ++it)
+  {
+    if (it->second.id == id)
+    {
+      simEvents.erase(it);
+      return;
+    }
+  }
+}
+
+bool halSimHasPendingEvents() { return !simEvents.empty(); }
+
+bool halSimWait(const std::function<bool()> &ready, uint32_t timeoutTicks)
+{
+  uint32_t waited = 0;
+  while (!ready())
+  {
+    if (timeoutTicks == HAL_WAIT_FOREVER)
+    {
+      // Nothing left that could wake us up, waiting forever would hang the simulation
+      if (simEvents.empty())
+      {
+        return false;
+      }
+    }
+    else if (waited >= timeoutTicks)
+    {
+      return false;
+    }
+    halSimAdvance(1);
+    waited++;
+  }
+  return true;
+}
+
+void halSimReset()
+{
+  simNowUs  = 0;
+  simNextId = 1;
+  simEvents.clear();
+  adcStreamRunning     = false;
+  adcStreamConversions = 0;
+
+  halPinsReset();
+  for (uint8_t i = 0; i < LEDC_CHANNELS; i++)
+  {
+    ledcChannels[i].freq = 0;
+    ledcChannels[i].bits = 0;
+    ledcChannels[i].duty = 0;
+  }
+  adcResolution = HAL_ADC_MAX_RESOLUTION;
+  pwmResolution = HAL_PWM_DEFAULT_BITS;
+
+  Serial.end();
+  Serial0.end();
+  Serial1.end();
+  Serial2.end();
+  for (uint8_t i = 0; i < HAL_UART_COUNT; i++)
+  {
+    halUartTakeTx(i);
+  }
+  halI2CResetStats();
+}
+
+/* GPIO / ADC / PWM --------------------------------------------------- */
+void halGpioSetInput(uint8_t pin, uint8_t level)
+{
+  if (pin >= HAL_GPIO_PIN_COUNT)
+  {
+    return;
+  }
+
+  hal_pin_t &p        = pins[pin];
+  uint8_t    previous = halPinLevel(pin);
+  p.input             = (level != LOW) ? HIGH : LOW;
+  p.driven            = true;
+  uint8_t current     = halPinLevel(pin);
+
+  bool fire = false;
+  switch (p.isrMode)
+  {
+    case RISING:
+      fire = (previous == LOW && current == HIGH);
+      break;
+    case FALLING:
+      fire = (previous == HIGH && current == LOW);
+      break;
+    case CHANGE:
+      fire = (previous != current);
+      break;
+    case ONLOW:
+      fire = (current == LOW);
+      break;
+    case ONHIGH:
+      fire = (current == HIGH);
+      break;
+    default:
+      break;
+  }
+
+  if (fire && p.isr != nullptr)
+  {
+    p.isr();
+  }
+  else if (fire && p.isrArg != nullptr)
+  {
+    p.isrArg(p.arg);
+  }
+}
+
+uint8_t halGpioGetOutput(uint8_t pin) { return (pin < HAL_GPIO_PIN_COUNT) ? pins[pin].output : LOW; }
+
+uint8_t halGpioGetMode(uint8_t pin) { return (pin < HAL_GPIO_PIN_COUNT) ? pins[pin].mode : 0; }
+
+void halAnalogSetInput(uint8_t pin, uint16_t value)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].analogIn = (value > HAL_ADC_MAX_VALUE) ? HAL_ADC_MAX_VALUE : value;
+  }
+}
+
+uint32_t halAnalogGetOutput(uint8_t pin) { return (pin < HAL_GPIO_PIN_COUNT) ? pins[pin].analogOut : 0; }
+
+uint32_t halAnalogGetWriteCount(uint8_t pin)
+{
+  return (pin < HAL_GPIO_PIN_COUNT) ? pins[pin].analogWrites : 0;
+}
+
+bool halAdcContinuousStart(uint8_t pin, uint32_t sampleRateHz, uint16_t frameSamples,
+                           hal_adc_frame_callback_t callback, void *arg)
+{
+  if (adcStreamRunning || pin >= HAL_GPIO_PIN_COUNT || sampleRateHz == 0 || sampleRateHz > 1000000U ||
+      frameSamples == 0 || frameSamples > 1024 || callback == nullptr)
+  {
+    return false;
+  }
+
+  adcStreamRunning  = true;
+  adcStreamPin      = pin;
+  adcStreamPeriodUs = 1000000U / sampleRateHz;
+  adcStreamFrame    = frameSamples;
+  adcStreamCallback = callback;
+  adcStreamArg      = arg;
+  adcStreamSamples.clear();
+  adcStreamEvent = halSimScheduleIn(adcStreamPeriodUs, halAdcConvert);
+  return true;
+}
+
+void halAdcContinuousStop()
+{
+  if (adcStreamRunning)
+  {
+    halSimCancel(adcStreamEvent);
+    adcStreamRunning = false;
+  }
+}
+
+uint32_t halAdcContinuousGetConversions() { return adcStreamConversions; }
+
+/* Arduino core ------------------------------------------------------- */
+unsigned long millis() { return (unsigned long) (uint32_t) (simNowUs / 1000U); }
+
+unsigned long micros() { return (unsigned long) (uint32_t) simNowUs; }
+
+void delay(uint32_t ms) { halSimAdvance(ms); }
+
+void delayMicroseconds(uint32_t us) { halSimAdvanceMicros(us); }
+
+void yield() {}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].mode = mode;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].output = (val != LOW) ? HIGH : LOW;
+  }
+}
+
+int digitalRead(uint8_t pin) { return (pin < HAL_GPIO_PIN_COUNT) ? halPinLevel(pin) : LOW; }
+
+uint16_t analogRead(uint8_t pin)
+{
+  if (pin >= HAL_GPIO_PIN_COUNT)
+  {
+    return 0;
+  }
+  // Input is kept at full resolution, scale it to what the caller asked for
+  uint32_t raw = pins[pin].analogIn;
+  if (adcResolution < HAL_ADC_MAX_RESOLUTION)
+  {
+    return (uint16_t) (raw >> (HAL_ADC_MAX_RESOLUTION - adcResolution));
+  }
+  return (uint16_t) (raw << (adcResolution - HAL_ADC_MAX_RESOLUTION));
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin)
+{
+  return (pin < HAL_GPIO_PIN_COUNT) ? pins[pin].analogIn * HAL_ADC_REF_MV / HAL_ADC_MAX_VALUE : 0;
+}
+
+void analogReadResolution(uint8_t bits)
+{
+  if (bits >= 1 && bits <= 16)
+  {
+    adcResolution = bits;
+  }
+}
+
+void analogWrite(uint8_t pin, int value)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    halPwmOutput(pin, (value < 0) ? 0 : (uint32_t) value);
+  }
+}
+
+void analogWriteResolution(uint8_t bits)
+{
+  if (bits >= 1 && bits <= 16)
+  {
+    pwmResolution = bits;
+  }
+}
+
+void analogWriteFrequency(uint32_t freq) {}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].isr     = handler;
+    pins[pin].isrArg  = nullptr;
+    pins[pin].isrMode = mode;
+  }
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].isr     = nullptr;
+    pins[pin].isrArg  = handler;
+    pins[pin].arg     = arg;
+    pins[pin].isrMode = mode;
+  }
+}
+
+void detachInterrupt(uint8_t pin)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].isr     = nullptr;
+    pins[pin].isrArg  = nullptr;
+    pins[pin].isrMode = 0;
+  }
+}
+
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout)
+{
+  // Resolution is one tick, good enough for the scripted pulses this is used with
+  uint32_t timeoutMs = (uint32_t) (timeout / 1000U) + 1;
+  if (!halSimWait([pin, state]() { return digitalRead(pin) != state; }, timeoutMs) ||
+      !halSimWait([pin, state]() { return digitalRead(pin) == state; }, timeoutMs))
+  {
+    return 0;
+  }
+  uint64_t start = simNowUs;
+  if (!halSimWait([pin, state]() { return digitalRead(pin) != state; }, timeoutMs))
+  {
+    return 0;
+  }
+  return (unsigned long) (simNowUs - start);
+}
+
+unsigned long pulseInLong(uint8_t pin, uint8_t state, unsigned long timeout)
+{
+  return pulseIn(pin, state, timeout);
+}
+
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder)
+{
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < 8; ++i)
+  {
+    digitalWrite(clockPin, HIGH);
+    if (bitOrder == LSBFIRST)
+    {
+      value |= digitalRead(dataPin) << i;
+    }
+    else
+    {
+      value |= digitalRead(dataPin) << (7 - i);
+    }
+    digitalWrite(clockPin, LOW);
+  }
+  return value;
+}
+
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
+{
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    digitalWrite(dataPin, (bitOrder == LSBFIRST) ? !!(val & (1 << i)) : !!(val & (1 << (7 - i))));
+    digitalWrite(clockPin, HIGH);
+    digitalWrite(clockPin, LOW);
+  }
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    halPwmOutput(pin, frequency);
+  }
+}
+
+void noTone(uint8_t pin)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    halPwmOutput(pin, 0);
+  }
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  // Same guard as the Arduino-ESP32 core
+  const long run = in_max - in_min;
+  if (run == 0)
+  {
+    return -1;
+  }
+  const long rise = out_max - out_min;
+  const long delta = x - in_min;
+  return (delta * rise) / run + out_min;
+}
+
+long random(long howbig)
+{
+  if (howbig <= 0)
+  {
+    return 0;
+  }
+  return rand() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig)
+  {
+    return howsmall;
+  }
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0)
+  {
+    srand((unsigned int) seed);
+  }
+}
+
+/* LEDC --------------------------------------------------------------- */
+uint32_t ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolution_bits)
+{
+  if (channel >= LEDC_CHANNELS || resolution_bits == 0 || resolution_bits > 20)
+  {
+    return 0;
+  }
+  ledcChannels[channel].freq = freq;
+  ledcChannels[channel].bits = resolution_bits;
+  return freq;
+}
+
+void ledcWrite(uint8_t channel, uint32_t duty)
+{
+  if (channel >= LEDC_CHANNELS)
+  {
+    return;
+  }
+  ledcChannels[channel].duty = duty;
+  for (uint8_t pin = 0; pin < HAL_GPIO_PIN_COUNT; pin++)
+  {
+    if (pins[pin].ledcChannel == (int8_t) channel)
+    {
+      halPwmOutput(pin, duty);
+    }
+  }
+}
+
+uint32_t ledcRead(uint8_t channel) { return (channel < LEDC_CHANNELS) ? ledcChannels[channel].duty : 0; }
+
+uint32_t ledcReadFreq(uint8_t channel) { return (channel < LEDC_CHANNELS) ? ledcChannels[channel].freq : 0; }
+
+uint32_t ledcWriteTone(uint8_t channel, uint32_t freq)
+{
+  if (channel >= LEDC_CHANNELS)
+  {
+    return 0;
+  }
+  ledcChannels[channel].freq = freq;
+  ledcWrite(channel, (freq == 0) ? 0 : (1U << (ledcChannels[channel].bits - 1)));
+  return freq;
+}
+
+uint32_t ledcChangeFrequency(uint8_t channel, uint32_t freq, uint8_t resolution_bits)
+{
+  return ledcSetup(channel, freq, resolution_bits);
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel)
+{
+  if (pin < HAL_GPIO_PIN_COUNT && channel < LEDC_CHANNELS)
+  {
+    pins[pin].ledcChannel = (int8_t) channel;
+  }
+}
+
+void ledcDetachPin(uint8_t pin)
+{
+  if (pin < HAL_GPIO_PIN_COUNT)
+  {
+    pins[pin].ledcChannel = HAL_LEDC_NO_CHANNEL;
+  }
+}
+
+/* Private definitions ------------------------------------------------ */
+static void halPinsReset()
+{
+  for (uint8_t i = 0; i < HAL_GPIO_PIN_COUNT; i++)
+  {
+    pins[i]             = hal_pin_t();
+    pins[i].ledcChannel = HAL_LEDC_NO_CHANNEL;
+  }
+}
+
+static uint8_t halPinLevel(uint8_t pin)
+{
+  const hal_pin_t &p = pins[pin];
+  if (p.mode == OUTPUT)
+  {
+    return p.output;
+  }
+  if (p.driven)
+  {
+    return p.input;
+  }
+  // Floating input: the pull resistor sets the level
+  return ((p.mode & PULLUP) != 0) ? HIGH : LOW;
+}
+
+static void halPwmOutput(uint8_t pin, uint32_t duty)
+{
+  pins[pin].analogOut = duty;
+  pins[pin].analogWrites++;
+}
+
+static void halAdcConvert()
+{
+  // One conversion per event, the callback runs when a frame is full
+  adcStreamSamples.push_back(pins[adcStreamPin].analogIn);
+  adcStreamConversions++;
+  adcStreamEvent = halSimScheduleIn(adcStreamPeriodUs, halAdcConvert);
+
+  if (adcStreamSamples.size() >= adcStreamFrame)
+  {
+    std::vector<uint16_t> frame;
+    frame.swap(adcStreamSamples);
+    adcStreamCallback(frame.data(), frame.size(), adcStreamArg);
+  }
+}
+
+/* Static initialization ---------------------------------------------- */
+static struct HalNativeInit
+{
+  HalNativeInit() { halPinsReset(); }
+} halNativeInit;
+
+/* End of file -------------------------------------------------------- */
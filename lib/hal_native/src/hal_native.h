@@ -0,0 +1,315 @@
+/**
+ * @file       hal_native.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for HAL Native library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_NATIVE_H
+  #define HAL_NATIVE_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stddef.h>
+  #include <stdint.h>
+
+  #include <functional>
+  #include <string>
+
+  /* Public defines ----------------------------------------------------- */
+  #define HAL_NATIVE_LIB_VERSION  "0.1.0"
+
+  #define HAL_GPIO_PIN_COUNT      64
+  #define HAL_ADC_MAX_RESOLUTION  12
+  #define HAL_UART_COUNT          3
+  #define HAL_I2C_MAX_DEVICES     128
+
+/* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief Counters of the simulated I2C bus, used to compare driver traffic between revisions.
+ */
+typedef struct
+{
+  uint32_t transactions; /**< START ... STOP sequences, reads and writes */
+  uint32_t bytesWritten; /**< Payload bytes sent to devices */
+  uint32_t bytesRead;    /**< Payload bytes received from devices */
+  uint32_t nacks;        /**< Transactions not acknowledged by any device */
+  uint64_t busTimeUs;    /**< Virtual time spent on the wire */
+} hal_i2c_stats_t;
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief Interface of a device model attached to the simulated I2C bus.
+ *
+ * A model sees every transaction addressed to it. Writes arrive whole (after STOP), reads ask for the number
+ * of bytes the master requested.
+ */
+class HalI2CDevice
+{
+public:
+  virtual ~HalI2CDevice() {}
+
+  /**
+   * @brief Handles a write transaction.
+   *
+   * @param[in] data Bytes written by the master, may be empty for an address probe.
+   * @param[in] len  Number of bytes.
+   *
+   * @return bool `true` to ACK, `false` to NACK.
+   */
+  virtual bool onWrite(const uint8_t *data, size_t len) = 0;
+
+  /**
+   * @brief Handles a read transaction.
+   *
+   * @param[out] data Buffer to fill.
+   * @param[in]  len  Number of bytes requested.
+   *
+   * @return size_t Number of bytes provided, `0` to NACK.
+   */
+  virtual size_t onRead(uint8_t *data, size_t len) = 0;
+};
+
+/* Function Declaration ----------------------------------------------- */
+/* Virtual clock ------------------------------------------------------ */
+/**
+ * @brief Retrieves the virtual time. `millis()`, `micros()` and the FreeRTOS tick are derived from it.
+ *
+ * @return uint64_t Microseconds since the start of the simulation.
+ */
+uint64_t halSimMicros();
+
+/**
+ * @brief Advances the virtual time, firing every scheduled event and timer that falls due on the way.
+ *
+ * @param[in] us Microseconds to advance.
+ *
+ * @attention Event callbacks must not sleep (`delay()`, `vTaskDelay()`), nested advances only move the clock.
+ */
+void halSimAdvanceMicros(uint64_t us);
+
+/**
+ * @brief Advances the virtual time in milliseconds.
+ *
+ * @param[in] ms Milliseconds to advance.
+ */
+void halSimAdvance(uint32_t ms);
+
+/**
+ * @brief Schedules a script step at an absolute virtual time.
+ *
+ * @param[in] atMs     Virtual time in ms, a past time fires on the next advance.
+ * @param[in] callback Step to run, e.g. changing a GPIO level or a device model value.
+ *
+ * @return uint32_t Identifier of the event, usable with `halSimCancel()`.
+ */
+uint32_t halSimSchedule(uint32_t atMs, std::function<void()> callback);
+
+/**
+ * @brief Schedules a script step relative to the current virtual time.
+ *
+ * @param[in] afterUs  Delay in microseconds.
+ * @param[in] callback Step to run.
+ *
+ * @return uint32_t Identifier of the event.
+ */
+uint32_t halSimScheduleIn(uint64_t afterUs, std::function<void()> callback);
+
+/**
+ * @brief Cancels a scheduled event that has not fired yet.
+ *
+ * @param[in] id Identifier returned by `halSimSchedule()`.
+ */
+void halSimCancel(uint32_t id);
+
+/**
+ * @brief Checks if any scheduled event is still pending.
+ *
+ * @return bool `true` if at least one event will fire in the future.
+ */
+bool halSimHasPendingEvents();
+
+/**
+ * @brief Blocks the (single) caller on the virtual clock until a condition holds or a timeout elapses.
+ *
+ * Used by the FreeRTOS model to implement blocking calls: time advances in ticks so scripted events can
+ * satisfy the condition. With `portMAX_DELAY` it gives up once no event is left to wait for.
+ *
+ * @param[in] ready        Condition to wait for.
+ * @param[in] timeoutTicks Timeout in ticks (ms), `0xFFFFFFFF` for no timeout.
+ *
+ * @return bool `true` if the condition holds.
+ */
+bool halSimWait(const std::function<bool()> &ready, uint32_t timeoutTicks);
+
+/**
+ * @brief Resets the clock, the event queue and every pin, UART and bus counter.
+ */
+void halSimReset();
+
+/* GPIO / ADC / PWM --------------------------------------------------- */
+/**
+ * @brief Drives the external level seen by an input pin. Fires the attached interrupt on a matching edge.
+ *
+ * @param[in] pin   GPIO number.
+ * @param[in] level `LOW` or `HIGH`.
+ */
+void halGpioSetInput(uint8_t pin, uint8_t level);
+
+/**
+ * @brief Retrieves the level driven by an output pin.
+ *
+ * @param[in] pin GPIO number.
+ *
+ * @return uint8_t `LOW` or `HIGH`.
+ */
+uint8_t halGpioGetOutput(uint8_t pin);
+
+/**
+ * @brief Retrieves the last mode set with `pinMode()`.
+ *
+ * @param[in] pin GPIO number.
+ *
+ * @return uint8_t The mode, `0` if never configured.
+ */
+uint8_t halGpioGetMode(uint8_t pin);
+
+/**
+ * @brief Sets the voltage seen by an analog pin, as a raw count at the full ADC resolution.
+ *
+ * @param[in] pin   GPIO number.
+ * @param[in] value Raw count (0-4095).
+ */
+void halAnalogSetInput(uint8_t pin, uint16_t value);
+
+/**
+ * @brief Retrieves the last duty written with `analogWrite()` or `ledcWrite()`.
+ *
+ * @param[in] pin GPIO number.
+ *
+ * @return uint32_t The duty, in the resolution it was written with.
+ */
+uint32_t halAnalogGetOutput(uint8_t pin);
+
+/**
+ * @brief Retrieves the number of duty updates of a PWM pin, to check how often a driver touches it.
+ *
+ * @param[in] pin GPIO number.
+ *
+ * @return uint32_t Number of writes since the last reset.
+ */
+uint32_t halAnalogGetWriteCount(uint8_t pin);
+
+/**
+ * @brief Frame callback of the continuous ADC model, receives the raw counts of one DMA frame.
+ */
+typedef void (*hal_adc_frame_callback_t)(const uint16_t *samples, size_t count, void *arg);
+
+/**
+ * @brief Starts the continuous (DMA) ADC model on one pin.
+ *
+ * Every `1 / sampleRateHz` of virtual time the level set with `halAnalogSetInput()` is sampled at 12 bits.
+ * Once `frameSamples` conversions are collected the callback receives them, as the driver task does on the
+ * board. Only one conversion stream exists, as with the single ADC DMA engine.
+ *
+ * @attention The conversions are clock events: while the stream runs, a wait without timeout never ends.
+ *
+ * @param[in] pin          GPIO number.
+ * @param[in] sampleRateHz Conversions per second, 1 Hz to 1 MHz.
+ * @param[in] frameSamples Conversions per callback, 1 to 1024.
+ * @param[in] callback     Called with each frame.
+ * @param[in] arg          Passed to the callback.
+ *
+ * @return bool `false` on an invalid argument or when the stream already runs.
+ */
+bool halAdcContinuousStart(uint8_t pin, uint32_t sampleRateHz, uint16_t frameSamples,
+                           hal_adc_frame_callback_t callback, void *arg);
+
+/**
+ * @brief Stops the continuous ADC model, the partial frame is dropped.
+ */
+void halAdcContinuousStop();
+
+/**
+ * @brief Retrieves the number of conversions made by the continuous ADC model since the last reset.
+ *
+ * @return uint32_t Number of conversions.
+ */
+uint32_t halAdcContinuousGetConversions();
+
+/* UART --------------------------------------------------------------- */
+/**
+ * @brief Queues bytes for a UART to receive.
+ *
+ * @param[in] uart_nr UART number (0-2).
+ * @param[in] data    Bytes to inject.
+ * @param[in] len     Number of bytes.
+ */
+void halUartInject(uint8_t uart_nr, const uint8_t *data, size_t len);
+
+/**
+ * @brief Retrieves and clears everything transmitted by a UART.
+ *
+ * @param[in] uart_nr UART number (0-2).
+ *
+ * @return std::string The transmitted bytes.
+ */
+std::string halUartTakeTx(uint8_t uart_nr);
+
+/**
+ * @brief Chooses whether UART0 and `Serial` output is echoed to stdout (default) or only captured.
+ *
+ * @param[in] enable `true` to echo.
+ */
+void halUartEchoConsole(bool enable);
+
+/* I2C ---------------------------------------------------------------- */
+/**
+ * @brief Attaches a device model to the simulated bus.
+ *
+ * @param[in] address 7-bit address.
+ * @param[in] device  The model, must outlive the attachment.
+ *
+ * @return bool `false` if the address is invalid or already taken.
+ */
+bool halI2CAttach(uint8_t address, HalI2CDevice *device);
+
+/**
+ * @brief Detaches the device model at an address, later transactions are NACKed.
+ *
+ * @param[in] address 7-bit address.
+ */
+void halI2CDetach(uint8_t address);
+
+/**
+ * @brief Retrieves the device model at an address.
+ *
+ * @param[in] address 7-bit address.
+ *
+ * @return HalI2CDevice* The model, `nullptr` if none.
+ */
+HalI2CDevice *halI2CGetDevice(uint8_t address);
+
+/**
+ * @brief Retrieves the bus counters.
+ *
+ * @return hal_i2c_stats_t Counters since the last reset.
+ */
+hal_i2c_stats_t halI2CGetStats();
+
+/**
+ * @brief Clears the bus counters.
+ */
+void halI2CResetStats();
+
+#endif // HAL_NATIVE_H
+
+/* End of file -------------------------------------------------------- */
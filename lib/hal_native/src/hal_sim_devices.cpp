@@ -0,0 +1,467 @@
+/**
+ * @file       hal_sim_devices.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      I2C device models of the board peripherals for the host HAL
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "hal_sim_devices.h"
+
+#include <string.h>
+
+/* Private defines ---------------------------------------------------- */
+#define SHT4X_TICKS_MAX        65535.0f
+#define SHT4X_RESPONSE_LEN     6
+
+#define BMP280_CHIP_ID         0x58
+#define BMP280_REG_CALIB       0x88
+#define BMP280_REG_CHIPID      0xD0
+#define BMP280_REG_RESET       0xE0
+#define BMP280_REG_STATUS      0xF3
+#define BMP280_REG_CTRL_MEAS   0xF4
+#define BMP280_REG_CONFIG      0xF5
+#define BMP280_REG_PRESS_MSB   0xF7
+#define BMP280_RESET_CODE      0xB6
+#define BMP280_ADC_MAX         0xFFFFF
+
+#define PCF8574_RS             0x01
+#define PCF8574_EN             0x04
+#define PCF8574_BACKLIGHT      0x08
+
+#define HD44780_LINE_LEN       40
+#define HD44780_LINE2_ADDR     0x40
+
+/* Private variables -------------------------------------------------- */
+// Datasheet compensation example: adc_T = 519888 gives 25.08 °C, adc_P = 415148 gives 100653 Pa
+static const uint16_t bmp280Calib[12] = { 27504, 26435, (uint16_t) -1000, 36477, (uint16_t) -10685, 3024,
+                                          2855,  140,   (uint16_t) -7,    15500, (uint16_t) -14600, 6000 };
+
+/* Class method definitions ------------------------------------------- */
+/* SimSHT4X ----------------------------------------------------------- */
+SimSHT4X::SimSHT4X() : _readyAtUs(0), _responseLen(0), _measurements(0)
+{
+  setTemperature(25.0f);
+  setHumidity(50.0f);
+}
+
+bool SimSHT4X::onWrite(const uint8_t *data, size_t len)
+{
+  // The sensor does not acknowledge anything while a conversion is running
+  if (halSimMicros() < _readyAtUs)
+  {
+    return false;
+  }
+  if (len == 0)
+  {
+    return true;
+  }
+  // Commands are a single byte, anything sent after one is not acknowledged
+  if (len > 1)
+  {
+    return false;
+  }
+
+  uint32_t durationUs = 0;
+  switch (data[0])
+  {
+    case 0xFD: // High precision
+      durationUs = 8300;
+      break;
+    case 0xF6: // Medium precision
+      durationUs = 4500;
+      break;
+    case 0xE0: // Low precision
+      durationUs = 1600;
+      break;
+    case 0x39: // Heater for 1 s
+    case 0x2F:
+    case 0x1E:
+      durationUs = 1100000;
+      break;
+    case 0x32: // Heater for 0.1 s
+    case 0x24:
+    case 0x15:
+      durationUs = 110000;
+      break;
+    case 0x89: // Serial number
+    {
+      const uint8_t serial[4] = { 0x0F, 0x6A, 0x2B, 0x11 };
+      _response[0]            = serial[0];
+      _response[1]            = serial[1];
+      _response[2]            = crc8(serial, 2);
+      _response[3]            = serial[2];
+      _response[4]            = serial[3];
+      _response[5]            = crc8(serial + 2, 2);
+      _responseLen            = SHT4X_RESPONSE_LEN;
+      _readyAtUs              = halSimMicros() + 1000;
+      return true;
+    }
+    case 0x94: // Soft reset
+      _responseLen = 0;
+      _readyAtUs   = halSimMicros() + 1000;
+      return true;
+    default:
+      return false;
+  }
+
+  _response[0] = (uint8_t) (_tTicks >> 8);
+  _response[1] = (uint8_t) _tTicks;
+  _response[2] = crc8(_response, 2);
+  _response[3] = (uint8_t) (_rhTicks >> 8);
+  _response[4] = (uint8_t) _rhTicks;
+  _response[5] = crc8(_response + 3, 2);
+  _responseLen = SHT4X_RESPONSE_LEN;
+  _readyAtUs   = halSimMicros() + durationUs;
+  _measurements++;
+  return true;
+}
+
+size_t SimSHT4X::onRead(uint8_t *data, size_t len)
+{
+  if (halSimMicros() < _readyAtUs || _responseLen == 0)
+  {
+    return 0;
+  }
+
+  size_t count = (len < _responseLen) ? len : _responseLen;
+  memcpy(data, _response, count);
+  _responseLen = 0;
+  return count;
+}
+
+void SimSHT4X::setTemperature(float celsius)
+{
+  float ticks = (celsius + 45.0f) * SHT4X_TICKS_MAX / 175.0f + 0.5f;
+  _tTicks     = (ticks <= 0.0f) ? 0 : (ticks >= SHT4X_TICKS_MAX) ? 0xFFFF : (uint16_t) ticks;
+}
+
+void SimSHT4X::setHumidity(float percent)
+{
+  float ticks = (percent + 6.0f) * SHT4X_TICKS_MAX / 125.0f + 0.5f;
+  _rhTicks    = (ticks <= 0.0f) ? 0 : (ticks >= SHT4X_TICKS_MAX) ? 0xFFFF : (uint16_t) ticks;
+}
+
+uint8_t SimSHT4X::crc8(const uint8_t *data, size_t len)
+{
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x31) : (uint8_t) (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/* SimBMP280 ---------------------------------------------------------- */
+SimBMP280::SimBMP280() : _pointer(0)
+{
+  resetRegisters();
+  setRaw(519888, 415148);
+}
+
+bool SimBMP280::onWrite(const uint8_t *data, size_t len)
+{
+  if (len == 0)
+  {
+    return true;
+  }
+
+  // A lone byte sets the read pointer, longer writes are (register, value) pairs
+  _pointer = data[0];
+  for (size_t i = 0; i + 1 < len; i += 2)
+  {
+    uint8_t reg   = data[i];
+    uint8_t value = data[i + 1];
+    if (reg == BMP280_REG_RESET && value == BMP280_RESET_CODE)
+    {
+      resetRegisters();
+    }
+    else if (reg == BMP280_REG_CTRL_MEAS || reg == BMP280_REG_CONFIG)
+    {
+      _regs[reg] = value;
+    }
+  }
+  return true;
+}
+
+size_t SimBMP280::onRead(uint8_t *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    data[i] = _regs[_pointer++];
+  }
+  return len;
+}
+
+void SimBMP280::setRaw(int32_t adcT, int32_t adcP)
+{
+  _adcT = adcT & BMP280_ADC_MAX;
+  _adcP = adcP & BMP280_ADC_MAX;
+
+  // 20-bit values, MSB first and left-aligned in the XLSB register
+  _regs[BMP280_REG_PRESS_MSB + 0] = (uint8_t) (_adcP >> 12);
+  _regs[BMP280_REG_PRESS_MSB + 1] = (uint8_t) (_adcP >> 4);
+  _regs[BMP280_REG_PRESS_MSB + 2] = (uint8_t) ((_adcP & 0x0F) << 4);
+  _regs[BMP280_REG_PRESS_MSB + 3] = (uint8_t) (_adcT >> 12);
+  _regs[BMP280_REG_PRESS_MSB + 4] = (uint8_t) (_adcT >> 4);
+  _regs[BMP280_REG_PRESS_MSB + 5] = (uint8_t) ((_adcT & 0x0F) << 4);
+}
+
+void SimBMP280::setTemperature(float celsius)
+{
+  // Temperature rises with adc_T, binary search the raw value
+  int32_t target = (int32_t) (celsius * 100.0f + (celsius < 0 ? -0.5f : 0.5f));
+  int32_t low = 0, high = BMP280_ADC_MAX, tFine;
+  while (low < high)
+  {
+    int32_t mid = low + (high - low) / 2;
+    if (compensateT(mid, tFine) < target)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  setRaw(low, _adcP);
+}
+
+void SimBMP280::setPressure(float pascal)
+{
+  // Pressure falls as adc_P rises, binary search the raw value
+  int32_t tFine;
+  compensateT(_adcT, tFine);
+
+  int64_t target = (int64_t) ((pascal + 0.5f) * 256.0f);
+  int32_t low = 0, high = BMP280_ADC_MAX;
+  while (low < high)
+  {
+    int32_t mid = low + (high - low) / 2;
+    if (compensateP(mid, tFine) > target)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  setRaw(_adcT, low);
+}
+
+/* Private definitions ------------------------------------------------ */
+void SimBMP280::resetRegisters()
+{
+  memset(_regs, 0, sizeof(_regs));
+  for (uint8_t i = 0; i < 12; i++)
+  {
+    _regs[BMP280_REG_CALIB + 2 * i]     = (uint8_t) bmp280Calib[i];
+    _regs[BMP280_REG_CALIB + 2 * i + 1] = (uint8_t) (bmp280Calib[i] >> 8);
+  }
+  _regs[BMP280_REG_CHIPID] = BMP280_CHIP_ID;
+  _regs[BMP280_REG_STATUS] = 0x00;
+}
+
+int32_t SimBMP280::compensateT(int32_t adcT, int32_t &tFine) const
+{
+  // Datasheet section 3.11.3, result in 0.01 °C
+  int32_t t1 = (uint16_t) calib(0x88), t2 = calib(0x8A), t3 = calib(0x8C);
+  int32_t var1 = ((((adcT >> 3) - (t1 << 1))) * t2) >> 11;
+  int32_t var2 = (((((adcT >> 4) - t1) * ((adcT >> 4) - t1)) >> 12) * t3) >> 14;
+  tFine        = var1 + var2;
+  return (tFine * 5 + 128) >> 8;
+}
+
+int64_t SimBMP280::compensateP(int32_t adcP, int32_t tFine) const
+{
+  // Datasheet section 3.11.3, result in Pa as Q24.8
+  int64_t p1 = (uint16_t) calib(0x8E), p2 = calib(0x90), p3 = calib(0x92), p4 = calib(0x94);
+  int64_t p5 = calib(0x96), p6 = calib(0x98), p7 = calib(0x9A), p8 = calib(0x9C), p9 = calib(0x9E);
+
+  int64_t var1 = (int64_t) tFine - 128000;
+  int64_t var2 = var1 * var1 * p6;
+  var2         = var2 + ((var1 * p5) << 17);
+  var2         = var2 + (p4 << 35);
+  var1         = ((var1 * var1 * p3) >> 8) + ((var1 * p2) << 12);
+  var1         = ((((int64_t) 1) << 47) + var1) * p1 >> 33;
+  if (var1 == 0)
+  {
+    return 0;
+  }
+  int64_t p = 1048576 - adcP;
+  p         = (((p << 31) - var2) * 3125) / var1;
+  var1      = (p9 * (p >> 13) * (p >> 13)) >> 25;
+  var2      = (p8 * p) >> 19;
+  return ((p + var1 + var2) >> 8) + (p7 << 4);
+}
+
+/* SimLCD1602 --------------------------------------------------------- */
+SimLCD1602::SimLCD1602()
+    : _port(0), _fourBit(false), _highNibble(true), _latched(0), _address(0), _cgramSelected(false),
+      _increment(true), _displayOn(false), _backlight(false), _shift(0)
+{
+  memset(_ddram, ' ', sizeof(_ddram));
+  memset(_cgram, 0, sizeof(_cgram));
+  resetCounters();
+}
+
+bool SimLCD1602::onWrite(const uint8_t *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    uint8_t value = data[i];
+    _expanderWrites++;
+
+    // The HD44780 samples the data lines on the falling edge of EN
+    if ((_port & PCF8574_EN) && !(value & PCF8574_EN))
+    {
+      latchNibble((uint8_t) (value >> 4), (value & PCF8574_RS) != 0);
+    }
+    _port      = value;
+    _backlight = (value & PCF8574_BACKLIGHT) != 0;
+  }
+  return true;
+}
+
+size_t SimLCD1602::onRead(uint8_t *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    data[i] = _port;
+  }
+  return len;
+}
+
+std::string SimLCD1602::getLine(uint8_t row) const
+{
+  std::string line;
+  uint8_t     base = (row == 0) ? 0 : HD44780_LINE2_ADDR;
+  for (uint8_t col = 0; col < SIM_LCD1602_COLUMNS; col++)
+  {
+    line += (char) _ddram[base + (col + _shift) % HD44780_LINE_LEN];
+  }
+  return line;
+}
+
+void SimLCD1602::resetCounters()
+{
+  _commands       = 0;
+  _dataWrites     = 0;
+  _expanderWrites = 0;
+}
+
+void SimLCD1602::latchNibble(uint8_t nibble, bool rs)
+{
+  // Before the 4-bit function set, each strobe is a whole 8-bit instruction with D3-D0 unconnected
+  if (!_fourBit)
+  {
+    execute((uint8_t) (nibble << 4), rs);
+    return;
+  }
+
+  if (_highNibble)
+  {
+    _latched    = (uint8_t) (nibble << 4);
+    _highNibble = false;
+    return;
+  }
+  _highNibble = true;
+  execute((uint8_t) (_latched | nibble), rs);
+}
+
+void SimLCD1602::execute(uint8_t value, bool rs)
+{
+  if (!rs)
+  {
+    _commands++;
+    command(value);
+    return;
+  }
+
+  _dataWrites++;
+  if (_cgramSelected)
+  {
+    _cgram[_address & (SIM_LCD1602_CGRAM_LEN - 1)] = value;
+    _address = (uint8_t) ((_address + (_increment ? 1 : -1)) & (SIM_LCD1602_CGRAM_LEN - 1));
+    return;
+  }
+
+  _ddram[_address & (SIM_LCD1602_DDRAM_LEN - 1)] = value;
+  if (_increment)
+  {
+    _address++;
+    _address = (_address == HD44780_LINE_LEN) ? HD44780_LINE2_ADDR
+             : (_address == HD44780_LINE2_ADDR + HD44780_LINE_LEN) ? 0
+                                                                      : _address;
+  }
+  else
+  {
+    _address = (_address == 0)                   ? HD44780_LINE2_ADDR + HD44780_LINE_LEN - 1
+             : (_address == HD44780_LINE2_ADDR) ? HD44780_LINE_LEN - 1
+                                                 : _address - 1;
+  }
+}
+
+void SimLCD1602::command(uint8_t cmd)
+{
+  if (cmd & 0x80) // Set DDRAM address
+  {
+    _address       = cmd & 0x7F;
+    _cgramSelected = false;
+  }
+  else if (cmd & 0x40) // Set CGRAM address
+  {
+    _address       = cmd & 0x3F;
+    _cgramSelected = true;
+  }
+  else if (cmd & 0x20) // Function set
+  {
+    bool fourBit = (cmd & 0x10) == 0;
+    if (fourBit && !_fourBit)
+    {
+      _highNibble = true;
+    }
+    _fourBit = fourBit;
+  }
+  else if (cmd & 0x10) // Cursor or display shift
+  {
+    if (cmd & 0x08)
+    {
+      _shift = (cmd & 0x04) ? (uint8_t) ((_shift + HD44780_LINE_LEN - 1) % HD44780_LINE_LEN)
+                            : (uint8_t) ((_shift + 1) % HD44780_LINE_LEN);
+    }
+  }
+  else if (cmd & 0x08) // Display on/off control
+  {
+    _displayOn = (cmd & 0x04) != 0;
+  }
+  else if (cmd & 0x04) // Entry mode set
+  {
+    _increment = (cmd & 0x02) != 0;
+  }
+  else if (cmd & 0x02) // Return home
+  {
+    _address       = 0;
+    _shift         = 0;
+    _cgramSelected = false;
+  }
+  else if (cmd & 0x01) // Clear display
+  {
+    memset(_ddram, ' ', sizeof(_ddram));
+    _address       = 0;
+    _shift         = 0;
+    _increment     = true;
+    _cgramSelected = false;
+  }
+}
+
+/* End of file -------------------------------------------------------- */
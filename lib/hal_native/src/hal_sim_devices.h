@@ -0,0 +1,199 @@
+/**
+ * @file       hal_sim_devices.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      I2C device models of the board peripherals for the host HAL
+ *
+ * Each model follows the datasheet protocol closely enough for the unmodified drivers in lib/ to talk to
+ * it: command timing, register auto-increment, CRCs and the HD44780 4-bit interface behind a PCF8574.
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef HAL_SIM_DEVICES_H
+  #define HAL_SIM_DEVICES_H
+
+  /* Includes ----------------------------------------------------------- */
+  #include <stddef.h>
+  #include <stdint.h>
+
+  #include <string>
+
+  #include "hal_native.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define SIM_SHT4X_I2C_ADDR    0x44
+  #define SIM_BMP280_I2C_ADDR   0x76
+  #define SIM_LCD1602_I2C_ADDR  0x21
+
+  #define SIM_LCD1602_COLUMNS   16
+  #define SIM_LCD1602_ROWS      2
+  #define SIM_LCD1602_DDRAM_LEN 0x80
+  #define SIM_LCD1602_CGRAM_LEN 64
+
+/* Class Declaration -------------------------------------------------- */
+/**
+ * @brief SHT4x humidity and temperature sensor.
+ *
+ * A measurement command starts a conversion that lasts the datasheet maximum for the selected precision or
+ * heater mode. Reading before it completes is NACKed, like the real part, and so is a command followed by
+ * data bytes.
+ */
+class SimSHT4X : public HalI2CDevice
+{
+public:
+  SimSHT4X();
+
+  bool   onWrite(const uint8_t *data, size_t len) override;
+  size_t onRead(uint8_t *data, size_t len) override;
+
+  /**
+   * @brief Sets the temperature returned by the next measurement.
+   *
+   * @param[in] celsius Temperature in °C (-45 to 130).
+   */
+  void setTemperature(float celsius);
+
+  /**
+   * @brief Sets the relative humidity returned by the next measurement.
+   *
+   * @param[in] percent Relative humidity in %RH.
+   */
+  void setHumidity(float percent);
+
+  /**
+   * @brief Retrieves the number of measurements started since creation.
+   */
+  uint32_t getMeasurementCount() const { return _measurements; }
+
+  /**
+   * @brief CRC-8 of the SHT4x (polynomial 0x31, init 0xFF).
+   */
+  static uint8_t crc8(const uint8_t *data, size_t len);
+
+private:
+  uint16_t _tTicks;
+  uint16_t _rhTicks;
+  uint64_t _readyAtUs;
+  uint8_t  _response[6];
+  size_t   _responseLen;
+  uint32_t _measurements;
+};
+
+/**
+ * @brief BMP280 pressure and temperature sensor.
+ *
+ * Register file with auto-incrementing reads and writes, chip ID 0x58 and the calibration values of the
+ * datasheet compensation example (section 8.1).
+ */
+class SimBMP280 : public HalI2CDevice
+{
+public:
+  SimBMP280();
+
+  bool   onWrite(const uint8_t *data, size_t len) override;
+  size_t onRead(uint8_t *data, size_t len) override;
+
+  /**
+   * @brief Sets the raw 20-bit ADC outputs.
+   *
+   * @param[in] adcT Temperature ADC output.
+   * @param[in] adcP Pressure ADC output.
+   */
+  void setRaw(int32_t adcT, int32_t adcP);
+
+  /**
+   * @brief Sets the raw temperature that compensates to the given value.
+   *
+   * @param[in] celsius Temperature in °C.
+   */
+  void setTemperature(float celsius);
+
+  /**
+   * @brief Sets the raw pressure that compensates to the given value at the current temperature.
+   *
+   * @param[in] pascal Pressure in Pa.
+   */
+  void setPressure(float pascal);
+
+  /**
+   * @brief Retrieves the value of a register.
+   */
+  uint8_t getRegister(uint8_t reg) const { return _regs[reg]; }
+
+private:
+  uint8_t _regs[256];
+  uint8_t _pointer;
+  int32_t _adcT;
+  int32_t _adcP;
+
+  void    resetRegisters();
+  int32_t compensateT(int32_t adcT, int32_t &tFine) const;
+  int64_t compensateP(int32_t adcP, int32_t tFine) const;
+  int16_t calib(uint8_t reg) const { return (int16_t) (_regs[reg] | (_regs[reg + 1] << 8)); }
+};
+
+/**
+ * @brief 16x2 character LCD (HD44780) behind a PCF8574 I2C expander.
+ *
+ * The expander byte is decoded as RS/RW/EN/backlight on P0-P3 and D4-D7 on P4-P7. Nibbles are latched on
+ * the falling edge of EN, so the display content follows exactly what a real module would show.
+ */
+class SimLCD1602 : public HalI2CDevice
+{
+public:
+  SimLCD1602();
+
+  bool   onWrite(const uint8_t *data, size_t len) override;
+  size_t onRead(uint8_t *data, size_t len) override;
+
+  /**
+   * @brief Retrieves the visible characters of a row, custom characters shown as their code (0-7).
+   *
+   * @param[in] row Row index.
+   *
+   * @return std::string The 16 characters of the row.
+   */
+  std::string getLine(uint8_t row) const;
+
+  bool isBacklightOn() const { return _backlight; }
+  bool isDisplayOn() const { return _displayOn; }
+
+  /**
+   * @brief Retrieves the 8 rows of a custom character.
+   */
+  const uint8_t *getCustomChar(uint8_t location) const { return &_cgram[(location & 0x07) * 8]; }
+
+  uint32_t getCommandCount() const { return _commands; }
+  uint32_t getDataCount() const { return _dataWrites; }
+  uint32_t getExpanderWrites() const { return _expanderWrites; }
+
+  void resetCounters();
+
+private:
+  uint8_t  _ddram[SIM_LCD1602_DDRAM_LEN];
+  uint8_t  _cgram[SIM_LCD1602_CGRAM_LEN];
+  uint8_t  _port;
+  bool     _fourBit;
+  bool     _highNibble;
+  uint8_t  _latched;
+  uint8_t  _address;
+  bool     _cgramSelected;
+  bool     _increment;
+  bool     _displayOn;
+  bool     _backlight;
+  uint8_t  _shift;
+  uint32_t _commands;
+  uint32_t _dataWrites;
+  uint32_t _expanderWrites;
+
+  void latchNibble(uint8_t nibble, bool rs);
+  void execute(uint8_t value, bool rs);
+  void command(uint8_t cmd);
+};
+
+#endif // HAL_SIM_DEVICES_H
+
+/* End of file -------------------------------------------------------- */
@@ -1,6 +1,10 @@
 #include "lcd_16x2.h"
+#include "bsp_i2c.h"
 
 #include <lcd_16x2_constants.h>
+#include <string.h>
+
+static const uint8_t row_offsets[] = {0x00, 0x40, 0x14, 0x54};
 
 /**
  * @brief function begin
@@ -11,6 +15,18 @@ void LCD_I2C::begin(TwoWire *wire)
 {
   _wire = wire;
 
+  memset(_frame, ' ', sizeof(_frame));
+  _frameColumn = 0;
+  _frameRow    = 0;
+
+  // CGRAM content is random after power on
+  _cgramKnown = 0;
+  for (uint8_t slot = 0; slot < LCD_CGRAM_SLOTS; slot++)
+  {
+    _slotSet[slot] = nullptr;
+    _slotUse[slot] = 0;
+  }
+
   // Clear i2c adapter
   I2C_Write(0b00000000);
   // Wait more than 40 ms after powerOn
@@ -42,15 +58,20 @@ void LCD_I2C::backlightOff()
 
 /**
  * @brief Clears the LCD screen and positions the cursor in the upper-left corner.
+ *  When buffered, only the framebuffer is cleared, the display keeps its content until flush().
  *
  */
 void LCD_I2C::clear()
 {
-  _output.rs = 0;
-  _output.rw = 0;
+  if (_buffered)
+  {
+    memset(_frame, ' ', sizeof(_frame));
+    _frameColumn = 0;
+    _frameRow    = 0;
+    return;
+  }
 
-  LCD_Write(HD44780_CLEAR_DISPLAY);
-  delayMicroseconds(1550);
+  clearDisplay();
 }
 
 /**
@@ -61,11 +82,22 @@ void LCD_I2C::clear()
  */
 void LCD_I2C::home()
 {
+  if (_buffered)
+  {
+    _frameColumn = 0;
+    _frameRow    = 0;
+    return;
+  }
+
   _output.rs = 0;
   _output.rw = 0;
 
   LCD_Write(HD44780_CURSOR_HOME);
   delayMicroseconds(1550);
+
+  // Home also undoes a display shift
+  _ddramAddress = 0;
+  _addressKnown = true;
 }
 
 /**
@@ -100,6 +132,9 @@ void LCD_I2C::rightToLeft()
 
   LCD_Write(HD44780_ENTRY_MODE_SET | _entryState);
   delayMicroseconds(37);
+
+  // The framebuffer only tracks left-to-right writes
+  invalidate();
 }
 
 /**
@@ -119,6 +154,9 @@ void LCD_I2C::autoscroll()
 
   LCD_Write(HD44780_ENTRY_MODE_SET | _entryState);
   delayMicroseconds(37);
+
+  // The framebuffer only tracks writes without display shift
+  invalidate();
 }
 
 /**
@@ -240,6 +278,8 @@ void LCD_I2C::scrollDisplayLeft()
 
   LCD_Write(0b00011000);
   delayMicroseconds(37);
+
+  invalidate();
 }
 
 /**
@@ -253,6 +293,8 @@ void LCD_I2C::scrollDisplayRight()
 
   LCD_Write(0b00011100);
   delayMicroseconds(37);
+
+  invalidate();
 }
 
 /**
@@ -272,13 +314,131 @@ void LCD_I2C::createChar(uint8_t memory_location, uint8_t charmap[])
 
   memory_location %= 8;
 
+  // Written straight to CGRAM, even when buffered
+  beginStream();
   LCD_Write(HD44780_SET_CGRAM_ADDR | (memory_location << 3));
-  delayMicroseconds(37);
 
+  _output.rs = 1;
   for (int i = 0; i < 8; i++)
-    write(charmap[i]);
+  {
+    LCD_Write(charmap[i]);
+  }
+
+  setAddress(cellAddress(0, 0)); // Set the address pointer back to the DDRAM
+  endStream();
+
+  releaseSlot(memory_location);
+  memcpy(_cgram[memory_location], charmap, 8);
+  _cgramKnown |= (1 << memory_location);
+  _slotUse[memory_location] = ++_glyphClock;
+}
+
+/**
+ * @brief Make a glyph set resident in CGRAM.
+ *  The set takes consecutive slots, placed where the sets it evicts were used the longest time ago. Slots
+ *  already holding the right pixels are not uploaded again, so a resident set costs no I2C traffic.
+ *
+ * @param set glyph set
+ * @return uint8_t character code of the first glyph of the set, the others follow
+ */
+uint8_t LCD_I2C::useGlyphs(const lcd_glyph_set_t &set)
+{
+  uint8_t count = (set.count > LCD_CGRAM_SLOTS) ? LCD_CGRAM_SLOTS : set.count;
+  _glyphClock++;
+
+  // Already resident
+  for (uint8_t base = 0; base + count <= LCD_CGRAM_SLOTS; base++)
+  {
+    uint8_t i = 0;
+    while (i < count && _slotSet[base + i] == &set && _slotIndex[base + i] == i)
+    {
+      i++;
+    }
+    if (i == count)
+    {
+      for (i = 0; i < count; i++)
+      {
+        _slotUse[base + i] = _glyphClock;
+      }
+      return base;
+    }
+  }
+
+  // Place it where the most recently used slot it overwrites is the oldest, then where fewer slots change
+  uint8_t  best      = 0;
+  uint32_t bestUse   = UINT32_MAX;
+  uint8_t  bestWrite = UINT8_MAX;
+  for (uint8_t base = 0; base + count <= LCD_CGRAM_SLOTS; base++)
+  {
+    uint32_t use    = 0;
+    uint8_t  writes = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+      uint8_t slot = base + i;
+      if (_slotUse[slot] > use)
+      {
+        use = _slotUse[slot];
+      }
+      if (!(_cgramKnown & (1 << slot)) || memcmp(_cgram[slot], set.glyphs[i], 8) != 0)
+      {
+        writes++;
+      }
+    }
+    if (use < bestUse || (use == bestUse && writes < bestWrite))
+    {
+      best      = base;
+      bestUse   = use;
+      bestWrite = writes;
+    }
+  }
 
-  setCursor(0, 0); // Set the address pointer back to the DDRAM
+  // Upload the slots that differ, consecutive slots share one CGRAM address command
+  bool    restore   = _addressKnown;
+  uint8_t address   = _ddramAddress;
+  int8_t  nextSlot  = -1;
+  bool    streaming = _streaming;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    releaseSlot(best + i);
+  }
+
+  beginStream();
+  for (uint8_t i = 0; i < count; i++)
+  {
+    uint8_t slot     = best + i;
+    _slotSet[slot]   = &set;
+    _slotIndex[slot] = i;
+    _slotUse[slot]   = _glyphClock;
+
+    if ((_cgramKnown & (1 << slot)) && memcmp(_cgram[slot], set.glyphs[i], 8) == 0)
+    {
+      continue;
+    }
+    if (nextSlot != slot)
+    {
+      _output.rs = 0;
+      _output.rw = 0;
+      LCD_Write(HD44780_SET_CGRAM_ADDR | (slot << 3));
+    }
+    _output.rs = 1;
+    for (uint8_t row = 0; row < 8; row++)
+    {
+      LCD_Write(set.glyphs[i][row]);
+    }
+    memcpy(_cgram[slot], set.glyphs[i], 8);
+    _cgramKnown |= (1 << slot);
+    nextSlot = slot + 1;
+  }
+  if (nextSlot >= 0)
+  {
+    // Back to DDRAM, where the cursor was
+    setAddress(restore ? address : cellAddress(0, 0));
+  }
+  if (!streaming)
+  {
+    endStream();
+  }
+  return best;
 }
 
 /**
@@ -289,9 +449,6 @@ void LCD_I2C::createChar(uint8_t memory_location, uint8_t charmap[])
  */
 void LCD_I2C::setCursor(uint8_t column, uint8_t row)
 {
-  static const uint8_t row_offsets[] = {0x00, 0x40, 0x14, 0x54};
-  _output.rs                         = 0;
-  _output.rw                         = 0;
   // sanity limits
   if (column > _columnMax)
   {
@@ -303,29 +460,153 @@ void LCD_I2C::setCursor(uint8_t column, uint8_t row)
     row = _rowMax;
   }
 
-  uint8_t newAddress = row_offsets[row] + column;
+  if (_buffered)
+  {
+    _frameColumn = column;
+    _frameRow    = row;
+    return;
+  }
 
-  LCD_Write(HD44780_SET_DDRRAM_ADDR | newAddress);
-  delayMicroseconds(37);
+  setAddress(cellAddress(column, row));
 }
 
 /**
  * @brief Write a character to the LCD.
+ *  When buffered, the character goes to the framebuffer and is clipped at the end of the row.
  *
  * @param character to write
  * @return size_t written bytes
  */
 size_t LCD_I2C::write(uint8_t character)
 {
-  _output.rs = 1;
-  _output.rw = 0;
+  if (_buffered)
+  {
+    if (_frameColumn <= _columnMax)
+    {
+      _frame[_frameRow][_frameColumn++] = character;
+    }
+    return 1;
+  }
 
-  LCD_Write(character);
-  delayMicroseconds(41);
+  sendData(character);
 
   return 1;
 }
 
+/**
+ * @brief Write a string to the LCD in as few I2C transactions as possible.
+ *
+ * @param buffer characters to write
+ * @param size number of characters
+ * @return size_t written bytes
+ */
+size_t LCD_I2C::write(const uint8_t *buffer, size_t size)
+{
+  bool streaming = _streaming;
+  if (!_buffered && !streaming)
+  {
+    beginStream();
+  }
+
+  for (size_t i = 0; i < size; i++)
+  {
+    write(buffer[i]);
+  }
+
+  if (!_buffered && !streaming)
+  {
+    endStream();
+  }
+  return size;
+}
+
+/**
+ * @brief Start packing expander writes instead of sending each of them.
+ *  Not for clear() and home(), they need 1.52 ms before the next instruction. On a bus faster than
+ *  LCD_STREAM_MAX_CLOCK the bytes would outrun the instructions, each write is then sent with its delays.
+ *
+ */
+void LCD_I2C::beginStream() { _streaming = (_wire->getClock() <= LCD_STREAM_MAX_CLOCK); }
+
+/**
+ * @brief Send what was packed since beginStream() and go back to one transaction per expander write.
+ *
+ */
+void LCD_I2C::endStream()
+{
+  streamSend();
+  _streaming = false;
+}
+
+/**
+ * @brief Switch between drawing straight to the display and drawing into the framebuffer.
+ *  The framebuffer starts from a copy of what is known to be on the display.
+ *
+ * @param buffered true to draw into the framebuffer
+ */
+void LCD_I2C::setBuffered(bool buffered)
+{
+  if (buffered && !_buffered)
+  {
+    memcpy(_frame, _glass, sizeof(_frame));
+    if (!_glassValid)
+    {
+      memset(_frame, ' ', sizeof(_frame));
+    }
+    _frameColumn = 0;
+    _frameRow    = 0;
+  }
+  _buffered = buffered;
+}
+
+bool LCD_I2C::isBuffered() { return _buffered; }
+
+/**
+ * @brief Send the framebuffer cells that differ from the display.
+ *  Runs of changed cells are written back to back, the address counter only moves over unchanged cells
+ *  and to a new row. Everything is sent when the display content is unknown (see invalidate()).
+ *  Assumes the default left-to-right entry mode without autoscroll.
+ *
+ */
+void LCD_I2C::flush()
+{
+  if (!_buffered)
+  {
+    return;
+  }
+
+  beginStream();
+  for (uint8_t row = 0; row <= _rowMax; row++)
+  {
+    for (uint8_t column = 0; column <= _columnMax; column++)
+    {
+      if (_glassValid && _frame[row][column] == _glass[row][column])
+      {
+        continue;
+      }
+
+      uint8_t address = cellAddress(column, row);
+      if (!_addressKnown || _ddramAddress != address)
+      {
+        setAddress(address);
+      }
+      sendData(_frame[row][column]);
+    }
+  }
+  endStream();
+  _glassValid = true;
+}
+
+/**
+ * @brief Forget what is on the display, the next flush() redraws every cell.
+ *
+ */
+void LCD_I2C::invalidate()
+{
+  _glassValid   = false;
+  _addressKnown = false;
+}
+
 /**
  * @brief Function to initialize LCD
  *
@@ -361,7 +642,7 @@ void LCD_I2C::InitializeLCD()
   delayMicroseconds(37);
 
   displayOff();
-  clear();
+  clearDisplay();
   leftToRight();
 }
 
@@ -373,12 +654,128 @@ void LCD_I2C::InitializeLCD()
  * @param output
  */
 void LCD_I2C::writeCharCode(uint8_t code)
+{
+  if (_buffered)
+  {
+    write(code);
+    return;
+  }
+
+  sendData(code);
+}
+
+/**
+ * @brief Clear the display itself, whatever the buffering mode
+ *
+ */
+void LCD_I2C::clearDisplay()
+{
+  _output.rs = 0;
+  _output.rw = 0;
+
+  LCD_Write(HD44780_CLEAR_DISPLAY);
+  delayMicroseconds(1550);
+
+  memset(_glass, ' ', sizeof(_glass));
+  _glassValid   = true;
+  _ddramAddress = 0;
+  _addressKnown = true;
+}
+
+/**
+ * @brief Forget the glyph set owning a CGRAM slot, its other slots become free
+ *
+ * @param slot CGRAM slot
+ */
+void LCD_I2C::releaseSlot(uint8_t slot)
+{
+  const lcd_glyph_set_t *owner = _slotSet[slot];
+  if (owner == nullptr)
+  {
+    return;
+  }
+  for (uint8_t i = 0; i < LCD_CGRAM_SLOTS; i++)
+  {
+    if (_slotSet[i] == owner)
+    {
+      _slotSet[i] = nullptr;
+      _slotUse[i] = 0;
+    }
+  }
+}
+
+/**
+ * @brief Set the DDRAM address counter
+ *
+ * @param address DDRAM address
+ */
+void LCD_I2C::setAddress(uint8_t address)
+{
+  _output.rs = 0;
+  _output.rw = 0;
+
+  LCD_Write(HD44780_SET_DDRRAM_ADDR | address);
+  if (!_streaming)
+  {
+    delayMicroseconds(37);
+  }
+
+  _ddramAddress = address;
+  _addressKnown = true;
+}
+
+/**
+ * @brief Write a character at the address counter and keep track of it in the display copy
+ *
+ * @param character to write
+ */
+void LCD_I2C::sendData(uint8_t character)
 {
   _output.rs = 1;
-  LCD_Write(code);
-  delayMicroseconds(37);
+  _output.rw = 0;
+
+  LCD_Write(character);
+  if (!_streaming)
+  {
+    delayMicroseconds(41);
+  }
+
+  if (!_addressKnown)
+  {
+    _glassValid = false;
+    return;
+  }
+
+  for (uint8_t row = 0; row <= _rowMax; row++)
+  {
+    if (_ddramAddress >= row_offsets[row] && _ddramAddress <= row_offsets[row] + _columnMax)
+    {
+      _glass[row][_ddramAddress - row_offsets[row]] = character;
+      break;
+    }
+  }
+
+  // In 2-line mode the counter runs 0x00-0x27 then 0x40-0x67
+  _ddramAddress++;
+  if (_ddramAddress == 0x28)
+  {
+    _ddramAddress = 0x40;
+  }
+  else if (_ddramAddress == 0x68)
+  {
+    _ddramAddress = 0x00;
+  }
 }
 
+/**
+ * @brief DDRAM address of a cell
+ *
+ * @param column
+ * @param row
+ * @return uint8_t DDRAM address
+ */
+uint8_t LCD_I2C::cellAddress(uint8_t column, uint8_t row) { return row_offsets[row] + column; }
+
 /**
  * @brief I²C write function
  *
@@ -386,9 +783,12 @@ void LCD_I2C::writeCharCode(uint8_t code)
  */
 void LCD_I2C::I2C_Write(uint8_t output)
 {
+  // The bus is shared with the sensors, hold it for the whole transmission
+  bspI2CLock();
   _wire->beginTransmission(_address);
   _wire->write(output);
   _wire->endTransmission();
+  bspI2CUnlock();
 }
 
 /**
@@ -401,6 +801,21 @@ void LCD_I2C::LCD_Write(uint8_t output, bool initialization)
 {
   _output.data = output;
 
+  // Same expander bytes, packed. Each byte lasts 90 us on the bus at LCD_STREAM_MAX_CLOCK, longer than the
+  // 450 ns enable pulse and the 37-41 us an instruction takes, so no delay is needed between them.
+  if (_streaming && !initialization)
+  {
+    _output.en = true;
+    streamWrite(_output.GetHighData());
+    _output.en = false;
+    streamWrite(_output.GetHighData());
+    _output.en = true;
+    streamWrite(_output.GetLowData());
+    _output.en = false;
+    streamWrite(_output.GetLowData());
+    return;
+  }
+
   _output.en = true;
   I2C_Write(_output.GetHighData());
   // High part of enable should be > 450 ns
@@ -425,27 +840,49 @@ void LCD_I2C::LCD_Write(uint8_t output, bool initialization)
   }
 }
 
+/**
+ * @brief Queue one expander write, sending the queue when it is full
+ *
+ * @param output expander byte
+ */
+void LCD_I2C::streamWrite(uint8_t output)
+{
+  if (_streamLength >= LCD_STREAM_LENGTH)
+  {
+    streamSend();
+  }
+  _stream[_streamLength++] = output;
+}
+
+/**
+ * @brief Send the queued expander writes in one transaction
+ *
+ */
+void LCD_I2C::streamSend()
+{
+  if (_streamLength == 0)
+  {
+    return;
+  }
+
+  bspI2CLock();
+  _wire->beginTransmission(_address);
+  _wire->write(_stream, _streamLength);
+  _wire->endTransmission();
+  bspI2CUnlock();
+
+  _streamLength = 0;
+}
+
 void LCD_I2C::progressBar(uint8_t row, uint8_t progress)
 {
   // Define the width of the progress bar (in characters)
   const uint8_t progressBarWidth = 16;
   // Define the number of custom characters needed
-  const uint8_t customChars = 5;
-
-  // Define the custom characters for the progress bar
-  uint8_t progressChars[customChars][8] = {
-  {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000}, // 1/5
-  {0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000}, // 2/5
-  {0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100}, // 3/5
-  {0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110}, // 4/5
-  {0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111}  // 5/5 (full block)
-  };
+  const uint8_t customChars = LCD_GLYPHS_BARS.count;
 
-  // Create the custom characters
-  for (uint8_t i = 0; i < customChars; i++)
-  {
-    createChar(i, progressChars[i]);
-  }
+  // Upload the custom characters, only if they are not in CGRAM already
+  uint8_t firstChar = useGlyphs(LCD_GLYPHS_BARS);
 
   // Calculate the number of full and partial blocks
   uint8_t fullBlocks   = (progress * progressBarWidth) / 100;
@@ -463,7 +900,7 @@ void LCD_I2C::progressBar(uint8_t row, uint8_t progress)
     }
     else if (i == fullBlocks)
     {
-      write(partialBlock); // Partial block character
+      write(firstChar + partialBlock); // Partial block character
     }
     else
     {
@@ -471,29 +908,3 @@ void LCD_I2C::progressBar(uint8_t row, uint8_t progress)
     }
   }
 }
-
-lcd_screen_state_t LCD_I2C::getScreenState() { return lcdScreenState; }
-
-void LCD_I2C::setScreenState(lcd_screen_state_t screenState) { lcdScreenState = screenState; }
-
-void LCD_I2C::updateScreenState(bool increment)
-{
-  if (LCD_SCREEN_COUNT == 0)
-  {
-    return;
-  }
-  if (increment)
-  {
-    lcdScreenState = (lcd_screen_state_t) ((lcdScreenState + 1) % LCD_SCREEN_COUNT);
-#ifdef DEBUG_PRINT_SCREEN_STATE
-    Serial.println(lcdScreenState);
-#endif // DEBUG_PRINT_SCREEN_STATE
-  }
-  else
-  {
-    lcdScreenState = (lcd_screen_state_t) ((lcdScreenState - 1 + LCD_SCREEN_COUNT) % LCD_SCREEN_COUNT);
-#ifdef DEBUG_PRINT_SCREEN_STATE
-    Serial.println(lcdScreenState);
-#endif // DEBUG_PRINT_SCREEN_STATE
-  }
-}
\ No newline at end of file
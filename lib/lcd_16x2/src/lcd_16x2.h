@@ -4,12 +4,29 @@
 #include "Arduino.h"
 #include "Wire.h"
 
+#include "lcd_16x2_glyphs.h"
+
 /*
    This struct helps us constructing the I2C output based on data and control outputs.
    Because the LCD is set to 4-bit mode, 4 bits of the I2C output are for the control outputs
    while the other 4 bits are for the 8 bits of data which are send in parts using the enable output.
 */
-// #define DEBUG_PRINT_SCREEN_STATE
+// Size of the shadow framebuffer, larger displays are clipped to it
+#define LCD_FRAME_MAX_COLUMNS 20
+#define LCD_FRAME_MAX_ROWS    4
+
+#define LCD_CGRAM_SLOTS 8
+
+// Expander bytes packed into one I2C transaction while streaming, bounded by the Wire buffer
+#ifdef I2C_BUFFER_LENGTH
+  #define LCD_STREAM_LENGTH I2C_BUFFER_LENGTH
+#else
+  #define LCD_STREAM_LENGTH 32
+#endif
+
+// Fastest bus clock for streaming. Packed bytes carry no HD44780 instruction delay, the 90 us each byte takes
+// at 100 kHz (the PCF8574 maximum) covers it. Above it, beginStream() keeps one transaction per write.
+#define LCD_STREAM_MAX_CLOCK 100000UL
 
 struct OutputState
 {
@@ -46,52 +63,70 @@ struct OutputState
   }
 };
 
-typedef enum
-{
-  LCD_SCREEN_DOOR = 0,
-  LCD_SCREEN_SHT4X,
-  LCD_SCREEN_BMP280,
-  LCD_SCREEN_LIGHT,
-  LCD_SCREEN_MINIFAN,
-  LCD_SCREEN_COUNT // Total number of states
-} lcd_screen_state_t;
-
 class LCD_I2C : public Print
 {
 public:
   LCD_I2C(uint8_t address, uint8_t columns = 16, uint8_t rows = 2)
       : _address(address), _columnMax(--columns), _rowMax(--rows)
   {
+    if (_columnMax >= LCD_FRAME_MAX_COLUMNS)
+    {
+      _columnMax = LCD_FRAME_MAX_COLUMNS - 1;
+    }
+    if (_rowMax >= LCD_FRAME_MAX_ROWS)
+    {
+      _rowMax = LCD_FRAME_MAX_ROWS - 1;
+    }
   }
 
-  void begin(TwoWire *wire);
-  void backlight();
-  void backlightOff();
-
-  void               clear();
-  void               home();
-  void               leftToRight();
-  void               rightToLeft();
-  void               autoscroll();
-  void               autoscrollOff();
-  void               display();
-  void               displayOff();
-  void               cursor();
-  void               cursorOff();
-  void               blink();
-  void               blinkOff();
-  void               scrollDisplayLeft();
-  void               scrollDisplayRight();
-  void               createChar(uint8_t memory_location, uint8_t charmap[]);
-  void               setCursor(uint8_t column, uint8_t row);
-  void               writeCharCode(uint8_t code);
-  void               progressBar(uint8_t row, uint8_t progress);
-  lcd_screen_state_t getScreenState();
-  void               setScreenState(lcd_screen_state_t screenState);
-  void               updateScreenState(bool increment);
+  void    begin(TwoWire *wire);
+  void    backlight();
+  void    backlightOff();
+  uint8_t getColumns() { return _columnMax + 1; }
+  uint8_t getRows() { return _rowMax + 1; }
+
+  void clear();
+  void home();
+  void leftToRight();
+  void rightToLeft();
+  void autoscroll();
+  void autoscrollOff();
+  void display();
+  void displayOff();
+  void cursor();
+  void cursorOff();
+  void blink();
+  void blinkOff();
+  void scrollDisplayLeft();
+  void scrollDisplayRight();
+  void createChar(uint8_t memory_location, uint8_t charmap[]);
+  void setCursor(uint8_t column, uint8_t row);
+  void writeCharCode(uint8_t code);
+  void progressBar(uint8_t row, uint8_t progress);
+
+  // Makes a glyph set resident in CGRAM and returns the character code of its first glyph. Uploads only the
+  // slots whose content differs, evicting the least recently used sets. Slots set by createChar() count as
+  // used at that time and may be evicted too.
+  uint8_t useGlyphs(const lcd_glyph_set_t &set);
+
+  // Shadow framebuffer: when buffered, clear(), home(), setCursor() and write() draw into RAM and flush()
+  // sends the cells that differ from what is on the glass
+  void setBuffered(bool buffered);
+  bool isBuffered();
+  void flush();
+  void invalidate();
+
+  // Packs the expander writes of the commands and characters sent until endStream() into as few I2C
+  // transactions as the Wire buffer allows, instead of four transactions per character. Only on a bus
+  // clocked at LCD_STREAM_MAX_CLOCK or slower, see there.
+  void beginStream();
+  void endStream();
 
   // Method used by the Arduino class "Print" which is the one that provides the .print(string) method
   virtual size_t write(uint8_t character);
+  // Whole strings are streamed
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
 
 private:
   TwoWire           *_wire{nullptr};
@@ -101,11 +136,37 @@ private:
   OutputState        _output;
   uint8_t            _displayState  = 0x00;
   uint8_t            _entryState    = 0x00;
-  lcd_screen_state_t lcdScreenState = LCD_SCREEN_SHT4X;
+
+  bool    _buffered    = false;
+  uint8_t _frame[LCD_FRAME_MAX_ROWS][LCD_FRAME_MAX_COLUMNS]; // What the caller drew
+  uint8_t _glass[LCD_FRAME_MAX_ROWS][LCD_FRAME_MAX_COLUMNS]; // What the display shows
+  bool    _glassValid  = false;
+  uint8_t _frameColumn = 0;
+  uint8_t _frameRow    = 0;
+  uint8_t _ddramAddress = 0; // Address counter of the controller
+  bool    _addressKnown = false;
+
+  uint8_t                _cgram[LCD_CGRAM_SLOTS][8]; // CGRAM content, valid for the slots in _cgramKnown
+  uint8_t                _cgramKnown = 0;
+  const lcd_glyph_set_t *_slotSet[LCD_CGRAM_SLOTS]   = {nullptr};
+  uint8_t                _slotIndex[LCD_CGRAM_SLOTS] = {0};
+  uint32_t               _slotUse[LCD_CGRAM_SLOTS]   = {0};
+  uint32_t               _glyphClock                 = 0;
+
+  bool    _streaming = false;
+  uint8_t _stream[LCD_STREAM_LENGTH];
+  size_t  _streamLength = 0;
 
   void InitializeLCD();
+  void clearDisplay();
+  void setAddress(uint8_t address);
+  void releaseSlot(uint8_t slot);
+  void sendData(uint8_t character);
+  uint8_t cellAddress(uint8_t column, uint8_t row);
   void I2C_Write(uint8_t output);
   void LCD_Write(uint8_t output, bool initialization = false);
+  void streamWrite(uint8_t output);
+  void streamSend();
 };
 
 #endif
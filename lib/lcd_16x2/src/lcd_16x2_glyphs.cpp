@@ -0,0 +1,32 @@
+#include "lcd_16x2_glyphs.h"
+
+static const uint8_t barGlyphs[5][8] = {
+  {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000}, // 1/5
+  {0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000}, // 2/5
+  {0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100}, // 3/5
+  {0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110}, // 4/5
+  {0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111}  // 5/5 (full block)
+};
+
+static const uint8_t arrowGlyphs[4][8] = {
+  {0b00100, 0b01110, 0b10101, 0b00100, 0b00100, 0b00100, 0b00100, 0b00000}, // Up
+  {0b00100, 0b00100, 0b00100, 0b00100, 0b10101, 0b01110, 0b00100, 0b00000}, // Down
+  {0b00000, 0b00100, 0b01000, 0b11111, 0b01000, 0b00100, 0b00000, 0b00000}, // Left
+  {0b00000, 0b00100, 0b00010, 0b11111, 0b00010, 0b00100, 0b00000, 0b00000}  // Right
+};
+
+static const uint8_t wifiGlyphs[4][8] = {
+  {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b10000, 0b10000}, // 1 bar
+  {0b00000, 0b00000, 0b00000, 0b00000, 0b00100, 0b00100, 0b10100, 0b10100}, // 2 bars
+  {0b00000, 0b00000, 0b00001, 0b00001, 0b00101, 0b00101, 0b10101, 0b10101}, // 3 bars
+  {0b00001, 0b00001, 0b00101, 0b00101, 0b10101, 0b10101, 0b10101, 0b10101}  // 4 bars
+};
+
+static const uint8_t degreeGlyphs[1][8] = {
+  {0b01100, 0b10010, 0b10010, 0b01100, 0b00000, 0b00000, 0b00000, 0b00000} // Degree sign
+};
+
+const lcd_glyph_set_t LCD_GLYPHS_BARS   = {"bars", 5, barGlyphs};
+const lcd_glyph_set_t LCD_GLYPHS_ARROWS = {"arrows", 4, arrowGlyphs};
+const lcd_glyph_set_t LCD_GLYPHS_WIFI   = {"wifi", 4, wifiGlyphs};
+const lcd_glyph_set_t LCD_GLYPHS_DEGREE = {"degree", 1, degreeGlyphs};
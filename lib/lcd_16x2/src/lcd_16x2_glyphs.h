@@ -0,0 +1,27 @@
+#ifndef _LCD_GLYPHS_H_
+#define _LCD_GLYPHS_H_
+
+#include "Arduino.h"
+
+/**
+ * @brief A set of custom characters (5x8 pixels, one byte per row) uploaded together to consecutive CGRAM
+ *  slots by LCD_I2C::useGlyphs(). The set is identified by its address, define it once.
+ *
+ */
+struct lcd_glyph_set_t
+{
+  const char *name;
+  uint8_t     count; // 1 to 8
+  const uint8_t (*glyphs)[8];
+};
+
+// 1/5 to 5/5 filled cell, used by progressBar()
+extern const lcd_glyph_set_t LCD_GLYPHS_BARS;
+// Up, down, left, right
+extern const lcd_glyph_set_t LCD_GLYPHS_ARROWS;
+// Signal strength, 1 to 4 bars
+extern const lcd_glyph_set_t LCD_GLYPHS_WIFI;
+// Degree sign
+extern const lcd_glyph_set_t LCD_GLYPHS_DEGREE;
+
+#endif
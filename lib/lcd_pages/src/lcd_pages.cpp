@@ -0,0 +1,238 @@
+/**
+ * @file       lcd_pages.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-10
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for LCD Pages library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "lcd_pages.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Private defines ---------------------------------------------------- */
+#define LCD_PAGES_KEY_MISSING INT32_MIN       // Source not published yet, drawn as "--"
+#define LCD_PAGES_KEY_INVALID (INT32_MIN + 1) // Non-finite or out of range value
+
+/* Private variables -------------------------------------------------- */
+static const float decimalScale[LCD_PAGES_MAX_DECIMALS + 1] = { 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f };
+
+/* Class method definitions ------------------------------------------- */
+LcdPages::LcdPages(LCD_I2C &lcd)
+    : _lcd(lcd), _pageCount(0), _current(0), _scroll(0), _lastScroll(0), _renders(0), _drawn(false),
+      _pageSteps(0), _scrollSteps(0)
+{
+  memset(_pages, 0, sizeof(_pages));
+  memset(_keys, 0, sizeof(_keys));
+}
+
+lcd_pages_error_t LcdPages::addPage(const lcd_page_t *page)
+{
+  if (page == nullptr || page->lines == nullptr || page->lineCount == 0)
+  {
+    return LCD_PAGES_ERR_INVALID_ARG;
+  }
+  if (_pageCount >= LCD_PAGES_MAX)
+  {
+    return LCD_PAGES_ERR_FULL;
+  }
+
+  _pages[_pageCount++] = page;
+  return LCD_PAGES_OK;
+}
+
+void LcdPages::next() { _pageSteps.fetch_add(1); }
+
+void LcdPages::previous() { _pageSteps.fetch_sub(1); }
+
+void LcdPages::scroll(int8_t lines) { _scrollSteps.fetch_add(lines); }
+
+void LcdPages::invalidate() { _drawn = false; }
+
+bool LcdPages::update(const sensor_snapshot_t &snapshot, uint32_t now)
+{
+  if (_pageCount == 0)
+  {
+    return false;
+  }
+
+  bool dirty = !_drawn;
+  if (!_drawn)
+  {
+    _lastScroll = now;
+  }
+
+  int pageSteps = _pageSteps.exchange(0);
+  if (pageSteps != 0)
+  {
+    _current    = (uint8_t) (((_current + pageSteps) % _pageCount + _pageCount) % _pageCount);
+    _scroll     = 0;
+    _lastScroll = now;
+    dirty       = true;
+  }
+
+  const lcd_page_t *page      = _pages[_current];
+  uint8_t           rows      = (page->lineCount < _lcd.getRows()) ? page->lineCount : _lcd.getRows();
+  uint8_t           positions = page->lineCount - rows + 1; // Scroll positions
+
+  int scrollSteps = _scrollSteps.exchange(0);
+  if (scrollSteps != 0)
+  {
+    _scroll     = (uint8_t) (((_scroll + scrollSteps) % positions + positions) % positions);
+    _lastScroll = now;
+    dirty       = true;
+  }
+  else if (page->scrollPeriodMs != 0 && positions > 1 && now - _lastScroll >= page->scrollPeriodMs)
+  {
+    _scroll     = (_scroll + 1) % positions;
+    _lastScroll = now;
+    dirty       = true;
+  }
+
+  // Compare what each row would show with what it shows
+  float   values[LCD_FRAME_MAX_ROWS];
+  bool    valid[LCD_FRAME_MAX_ROWS];
+  int32_t keys[LCD_FRAME_MAX_ROWS];
+  for (uint8_t row = 0; row < rows; row++)
+  {
+    const lcd_line_t &line = page->lines[_scroll + row];
+    values[row]            = readValue(line.binding, snapshot, valid[row]);
+    keys[row]              = valueKey(line, values[row], valid[row]);
+    if (keys[row] != _keys[row])
+    {
+      dirty = true;
+    }
+  }
+
+  if (!dirty)
+  {
+    return false;
+  }
+
+  _lcd.setBuffered(true);
+  _lcd.clear();
+  for (uint8_t row = 0; row < rows; row++)
+  {
+    drawLine(page->lines[_scroll + row], row, values[row], valid[row]);
+    _keys[row] = keys[row];
+  }
+  _lcd.flush();
+
+  _drawn = true;
+  _renders++;
+  return true;
+}
+
+/* Private definitions ------------------------------------------------ */
+float LcdPages::readValue(const lcd_binding_t &binding, const sensor_snapshot_t &snapshot, bool &valid)
+{
+  valid = (binding.source >= SNAPSHOT_SOURCE_COUNT) || SNAPSHOT_IS_VALID(snapshot, binding.source);
+  if (!valid)
+  {
+    return NAN;
+  }
+
+  const uint8_t *base = (const uint8_t *) &snapshot;
+  switch (binding.kind)
+  {
+    case LCD_BIND_SNAPSHOT_FLOAT:
+    {
+      float value;
+      memcpy(&value, base + binding.offset, sizeof(value));
+      return value;
+    }
+
+    case LCD_BIND_SNAPSHOT_INT:
+    {
+      int value;
+      memcpy(&value, base + binding.offset, sizeof(value));
+      return (float) value;
+    }
+
+    case LCD_BIND_GETTER:
+    {
+      // A getter without a value to show returns NAN, drawn like a source that never published
+      float value = (binding.getter != nullptr) ? binding.getter() : NAN;
+      valid       = !isnan(value);
+      return value;
+    }
+
+    default:
+      return 0.0f;
+  }
+}
+
+int32_t LcdPages::valueKey(const lcd_line_t &line, float value, bool valid)
+{
+  if (line.binding.kind == LCD_BIND_NONE)
+  {
+    return 0;
+  }
+  if (!valid)
+  {
+    return LCD_PAGES_KEY_MISSING;
+  }
+
+  // Rounded the way it is printed, a change below the displayed precision does not redraw
+  float scaled = (line.format == LCD_FORMAT_NUMBER)
+                     ? value * decimalScale[(line.decimals > LCD_PAGES_MAX_DECIMALS) ? LCD_PAGES_MAX_DECIMALS
+                                                                                      : line.decimals]
+                     : value;
+  if (!isfinite(scaled) || fabsf(scaled) >= 2.0e9f)
+  {
+    return LCD_PAGES_KEY_INVALID;
+  }
+  return (int32_t) lroundf(scaled);
+}
+
+void LcdPages::drawLine(const lcd_line_t &line, uint8_t row, float value, bool valid)
+{
+  if (line.format == LCD_FORMAT_BAR)
+  {
+    int progress = valid && isfinite(value) ? (int) lroundf(value) : 0;
+    _lcd.progressBar(row, (uint8_t) constrain(progress, 0, 100));
+    return;
+  }
+
+  _lcd.setCursor(0, row);
+  if (line.label != nullptr)
+  {
+    _lcd.print(line.label);
+  }
+  if (line.binding.kind == LCD_BIND_NONE)
+  {
+    return;
+  }
+  if (!valid)
+  {
+    _lcd.print("--");
+    return;
+  }
+
+  if (line.format == LCD_FORMAT_CHOICE)
+  {
+    // A value without a text, e.g. a getter returning a new state, must not index past the table
+    if (line.choices != nullptr && value >= 0.0f && value < (float) line.choiceCount)
+    {
+      _lcd.print(line.choices[(int) value]);
+    }
+    else
+    {
+      _lcd.print("--");
+    }
+    return;
+  }
+
+  _lcd.print(value, line.decimals);
+  if (line.unit != nullptr)
+  {
+    _lcd.print(line.unit);
+  }
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,252 @@
+/**
+ * @file       lcd_pages.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-10
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for LCD Pages library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef LCD_PAGES_H
+  #define LCD_PAGES_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include "lcd_16x2.h"
+  #include "sensor_snapshot.h"
+
+  #include <atomic>
+  #include <stddef.h>
+  #include <type_traits>
+
+  /* Public defines ----------------------------------------------------- */
+  #define LCD_PAGES_LIB_VERSION  (F("0.1.0"))
+
+  #define LCD_PAGES_MAX          8
+  #define LCD_PAGES_MAX_DECIMALS 4
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  LCD_PAGES_OK = 0,          /* No error */
+  LCD_PAGES_ERR,             /* Generic error */
+  LCD_PAGES_ERR_INVALID_ARG, /* Null page or page without lines */
+  LCD_PAGES_ERR_FULL         /* `LCD_PAGES_MAX` pages already registered */
+} lcd_pages_error_t;
+
+/**
+ * @brief Where the value of a line comes from.
+ */
+typedef enum
+{
+  LCD_BIND_NONE = 0,       /* Static text, the label only */
+  LCD_BIND_SNAPSHOT_FLOAT, /* `float` field of `sensor_snapshot_t` */
+  LCD_BIND_SNAPSHOT_INT,   /* `int` field of `sensor_snapshot_t` */
+  LCD_BIND_GETTER          /* Returned by a function, e.g. the state of an actuator */
+} lcd_binding_kind_t;
+
+/**
+ * @brief How the value of a line is drawn.
+ */
+typedef enum
+{
+  LCD_FORMAT_NUMBER = 0, /* Label, value with `decimals` digits, unit */
+  LCD_FORMAT_CHOICE,     /* Label, `choices[value]`, `--` out of `choiceCount` */
+  LCD_FORMAT_BAR         /* Progress bar of `value` percent over the whole row, no label */
+} lcd_format_t;
+
+/**
+ * @brief Data binding of a line, built with the `LCD_BIND_*` macros.
+ */
+typedef struct
+{
+  lcd_binding_kind_t kind;
+  uint8_t            source; /**< Snapshot source, `--` is shown until it has published once */
+  uint16_t           offset; /**< Offset of the field in `sensor_snapshot_t` */
+  float (*getter)();         /**< Value of a `LCD_BIND_GETTER` binding, `NAN` shows `--` */
+} lcd_binding_t;
+
+/**
+ * @brief One line of a page.
+ */
+typedef struct
+{
+  const char        *label;       /**< Printed before the value, may be null */
+  lcd_binding_t      binding;     /**< Value of the line */
+  lcd_format_t       format;      /**< How the value is drawn */
+  uint8_t            decimals;    /**< Digits after the point of a `LCD_FORMAT_NUMBER` value */
+  const char        *unit;        /**< Printed after a `LCD_FORMAT_NUMBER` value, may be null */
+  const char *const *choices;     /**< Texts of a `LCD_FORMAT_CHOICE` value, indexed by the value */
+  uint8_t            choiceCount; /**< Number of `choices`, set with `LCD_CHOICES()` */
+} lcd_line_t;
+
+/**
+ * @brief A page: its lines and, when it has more lines than the display has rows, how it scrolls.
+ */
+typedef struct
+{
+  const char       *name;
+  const lcd_line_t *lines;
+  uint8_t           lineCount;
+  uint32_t          scrollPeriodMs; /**< Scroll by one line every period, `0` to scroll only on request */
+} lcd_page_t;
+
+/* Public macros ------------------------------------------------------ */
+  // Binding of a field of sensor_snapshot_t, float or int is picked from the type of the field
+  #define LCD_BIND_SNAPSHOT(source, field)                                                                   \
+    {                                                                                                        \
+      (std::is_same<decltype(sensor_snapshot_t::field), int>::value ? LCD_BIND_SNAPSHOT_INT                  \
+                                                                    : LCD_BIND_SNAPSHOT_FLOAT),              \
+          (uint8_t) (source), (uint16_t) offsetof(sensor_snapshot_t, field), nullptr                         \
+    }
+
+  #define LCD_BIND_FN(getter)                                                                                \
+    {                                                                                                        \
+      LCD_BIND_GETTER, (uint8_t) SNAPSHOT_SOURCE_COUNT, 0, (getter)                                          \
+    }
+
+  #define LCD_BIND_STATIC                                                                                    \
+    {                                                                                                        \
+      LCD_BIND_NONE, (uint8_t) SNAPSHOT_SOURCE_COUNT, 0, nullptr                                             \
+    }
+
+  #define LCD_PAGE_LINES(lines) (lines), (uint8_t) (sizeof(lines) / sizeof((lines)[0]))
+
+  // Choices of a LCD_FORMAT_CHOICE line, the count is taken from the array
+  #define LCD_CHOICES(choices) (choices), (uint8_t) (sizeof(choices) / sizeof((choices)[0]))
+  #define LCD_NO_CHOICES       nullptr, 0
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Page engine on top of the `LCD_I2C` framebuffer.
+ *
+ * The `LcdPages` class replaces a hand-written `switch` over screens. Each page is a table of lines, each
+ * line binds a sensor snapshot field or a getter, and the engine decides when the display must be redrawn.
+ *
+ * ### Features:
+ *
+ * - Redraws only when a bound value changes at the precision it is displayed with, when the page is
+ * switched or when it scrolls. Otherwise `update()` costs a few comparisons and no I2C traffic.
+ *
+ * - Pages longer than the display scroll, on request (`scroll()`) or periodically (`scrollPeriodMs`).
+ *
+ * - `next()`, `previous()` and `scroll()` only record the request and are safe to call from another task
+ * (e.g. a button callback), the drawing happens in the task calling `update()`.
+ *
+ * - Values of a snapshot source that has not published yet are drawn as `--`.
+ *
+ * ### Usage:
+ *
+ * ```
+ * static const lcd_line_t climateLines[] = {
+ *   { "T: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_SHT4X, temperature), LCD_FORMAT_NUMBER, 1, " C",
+ *     LCD_NO_CHOICES },
+ * };
+ * static const lcd_page_t climatePage = { "climate", LCD_PAGE_LINES(climateLines), 0 };
+ *
+ * pages.addPage(&climatePage);
+ * // In the LCD task
+ * pages.update(snapshot, millis());
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - `LCD_I2C` in buffered mode, set by the first `update()`. Nothing else may draw on the display.
+ *
+ * - `sensor_snapshot_t` for the snapshot bindings.
+ */
+class LcdPages
+{
+public:
+  /**
+   * @brief Constructor of the `LcdPages` class.
+   *
+   * @param[in] lcd The display the pages are drawn on.
+   */
+  explicit LcdPages(LCD_I2C &lcd);
+
+  /**
+   * @brief Registers a page, pages are shown in registration order.
+   *
+   * @param[in] page Page to add, must outlive the engine.
+   *
+   * @return
+   *  - `LCD_PAGES_OK`: Page added
+   *
+   *  - `LCD_PAGES_ERR_INVALID_ARG`: Null page or page without lines
+   *
+   *  - `LCD_PAGES_ERR_FULL`: `LCD_PAGES_MAX` pages already registered
+   */
+  lcd_pages_error_t addPage(const lcd_page_t *page);
+
+  /**
+   * @brief Requests the next page, applied by the next `update()`.
+   */
+  void next();
+
+  /**
+   * @brief Requests the previous page, applied by the next `update()`.
+   */
+  void previous();
+
+  /**
+   * @brief Requests scrolling the current page, applied by the next `update()`. Wraps around.
+   *
+   * @param[in] lines Lines to scroll by, negative to scroll up.
+   */
+  void scroll(int8_t lines);
+
+  /**
+   * @brief Applies the pending requests and redraws the current page if anything it shows changed.
+   *
+   * @param[in] snapshot Latest sensor values.
+   * @param[in] now      Current time in ms, for periodic scrolling.
+   *
+   * @return bool `true` if the page was redrawn, `false` if the display was left untouched.
+   */
+  bool update(const sensor_snapshot_t &snapshot, uint32_t now);
+
+  /**
+   * @brief Forces a redraw on the next `update()`, e.g. after something else drew on the display.
+   */
+  void invalidate();
+
+  uint8_t  getPageIndex() { return _current; }
+  uint8_t  getPageCount() { return _pageCount; }
+  uint8_t  getScroll() { return _scroll; }
+  uint32_t getRenderCount() { return _renders; }
+
+private:
+  LCD_I2C          &_lcd;
+  const lcd_page_t *_pages[LCD_PAGES_MAX];
+  uint8_t           _pageCount;
+  uint8_t           _current;
+  uint8_t           _scroll;
+  uint32_t          _lastScroll;
+  uint32_t          _renders;
+  bool              _drawn;
+
+  std::atomic<int> _pageSteps;
+  std::atomic<int> _scrollSteps;
+
+  int32_t _keys[LCD_FRAME_MAX_ROWS]; // Displayed value of each row, at display precision
+
+  float   readValue(const lcd_binding_t &binding, const sensor_snapshot_t &snapshot, bool &valid);
+  int32_t valueKey(const lcd_line_t &line, float value, bool valid);
+  void    drawLine(const lcd_line_t &line, uint8_t row, float value, bool valid);
+};
+
+#endif // LCD_PAGES_H
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,229 @@
+/**
+ * @file       led_effects.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-20
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for LED Effects library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "led_effects.h"
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+// round(255 * (i / 255)^2.6): the eye is far more sensitive to changes at low light
+static const uint8_t gammaTable[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+    3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+    7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+   13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+   20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+   30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+   42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+   58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+   76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+   97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+  122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+  150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+  182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+  218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+
+/* Class method definitions ------------------------------------------- */
+LedEffects::LedEffects()
+    : _show(nullptr), _showArg(nullptr), _count(0), _effect(LED_EFFECT_SOLID), _from(LED_COLOR_OFF),
+      _color(LED_COLOR_OFF), _current(LED_COLOR_OFF), _startMs(0), _periodMs(0), _offMs(0), _brightness(255),
+      _restart(false), _dirty(true), _shown(LED_COLOR_OFF), _showCount(0)
+{
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+}
+
+led_effects_error_t LedEffects::begin(uint16_t count, led_effects_show_t show, void *arg)
+{
+  if (show == nullptr || count == 0 || count > LED_EFFECTS_MAX_PIXELS)
+  {
+    return LED_EFFECTS_ERR_INVALID_ARG;
+  }
+
+  _show    = show;
+  _showArg = arg;
+  _count   = count;
+  _dirty   = true;
+  return LED_EFFECTS_OK;
+}
+
+void LedEffects::setBrightness(uint8_t brightness)
+{
+  portENTER_CRITICAL(&_lock);
+  _brightness = brightness;
+  _dirty      = true;
+  portEXIT_CRITICAL(&_lock);
+}
+
+void LedEffects::solid(led_color_t color) { start(LED_EFFECT_SOLID, color, 0, 0); }
+
+void LedEffects::fadeTo(led_color_t color, uint32_t durationMs)
+{
+  start((durationMs > 0) ? LED_EFFECT_FADE : LED_EFFECT_SOLID, color, durationMs, 0);
+}
+
+led_effects_error_t LedEffects::breathe(led_color_t color, uint32_t periodMs)
+{
+  if (periodMs == 0)
+  {
+    return LED_EFFECTS_ERR_INVALID_ARG;
+  }
+  start(LED_EFFECT_BREATHE, color, periodMs, 0);
+  return LED_EFFECTS_OK;
+}
+
+led_effects_error_t LedEffects::blink(led_color_t color, uint32_t onMs, uint32_t offMs)
+{
+  if (onMs == 0 && offMs == 0)
+  {
+    return LED_EFFECTS_ERR_INVALID_ARG;
+  }
+  start(LED_EFFECT_BLINK, color, onMs, offMs);
+  return LED_EFFECTS_OK;
+}
+
+bool LedEffects::render(uint32_t nowMs)
+{
+  if (_show == nullptr)
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  if (_restart)
+  {
+    _restart = false;
+    _startMs = nowMs;
+  }
+  uint32_t    elapsed = nowMs - _startMs;
+  led_color_t color   = _color;
+  switch (_effect)
+  {
+    case LED_EFFECT_FADE:
+      if (elapsed >= _periodMs)
+      {
+        _effect = LED_EFFECT_SOLID;
+      }
+      else
+      {
+        // Linear in light, the gamma table makes it look linear to the eye
+        uint8_t t = (uint8_t) (elapsed * 255UL / _periodMs);
+        color.r   = _from.r + (((int) _color.r - _from.r) * t) / 255;
+        color.g   = _from.g + (((int) _color.g - _from.g) * t) / 255;
+        color.b   = _from.b + (((int) _color.b - _from.b) * t) / 255;
+      }
+      break;
+
+    case LED_EFFECT_BREATHE:
+    {
+      // Triangle wave off -> full -> off, smoothed by the gamma curve
+      uint32_t phase = (elapsed % _periodMs) * 510UL / _periodMs;
+      color          = scale(_color, (uint8_t) ((phase <= 255) ? phase : 510 - phase));
+      break;
+    }
+
+    case LED_EFFECT_BLINK:
+      if (elapsed % (_periodMs + _offMs) >= _periodMs)
+      {
+        color = LED_COLOR_OFF;
+      }
+      break;
+
+    default:
+      break;
+  }
+  _current           = color;
+  uint8_t brightness = _brightness;
+  bool    dirty      = _dirty;
+  _dirty             = false;
+  portEXIT_CRITICAL(&_lock);
+
+  color   = scale(color, brightness);
+  color.r = gammaTable[color.r];
+  color.g = gammaTable[color.g];
+  color.b = gammaTable[color.b];
+  if (!dirty && color.r == _shown.r && color.g == _shown.g && color.b == _shown.b)
+  {
+    return false;
+  }
+
+  for (uint16_t i = 0; i < _count; i++)
+  {
+    _frame[i] = color;
+  }
+  _shown = color;
+  _showCount++;
+  _show(_frame, _count, _showArg);
+  return true;
+}
+
+led_color_t LedEffects::fromDisplay(led_color_t color)
+{
+  return LED_COLOR(ungamma(color.r), ungamma(color.g), ungamma(color.b));
+}
+
+bool LedEffects::isAnimating()
+{
+  portENTER_CRITICAL(&_lock);
+  bool animating = _effect != LED_EFFECT_SOLID || _restart || _dirty;
+  portEXIT_CRITICAL(&_lock);
+  return animating;
+}
+
+/* Private definitions ------------------------------------------------ */
+void LedEffects::start(led_effect_t effect, led_color_t color, uint32_t periodMs, uint32_t offMs)
+{
+  portENTER_CRITICAL(&_lock);
+  // A fade starts from what is on the strip now, even halfway through another effect
+  _from     = _current;
+  _effect   = effect;
+  _color    = color;
+  _periodMs = periodMs;
+  _offMs    = offMs;
+  _restart  = true;
+  portEXIT_CRITICAL(&_lock);
+}
+
+led_color_t LedEffects::scale(led_color_t color, uint8_t level)
+{
+  led_color_t scaled;
+  scaled.r = (uint8_t) ((color.r * level + 127) / 255);
+  scaled.g = (uint8_t) ((color.g * level + 127) / 255);
+  scaled.b = (uint8_t) ((color.b * level + 127) / 255);
+  return scaled;
+}
+
+uint8_t LedEffects::ungamma(uint8_t value)
+{
+  // First linear level shown at least as bright, or the one below if that is closer
+  uint16_t i = 0;
+  while (gammaTable[i] < value)
+  {
+    i++;
+  }
+  if (i > 0 && value - gammaTable[i - 1] < gammaTable[i] - value)
+  {
+    i--;
+  }
+  return (uint8_t) i;
+}
+
+/* End of file -------------------------------------------------------- */
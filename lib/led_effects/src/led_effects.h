@@ -0,0 +1,217 @@
+/**
+ * @file       led_effects.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-20
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for LED Effects library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef LED_EFFECTS_H
+  #define LED_EFFECTS_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  /* Public defines ----------------------------------------------------- */
+  #define LED_EFFECTS_LIB_VERSION (F("0.1.0"))
+
+  #define LED_EFFECTS_MAX_PIXELS  16
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  LED_EFFECTS_OK = 0,          /* No error */
+  LED_EFFECTS_ERR,             /* Generic error */
+  LED_EFFECTS_ERR_INIT,        /* `begin()` not called */
+  LED_EFFECTS_ERR_INVALID_ARG  /* Null writer, pixel count out of range or zero period */
+} led_effects_error_t;
+
+typedef enum
+{
+  LED_EFFECT_SOLID = 0, /* Constant color */
+  LED_EFFECT_FADE,      /* Linear cross-fade from the current color, then solid */
+  LED_EFFECT_BREATHE,   /* Brightness rises and falls continuously */
+  LED_EFFECT_BLINK      /* Color and off, alternating */
+} led_effect_t;
+
+/**
+ * @brief Color in linear light, before brightness and gamma.
+ */
+typedef struct
+{
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+} led_color_t;
+
+/**
+ * @brief Sends a frame to the strip, e.g. `setPixelColor()` on each pixel then `show()`. Runs in the task
+ * calling `render()`.
+ */
+typedef void (*led_effects_show_t)(const led_color_t *frame, uint16_t count, void *arg);
+
+/* Public macros ------------------------------------------------------ */
+  #define LED_COLOR(r, g, b) (led_color_t{ (r), (g), (b) })
+  #define LED_COLOR_OFF      LED_COLOR(0, 0, 0)
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Effects engine for an RGB LED strip.
+ *
+ * The `LedEffects` class splits the LED output in two: any task picks an effect, which only stores a few
+ * values, and a single owner task calls `render()` at a fixed frame rate. `render()` computes the color of
+ * the frame, applies the brightness and a precomputed gamma table into a frame buffer and hands it to the
+ * strip only when it differs from the last one shown. Callers never wait on the strip.
+ *
+ * ### Features:
+ *
+ * - Solid, fade, breathing and blink effects over the whole strip.
+ *
+ * - Gamma 2.6 correction from a 256-entry table, a linear fade or ramp looks even to the eye.
+ *
+ * - Global brightness, applied before gamma.
+ *
+ * - `fromDisplay()` turns a color picked for the strip itself into linear light, it then shows unchanged.
+ *
+ * - A static strip is not rewritten, `isAnimating()` tells the owner task when it may sleep.
+ *
+ * ### Usage:
+ *
+ * ```
+ * const led_color_t orange = LedEffects::fromDisplay(LED_COLOR(255, 102, 0)); // Once
+ * ledEffects.begin(rgb.numPixels(), showOnStrip, nullptr);
+ * ledEffects.fadeTo(orange, 300); // From any task
+ * ledEffects.render(millis());    // Owner task, every frame
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - None, the strip is reached through the show callback. Effect setters are safe from any task, `render()`
+ * belongs to one task.
+ */
+class LedEffects
+{
+public:
+  LedEffects();
+
+  /**
+   * @brief Sets up the frame buffer. The strip starts off and is written on the first `render()`.
+   *
+   * @param[in] count Number of pixels (1–`LED_EFFECTS_MAX_PIXELS`).
+   * @param[in] show  Sends a frame to the strip.
+   * @param[in] arg   Passed to `show`.
+   *
+   * @return
+   *  - `LED_EFFECTS_OK`: Success
+   *
+   *  - `LED_EFFECTS_ERR_INVALID_ARG`: Null writer or pixel count out of range
+   */
+  led_effects_error_t begin(uint16_t count, led_effects_show_t show, void *arg = nullptr);
+
+  /**
+   * @brief Sets the global brightness, 255 for full. Applies from the next frame.
+   */
+  void setBrightness(uint8_t brightness);
+
+  void solid(led_color_t color);
+
+  /**
+   * @brief Cross-fades from the color shown now to a new one.
+   *
+   * @param[in] color      Final color.
+   * @param[in] durationMs Length of the fade, `0` for an immediate change.
+   */
+  void fadeTo(led_color_t color, uint32_t durationMs);
+
+  /**
+   * @brief Breathes a color, from off to full and back over `periodMs`.
+   *
+   * @return
+   *  - `LED_EFFECTS_OK`: Success
+   *
+   *  - `LED_EFFECTS_ERR_INVALID_ARG`: `periodMs` is `0`
+   */
+  led_effects_error_t breathe(led_color_t color, uint32_t periodMs);
+
+  /**
+   * @brief Blinks a color, starting on.
+   *
+   * @return
+   *  - `LED_EFFECTS_OK`: Success
+   *
+   *  - `LED_EFFECTS_ERR_INVALID_ARG`: `onMs` and `offMs` are both `0`
+   */
+  led_effects_error_t blink(led_color_t color, uint32_t onMs, uint32_t offMs);
+
+  /**
+   * @brief Renders the frame at a given time and shows it if it changed.
+   *
+   * @param[in] nowMs millis() of the frame.
+   *
+   * @return bool `true` if the frame was sent to the strip.
+   */
+  bool render(uint32_t nowMs);
+
+  /**
+   * @brief Tells whether the frames still change over time.
+   *
+   * @return bool `false` for a solid color once shown, the owner task may then sleep until the next effect.
+   */
+  bool isAnimating();
+
+  /**
+   * @brief Converts a color as it should look on the strip, e.g. an sRGB constant picked for the old direct
+   * writes, to the linear light the effects work in. Shown at full brightness it comes out as given, within
+   * one step of the gamma table. Convert constants once, not every frame.
+   *
+   * @param[in] color Color as written to the strip.
+   *
+   * @return led_color_t Linear color to pass to the effects.
+   */
+  static led_color_t fromDisplay(led_color_t color);
+
+  led_effect_t getEffect() { return _effect; }
+  uint32_t     getShowCount() { return _showCount; }
+
+private:
+  portMUX_TYPE       _lock;
+  led_effects_show_t _show;
+  void              *_showArg;
+  uint16_t           _count;
+
+  // Effect, written by any task under _lock
+  led_effect_t _effect;
+  led_color_t  _from;    /** Fade start */
+  led_color_t  _color;   /** Target or effect color */
+  led_color_t  _current; /** Linear color of the last frame */
+  uint32_t     _startMs;
+  uint32_t     _periodMs; /** Fade length, breathing period or blink on time */
+  uint32_t     _offMs;
+  uint8_t      _brightness;
+  bool         _restart;  /** Effect changed, its clock starts on the next frame */
+  bool         _dirty;    /** Frame must be shown even if unchanged */
+
+  // Owned by the render task
+  led_color_t _frame[LED_EFFECTS_MAX_PIXELS];
+  led_color_t _shown;
+  uint32_t    _showCount;
+
+  void               start(led_effect_t effect, led_color_t color, uint32_t periodMs, uint32_t offMs);
+  static led_color_t scale(led_color_t color, uint8_t level);
+  static uint8_t     ungamma(uint8_t value);
+};
+
+#endif // LED_EFFECTS_H
+
+/* End of file -------------------------------------------------------- */
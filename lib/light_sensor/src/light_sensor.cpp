@@ -11,9 +11,14 @@
 
 /* Includes ----------------------------------------------------------- */
 #include "light_sensor.h"
+#include "bsp_adc.h"
 #include "bsp_gpio.h"
 
+#include <math.h>
+#include <string.h>
+
 /* Private defines ---------------------------------------------------- */
+#define LIGHT_SENSOR_RING_MASK (LIGHT_SENSOR_RING_LENGTH - 1)
 
 /* Private enumerate/structure ---------------------------------------- */
 
@@ -26,8 +31,15 @@
 /* Class method Definitions ---------------------------------- */
 
 // Constructor
-LightSensor::LightSensor(int pin) : _pin(pin)
+LightSensor::LightSensor(int pin)
+    : _pin(pin), _continuous(false), _decimation(1), _decimationCount(0), _decimationSum(0), _sampleCount(0),
+      _averageWindow(8), _medianWindow(5), _averageSum(0), _emaAlpha(0.2f), _ema(0.0f), _triggerCount(0),
+      _legacyTrigger(-1)
 {
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+  memset(_ring, 0, sizeof(_ring));
+
   pinMode(_pin, INPUT);
   sensorValue[0] = 0;
   sensorValue[1] = 0;
@@ -37,9 +49,17 @@ LightSensor::LightSensor(int pin) : _pin(pin)
 
 light_sensor_error_t LightSensor::read()
 {
-  sensorValue[0] = bspGpioAnalogRead(_pin);
-  sensorValue[1] = map(sensorValue[0], 0, 4095, 0, 100);
-  sensorValue[1] = constrain(sensorValue[1], 0, 100);
+  if (_continuous)
+  {
+    // The pipeline already holds a fresh value, do not touch the ADC
+    setSensorValue(filterValue(LIGHT_FILTER_AVERAGE));
+    return LIGHT_SENSOR_OK;
+  }
+
+  // One-shot mode feeds the same filters and triggers, one sample per read()
+  int raw = bspGpioAnalogRead(_pin);
+  setSensorValue(raw);
+  pushSample((uint16_t) raw);
   return LIGHT_SENSOR_OK;
 }
 
@@ -62,6 +82,11 @@ bool LightSensor::isAboveThreshold(int threshold) { return sensorValue[0] > thre
 
 int LightSensor::getAverageReading(int samples)
 {
+  if (_continuous)
+  {
+    return filterValue(LIGHT_FILTER_AVERAGE);
+  }
+
   long total = 0;
   for (int i = 0; i < samples; i++)
   {
@@ -74,14 +99,360 @@ int LightSensor::getAverageReading(int samples)
 
 light_sensor_error_t LightSensor::onThresholdCross(int threshold, void (*callback)())
 {
-  _callback = callback;
-  if (isAboveThreshold(threshold) && _callback != nullptr)
+  if (callback == nullptr)
+  {
+    return LIGHT_SENSOR_ERR;
+  }
+
+  light_sensor_trigger_t trigger = { LIGHT_TRIGGER_RISING, LIGHT_FILTER_LATEST, threshold, 0, 0, 0 };
+  _callback                      = callback;
+  if (_legacyTrigger < 0)
+  {
+    light_sensor_error_t err = addTrigger(trigger, legacyCallback, this);
+    if (err == LIGHT_SENSOR_OK)
+    {
+      _legacyTrigger = (int8_t) (_triggerCount - 1);
+    }
+    return err;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  trigger_slot_t &slot = _triggers[_legacyTrigger];
+  slot.config          = trigger;
+  slot.known           = false;
+  slot.holdingOff      = false;
+  portEXIT_CRITICAL(&_lock);
+  return LIGHT_SENSOR_OK;
+}
+
+light_sensor_error_t LightSensor::beginContinuous(uint32_t sampleRateHz, uint8_t decimation,
+                                                  uint16_t frameSamples)
+{
+  if (_continuous || decimation == 0 || _pin < 0)
+  {
+    return LIGHT_SENSOR_ERR_INIT;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  _decimation      = decimation;
+  _decimationCount = 0;
+  _decimationSum   = 0;
+  _sampleCount     = 0;
+  _averageSum      = 0;
+  _ema             = 0.0f;
+  for (uint8_t i = 0; i < _triggerCount; i++)
   {
-    _callback();
+    _triggers[i].known      = false;
+    _triggers[i].holdingOff = false;
   }
+  portEXIT_CRITICAL(&_lock);
+
+  if (bspAdcContinuousBegin((uint8_t) _pin, sampleRateHz, onFrame, this, frameSamples) != BSP_ADC_OK)
+  {
+    return LIGHT_SENSOR_ERR_INIT;
+  }
+  _continuous = true;
   return LIGHT_SENSOR_OK;
 }
 
+void LightSensor::endContinuous()
+{
+  if (_continuous)
+  {
+    bspAdcContinuousEnd();
+    _continuous = false;
+  }
+}
+
+light_sensor_error_t LightSensor::setFilterWindows(uint8_t averageWindow, uint8_t medianWindow)
+{
+  if (averageWindow == 0 || averageWindow > LIGHT_SENSOR_RING_LENGTH || medianWindow == 0 ||
+      medianWindow > LIGHT_SENSOR_MEDIAN_MAX)
+  {
+    return LIGHT_SENSOR_ERR;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  _averageWindow = averageWindow;
+  _medianWindow  = medianWindow;
+
+  // Running sum over the new window
+  uint32_t n  = (_sampleCount < averageWindow) ? _sampleCount : averageWindow;
+  _averageSum = 0;
+  for (uint32_t i = 1; i <= n; i++)
+  {
+    _averageSum += _ring[(_sampleCount - i) & LIGHT_SENSOR_RING_MASK];
+  }
+  portEXIT_CRITICAL(&_lock);
+  return LIGHT_SENSOR_OK;
+}
+
+light_sensor_error_t LightSensor::setEmaAlpha(float alpha)
+{
+  if (!(alpha > 0.0f && alpha <= 1.0f))
+  {
+    return LIGHT_SENSOR_ERR;
+  }
+  _emaAlpha = alpha;
+  return LIGHT_SENSOR_OK;
+}
+
+int LightSensor::getFiltered(light_sensor_filter_t filter) { return filterValue(filter); }
+
+light_sensor_error_t LightSensor::addTrigger(const light_sensor_trigger_t &trigger,
+                                             light_sensor_trigger_cb_t callback, void *arg)
+{
+  if (callback == nullptr || trigger.hysteresis < 0 ||
+      (trigger.type == LIGHT_TRIGGER_BAND && trigger.upper < trigger.threshold))
+  {
+    return LIGHT_SENSOR_ERR;
+  }
+  return addSlot(trigger, callback, nullptr, arg);
+}
+
+light_sensor_error_t LightSensor::addThresholdCallback(int threshold, light_sensor_filter_t filter,
+                                                       light_sensor_threshold_cb_t callback)
+{
+  if (callback == nullptr || threshold < 0)
+  {
+    return LIGHT_SENSOR_ERR;
+  }
+
+  // Below is the band [0, threshold]: entering it is falling below, leaving it is going above
+  light_sensor_trigger_t trigger = { LIGHT_TRIGGER_BAND, filter, 0, threshold, 0, 0 };
+  return addSlot(trigger, nullptr, callback, nullptr);
+}
+
 /* Private function definitions --------------------------------------- */
+light_sensor_error_t LightSensor::addSlot(const light_sensor_trigger_t &trigger,
+                                          light_sensor_trigger_cb_t callback,
+                                          light_sensor_threshold_cb_t thresholdCallback, void *arg)
+{
+  portENTER_CRITICAL(&_lock);
+  if (_triggerCount >= LIGHT_SENSOR_MAX_TRIGGERS)
+  {
+    portEXIT_CRITICAL(&_lock);
+    return LIGHT_SENSOR_ERR;
+  }
+  trigger_slot_t &slot   = _triggers[_triggerCount];
+  slot.config            = trigger;
+  slot.callback          = callback;
+  slot.thresholdCallback = thresholdCallback;
+  slot.arg               = arg;
+  slot.active            = false;
+  slot.known             = false;
+  slot.holdingOff        = false;
+  slot.firedAt           = 0;
+  _triggerCount++;
+  portEXIT_CRITICAL(&_lock);
+  return LIGHT_SENSOR_OK;
+}
+
+void LightSensor::onFrame(const uint16_t *samples, size_t count, void *arg)
+{
+  // ADC reader task: decimate by averaging, only this task touches the decimation state
+  LightSensor *self = (LightSensor *) arg;
+  for (size_t i = 0; i < count; i++)
+  {
+    self->_decimationSum += samples[i];
+    if (++self->_decimationCount < self->_decimation)
+    {
+      continue;
+    }
+
+    uint16_t value         = (uint16_t) ((self->_decimationSum + self->_decimation / 2) / self->_decimation);
+    self->_decimationSum   = 0;
+    self->_decimationCount = 0;
+    self->pushSample(value);
+  }
+}
+
+void LightSensor::pushSample(uint16_t value)
+{
+  portENTER_CRITICAL(&_lock);
+  if (_sampleCount >= _averageWindow)
+  {
+    _averageSum -= _ring[(_sampleCount - _averageWindow) & LIGHT_SENSOR_RING_MASK];
+  }
+  _ring[_sampleCount & LIGHT_SENSOR_RING_MASK] = value;
+  _averageSum += value;
+  _ema = (_sampleCount == 0) ? (float) value : _ema + _emaAlpha * ((float) value - _ema);
+  _sampleCount++;
+  portEXIT_CRITICAL(&_lock);
+
+  evaluateTriggers();
+}
+
+int LightSensor::filterValue(light_sensor_filter_t filter)
+{
+  if (filter == LIGHT_FILTER_MEDIAN)
+  {
+    return median();
+  }
+
+  int value = 0;
+  portENTER_CRITICAL(&_lock);
+  uint32_t count = _sampleCount;
+  if (count > 0)
+  {
+    switch (filter)
+    {
+      case LIGHT_FILTER_AVERAGE:
+      {
+        uint32_t n = (count < _averageWindow) ? count : _averageWindow;
+        value      = (int) ((_averageSum + n / 2) / n);
+        break;
+      }
+
+      case LIGHT_FILTER_EMA:
+        value = (int) lroundf(_ema);
+        break;
+
+      default:
+        value = _ring[(count - 1) & LIGHT_SENSOR_RING_MASK];
+        break;
+    }
+  }
+  portEXIT_CRITICAL(&_lock);
+  return value;
+}
+
+int LightSensor::median()
+{
+  // Copy the window under the lock, sort outside of it
+  uint16_t window[LIGHT_SENSOR_MEDIAN_MAX];
+  portENTER_CRITICAL(&_lock);
+  uint32_t n = (_sampleCount < _medianWindow) ? _sampleCount : _medianWindow;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    window[i] = _ring[(_sampleCount - 1 - i) & LIGHT_SENSOR_RING_MASK];
+  }
+  portEXIT_CRITICAL(&_lock);
+
+  if (n == 0)
+  {
+    return 0;
+  }
+  for (uint32_t i = 1; i < n; i++)
+  {
+    uint16_t value = window[i];
+    uint32_t j     = i;
+    while (j > 0 && window[j - 1] > value)
+    {
+      window[j] = window[j - 1];
+      j--;
+    }
+    window[j] = value;
+  }
+  return window[n / 2];
+}
+
+void LightSensor::evaluateTriggers()
+{
+  // Runs in the task producing the samples, only this task changes the state of the triggers
+  portENTER_CRITICAL(&_lock);
+  uint8_t triggerCount = _triggerCount;
+  portEXIT_CRITICAL(&_lock);
+
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < triggerCount; i++)
+  {
+    trigger_slot_t &slot = _triggers[i];
+    portENTER_CRITICAL(&_lock);
+    light_sensor_trigger_t config = slot.config;
+    portEXIT_CRITICAL(&_lock);
+
+    if (slot.holdingOff)
+    {
+      if (now - slot.firedAt < config.holdOffMs)
+      {
+        continue;
+      }
+      slot.holdingOff = false;
+    }
+
+    int                  value  = filterValue(config.filter);
+    bool                 active = slot.active;
+    bool                 fire   = false;
+    light_sensor_event_t event  = LIGHT_EVENT_RISE;
+    switch (config.type)
+    {
+      case LIGHT_TRIGGER_RISING:
+        if (!active && value > config.threshold)
+        {
+          active = true;
+          fire   = true;
+          event  = LIGHT_EVENT_RISE;
+        }
+        else if (active && value < config.threshold - config.hysteresis)
+        {
+          active = false; // Re-armed, nothing to report
+        }
+        break;
+
+      case LIGHT_TRIGGER_FALLING:
+        if (!active && value < config.threshold)
+        {
+          active = true;
+          fire   = true;
+          event  = LIGHT_EVENT_FALL;
+        }
+        else if (active && value > config.threshold + config.hysteresis)
+        {
+          active = false;
+        }
+        break;
+
+      case LIGHT_TRIGGER_BAND:
+        if (!active && value >= config.threshold && value <= config.upper)
+        {
+          active = true;
+          fire   = true;
+          event  = LIGHT_EVENT_ENTER_BAND;
+        }
+        else if (active && (value < config.threshold - config.hysteresis ||
+                            value > config.upper + config.hysteresis))
+        {
+          active = false;
+          fire   = true;
+          event  = LIGHT_EVENT_LEAVE_BAND;
+        }
+        break;
+    }
+
+    // The first sample only tells the side the value starts on
+    slot.active = active;
+    if (fire && slot.known)
+    {
+      slot.firedAt    = now;
+      slot.holdingOff = config.holdOffMs > 0;
+      if (slot.thresholdCallback != nullptr)
+      {
+        slot.thresholdCallback(value, event == LIGHT_EVENT_LEAVE_BAND);
+      }
+      else
+      {
+        slot.callback(value, event, slot.arg);
+      }
+    }
+    slot.known = true;
+  }
+}
+
+void LightSensor::legacyCallback(int, light_sensor_event_t, void *arg)
+{
+  LightSensor *self = (LightSensor *) arg;
+  if (self->_callback != nullptr)
+  {
+    self->_callback();
+  }
+}
+
+void LightSensor::setSensorValue(int raw)
+{
+  sensorValue[0] = raw;
+  sensorValue[1] = map(sensorValue[0], 0, 4095, 0, 100);
+  sensorValue[1] = constrain(sensorValue[1], 0, 100);
+}
 
 /* End of file -------------------------------------------------------- */
@@ -21,6 +21,11 @@
   #endif
 
 /* Public defines ----------------------------------------------------- */
+  #define LIGHT_SENSOR_RING_LENGTH    32 // Decimated samples kept by the continuous pipeline, power of two
+  #define LIGHT_SENSOR_MEDIAN_MAX     15 // Longest median window
+  #define LIGHT_SENSOR_MAX_TRIGGERS   8
+  #define LIGHT_SENSOR_FRAME_SAMPLES  64 // Conversions per DMA frame, one wake-up of the ADC reader each
+
 typedef enum
 {
   LIGHT_SENSOR_OK = 0,   /* No error */
@@ -30,6 +35,60 @@ typedef enum
 } light_sensor_error_t;
 
 /* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief Output of the continuous pipeline.
+ */
+typedef enum
+{
+  LIGHT_FILTER_LATEST = 0, /* Last decimated sample */
+  LIGHT_FILTER_AVERAGE,    /* Moving average of the last `averageWindow` decimated samples */
+  LIGHT_FILTER_MEDIAN,     /* Median of the last `medianWindow` decimated samples, rejects spikes */
+  LIGHT_FILTER_EMA         /* Exponential moving average */
+} light_sensor_filter_t;
+
+/**
+ * @brief Kind of trigger evaluated on every sample.
+ */
+typedef enum
+{
+  LIGHT_TRIGGER_RISING = 0, /* Value goes above `threshold`, re-armed below `threshold - hysteresis` */
+  LIGHT_TRIGGER_FALLING,    /* Value goes below `threshold`, re-armed above `threshold + hysteresis` */
+  LIGHT_TRIGGER_BAND        /* Value enters [`threshold`, `upper`], leaves it by more than `hysteresis` */
+} light_sensor_trigger_type_t;
+
+/**
+ * @brief Event passed to a trigger callback.
+ */
+typedef enum
+{
+  LIGHT_EVENT_RISE = 0,   /* `LIGHT_TRIGGER_RISING` fired */
+  LIGHT_EVENT_FALL,       /* `LIGHT_TRIGGER_FALLING` fired */
+  LIGHT_EVENT_ENTER_BAND, /* `LIGHT_TRIGGER_BAND`, value entered the band */
+  LIGHT_EVENT_LEAVE_BAND  /* `LIGHT_TRIGGER_BAND`, value left the band */
+} light_sensor_event_t;
+
+/**
+ * @brief Trigger configuration, see `LightSensor::addTrigger()`.
+ */
+typedef struct
+{
+  light_sensor_trigger_type_t type;
+  light_sensor_filter_t       filter;     /**< Value watched, e.g. the median to ignore spikes */
+  int                         threshold;  /**< Raw value (0–4095), lower edge of a band */
+  int                         upper;      /**< Upper edge of a band, unused otherwise */
+  int                         hysteresis; /**< Raw counts to move back by before the trigger re-arms */
+  uint32_t                    holdOffMs;  /**< After firing, the trigger ignores samples for this long */
+} light_sensor_trigger_t;
+
+/**
+ * @brief Trigger callback: the filtered value that fired it, the event and the argument of `addTrigger()`.
+ */
+typedef void (*light_sensor_trigger_cb_t)(int value, light_sensor_event_t event, void *arg);
+
+/**
+ * @brief Threshold callback: the filtered value and the side it crossed to.
+ */
+typedef void (*light_sensor_threshold_cb_t)(int value, bool above);
 
 /* Public macros ------------------------------------------------------ */
 
@@ -63,6 +122,22 @@ typedef enum
  * for smoothed data, or `onThresholdCross()` to set up event-driven callbacks. Regularly call `read()` to
  * update sensor values.
  *
+ * ### Continuous mode:
+ *
+ * `beginContinuous()` hands the pin to the ADC DMA engine (`bsp_adc`). Conversions arrive in frames at a
+ * fixed rate, are decimated by averaging (oversampling), and each decimated sample goes into a ring buffer
+ * and through the moving average, median and EMA filters. `read()`, `getFiltered()` and `getAverageReading()`
+ * then return at once with the latest filtered values instead of converting and waiting. A frame is processed
+ * at once when the DMA completes it: larger frames wake the CPU less often, at the cost of trigger latency.
+ *
+ * ### Triggers:
+ *
+ * Rising, falling and band triggers added with `addTrigger()` are evaluated on every new sample: each
+ * decimated sample in continuous mode, each `read()` otherwise. `addThresholdCallback()` is the short form for
+ * a threshold crossed in either direction. They are edge-triggered, with hysteresis so a
+ * noisy value sitting on the threshold fires once, and a hold-off so a flickering light cannot flood the
+ * callback. An automation hooked on a trigger reacts within one sample period.
+ *
  * ### Dependencies:
  *
  * - Requires an Arduino-compatible board with analog input support (12-bit ADC).
@@ -70,6 +145,7 @@ typedef enum
  * - Sensor must be connected to a valid analog pin.
  *
  * - Depends on `bsp_gpio.h` for analog reading (`bspGpioAnalogRead`).
+ * - Depends on `bsp_adc.h` for the continuous mode, ADC1 pins only.
  *
  * - Callback functions must be defined before use with `onThresholdCross()`.
  */
@@ -92,7 +168,8 @@ public:
    * @brief Reads the analog value from the light sensor.
    *
    * Uses the `bspGpioAnalogRead` function to retrieve the raw 12-bit analog value (0–4095) from the sensor
-   * and computes a percentage value (0–100), storing both internally.
+   * and computes a percentage value (0–100), storing both internally. In continuous mode, stores the moving
+   * average of the pipeline instead, without touching the ADC.
    *
    * @param[in] None
    *
@@ -164,7 +241,8 @@ public:
    * @brief Computes the average sensor reading over multiple samples.
    *
    * Takes multiple readings from the sensor with a 10ms delay between each and returns their average to
-   * reduce noise.
+   * reduce noise. In continuous mode, returns the moving average of the pipeline at once and ignores
+   * `samples`.
    *
    * @param[in] samples Number of samples to average (default: 10).
    *
@@ -177,8 +255,10 @@ public:
   /**
    * @brief Sets a callback function for threshold-crossing events.
    *
-   * Configures a callback function to be triggered when the light intensity crosses the specified threshold,
-   * invoking the callback if the threshold is currently exceeded.
+   * Configures a callback function to be triggered when the light intensity rises above the specified
+   * threshold. This is a `LIGHT_TRIGGER_RISING` trigger on the latest sample, without hysteresis: it fires on
+   * the sample that crosses, not when the value already is above. Calling it again replaces the threshold and
+   * the callback.
    *
    * @param[in] threshold The threshold value for triggering the callback (0–4095).
    * @param[in] callback The function to call when the threshold is crossed.
@@ -193,10 +273,151 @@ public:
    */
   light_sensor_error_t onThresholdCross(int threshold, void (*callback)());
 
+  /**
+   * @brief Starts the continuous pipeline.
+   *
+   * @param[in] sampleRateHz ADC conversions per second, `BSP_ADC_MIN_SAMPLE_RATE` to
+   * `BSP_ADC_MAX_SAMPLE_RATE`.
+   * @param[in] decimation   Conversions averaged into one decimated sample (1-255). The filters and the
+   * threshold callbacks run at `sampleRateHz / decimation`.
+   * @param[in] frameSamples Conversions per DMA frame, 1 to `BSP_ADC_MAX_FRAME_SAMPLES`. The samples of a
+   * frame are filtered, and the triggers evaluated, when the frame completes: every
+   * `frameSamples / sampleRateHz` seconds.
+   *
+   * @attention One pin at a time can stream, the ADC has one DMA engine.
+   *
+   * @return
+   *  - `LIGHT_SENSOR_OK`: Success
+   *
+   *  - `LIGHT_SENSOR_ERR_INIT`: Invalid rate, decimation or frame, pin not usable, or the ADC is already
+   *  streaming
+   */
+  light_sensor_error_t beginContinuous(uint32_t sampleRateHz = 1000, uint8_t decimation = 10,
+                                       uint16_t frameSamples = LIGHT_SENSOR_FRAME_SAMPLES);
+
+  /**
+   * @brief Stops the continuous pipeline, `read()` converts on demand again. The filters keep their values.
+   */
+  void endContinuous();
+
+  /**
+   * @brief Sets the windows of the moving average and median filters, in decimated samples.
+   *
+   * @param[in] averageWindow 1 to `LIGHT_SENSOR_RING_LENGTH` (default 8).
+   * @param[in] medianWindow  1 to `LIGHT_SENSOR_MEDIAN_MAX` (default 5).
+   *
+   * @return
+   *  - `LIGHT_SENSOR_OK`: Success
+   *
+   *  - `LIGHT_SENSOR_ERR`: Window out of range
+   */
+  light_sensor_error_t setFilterWindows(uint8_t averageWindow, uint8_t medianWindow);
+
+  /**
+   * @brief Sets the weight of the newest sample in the exponential moving average.
+   *
+   * @param[in] alpha 0 (exclusive) to 1 (default 0.2). Higher follows faster, lower smooths more.
+   *
+   * @return
+   *  - `LIGHT_SENSOR_OK`: Success
+   *
+   *  - `LIGHT_SENSOR_ERR`: Alpha out of range
+   */
+  light_sensor_error_t setEmaAlpha(float alpha);
+
+  /**
+   * @brief Retrieves a filtered value of the continuous pipeline. Does not block.
+   *
+   * @param[in] filter Which output.
+   *
+   * @return int The filtered raw value (0–4095), `0` before the first decimated sample.
+   */
+  int getFiltered(light_sensor_filter_t filter);
+
+  /**
+   * @brief Adds a trigger evaluated on every new sample.
+   *
+   * The state of the trigger (above, below, inside the band) is taken from the first sample it sees, the
+   * callback fires on later transitions only. It runs in the task producing the samples: the ADC reader task
+   * in continuous mode, the caller of `read()` otherwise. Keep it short and do not call back into the sensor.
+   *
+   * @param[in] trigger  Configuration, copied.
+   * @param[in] callback Called with the filtered value and the event.
+   * @param[in] arg      Passed to the callback.
+   *
+   * @return
+   *  - `LIGHT_SENSOR_OK`: Success
+   *
+   *  - `LIGHT_SENSOR_ERR`: Null callback, invalid band or hysteresis, or `LIGHT_SENSOR_MAX_TRIGGERS` already
+   * added
+   */
+  light_sensor_error_t addTrigger(const light_sensor_trigger_t &trigger, light_sensor_trigger_cb_t callback,
+                                  void *arg = nullptr);
+
+  /**
+   * @brief Adds a callback fired when a filtered value crosses a threshold, in either direction.
+   *
+   * A trigger without hysteresis nor hold-off, see `addTrigger()`: the side is taken from the first sample,
+   * the callback fires on later crossings and runs in the task producing the samples.
+   *
+   * @param[in] threshold Raw value (0–4095), above means strictly greater.
+   * @param[in] filter    Filtered value compared with the threshold, e.g. the median to ignore spikes.
+   * @param[in] callback  Called with the value and `true` when it went above, `false` when it fell below.
+   *
+   * @return
+   *  - `LIGHT_SENSOR_OK`: Success
+   *
+   *  - `LIGHT_SENSOR_ERR`: Null callback, negative threshold or `LIGHT_SENSOR_MAX_TRIGGERS` already added
+   */
+  light_sensor_error_t addThresholdCallback(int threshold, light_sensor_filter_t filter,
+                                            light_sensor_threshold_cb_t callback);
+
+  bool     isContinuous() { return _continuous; }
+  uint32_t getSampleCount() { return _sampleCount; } /** Decimated samples since beginContinuous() */
+
 private:
   int      _pin;                 /** SIG pin of the Light Sensor */
   uint32_t sensorValue[2];       /** Value from the sensor */
   void (*_callback)() = nullptr; /** Callback function */
+
+  typedef struct
+  {
+    light_sensor_trigger_t      config;
+    light_sensor_trigger_cb_t   callback;
+    light_sensor_threshold_cb_t thresholdCallback; /** Called instead of `callback` if set */
+    void                       *arg;
+    bool                        active;            /** Fired and not re-armed yet, inside for a band */
+    bool                        known;             /** Side known from a first sample, report transitions */
+    bool                        holdingOff;        /** Fired less than `holdOffMs` ago */
+    uint32_t                    firedAt;           /** millis() of the last event */
+  } trigger_slot_t;
+
+  // Continuous pipeline, written by the ADC reader task and read by the others under _lock
+  portMUX_TYPE   _lock;
+  bool           _continuous;
+  uint8_t        _decimation;
+  uint8_t        _decimationCount;
+  uint32_t       _decimationSum;
+  uint16_t       _ring[LIGHT_SENSOR_RING_LENGTH];
+  uint32_t       _sampleCount;
+  uint8_t        _averageWindow;
+  uint8_t        _medianWindow;
+  uint32_t       _averageSum;
+  float          _emaAlpha;
+  float          _ema;
+  trigger_slot_t _triggers[LIGHT_SENSOR_MAX_TRIGGERS];
+  uint8_t        _triggerCount;
+  int8_t         _legacyTrigger; /** Slot used by onThresholdCross(), -1 if none */
+
+  static void          onFrame(const uint16_t *samples, size_t count, void *arg);
+  void                 pushSample(uint16_t value);
+  int                  filterValue(light_sensor_filter_t filter);
+  int                  median();
+  light_sensor_error_t addSlot(const light_sensor_trigger_t &trigger, light_sensor_trigger_cb_t callback,
+                               light_sensor_threshold_cb_t thresholdCallback, void *arg);
+  void                 evaluateTriggers();
+  static void          legacyCallback(int value, light_sensor_event_t event, void *arg);
+  void                 setSensorValue(int raw);
 };
 
 #endif // LIGHT_SENSOR_H
@@ -12,7 +12,11 @@
 /* Includes ----------------------------------------------------------- */
 #include "mini_fan.h"
 #include "bsp_gpio.h"
+#include "bsp_timer.h"
+
+#include <math.h>
 /* Private defines ---------------------------------------------------- */
+#define MINI_FAN_MAX_DUTY 255
 
 /* Private enumerate/structure ---------------------------------------- */
 
@@ -25,8 +29,14 @@
 /* Class method Definitions ---------------------------------- */
 
 // Constructor
-MiniFan::MiniFan(int pin) : _pin(pin)
+MiniFan::MiniFan(int pin)
+    : _pin(pin), _rampReady(false), _timer(0), _ramping(false), _target(0), _slewRate(0.0f), _accel(0.0f),
+      _linearRate(0.0f), _velocity(0.0f), _duty(0.0f), _written(0), _kickDuty(MINI_FAN_MAX_DUTY), _kickMs(0),
+      _kicking(false), _kickStart(0)
 {
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+
   bspGpioPinMode(_pin, OUTPUT);
   _speed[0] = 0;
   _speed[1] = 0;
@@ -43,7 +53,7 @@ void MiniFan::setFanSpeed(int speed)
   status = (_speed[0] > 0);
 
   // Spin the fan
-  bspGpioAnalogWrite(_pin, _speed[0]);
+  applySpeed(_speed[0]);
 }
 
 void MiniFan::setFanSpeedPercentage(int percentage)
@@ -56,7 +66,7 @@ void MiniFan::setFanSpeedPercentage(int percentage)
   _speed[0] = map(percentage, 0, 100, 0, 255);
 
   // Set the fan speed using the mapped PWM value
-  bspGpioAnalogWrite(_pin, _speed[0]);
+  applySpeed(_speed[0]);
 
   // Update the fan state
   status = (_speed[0] > 0);
@@ -70,14 +80,14 @@ void MiniFan::toggleFan()
 {
   if (isFanRunning())
   {
-    bspGpioAnalogWrite(_pin, LOW);
+    applySpeed(LOW);
     status = false;
   }
   else
   {
     // Restore previous speed or default to maximum if unset
     int targetSpeed = (_speed[0] > 0) ? _speed[0] : 255;
-    bspGpioAnalogWrite(_pin, targetSpeed);
+    applySpeed(targetSpeed);
     // Update percentage if default speed is used
     if (_speed[0] == 0)
     {
@@ -90,6 +100,228 @@ void MiniFan::toggleFan()
 
 bool MiniFan::isFanRunning() { return status; }
 
+mini_fan_error_t MiniFan::beginRamp()
+{
+  if (_rampReady)
+  {
+    return MINI_FAN_OK;
+  }
+  if (bspTimerCreate(onTick, this, "fan_ramp", &_timer) != BSP_TIMER_OK)
+  {
+    return MINI_FAN_ERR_INIT;
+  }
+  _rampReady = true;
+  return MINI_FAN_OK;
+}
+
+mini_fan_error_t MiniFan::setRampProfile(float slewPercentPerSec, float accelPercentPerSec2)
+{
+  if (!(slewPercentPerSec >= 0.0f) || !(accelPercentPerSec2 >= 0.0f))
+  {
+    return MINI_FAN_ERR;
+  }
+
+  // Percent to PWM counts
+  portENTER_CRITICAL(&_lock);
+  _slewRate = slewPercentPerSec * MINI_FAN_MAX_DUTY / 100.0f;
+  _accel    = accelPercentPerSec2 * MINI_FAN_MAX_DUTY / 100.0f;
+  portEXIT_CRITICAL(&_lock);
+  return MINI_FAN_OK;
+}
+
+void MiniFan::setKickStart(int percentage, uint16_t durationMs)
+{
+  percentage = constrain(percentage, 0, 100);
+
+  portENTER_CRITICAL(&_lock);
+  _kickDuty = map(percentage, 0, 100, 0, MINI_FAN_MAX_DUTY);
+  _kickMs   = durationMs;
+  portEXIT_CRITICAL(&_lock);
+}
+
+mini_fan_error_t MiniFan::rampTo(int percentage, uint32_t durationMs)
+{
+  if (durationMs > 0 && !_rampReady)
+  {
+    return MINI_FAN_ERR_INIT;
+  }
+
+  percentage = constrain(percentage, 0, 100);
+  _speed[1]  = percentage;
+  _speed[0]  = map(percentage, 0, 100, 0, 255);
+  status     = (_speed[0] > 0);
+
+  if (durationMs == 0)
+  {
+    setOutput(_speed[0]);
+  }
+  else
+  {
+    startRamp(_speed[0], durationMs);
+  }
+  return MINI_FAN_OK;
+}
+
+bool MiniFan::isRamping() { return _ramping; }
+
+int MiniFan::getOutputDuty() { return _written; }
+
 /* Private function definitions --------------------------------------- */
+void MiniFan::applySpeed(int duty)
+{
+  if (_rampReady && _slewRate > 0.0f)
+  {
+    startRamp(duty, 0);
+  }
+  else
+  {
+    setOutput(duty);
+  }
+}
+
+void MiniFan::setOutput(int duty)
+{
+  portENTER_CRITICAL(&_lock);
+  _target     = duty;
+  _duty       = (float) duty;
+  _velocity   = 0.0f;
+  _linearRate = 0.0f;
+  _kicking    = false;
+  _ramping    = false;
+  portEXIT_CRITICAL(&_lock);
+
+  if (_rampReady)
+  {
+    bspTimerStop(_timer);
+  }
+  writeDuty(duty);
+}
+
+void MiniFan::startRamp(int duty, uint32_t durationMs)
+{
+  portENTER_CRITICAL(&_lock);
+  // A reversal starts from rest, a change in the same direction keeps the current slew
+  if ((duty - _duty) * _velocity < 0.0f)
+  {
+    _velocity = 0.0f;
+  }
+  _target     = duty;
+  _linearRate = (durationMs > 0) ? fabsf(duty - _duty) * 1000.0f / durationMs : 0.0f;
+
+  bool kick = !_kicking && _written == 0 && duty > 0 && _kickMs > 0;
+  if (kick)
+  {
+    _kicking   = true;
+    _kickStart = millis();
+    _velocity  = 0.0f;
+  }
+  bool wasRamping = _ramping;
+  _ramping        = true;
+  int  kickDuty   = _kickDuty;
+  portEXIT_CRITICAL(&_lock);
+
+  if (kick)
+  {
+    writeDuty(kickDuty);
+  }
+  if (!wasRamping)
+  {
+    bspTimerStartPeriodic(_timer, MINI_FAN_RAMP_TICK_MS * 1000UL);
+  }
+}
+
+void MiniFan::onTick(void *arg)
+{
+  // esp_timer task
+  MiniFan *self = (MiniFan *) arg;
+  bool     done = false;
+  int      duty = self->tick(done);
+  if (duty != self->_written)
+  {
+    self->writeDuty(duty);
+  }
+  if (!done)
+  {
+    return;
+  }
+
+  bspTimerStop(self->_timer);
+
+  // A speed change between the last step and the stop found the engine running and did not start it
+  portENTER_CRITICAL(&self->_lock);
+  bool again = self->_ramping;
+  portEXIT_CRITICAL(&self->_lock);
+  if (again)
+  {
+    bspTimerStartPeriodic(self->_timer, MINI_FAN_RAMP_TICK_MS * 1000UL);
+  }
+}
+
+int MiniFan::tick(bool &done)
+{
+  const float dt = MINI_FAN_RAMP_TICK_MS / 1000.0f;
+
+  portENTER_CRITICAL(&_lock);
+  if (_kicking)
+  {
+    if (millis() - _kickStart < _kickMs)
+    {
+      int kickDuty = _kickDuty;
+      portEXIT_CRITICAL(&_lock);
+      return kickDuty;
+    }
+    // Spinning now, carry on from the kick or drop to a lower target
+    _kicking = false;
+    _duty    = (float) ((_kickDuty < _target) ? _kickDuty : _target);
+  }
+
+  float remaining = _target - _duty;
+  float step;
+  if (_linearRate > 0.0f)
+  {
+    step = _linearRate * dt;
+  }
+  else
+  {
+    // Trapezoidal slew: build up at `_accel`, cruise at `_slewRate`, slow down to stop on the target
+    float speed = (_accel > 0.0f) ? fabsf(_velocity) + _accel * dt : _slewRate;
+    if (speed > _slewRate)
+    {
+      speed = _slewRate;
+    }
+    if (_accel > 0.0f)
+    {
+      float stopping = sqrtf(2.0f * _accel * fabsf(remaining));
+      if (speed > stopping)
+      {
+        speed = stopping;
+      }
+    }
+    _velocity = (remaining >= 0.0f) ? speed : -speed;
+    step      = speed * dt;
+  }
+
+  if (step <= 0.0f || fabsf(remaining) <= step)
+  {
+    _duty       = (float) _target;
+    _velocity   = 0.0f;
+    _linearRate = 0.0f;
+    _ramping    = false;
+    done        = true;
+  }
+  else
+  {
+    _duty += (remaining > 0.0f) ? step : -step;
+  }
+  int duty = (int) lroundf(_duty);
+  portEXIT_CRITICAL(&_lock);
+  return duty;
+}
+
+void MiniFan::writeDuty(int duty)
+{
+  _written = duty;
+  bspGpioAnalogWrite(_pin, duty);
+}
 
 /* End of file -------------------------------------------------------- */
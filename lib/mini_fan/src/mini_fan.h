@@ -21,6 +21,14 @@
   #endif
 
 /* Public defines ----------------------------------------------------- */
+  #define MINI_FAN_RAMP_TICK_MS 10 // Period of the ramp engine while a ramp runs
+
+typedef enum
+{
+  MINI_FAN_OK = 0,   /* No error */
+  MINI_FAN_ERR,      /* Generic error, invalid argument */
+  MINI_FAN_ERR_INIT  /* Ramp engine not started or timer unavailable */
+} mini_fan_error_t;
 
 /* Public enumerate/structure ----------------------------------------- */
 
@@ -49,6 +57,23 @@
  *
  * - Stores fan speed and state internally for consistent control.
  *
+ * - Optional ramp engine: the output slews to the requested speed instead of jumping to it, with a kick-start
+ * pulse to get a stopped fan turning.
+ *
+ * ### Ramping:
+ *
+ * After `beginRamp()`, a periodic timer moves the output towards the target every `MINI_FAN_RAMP_TICK_MS`
+ * and stops once it is reached, so the fan costs nothing while its speed is steady. `setRampProfile()` sets
+ * the slew rate and the acceleration used by `setFanSpeed()`, `setFanSpeedPercentage()` and `toggleFan()`:
+ * the slew speeds up, cruises and slows down before the target, there is no audible step and no inrush
+ * current spike. `rampTo()` runs one linear ramp of a given duration. All calls return at once.
+ *
+ * Starting from standstill, `setKickStart()` drives the fan at the kick duty for a short time first, then
+ * the ramp resumes from the lower of the kick and the target speed. A fan that needs more than its target
+ * duty to break away still starts.
+ *
+ * The speed getters return the requested (target) speed, `getOutputDuty()` the duty written right now.
+ *
  * ### Usage:
  *
  * Instantiate the class with a PWM-capable pin. Use `setFanSpeed()` or `setFanSpeedPercentage()` to control
@@ -62,6 +87,8 @@
  * - Fan must be connected to a valid PWM-capable pin.
  *
  * - Depends on `bsp_gpio.h` for GPIO operations (`bspGpioAnalogWrite`, `bspGpioDigitalWrite`).
+ *
+ * - Depends on `bsp_timer.h` for the ramp tick. The tick runs in the esp_timer task.
  */
 class MiniFan
 {
@@ -146,10 +173,96 @@ public:
    */
   bool isFanRunning();
 
+  /**
+   * @brief Starts the ramp engine.
+   *
+   * Until a profile is set with `setRampProfile()`, speed changes still apply at once.
+   *
+   * @return
+   *  - `MINI_FAN_OK`: Success
+   *
+   *  - `MINI_FAN_ERR_INIT`: No timer available
+   */
+  mini_fan_error_t beginRamp();
+
+  /**
+   * @brief Sets the ramp used by `setFanSpeed()`, `setFanSpeedPercentage()` and `toggleFan()`.
+   *
+   * @param[in] slewPercentPerSec   Highest rate of change, `0` to apply speed changes at once.
+   * @param[in] accelPercentPerSec2 Rate at which the slew builds up and winds down, `0` for no limit.
+   *
+   * @return
+   *  - `MINI_FAN_OK`: Success
+   *
+   *  - `MINI_FAN_ERR`: Negative rate
+   */
+  mini_fan_error_t setRampProfile(float slewPercentPerSec, float accelPercentPerSec2 = 0.0f);
+
+  /**
+   * @brief Sets the pulse that gets a stopped fan turning.
+   *
+   * @param[in] percentage Duty of the pulse (0–100%).
+   * @param[in] durationMs Length of the pulse, `0` to disable it.
+   */
+  void setKickStart(int percentage, uint16_t durationMs);
+
+  /**
+   * @brief Ramps linearly to a speed over a given time, without blocking.
+   *
+   * Overrides the profile for this ramp only. A later speed change takes over from the current output.
+   *
+   * @param[in] percentage Target speed (0–100%).
+   * @param[in] durationMs Time to reach it, `0` to apply it at once.
+   *
+   * @return
+   *  - `MINI_FAN_OK`: Ramp started
+   *
+   *  - `MINI_FAN_ERR_INIT`: `beginRamp()` was not called and `durationMs` is not `0`
+   */
+  mini_fan_error_t rampTo(int percentage, uint32_t durationMs);
+
+  /**
+   * @brief Tells if the output is still moving towards the target.
+   *
+   * @return bool `true` while a ramp or a kick-start runs.
+   */
+  bool isRamping();
+
+  /**
+   * @brief Retrieves the duty written to the pin, which lags the target while ramping.
+   *
+   * @return int The output as a PWM value (0–255).
+   */
+  int getOutputDuty();
+
 private:
   int  _pin;      /** SIG pin of the Mini Fan */
   int  _speed[2]; /** Speed of the fan */
   bool status;    /**< Status of the fan (ON/OFF) */
+
+  // Ramp engine, the timer tick and the setters share it under _lock
+  portMUX_TYPE _lock;
+  bool         _rampReady;
+  uint8_t      _timer;
+  bool         _ramping;
+  int          _target;     /** Duty the output moves to */
+  float        _slewRate;   /** PWM counts per second, 0 = no ramp */
+  float        _accel;      /** PWM counts per second squared, 0 = no limit */
+  float        _linearRate; /** Rate of a rampTo() ramp, 0 = use the profile */
+  float        _velocity;   /** Current slew, PWM counts per second */
+  float        _duty;       /** Current output */
+  int          _written;    /** Last duty written to the pin */
+  int          _kickDuty;
+  uint16_t     _kickMs;
+  bool         _kicking;
+  uint32_t     _kickStart;
+
+  void        applySpeed(int duty);
+  void        setOutput(int duty);
+  void        startRamp(int duty, uint32_t durationMs);
+  static void onTick(void *arg);
+  int         tick(bool &done);
+  void        writeDuty(int duty);
 };
 
 #endif // MINI_FAN_H
@@ -0,0 +1,161 @@
+/**
+ * @file       rpc_router.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-22
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for RPC Router library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "rpc_router.h"
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Function definitions ----------------------------------------------- */
+const char *rpcRouterErrorName(rpc_router_error_t error)
+{
+  switch (error)
+  {
+    case RPC_ROUTER_OK:
+      return "ok";
+    case RPC_ROUTER_ERR_INVALID_PARAMS:
+      return "invalid params";
+    case RPC_ROUTER_ERR_UNKNOWN_METHOD:
+      return "unknown method";
+    default:
+      return "failed";
+  }
+}
+
+/* Class method definitions ------------------------------------------- */
+RpcRouter::RpcRouter(const rpc_method_t *methods, uint8_t count)
+    : _methods(methods), _count((count < RPC_ROUTER_MAX_METHODS) ? count : RPC_ROUTER_MAX_METHODS),
+      _totalCalls(0)
+{
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+  memset(_stats, 0, sizeof(_stats));
+}
+
+int RpcRouter::find(const char *name) const
+{
+  if (name == nullptr)
+  {
+    return -1;
+  }
+
+  // The hash settles it, the name comparison only guards against a name outside the table
+  uint32_t hash = fnv1a(name);
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_methods[i].hash == hash && strcmp(_methods[i].name, name) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+rpc_router_error_t RpcRouter::dispatch(uint8_t index, const JsonVariantConst &params, JsonDocument &response)
+{
+  if (index >= _count)
+  {
+    return RPC_ROUTER_ERR_UNKNOWN_METHOD;
+  }
+
+  uint32_t           start   = micros();
+  rpc_router_error_t error   = _methods[index].handler(params, response);
+  uint32_t           elapsed = micros() - start;
+
+  if (error != RPC_ROUTER_OK && response.isNull())
+  {
+    response["error"] = rpcRouterErrorName(error);
+  }
+
+  portENTER_CRITICAL(&_lock);
+  rpc_method_stats_t &stats = _stats[index];
+  stats.calls++;
+  stats.errors += (error != RPC_ROUTER_OK) ? 1 : 0;
+  stats.totalUs += elapsed;
+  if (elapsed > stats.maxUs)
+  {
+    stats.maxUs = elapsed;
+  }
+  _totalCalls++;
+  portEXIT_CRITICAL(&_lock);
+  return error;
+}
+
+rpc_router_error_t RpcRouter::dispatch(const char *name, const JsonVariantConst &params,
+                                      JsonDocument &response)
+{
+  int index = find(name);
+  if (index < 0)
+  {
+    response["error"] = rpcRouterErrorName(RPC_ROUTER_ERR_UNKNOWN_METHOD);
+    return RPC_ROUTER_ERR_UNKNOWN_METHOD;
+  }
+  return dispatch((uint8_t) index, params, response);
+}
+
+bool RpcRouter::getStats(uint8_t index, rpc_method_stats_t &stats)
+{
+  if (index >= _count)
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  stats = _stats[index];
+  portEXIT_CRITICAL(&_lock);
+  return true;
+}
+
+uint32_t RpcRouter::getTotalCalls()
+{
+  portENTER_CRITICAL(&_lock);
+  uint32_t calls = _totalCalls;
+  portEXIT_CRITICAL(&_lock);
+  return calls;
+}
+
+bool RpcRouter::exportStats(JsonObject out)
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    rpc_method_stats_t stats;
+    getStats(i, stats);
+
+    JsonObject method = out.createNestedObject(_methods[i].name);
+    if (method.isNull())
+    {
+      return false;
+    }
+    method["calls"]  = stats.calls;
+    method["errors"] = stats.errors;
+    method["avgUs"]  = (stats.calls > 0) ? (uint32_t) (stats.totalUs / stats.calls) : 0;
+    method["maxUs"]  = stats.maxUs;
+  }
+  return true;
+}
+
+void RpcRouter::resetStats()
+{
+  portENTER_CRITICAL(&_lock);
+  memset(_stats, 0, sizeof(_stats));
+  _totalCalls = 0;
+  portEXIT_CRITICAL(&_lock);
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,206 @@
+/**
+ * @file       rpc_router.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-22
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for RPC Router library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef RPC_ROUTER_H
+  #define RPC_ROUTER_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include "utility.h"
+
+  #include <ArduinoJson.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define RPC_ROUTER_LIB_VERSION (F("0.1.0"))
+
+  #define RPC_ROUTER_MAX_METHODS 16
+
+  // Object of one member per method, each {"calls", "errors", "avgUs", "maxUs"}
+  #define RPC_ROUTER_STATS_CAPACITY(methods) (JSON_OBJECT_SIZE(methods) + (methods) * JSON_OBJECT_SIZE(4))
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  RPC_ROUTER_OK = 0,              /* No error */
+  RPC_ROUTER_ERR,                 /* Generic error, the handler failed */
+  RPC_ROUTER_ERR_INVALID_PARAMS,  /* Parameters missing or of the wrong type */
+  RPC_ROUTER_ERR_UNKNOWN_METHOD   /* No method at this index or with this name */
+} rpc_router_error_t;
+
+/**
+ * @brief Handles one call. Writes its result straight into `response`, the document sent back to the server.
+ */
+typedef rpc_router_error_t (*rpc_handler_t)(const JsonVariantConst &params, JsonDocument &response);
+
+typedef struct
+{
+  const char   *name;    /**< Method name as sent by the server */
+  uint32_t      hash;    /**< `fnv1a(name)`, computed at compile time by `RPC_METHOD()` */
+  rpc_handler_t handler;
+} rpc_method_t;
+
+typedef struct
+{
+  uint32_t calls;   /**< Calls dispatched */
+  uint32_t errors;  /**< Calls whose handler did not return `RPC_ROUTER_OK` */
+  uint32_t maxUs;   /**< Slowest call */
+  uint64_t totalUs; /**< Time spent in the handler over all calls */
+} rpc_method_stats_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define RPC_METHOD(name, handler)                                                                          \
+    {                                                                                                        \
+      (name), fnv1a(name), (handler)                                                                         \
+    }
+
+  #define RPC_METHOD_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+/* Public variables --------------------------------------------------- */
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Checks at compile time that no method after `i` shares the hash of method `i`.
+ */
+constexpr bool rpcHashUniqueAfter(const rpc_method_t *methods, size_t count, size_t i, size_t j)
+{
+  return (j >= count) || (methods[i].hash != methods[j].hash && rpcHashUniqueAfter(methods, count, i, j + 1));
+}
+
+/**
+ * @brief Checks at compile time that no two methods of a table share a hash, for a `static_assert()`.
+ */
+constexpr bool rpcHashesUnique(const rpc_method_t *methods, size_t count, size_t i = 0)
+{
+  return (i >= count) ||
+         (rpcHashUniqueAfter(methods, count, i, i + 1) && rpcHashesUnique(methods, count, i + 1));
+}
+
+/**
+ * @brief Retrieves the name of an error, as sent back in the `error` member of a failed call.
+ */
+const char *rpcRouterErrorName(rpc_router_error_t error);
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Dispatcher over a constant table of RPC methods.
+ *
+ * The `RpcRouter` class keeps the methods in a `constexpr` table instead of a list of callbacks built at run
+ * time. Each entry carries the FNV-1a hash of its name, computed by the compiler, and `rpcHashesUnique()`
+ * rejects a colliding table at compile time. Handlers get the response document the transport sends back and
+ * fill it directly, no intermediate document is built. Every call is timed and counted per method.
+ *
+ * ### Features:
+ *
+ * - Lookup by name compares hashes first, then the name of the single candidate.
+ *
+ * - Per-method call, error and latency counters, exported as one JSON object.
+ *
+ * - A failed call without a response gets `{"error": "<reason>"}`.
+ *
+ * - No allocation: the table is in flash, the counters are a fixed array.
+ *
+ * ### Usage:
+ *
+ * ```
+ * constexpr rpc_method_t RPC_METHODS[] = { RPC_METHOD("setLedValue", processSetLedState) };
+ * static_assert(rpcHashesUnique(RPC_METHODS, RPC_METHOD_COUNT(RPC_METHODS)), "RPC method hash collision");
+ * RpcRouter rpcRouter(RPC_METHODS, RPC_METHOD_COUNT(RPC_METHODS));
+ * // From the transport callback of method i
+ * rpcRouter.dispatch(i, params, response);
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - ArduinoJson 6 and `fnv1a()` from `utility.h`. `dispatch()` and the statistics are safe from any task.
+ */
+class RpcRouter
+{
+public:
+  /**
+   * @param[in] methods Method table, kept by reference.
+   * @param[in] count   Number of methods, at most `RPC_ROUTER_MAX_METHODS`. Extra methods are ignored.
+   */
+  RpcRouter(const rpc_method_t *methods, uint8_t count);
+
+  /**
+   * @brief Finds a method by name.
+   *
+   * @param[in] name Method name.
+   *
+   * @return int Index of the method, `-1` if unknown.
+   */
+  int find(const char *name) const;
+
+  /**
+   * @brief Runs a method and records its duration and result.
+   *
+   * @param[in]  index    Index of the method in the table.
+   * @param[in]  params   Parameters of the call.
+   * @param[out] response Document sent back to the server.
+   *
+   * @return
+   *  - `RPC_ROUTER_OK`: Success
+   *
+   *  - `RPC_ROUTER_ERR_UNKNOWN_METHOD`: Index out of range, nothing is recorded
+   *
+   *  - Otherwise the error returned by the handler
+   */
+  rpc_router_error_t dispatch(uint8_t index, const JsonVariantConst &params, JsonDocument &response);
+
+  /**
+   * @brief Runs a method by name, for transports that do not route by method themselves.
+   */
+  rpc_router_error_t dispatch(const char *name, const JsonVariantConst &params, JsonDocument &response);
+
+  uint8_t             getCount() const { return _count; }
+  const rpc_method_t &getMethod(uint8_t index) const { return _methods[index]; }
+
+  /**
+   * @brief Retrieves a consistent copy of the counters of a method.
+   *
+   * @return bool `false` if `index` is out of range.
+   */
+  bool getStats(uint8_t index, rpc_method_stats_t &stats);
+
+  /**
+   * @brief Number of calls over all methods, to tell whether the statistics changed since the last export.
+   */
+  uint32_t getTotalCalls();
+
+  /**
+   * @brief Writes the counters of every method as `{"<name>": {"calls", "errors", "avgUs", "maxUs"}}`.
+   *
+   * @param[out] out Object to fill, sized with `RPC_ROUTER_STATS_CAPACITY()`.
+   *
+   * @return bool `false` if `out` ran out of room.
+   */
+  bool exportStats(JsonObject out);
+
+  void resetStats();
+
+private:
+  portMUX_TYPE        _lock;
+  const rpc_method_t *_methods;
+  uint8_t             _count;
+  uint32_t            _totalCalls;
+  rpc_method_stats_t  _stats[RPC_ROUTER_MAX_METHODS];
+};
+
+#endif // RPC_ROUTER_H
+
+/* End of file -------------------------------------------------------- */
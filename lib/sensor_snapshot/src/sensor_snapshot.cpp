@@ -0,0 +1,184 @@
+/**
+ * @file       sensor_snapshot.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Sensor Snapshot library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "sensor_snapshot.h"
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Class method definitions ------------------------------------------- */
+SensorSnapshotStore::SensorSnapshotStore() : _version(0)
+{
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+
+  for (uint8_t i = 0; i < SNAPSHOT_SOURCE_COUNT; i++)
+  {
+    _slots[i].sequence.store(0, std::memory_order_relaxed);
+    for (uint8_t j = 0; j < SNAPSHOT_MAX_FIELDS; j++)
+    {
+      _slots[i].values[j] = NAN;
+    }
+    _slots[i].timestamp = 0;
+    _slots[i].count     = 0;
+  }
+}
+
+snapshot_error_t SensorSnapshotStore::publish(snapshot_source_t source, const float *values, uint8_t count,
+                                              uint32_t timestamp)
+{
+  if (source >= SNAPSHOT_SOURCE_COUNT || values == nullptr || count > SNAPSHOT_MAX_FIELDS)
+  {
+    return SNAPSHOT_ERR_INVALID_ARG;
+  }
+
+  Slot &slot = _slots[source];
+
+  // No task of this core can run before the sequence is even again, a reader of the other core spins at most
+  // for the copy of a few fields
+  portENTER_CRITICAL(&_lock);
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+  // Odd sequence tells readers a publish is in progress
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    slot.values[i] = values[i];
+  }
+  slot.timestamp = timestamp;
+  slot.count++;
+
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  _version.fetch_add(1, std::memory_order_release);
+  portEXIT_CRITICAL(&_lock);
+
+  return SNAPSHOT_OK;
+}
+
+uint32_t SensorSnapshotStore::read(sensor_snapshot_t &snapshot) const
+{
+  float    values[SNAPSHOT_MAX_FIELDS];
+  uint32_t timestamp;
+  uint32_t count;
+  uint8_t  coherentMask = 0;
+
+  snapshot.version   = _version.load(std::memory_order_acquire);
+  snapshot.validMask = 0;
+
+  if (readSlot(_slots[SNAPSHOT_SOURCE_SHT4X], values, timestamp, count))
+  {
+    coherentMask |= (1U << SNAPSHOT_SOURCE_SHT4X);
+  }
+  snapshot.temperature                        = values[SNAPSHOT_SHT4X_TEMPERATURE];
+  snapshot.humidity                           = values[SNAPSHOT_SHT4X_HUMIDITY];
+  snapshot.updatedAt[SNAPSHOT_SOURCE_SHT4X]   = timestamp;
+  snapshot.sampleCount[SNAPSHOT_SOURCE_SHT4X] = count;
+
+  if (readSlot(_slots[SNAPSHOT_SOURCE_BMP280], values, timestamp, count))
+  {
+    coherentMask |= (1U << SNAPSHOT_SOURCE_BMP280);
+  }
+  snapshot.pressure                            = values[SNAPSHOT_BMP280_PRESSURE];
+  snapshot.bmpTemperature                      = values[SNAPSHOT_BMP280_TEMPERATURE];
+  snapshot.updatedAt[SNAPSHOT_SOURCE_BMP280]   = timestamp;
+  snapshot.sampleCount[SNAPSHOT_SOURCE_BMP280] = count;
+
+  if (readSlot(_slots[SNAPSHOT_SOURCE_LIGHT], values, timestamp, count))
+  {
+    coherentMask |= (1U << SNAPSHOT_SOURCE_LIGHT);
+  }
+  snapshot.lightRaw                           = (int) values[SNAPSHOT_LIGHT_RAW];
+  snapshot.lightPercentage                    = (int) values[SNAPSHOT_LIGHT_PERCENTAGE];
+  snapshot.updatedAt[SNAPSHOT_SOURCE_LIGHT]   = timestamp;
+  snapshot.sampleCount[SNAPSHOT_SOURCE_LIGHT] = count;
+
+  for (uint8_t i = 0; i < SNAPSHOT_SOURCE_COUNT; i++)
+  {
+    if ((coherentMask & (1U << i)) && snapshot.sampleCount[i] > 0)
+    {
+      snapshot.validMask |= (1U << i);
+    }
+  }
+
+  return snapshot.version;
+}
+
+bool SensorSnapshotStore::readSource(snapshot_source_t source, float *values, uint32_t *timestamp) const
+{
+  if (source >= SNAPSHOT_SOURCE_COUNT || values == nullptr)
+  {
+    return false;
+  }
+
+  uint32_t slotTimestamp;
+  uint32_t count;
+  if (!readSlot(_slots[source], values, slotTimestamp, count))
+  {
+    return false;
+  }
+
+  if (timestamp != nullptr)
+  {
+    *timestamp = slotTimestamp;
+  }
+  return count > 0;
+}
+
+uint32_t SensorSnapshotStore::getVersion() const { return _version.load(std::memory_order_acquire); }
+
+/* Private function definitions --------------------------------------- */
+bool SensorSnapshotStore::readSlot(const Slot &slot, float *values, uint32_t &timestamp,
+                                   uint32_t &count) const
+{
+  for (uint8_t retry = 0; retry < SNAPSHOT_READ_MAX_RETRIES; retry++)
+  {
+    uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1U)
+    {
+      // Writer of the other core is in the middle of a publish, try again
+      continue;
+    }
+
+    for (uint8_t i = 0; i < SNAPSHOT_MAX_FIELDS; i++)
+    {
+      values[i] = slot.values[i];
+    }
+    timestamp = slot.timestamp;
+    count     = slot.count;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == before)
+    {
+      return true;
+    }
+  }
+
+  // Still overlapping, the writer publishes faster than this task can copy
+  for (uint8_t i = 0; i < SNAPSHOT_MAX_FIELDS; i++)
+  {
+    values[i] = NAN;
+  }
+  timestamp = 0;
+  count     = 0;
+  return false;
+}
+
+/* End of file -------------------------------------------------------- */
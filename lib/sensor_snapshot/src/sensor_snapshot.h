@@ -0,0 +1,192 @@
+/**
+ * @file       sensor_snapshot.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Sensor Snapshot library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef SENSOR_SNAPSHOT_H
+  #define SENSOR_SNAPSHOT_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include <atomic>
+
+  /* Public defines ----------------------------------------------------- */
+  #define SENSOR_SNAPSHOT_LIB_VERSION (F("0.1.0"))
+
+  #define SNAPSHOT_MAX_FIELDS         3
+
+  // Retries of a reader that overlaps a publish, only a writer on the other core can be overlapped
+  #define SNAPSHOT_READ_MAX_RETRIES   32
+
+/* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief Sources that publish into the snapshot store. Each source must have exactly one writer task.
+ */
+typedef enum
+{
+  SNAPSHOT_SOURCE_SHT4X = 0,
+  SNAPSHOT_SOURCE_BMP280,
+  SNAPSHOT_SOURCE_LIGHT,
+  SNAPSHOT_SOURCE_COUNT
+} snapshot_source_t;
+
+/**
+ * @brief Field index of each value inside its source slot.
+ */
+enum
+{
+  SNAPSHOT_SHT4X_TEMPERATURE  = 0,
+  SNAPSHOT_SHT4X_HUMIDITY     = 1,
+  SNAPSHOT_BMP280_PRESSURE    = 0,
+  SNAPSHOT_BMP280_TEMPERATURE = 1,
+  SNAPSHOT_LIGHT_RAW          = 0,
+  SNAPSHOT_LIGHT_PERCENTAGE   = 1,
+};
+
+typedef enum
+{
+  SNAPSHOT_OK = 0,         /* No error */
+  SNAPSHOT_ERR,            /* Generic error */
+  SNAPSHOT_ERR_INVALID_ARG /* Invalid source or field count */
+} snapshot_error_t;
+
+/**
+ * @brief Coherent copy of every sensor value, as returned by `SensorSnapshotStore::read()`.
+ */
+typedef struct
+{
+  float    temperature;                        /**< SHT4X temperature (°C) */
+  float    humidity;                           /**< SHT4X relative humidity (%RH) */
+  float    pressure;                           /**< BMP280 pressure (Pa), consumers derive the altitude */
+  float    bmpTemperature;                     /**< BMP280 temperature (°C) */
+  int      lightRaw;                           /**< Light sensor raw 12-bit value */
+  int      lightPercentage;                    /**< Light sensor value in percent */
+  uint32_t updatedAt[SNAPSHOT_SOURCE_COUNT];   /**< millis() of the last publish of each source */
+  uint32_t sampleCount[SNAPSHOT_SOURCE_COUNT]; /**< Number of publishes of each source */
+  uint8_t  validMask;                          /**< Bit n set when source n has published at least once */
+  uint32_t version;                            /**< Store version at the time of the read */
+} sensor_snapshot_t;
+
+/* Public macros ------------------------------------------------------ */
+  #define SNAPSHOT_IS_VALID(snapshot, source) (((snapshot).validMask & (1U << (source))) != 0)
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Lock-free, versioned store for the latest sensor readings.
+ *
+ * The `SensorSnapshotStore` class decouples sensor polling from the consumers of the readings. Each sensor
+ * task publishes into its own slot after a successful measurement, and every consumer (telemetry, LCD,
+ * automation rules) reads the latest values without touching the I2C bus or the ADC.
+ *
+ * ### Features:
+ *
+ * - One seqlock per source: readers never block and retry only if they overlap a publish. The write side
+ * runs in a short critical section, so a reader cannot preempt a writer in the middle of a publish.
+ *
+ * - Torn reads are impossible, a reader always sees all fields of a source from the same sample.
+ *
+ * - Bounded retries: a reader on the other core that keeps overlapping publishes gives up on that source,
+ * which is reported as not valid for this read.
+ *
+ * - A global version counter lets consumers detect whether anything changed since their last read.
+ *
+ * - Per-source timestamps and sample counters for staleness checks.
+ *
+ * ### Usage:
+ *
+ * Call `publish()` from the single task owning a source. Call `read()` from any task to obtain a
+ * `sensor_snapshot_t` copy, then check `SNAPSHOT_IS_VALID()` before using the values of a source.
+ *
+ * ### Dependencies:
+ *
+ * - Requires `std::atomic` support from the toolchain.
+ *
+ * - FreeRTOS `portMUX_TYPE` for the write side, provided by HAL Native on the host.
+ */
+class SensorSnapshotStore
+{
+public:
+  SensorSnapshotStore();
+
+  /**
+   * @brief Publishes a new sample for one source.
+   *
+   * Copies `count` values into the slot of `source` under its sequence counter and bumps the store version.
+   *
+   * @param[in] source    The publishing source.
+   * @param[in] values    Pointer to the values, ordered as the `SNAPSHOT_<SOURCE>_<FIELD>` indexes.
+   * @param[in] count     Number of values (at most `SNAPSHOT_MAX_FIELDS`).
+   * @param[in] timestamp millis() of the measurement.
+   *
+   * @attention Only one task may publish to a given source.
+   *
+   * @return
+   *  - `SNAPSHOT_OK`: Success
+   *
+   *  - `SNAPSHOT_ERR_INVALID_ARG`: Invalid source, null pointer or too many values
+   */
+  snapshot_error_t publish(snapshot_source_t source, const float *values, uint8_t count, uint32_t timestamp);
+
+  /**
+   * @brief Reads a coherent copy of all sources.
+   *
+   * A source that could not be read within `SNAPSHOT_READ_MAX_RETRIES` has its `validMask` bit cleared.
+   *
+   * @param[out] snapshot Destination of the copy.
+   *
+   * @return uint32_t The store version the copy corresponds to.
+   */
+  uint32_t read(sensor_snapshot_t &snapshot) const;
+
+  /**
+   * @brief Reads the values of a single source.
+   *
+   * @param[in]  source    Source to read.
+   * @param[out] values    Destination buffer of at least `SNAPSHOT_MAX_FIELDS` floats.
+   * @param[out] timestamp millis() of the published sample (optional).
+   *
+   * @return bool `true` if the source has published at least once and was read, `false` otherwise.
+   */
+  bool readSource(snapshot_source_t source, float *values, uint32_t *timestamp = nullptr) const;
+
+  /**
+   * @brief Retrieves the store version, incremented on every publish.
+   *
+   * @return uint32_t The current version.
+   */
+  uint32_t getVersion() const;
+
+private:
+  struct Slot
+  {
+    std::atomic<uint32_t> sequence;                   /**< Odd while a publish is in progress */
+    float                 values[SNAPSHOT_MAX_FIELDS]; /**< Values of the last sample */
+    uint32_t              timestamp;                   /**< millis() of the last sample */
+    uint32_t              count;                       /**< Number of samples published */
+  };
+
+  Slot                  _slots[SNAPSHOT_SOURCE_COUNT];
+  std::atomic<uint32_t> _version;
+  portMUX_TYPE          _lock; // Write side of publish(), no reader takes it
+
+  bool readSlot(const Slot &slot, float *values, uint32_t &timestamp, uint32_t &count) const;
+};
+
+#endif // SENSOR_SNAPSHOT_H
+
+/* End of file -------------------------------------------------------- */
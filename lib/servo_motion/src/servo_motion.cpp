@@ -0,0 +1,199 @@
+/**
+ * @file       servo_motion.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-18
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Servo Motion library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "servo_motion.h"
+#include "bsp_timer.h"
+
+#include <math.h>
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Class method definitions ------------------------------------------- */
+ServoMotion::ServoMotion()
+    : _ready(false), _timer(0), _write(nullptr), _writeArg(nullptr), _done(nullptr), _doneArg(nullptr),
+      _profile(SERVO_PROFILE_S_CURVE), _minPulseUs(0), _maxPulseUs(0), _moving(false), _targetAngle(0),
+      _startUs(0.0f), _targetUs(0.0f), _currentUs(0.0f), _startMs(0), _durationMs(0)
+{
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+}
+
+servo_motion_error_t ServoMotion::begin(servo_motion_write_t write, void *arg, uint16_t minPulseUs,
+                                        uint16_t maxPulseUs, int initialAngle)
+{
+  if (write == nullptr || minPulseUs >= maxPulseUs || initialAngle < 0 ||
+      initialAngle > SERVO_MOTION_MAX_ANGLE)
+  {
+    return SERVO_MOTION_ERR_INVALID_ARG;
+  }
+  if (!_ready && bspTimerCreate(onTick, this, "servo_motion", &_timer) != BSP_TIMER_OK)
+  {
+    return SERVO_MOTION_ERR_INIT;
+  }
+
+  _write       = write;
+  _writeArg    = arg;
+  _minPulseUs  = minPulseUs;
+  _maxPulseUs  = maxPulseUs;
+  _targetAngle = initialAngle;
+  _currentUs   = angleToPulse(initialAngle);
+  _ready       = true;
+
+  _write((uint16_t) lroundf(_currentUs), _writeArg);
+  return SERVO_MOTION_OK;
+}
+
+void ServoMotion::attachDoneCallback(servo_motion_done_t callback, void *arg)
+{
+  portENTER_CRITICAL(&_lock);
+  _done    = callback;
+  _doneArg = arg;
+  portEXIT_CRITICAL(&_lock);
+}
+
+servo_motion_error_t ServoMotion::moveTo(int angle, uint32_t durationMs)
+{
+  if (!_ready)
+  {
+    return SERVO_MOTION_ERR_INIT;
+  }
+  if (angle < 0 || angle > SERVO_MOTION_MAX_ANGLE)
+  {
+    return SERVO_MOTION_ERR_INVALID_ARG;
+  }
+
+  if (durationMs == 0)
+  {
+    bspTimerStop(_timer);
+    portENTER_CRITICAL(&_lock);
+    _moving                     = false;
+    _targetAngle                = angle;
+    _currentUs                  = angleToPulse(angle);
+    float               pulse   = _currentUs;
+    servo_motion_done_t done    = _done;
+    void               *doneArg = _doneArg;
+    portEXIT_CRITICAL(&_lock);
+
+    _write((uint16_t) lroundf(pulse), _writeArg);
+    if (done != nullptr)
+    {
+      done(angle, doneArg);
+    }
+    return SERVO_MOTION_OK;
+  }
+
+  // Starts from where the servo is now, even halfway through another motion
+  portENTER_CRITICAL(&_lock);
+  bool wasMoving = _moving;
+  _moving        = true;
+  _targetAngle   = angle;
+  _startUs       = _currentUs;
+  _targetUs      = angleToPulse(angle);
+  _startMs       = millis();
+  _durationMs    = durationMs;
+  portEXIT_CRITICAL(&_lock);
+
+  if (!wasMoving)
+  {
+    bspTimerStartPeriodic(_timer, SERVO_MOTION_TICK_MS * 1000UL);
+  }
+  return SERVO_MOTION_OK;
+}
+
+int ServoMotion::getAngle()
+{
+  portENTER_CRITICAL(&_lock);
+  float pulse = _currentUs;
+  portEXIT_CRITICAL(&_lock);
+  return (int) lroundf((pulse - _minPulseUs) * SERVO_MOTION_MAX_ANGLE / (_maxPulseUs - _minPulseUs));
+}
+
+/* Private definitions ------------------------------------------------ */
+void ServoMotion::onTick(void *arg)
+{
+  // esp_timer task, one step per servo frame
+  ServoMotion *self = (ServoMotion *) arg;
+
+  portENTER_CRITICAL(&self->_lock);
+  uint32_t elapsed  = millis() - self->_startMs;
+  float    progress = (elapsed >= self->_durationMs) ? 1.0f : (float) elapsed / self->_durationMs;
+  self->_currentUs  = self->_startUs + (self->_targetUs - self->_startUs) * self->position(progress);
+  float pulse       = self->_currentUs;
+  bool  done        = progress >= 1.0f;
+  int   angle       = self->_targetAngle;
+  if (done)
+  {
+    self->_moving = false;
+  }
+  portEXIT_CRITICAL(&self->_lock);
+
+  self->_write((uint16_t) lroundf(pulse), self->_writeArg);
+  if (!done)
+  {
+    return;
+  }
+
+  bspTimerStop(self->_timer);
+
+  // A moveTo() between the last step and the stop found the timer running and did not start it
+  portENTER_CRITICAL(&self->_lock);
+  bool                again    = self->_moving;
+  servo_motion_done_t callback = self->_done;
+  void               *doneArg  = self->_doneArg;
+  portEXIT_CRITICAL(&self->_lock);
+  if (again)
+  {
+    bspTimerStartPeriodic(self->_timer, SERVO_MOTION_TICK_MS * 1000UL);
+  }
+  else if (callback != nullptr)
+  {
+    callback(angle, doneArg);
+  }
+}
+
+float ServoMotion::position(float progress)
+{
+  // Share of the distance covered at `progress` (0..1) of the duration
+  float s = progress;
+  if (_profile == SERVO_PROFILE_S_CURVE)
+  {
+    return s * s * s * (10.0f + s * (6.0f * s - 15.0f));
+  }
+
+  // Trapezoid: speed ramps up over the first `a` of the time, cruises, ramps down over the last `a`
+  const float a     = SERVO_MOTION_ACCEL_FRACTION;
+  const float speed = 1.0f / (1.0f - a);
+  if (s < a)
+  {
+    return speed * s * s / (2.0f * a);
+  }
+  if (s > 1.0f - a)
+  {
+    return 1.0f - speed * (1.0f - s) * (1.0f - s) / (2.0f * a);
+  }
+  return speed * (s - a / 2.0f);
+}
+
+float ServoMotion::angleToPulse(int angle)
+{
+  return _minPulseUs + (float) (_maxPulseUs - _minPulseUs) * angle / SERVO_MOTION_MAX_ANGLE;
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,179 @@
+/**
+ * @file       servo_motion.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-18
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Servo Motion library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef SERVO_MOTION_H
+  #define SERVO_MOTION_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  /* Public defines ----------------------------------------------------- */
+  #define SERVO_MOTION_LIB_VERSION     (F("0.1.0"))
+
+  #define SERVO_MOTION_TICK_MS         20    // One servo frame at 50 Hz, the servo ignores faster updates
+  #define SERVO_MOTION_ACCEL_FRACTION  0.25f // Share of a trapezoidal move spent speeding up, as much braking
+  #define SERVO_MOTION_MAX_ANGLE       180
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  SERVO_MOTION_OK = 0,          /* No error */
+  SERVO_MOTION_ERR,             /* Generic error */
+  SERVO_MOTION_ERR_INIT,        /* `begin()` not called or no timer available */
+  SERVO_MOTION_ERR_INVALID_ARG  /* Angle out of range, null writer or empty pulse range */
+} servo_motion_error_t;
+
+/**
+ * @brief Shape of the motion between two angles.
+ */
+typedef enum
+{
+  SERVO_PROFILE_TRAPEZOID = 0, /* Constant acceleration, cruise, constant deceleration */
+  SERVO_PROFILE_S_CURVE        /* Minimum jerk: acceleration itself ramps, the smoothest and quietest */
+} servo_profile_t;
+
+/**
+ * @brief Writes a pulse width to the servo, e.g. `Servo::writeMicroseconds()`. Runs in the timer task.
+ */
+typedef void (*servo_motion_write_t)(uint16_t pulseUs, void *arg);
+
+/**
+ * @brief Called once a motion reached its target. Runs in the timer task, keep it short and do not block.
+ */
+typedef void (*servo_motion_done_t)(int angle, void *arg);
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Non-blocking motion planner for a hobby servo.
+ *
+ * The `ServoMotion` class replaces a jump to the target angle, which slams the horn and draws a current
+ * spike, by a timed motion. `moveTo()` returns at once, a periodic timer then interpolates the pulse width
+ * along the chosen profile, one step per servo frame, and calls the done callback when the target is
+ * reached.
+ *
+ * ### Features:
+ *
+ * - Trapezoidal or S-curve (minimum jerk) profile over a requested duration.
+ *
+ * - A new `moveTo()` during a motion starts over from the current position.
+ *
+ * - The timer only runs during a motion.
+ *
+ * - The servo driver is reached through a writer callback, the planner works with any of them and on the
+ * host.
+ *
+ * ### Usage:
+ *
+ * ```
+ * doorMotion.begin([](uint16_t us, void *) { doorServo.writeMicroseconds(us); }, nullptr, 500, 1500, 0);
+ * doorMotion.attachDoneCallback(onDoorArrived, nullptr);
+ * doorMotion.moveTo(180, 1200);
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - `bsp_timer.h` for the frame tick. The writer and the done callback run in the esp_timer task.
+ */
+class ServoMotion
+{
+public:
+  ServoMotion();
+
+  /**
+   * @brief Starts the planner and moves the servo to its initial angle at once.
+   *
+   * @param[in] write        Writes a pulse width to the servo.
+   * @param[in] arg          Passed to `write`.
+   * @param[in] minPulseUs   Pulse width of 0°.
+   * @param[in] maxPulseUs   Pulse width of `SERVO_MOTION_MAX_ANGLE`.
+   * @param[in] initialAngle Angle to start from.
+   *
+   * @return
+   *  - `SERVO_MOTION_OK`: Success
+   *
+   *  - `SERVO_MOTION_ERR_INVALID_ARG`: Null writer, empty pulse range or angle out of range
+   *
+   *  - `SERVO_MOTION_ERR_INIT`: No timer available
+   */
+  servo_motion_error_t begin(servo_motion_write_t write, void *arg, uint16_t minPulseUs, uint16_t maxPulseUs,
+                             int initialAngle = 0);
+
+  void setProfile(servo_profile_t profile) { _profile = profile; }
+
+  /**
+   * @brief Sets the callback called at the end of each motion.
+   */
+  void attachDoneCallback(servo_motion_done_t callback, void *arg = nullptr);
+
+  /**
+   * @brief Starts a motion to an angle, without blocking.
+   *
+   * @param[in] angle      Target angle (0–`SERVO_MOTION_MAX_ANGLE`).
+   * @param[in] durationMs Duration of the motion, `0` to jump. The done callback then runs in the caller.
+   *
+   * @return
+   *  - `SERVO_MOTION_OK`: Motion started
+   *
+   *  - `SERVO_MOTION_ERR_INIT`: `begin()` was not called
+   *
+   *  - `SERVO_MOTION_ERR_INVALID_ARG`: Angle out of range
+   */
+  servo_motion_error_t moveTo(int angle, uint32_t durationMs);
+
+  bool isMoving() { return _moving; }
+  int  getTarget() { return _targetAngle; }
+
+  /**
+   * @brief Retrieves the angle the servo is commanded to right now, between the start and the target.
+   *
+   * @return int The angle in degrees.
+   */
+  int getAngle();
+
+private:
+  portMUX_TYPE         _lock;
+  bool                 _ready;
+  uint8_t              _timer;
+  servo_motion_write_t _write;
+  void                *_writeArg;
+  servo_motion_done_t  _done;
+  void                *_doneArg;
+  servo_profile_t      _profile;
+  uint16_t             _minPulseUs;
+  uint16_t             _maxPulseUs;
+
+  // Motion, shared by moveTo() and the timer task under _lock
+  bool     _moving;
+  int      _targetAngle;
+  float    _startUs;
+  float    _targetUs;
+  float    _currentUs;
+  uint32_t _startMs;
+  uint32_t _durationMs;
+
+  static void onTick(void *arg);
+  float       position(float progress);
+  float       angleToPulse(int angle);
+};
+
+#endif // SERVO_MOTION_H
+
+/* End of file -------------------------------------------------------- */
@@ -31,9 +31,118 @@ sht4x_error_t SHT4X::begin() { return (bspI2CExist(SHT40_I2C_ADDR_44) == true) ?
 
 sht4x_error_t SHT4X::update()
 {
-  uint8_t  readBuffer[6];
-  uint8_t  cmd      = SHT4x_CMD_NOHEAT_HIGHPRECISION;
-  uint16_t duration = 9;
+  sht4x_error_t err = startMeasurement();
+  if (err != SHT4X_OK)
+  {
+    return err;
+  }
+
+  while (poll() != SHT4X_STATE_READY)
+  {
+    DELAY(getRemainingTime());
+  }
+
+  return fetch();
+}
+
+sht4x_error_t SHT4X::startMeasurement()
+{
+  if (_state != SHT4X_STATE_IDLE)
+  {
+    return SHT4X_BUSY;
+  }
+
+  uint8_t  cmd;
+  uint16_t duration;
+  getCommand(cmd, duration);
+
+  // The command is the whole write, no data byte follows it
+  if (bspI2CWriteBytes(SHT40_I2C_ADDR_44, cmd, nullptr, 0) != BSP_I2C_OK)
+  {
+    return SHT4X_ERR_I2C;
+  }
+
+  _deadline = millis() + duration;
+  _state    = SHT4X_STATE_MEASURING;
+  return SHT4X_OK;
+}
+
+sht4x_state_t SHT4X::poll()
+{
+  // Signed difference keeps the comparison valid across millis() roll-over
+  if (_state == SHT4X_STATE_MEASURING && (int32_t) (millis() - _deadline) >= 0)
+  {
+    _state = SHT4X_STATE_READY;
+  }
+  return _state;
+}
+
+sht4x_error_t SHT4X::fetch()
+{
+  switch (poll())
+  {
+    case SHT4X_STATE_IDLE:
+      return SHT4X_ERR;
+    case SHT4X_STATE_MEASURING:
+      return SHT4X_BUSY;
+    default:
+      break;
+  }
+  _state = SHT4X_STATE_IDLE;
+
+  uint8_t readBuffer[6];
+  if (bspI2CReadBytes(SHT40_I2C_ADDR_44, readBuffer, sizeof(readBuffer)) != BSP_I2C_OK)
+  {
+    return SHT4X_ERR_I2C;
+  }
+
+  return decode(readBuffer);
+}
+
+sht4x_error_t SHT4X::decode(const uint8_t *frame)
+{
+  if (frame[2] != crc8(frame, 2) || frame[5] != crc8(frame + 3, 2))
+  {
+    return SHT4X_ERR_CHECKSUM;
+  }
+  float t_ticks  = ((uint16_t) frame[0] << 8) | frame[1];
+  float rh_ticks = ((uint16_t) frame[3] << 8) | frame[4];
+  // Use constants to avoid recalculating
+  const float scale = 1.52590219E-5;
+
+  sensorValue[SHT4X_TEMPERATURE_INDEX] = -45.0f + 175.0f * (t_ticks * scale);
+  sensorValue[SHT4X_HUMIDITY_INDEX]    = -6.0f + 125.0f * (rh_ticks * scale);
+  sensorValue[SHT4X_HUMIDITY_INDEX]    = min(max(sensorValue[SHT4X_HUMIDITY_INDEX], 0.0f), 100.0f);
+
+  return SHT4X_OK;
+}
+
+uint32_t SHT4X::getRemainingTime()
+{
+  if (poll() != SHT4X_STATE_MEASURING)
+  {
+    return 0;
+  }
+  return _deadline - millis();
+}
+
+void SHT4X::setPrecision(sht4x_precision_t prec) { _precision = prec; }
+
+sht4x_precision_t SHT4X::getPrecision() { return _precision; }
+
+void SHT4X::setHeater(sht4x_heater_t heat) { _heater = heat; }
+
+sht4x_heater_t SHT4X::getHeater() { return _heater; }
+
+float SHT4X::getTemperature() { return sensorValue[SHT4X_TEMPERATURE_INDEX]; }
+
+float SHT4X::getHumidity() { return sensorValue[SHT4X_HUMIDITY_INDEX]; }
+
+/* Private function definitions --------------------------------------- */
+void SHT4X::getCommand(uint8_t &cmd, uint16_t &duration)
+{
+  cmd      = SHT4x_CMD_NOHEAT_HIGHPRECISION;
+  duration = 9;
   switch (_heater)
   {
     case SHT4X_NO_HEATER:
@@ -78,39 +187,6 @@ sht4x_error_t SHT4X::update()
       duration = 110;
       break;
   }
-  bspI2CWriteByte(SHT40_I2C_ADDR_44, cmd, 1);
-
-  DELAY(duration);
-
-  bspI2CReadBytes(SHT40_I2C_ADDR_44, readBuffer, sizeof(readBuffer));
-
-  if (readBuffer[2] != crc8(readBuffer, 2) || readBuffer[5] != crc8(readBuffer + 3, 2))
-  {
-    return SHT4X_ERR_CHECKSUM;
-  }
-  float t_ticks  = ((uint16_t) readBuffer[0] << 8) | readBuffer[1];
-  float rh_ticks = ((uint16_t) readBuffer[3] << 8) | readBuffer[4];
-  // Use constants to avoid recalculating
-  const float scale = 1.52590219E-5;
-
-  sensorValue[SHT4X_TEMPERATURE_INDEX] = -45.0f + 175.0f * (t_ticks * scale);
-  sensorValue[SHT4X_HUMIDITY_INDEX]    = -6.0f + 125.0f * (rh_ticks * scale);
-  sensorValue[SHT4X_HUMIDITY_INDEX]    = min(max(sensorValue[SHT4X_HUMIDITY_INDEX], 0.0f), 100.0f);
-
-  return SHT4X_OK;
 }
 
-void SHT4X::setPrecision(sht4x_precision_t prec) { _precision = prec; }
-
-sht4x_precision_t SHT4X::getPrecision() { return _precision; }
-
-void SHT4X::setHeater(sht4x_heater_t heat) { _heater = heat; }
-
-sht4x_heater_t SHT4X::getHeater() { return _heater; }
-
-float SHT4X::getTemperature() { return sensorValue[SHT4X_TEMPERATURE_INDEX]; }
-
-float SHT4X::getHumidity() { return sensorValue[SHT4X_HUMIDITY_INDEX]; }
-/* Private function prototypes ---------------------------------------- */
-
 /* End of file -------------------------------------------------------- */
\ No newline at end of file
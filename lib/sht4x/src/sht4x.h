@@ -60,9 +60,20 @@ typedef enum
   SHT4X_ERR_RESET,   /* Reset error */
   SHT4X_TIMEOUT,     /* Timeout error*/
   SHT4X_ERR_I2C,     /* I2C error */
-  SHT4X_ERR_CHECKSUM /* Checksum error */
+  SHT4X_ERR_CHECKSUM, /* Checksum error */
+  SHT4X_BUSY          /* Measurement still in progress */
 } sht4x_error_t;
 
+/**
+ * @brief States of the non-blocking measurement state machine.
+ */
+typedef enum
+{
+  SHT4X_STATE_IDLE = 0,  /* No measurement in progress */
+  SHT4X_STATE_MEASURING, /* Command sent, waiting for the conversion deadline */
+  SHT4X_STATE_READY      /* Conversion done, result can be fetched */
+} sht4x_state_t;
+
 typedef enum
 {
   SHT4X_HIGH_PRECISION,
@@ -112,9 +123,12 @@ typedef enum
  * humidity, then retrieve values with `getTemperature()` and `getHumidity()`. Configure precision with
  * `setPrecision()` and heater settings with `setHeater()` as needed.
  *
+ * To avoid sleeping through the conversion time, call `startMeasurement()`, do other work (or other bus
+ * transactions) until `poll()` returns `SHT4X_STATE_READY`, then call `fetch()`.
+ *
  * ### Dependencies:
  *
- * - Requires an I2C communication library (`bsp_i2c.h` for `bspI2CExist`, `bspI2CWriteByte`,
+ * - Requires an I2C communication library (`bsp_i2c.h` for `bspI2CExist`, `bspI2CWriteBytes`,
  * `bspI2CReadBytes`).
  *
  * - Sensor must be connected to a valid I2C bus at address `SHT40_I2C_ADDR_44` (0x44).
@@ -158,6 +172,82 @@ public:
    */
   sht4x_error_t update(void);
 
+  /**
+   * @brief Starts a measurement without waiting for the conversion.
+   *
+   * Sends the measurement command matching the configured precision and heater settings and arms the
+   * conversion deadline.
+   *
+   * @param[in] None
+   *
+   * @attention Only one measurement can be in flight. Settings changed afterwards apply to the next one.
+   *
+   * @return
+   *  - `SHT4X_OK`: Command sent
+   *
+   *  - `SHT4X_BUSY`: A measurement is already in progress
+   *
+   *  - `SHT4X_ERR_I2C`: The command was not acknowledged
+   */
+  sht4x_error_t startMeasurement(void);
+
+  /**
+   * @brief Advances the measurement state machine.
+   *
+   * Moves from `SHT4X_STATE_MEASURING` to `SHT4X_STATE_READY` once the conversion deadline has passed. Does
+   * not touch the I2C bus.
+   *
+   * @param[in] None
+   *
+   * @return sht4x_state_t The current state.
+   */
+  sht4x_state_t poll(void);
+
+  /**
+   * @brief Reads the result of a finished measurement.
+   *
+   * Reads the 6 result bytes, verifies both checksums and updates the internal temperature and humidity
+   * values. The state machine returns to `SHT4X_STATE_IDLE` whatever the outcome.
+   *
+   * @param[in] None
+   *
+   * @return
+   *  - `SHT4X_OK`: Measurement successful
+   *
+   *  - `SHT4X_BUSY`: Conversion deadline not reached yet
+   *
+   *  - `SHT4X_ERR`: No measurement was started
+   *
+   *  - `SHT4X_ERR_I2C`: Result could not be read
+   *
+   *  - `SHT4X_ERR_CHECKSUM`: Checksum mismatch indicating data corruption
+   */
+  sht4x_error_t fetch(void);
+
+  /**
+   * @brief Decodes a raw measurement frame.
+   *
+   * Verifies both checksums of the 6-byte frame (temperature word, CRC, humidity word, CRC) and converts it
+   * into the internal temperature and humidity values. `fetch()` calls it on the bytes read from the sensor.
+   *
+   * @param[in] frame The 6 bytes returned by a measurement command.
+   *
+   * @return
+   *  - `SHT4X_OK`: Values updated
+   *
+   *  - `SHT4X_ERR_CHECKSUM`: Checksum mismatch, values left untouched
+   */
+  sht4x_error_t decode(const uint8_t *frame);
+
+  /**
+   * @brief Retrieves the time left before the measurement in flight can be fetched.
+   *
+   * @param[in] None
+   *
+   * @return uint32_t Milliseconds until the deadline, 0 if no measurement is pending or it is already ready.
+   */
+  uint32_t getRemainingTime(void);
+
   /**
    * @brief Sets the measurement precision of the SHT4X sensor.
    *
@@ -236,6 +326,10 @@ private:
                                 // Temperature: index 1
   sht4x_precision_t _precision = SHT4X_HIGH_PRECISION;
   sht4x_heater_t    _heater    = SHT4X_NO_HEATER;
+  sht4x_state_t     _state     = SHT4X_STATE_IDLE;
+  uint32_t          _deadline  = 0; // millis() at which the conversion is done
+
+  void getCommand(uint8_t &cmd, uint16_t &duration);
 };
 
 #endif // SHT40_h
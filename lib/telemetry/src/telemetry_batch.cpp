@@ -0,0 +1,120 @@
+/**
+ * @file       telemetry_batch.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-04
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Telemetry Batch library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "telemetry_batch.h"
+
+#include <sys/time.h>
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Function definitions ----------------------------------------------- */
+uint64_t telemetryGetEpochMs()
+{
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+
+  if ((unsigned long) now.tv_sec < TELEMETRY_EPOCH_VALID_S)
+  {
+    return 0;
+  }
+  return (uint64_t) now.tv_sec * 1000ULL + (uint64_t) (now.tv_usec / 1000);
+}
+
+/* Class method definitions ------------------------------------------- */
+TelemetryBatch::TelemetryBatch() : _count(0), _entries(0), _series(false), _timestamp(0) { begin(); }
+
+void TelemetryBatch::begin(uint64_t timestamp)
+{
+  _doc.clear();
+  _count     = 0;
+  _entries   = 0;
+  _series    = false;
+  _timestamp = timestamp;
+
+  if (timestamp != 0)
+  {
+    _doc["ts"] = timestamp;
+    _values    = _doc.createNestedObject("values");
+  }
+  else
+  {
+    _values = _doc.to<JsonObject>();
+  }
+}
+
+void TelemetryBatch::beginSeries()
+{
+  _doc.clear();
+  _doc.to<JsonArray>();
+  _values    = JsonObject();
+  _count     = 0;
+  _entries   = 0;
+  _series    = true;
+  _timestamp = 0;
+}
+
+telemetry_error_t TelemetryBatch::addEntry(uint64_t timestamp)
+{
+  if (!_series)
+  {
+    return TELEMETRY_ERR;
+  }
+  if (_entries >= TELEMETRY_BATCH_MAX_ENTRIES)
+  {
+    return TELEMETRY_ERR_FULL;
+  }
+
+  JsonObject entry = _doc.as<JsonArray>().createNestedObject();
+  entry["ts"]      = timestamp;
+  _values          = entry.createNestedObject("values");
+  if (_doc.overflowed() || _values.isNull())
+  {
+    _values = JsonObject();
+    return TELEMETRY_ERR_FULL;
+  }
+
+  _entries++;
+  return TELEMETRY_OK;
+}
+
+telemetry_error_t TelemetryBatch::add(const char *key, float value)
+{
+  if (isnan(value) || isinf(value))
+  {
+    return TELEMETRY_ERR_INVALID_ARG;
+  }
+  return add<float>(key, value);
+}
+
+bool TelemetryBatch::isEmpty() const { return _count == 0; }
+
+bool TelemetryBatch::isOverflowed() const { return _doc.overflowed(); }
+
+uint8_t TelemetryBatch::getCount() const { return _count; }
+
+uint8_t TelemetryBatch::getEntryCount() const { return _entries; }
+
+uint64_t TelemetryBatch::getTimestamp() const { return _timestamp; }
+
+JsonVariantConst TelemetryBatch::getJson() const { return _doc.as<JsonVariantConst>(); }
+
+size_t TelemetryBatch::measure() const { return measureJson(_doc); }
+
+/* End of file -------------------------------------------------------- */
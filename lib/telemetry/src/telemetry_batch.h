@@ -0,0 +1,243 @@
+/**
+ * @file       telemetry_batch.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-04
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Telemetry Batch library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef TELEMETRY_BATCH_H
+  #define TELEMETRY_BATCH_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include <ArduinoJson.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define TELEMETRY_BATCH_LIB_VERSION (F("0.1.0"))
+
+  #define TELEMETRY_BATCH_MAX_KEYS    24 // Keys over all entries
+  #define TELEMETRY_BATCH_MAX_ENTRIES 4  // Timestamped entries of a series
+
+  // Array of entries, each an envelope {"ts", "values"}, plus one member per key
+  #define TELEMETRY_BATCH_CAPACITY                                                                           \
+    (JSON_ARRAY_SIZE(TELEMETRY_BATCH_MAX_ENTRIES) + TELEMETRY_BATCH_MAX_ENTRIES * JSON_OBJECT_SIZE(2) +      \
+     JSON_OBJECT_SIZE(TELEMETRY_BATCH_MAX_KEYS))
+
+  // Any epoch before this (2020-09-13) means the clock has not been synchronized yet
+  #define TELEMETRY_EPOCH_VALID_S     1600000000UL
+
+/* Public enumerate/structure ----------------------------------------- */
+typedef enum
+{
+  TELEMETRY_OK = 0,          /* No error */
+  TELEMETRY_ERR,             /* Generic error */
+  TELEMETRY_ERR_INVALID_ARG, /* Null key or non-finite value */
+  TELEMETRY_ERR_FULL,        /* Batch has no room left for another key or entry */
+  TELEMETRY_ERR_EMPTY        /* Batch has no key to publish */
+} telemetry_error_t;
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Retrieves the wall-clock time in milliseconds since the Unix epoch.
+ *
+ * @return uint64_t The epoch time in ms, or `0` if the system clock has not been synchronized (SNTP).
+ */
+uint64_t telemetryGetEpochMs();
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Builder for a single multi-key telemetry message.
+ *
+ * The `TelemetryBatch` class accumulates every key of one publish cycle into one JSON object, so a cycle
+ * costs one MQTT PUBLISH instead of one per key.
+ *
+ * ### Features:
+ *
+ * - Flat `{"key": value, ...}` object when no timestamp is given, the server stamps it on arrival.
+ *
+ * - `{"ts": <epoch ms>, "values": {...}}` object when a timestamp is given.
+ *
+ * - `[{"ts": ..., "values": {...}}, ...]` series of up to `TELEMETRY_BATCH_MAX_ENTRIES` samples, used to
+ * upload buffered samples with their capture time in one message.
+ *
+ * - Fixed-size pool, no heap allocation. Non-finite floats are rejected instead of being sent as `null`.
+ *
+ * ### Usage:
+ *
+ * Call `begin()` at the start of a cycle, `add()` each key, then hand `getJson()` and `measure()` to
+ * `ThingsBoard::sendTelemetryJson()` when `isEmpty()` is `false`. For a series, call `beginSeries()` then
+ * `addEntry()` before the keys of each sample.
+ *
+ * ### Dependencies:
+ *
+ * - ArduinoJson 6. Keys are stored by pointer, they must outlive the batch (string literals or
+ * `constexpr char[]`).
+ */
+class TelemetryBatch
+{
+public:
+  TelemetryBatch();
+
+  /**
+   * @brief Clears the batch and starts a new message.
+   *
+   * @param[in] timestamp Epoch time of the values in ms, `0` to let the server stamp them.
+   */
+  void begin(uint64_t timestamp = 0);
+
+  /**
+   * @brief Clears the batch and starts a series of timestamped entries.
+   *
+   * @attention Keys can only be added after the first `addEntry()`.
+   */
+  void beginSeries();
+
+  /**
+   * @brief Starts a new entry of the series, following keys are added to it.
+   *
+   * @param[in] timestamp Epoch time of the entry in ms.
+   *
+   * @return
+   *  - `TELEMETRY_OK`: Success
+   *
+   *  - `TELEMETRY_ERR`: The batch was not started with `beginSeries()`
+   *
+   *  - `TELEMETRY_ERR_FULL`: `TELEMETRY_BATCH_MAX_ENTRIES` reached or no room left
+   */
+  telemetry_error_t addEntry(uint64_t timestamp);
+
+  /**
+   * @brief Adds a key to the batch.
+   *
+   * @param[in] key   The telemetry key.
+   * @param[in] value The value (`bool`, integer or string).
+   *
+   * @return
+   *  - `TELEMETRY_OK`: Success
+   *
+   *  - `TELEMETRY_ERR`: No entry started in series mode
+   *
+   *  - `TELEMETRY_ERR_INVALID_ARG`: Null key
+   *
+   *  - `TELEMETRY_ERR_FULL`: No room left, the key was not added
+   */
+  template <typename T>
+  telemetry_error_t add(const char *key, T value)
+  {
+    if (key == nullptr)
+    {
+      return TELEMETRY_ERR_INVALID_ARG;
+    }
+    if (_values.isNull())
+    {
+      return TELEMETRY_ERR;
+    }
+    if (_count >= TELEMETRY_BATCH_MAX_KEYS)
+    {
+      return TELEMETRY_ERR_FULL;
+    }
+
+    _values[key] = value;
+    if (_doc.overflowed())
+    {
+      _values.remove(key);
+      return TELEMETRY_ERR_FULL;
+    }
+
+    _count++;
+    return TELEMETRY_OK;
+  }
+
+  /**
+   * @brief Adds a floating point key to the batch.
+   *
+   * @param[in] key   The telemetry key.
+   * @param[in] value The value.
+   *
+   * @return
+   *  - `TELEMETRY_OK`: Success
+   *
+   *  - `TELEMETRY_ERR`: No entry started in series mode
+   *
+   *  - `TELEMETRY_ERR_INVALID_ARG`: Null key, NaN or infinite value
+   *
+   *  - `TELEMETRY_ERR_FULL`: No room left, the key was not added
+   */
+  telemetry_error_t add(const char *key, float value);
+
+  /**
+   * @brief Checks if the batch holds no key.
+   *
+   * @return bool `true` if nothing was added since `begin()`.
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Checks if a value ever failed to fit the pool since `begin()`, i.e. the message is truncated.
+   *
+   * @return bool `true` if the pool overflowed. `add()` and `addEntry()` roll back a value that did not fit.
+   */
+  bool isOverflowed() const;
+
+  /**
+   * @brief Retrieves the number of keys in the batch.
+   *
+   * @return uint8_t The key count.
+   */
+  uint8_t getCount() const;
+
+  /**
+   * @brief Retrieves the number of entries of a series.
+   *
+   * @return uint8_t The entry count, `0` when the batch is not a series.
+   */
+  uint8_t getEntryCount() const;
+
+  /**
+   * @brief Retrieves the timestamp the batch was started with.
+   *
+   * @return uint64_t Epoch time in ms, `0` if the message is not timestamped or is a series.
+   */
+  uint64_t getTimestamp() const;
+
+  /**
+   * @brief Retrieves the message root for serialization.
+   *
+   * @return JsonVariantConst The whole message, envelope included.
+   */
+  JsonVariantConst getJson() const;
+
+  /**
+   * @brief Computes the serialized length of the message.
+   *
+   * @return size_t Length in bytes, without the terminating null character.
+   */
+  size_t measure() const;
+
+private:
+  StaticJsonDocument<TELEMETRY_BATCH_CAPACITY> _doc;
+  JsonObject                                   _values;
+  uint8_t                                      _count;
+  uint8_t                                      _entries;
+  bool                                         _series;
+  uint64_t                                     _timestamp;
+};
+
+#endif // TELEMETRY_BATCH_H
+
+/* End of file -------------------------------------------------------- */
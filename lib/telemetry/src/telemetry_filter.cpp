@@ -0,0 +1,193 @@
+/**
+ * @file       telemetry_filter.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-26
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Telemetry Filter library
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "telemetry_filter.h"
+
+#include <math.h>
+
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+
+/* Function definitions ----------------------------------------------- */
+bool telemetryPolicyIsValid(const telemetry_policy_t &policy)
+{
+  if (!isfinite(policy.deadband) || !isfinite(policy.excursion) || policy.deadband < 0.0f ||
+      policy.excursion < 0.0f)
+  {
+    return false;
+  }
+  // An excursion inside the deadband would send more often between cycles than at them
+  if (policy.excursion > 0.0f && policy.excursion < policy.deadband)
+  {
+    return false;
+  }
+  return policy.maxSilenceMs <= TELEMETRY_FILTER_MAX_SILENCE_MS;
+}
+
+telemetry_error_t telemetryPolicyFromJson(const JsonObjectConst &object, telemetry_policy_t &policy)
+{
+  if (object.isNull())
+  {
+    return TELEMETRY_ERR_INVALID_ARG;
+  }
+
+  telemetry_policy_t updated   = policy;
+  JsonVariantConst   deadband  = object[TELEMETRY_POLICY_DEADBAND];
+  JsonVariantConst   excursion = object[TELEMETRY_POLICY_EXCURSION];
+  JsonVariantConst   silence   = object[TELEMETRY_POLICY_MAX_SILENCE];
+
+  if ((!deadband.isNull() && !deadband.is<float>()) || (!excursion.isNull() && !excursion.is<float>()) ||
+      (!silence.isNull() && !silence.is<float>()))
+  {
+    return TELEMETRY_ERR_INVALID_ARG;
+  }
+  if (!deadband.isNull())
+  {
+    updated.deadband = deadband.as<float>();
+  }
+  if (!excursion.isNull())
+  {
+    updated.excursion = excursion.as<float>();
+  }
+  if (!silence.isNull())
+  {
+    float seconds = silence.as<float>();
+    if (!isfinite(seconds) || seconds < 0.0f || seconds * 1000.0f > TELEMETRY_FILTER_MAX_SILENCE_MS)
+    {
+      return TELEMETRY_ERR_INVALID_ARG;
+    }
+    updated.maxSilenceMs = (uint32_t) (seconds * 1000.0f);
+  }
+
+  if (!telemetryPolicyIsValid(updated))
+  {
+    return TELEMETRY_ERR_INVALID_ARG;
+  }
+  policy = updated;
+  return TELEMETRY_OK;
+}
+
+/* Class method definitions ------------------------------------------- */
+TelemetryFilter::TelemetryFilter(const telemetry_policy_t *defaults, uint8_t count)
+    : _count((count < TELEMETRY_FILTER_MAX_KEYS) ? count : TELEMETRY_FILTER_MAX_KEYS), _sent(0),
+      _suppressed(0)
+{
+  portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+  _lock                 = unlocked;
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    _policies[i] = defaults[i];
+  }
+  reset();
+}
+
+telemetry_error_t TelemetryFilter::setPolicy(uint8_t key, const telemetry_policy_t &policy)
+{
+  if (key >= _count || !telemetryPolicyIsValid(policy))
+  {
+    return TELEMETRY_ERR_INVALID_ARG;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  _policies[key] = policy;
+  portEXIT_CRITICAL(&_lock);
+  return TELEMETRY_OK;
+}
+
+bool TelemetryFilter::getPolicy(uint8_t key, telemetry_policy_t &policy)
+{
+  if (key >= _count)
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  policy = _policies[key];
+  portEXIT_CRITICAL(&_lock);
+  return true;
+}
+
+telemetry_send_reason_t TelemetryFilter::check(uint8_t key, float value, uint32_t nowMs, bool cycle)
+{
+  if (key >= _count || !isfinite(value))
+  {
+    return TELEMETRY_SEND_NONE;
+  }
+
+  const key_state_t &state = _states[key];
+  if (!state.sent)
+  {
+    return TELEMETRY_SEND_FIRST;
+  }
+
+  telemetry_policy_t policy;
+  getPolicy(key, policy);
+
+  float delta = fabsf(value - state.value);
+  if (policy.excursion > 0.0f && delta >= policy.excursion)
+  {
+    return TELEMETRY_SEND_EXCURSION;
+  }
+  if (!cycle)
+  {
+    return TELEMETRY_SEND_NONE;
+  }
+  if (policy.deadband == 0.0f || delta >= policy.deadband)
+  {
+    return TELEMETRY_SEND_DEADBAND;
+  }
+  if (policy.maxSilenceMs > 0 && nowMs - state.sentAt >= policy.maxSilenceMs)
+  {
+    return TELEMETRY_SEND_SILENCE;
+  }
+  return TELEMETRY_SEND_NONE;
+}
+
+void TelemetryFilter::markSent(uint8_t key, float value, uint32_t nowMs)
+{
+  if (key >= _count)
+  {
+    return;
+  }
+
+  _states[key].value  = value;
+  _states[key].sentAt = nowMs;
+  _states[key].sent   = true;
+  _sent++;
+}
+
+void TelemetryFilter::markSuppressed(uint8_t key)
+{
+  if (key < _count)
+  {
+    _suppressed++;
+  }
+}
+
+void TelemetryFilter::reset()
+{
+  for (uint8_t i = 0; i < TELEMETRY_FILTER_MAX_KEYS; i++)
+  {
+    _states[i].value  = 0.0f;
+    _states[i].sentAt = 0;
+    _states[i].sent   = false;
+  }
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,192 @@
+/**
+ * @file       telemetry_filter.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-26
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Telemetry Filter library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef TELEMETRY_FILTER_H
+  #define TELEMETRY_FILTER_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include "telemetry_batch.h"
+
+  #include <ArduinoJson.h>
+
+  /* Public defines ----------------------------------------------------- */
+  #define TELEMETRY_FILTER_LIB_VERSION    (F("0.1.0"))
+
+  #define TELEMETRY_FILTER_MAX_KEYS       8
+
+  // Longest silence a policy accepts, one day
+  #define TELEMETRY_FILTER_MAX_SILENCE_MS (24UL * 3600UL * 1000UL)
+
+  // Members of a policy object, {"deadband": 0.2, "excursion": 1.5, "maxSilence": 300}, silence in seconds
+  #define TELEMETRY_POLICY_DEADBAND       "deadband"
+  #define TELEMETRY_POLICY_EXCURSION      "excursion"
+  #define TELEMETRY_POLICY_MAX_SILENCE    "maxSilence"
+
+/* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief When a key is worth sending.
+ */
+typedef struct
+{
+  float    deadband;     /**< Change from the last value sent worth a send at a cycle, `0` every cycle */
+  float    excursion;    /**< Change sent at once, without waiting for the cycle, `0` to disable */
+  uint32_t maxSilenceMs; /**< Longest time without a send, `0` for no limit */
+} telemetry_policy_t;
+
+typedef enum
+{
+  TELEMETRY_SEND_NONE = 0,  /* Suppressed, within the deadband */
+  TELEMETRY_SEND_FIRST,     /* Never sent, or sent again after `reset()` */
+  TELEMETRY_SEND_DEADBAND,  /* Moved past the deadband since the last send */
+  TELEMETRY_SEND_SILENCE,   /* Unchanged, but silent for `maxSilenceMs` */
+  TELEMETRY_SEND_EXCURSION  /* Moved past the excursion threshold, sent without waiting for the cycle */
+} telemetry_send_reason_t;
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Function Declaration ----------------------------------------------- */
+/**
+ * @brief Checks that a policy is usable: finite, non-negative, an excursion above the deadband.
+ */
+bool telemetryPolicyIsValid(const telemetry_policy_t &policy);
+
+/**
+ * @brief Updates a policy from a JSON object, members missing from the object keep their value.
+ *
+ * @param[in]     object Policy object, see `TELEMETRY_POLICY_DEADBAND` and the following members.
+ * @param[in,out] policy Current policy, left untouched if the result is not valid.
+ *
+ * @return
+ *  - `TELEMETRY_OK`: Policy updated
+ *
+ *  - `TELEMETRY_ERR_INVALID_ARG`: A member has the wrong type or the result is not valid
+ */
+telemetry_error_t telemetryPolicyFromJson(const JsonObjectConst &object, telemetry_policy_t &policy);
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Per-key deadband and max-silence filter of telemetry values.
+ *
+ * The `TelemetryFilter` class decides, key by key, whether a new value is worth an uplink. A key is sent at
+ * the next cycle once it moved past its deadband from the last value sent, or once it was silent for its
+ * maximum silence so the server still sees the device alive. A move past the excursion threshold is sent at
+ * once, the owner polls between cycles for that. Stable keys are suppressed, which is most of them indoors.
+ *
+ * ### Features:
+ *
+ * - One policy per key, changed at run time, e.g. from shared attributes.
+ *
+ * - Changes are measured against the last value sent, a slow drift is sent once it adds up to the deadband.
+ *
+ * - Counters of sent and suppressed values.
+ *
+ * ### Usage:
+ *
+ * ```
+ * TelemetryFilter filter(POLICIES, KEY_COUNT);
+ * if (filter.check(KEY_TEMPERATURE, temperature, millis(), cycle) != TELEMETRY_SEND_NONE)
+ * {
+ *   // Buffer the value, then
+ *   filter.markSent(KEY_TEMPERATURE, temperature, millis());
+ * }
+ * ```
+ *
+ * ### Dependencies:
+ *
+ * - ArduinoJson 6 for `telemetryPolicyFromJson()`. The policies may be set from any task, `check()` and
+ * `markSent()` belong to the task that sends the telemetry.
+ */
+class TelemetryFilter
+{
+public:
+  /**
+   * @param[in] defaults Policy of each key, copied.
+   * @param[in] count    Number of keys, at most `TELEMETRY_FILTER_MAX_KEYS`. Extra keys are ignored.
+   */
+  TelemetryFilter(const telemetry_policy_t *defaults, uint8_t count);
+
+  /**
+   * @brief Replaces the policy of a key.
+   *
+   * @return
+   *  - `TELEMETRY_OK`: Success
+   *
+   *  - `TELEMETRY_ERR_INVALID_ARG`: Key out of range or policy not valid
+   */
+  telemetry_error_t setPolicy(uint8_t key, const telemetry_policy_t &policy);
+
+  /**
+   * @brief Retrieves the policy of a key.
+   *
+   * @return bool `false` if `key` is out of range.
+   */
+  bool getPolicy(uint8_t key, telemetry_policy_t &policy);
+
+  /**
+   * @brief Decides whether a value is worth sending. Nothing is recorded, see `markSent()`.
+   *
+   * @param[in] key   Key index.
+   * @param[in] value New value.
+   * @param[in] nowMs Current time, `millis()`.
+   * @param[in] cycle `true` at a telemetry cycle, `false` between cycles where only excursions are sent.
+   *
+   * @return telemetry_send_reason_t Why the value is sent, `TELEMETRY_SEND_NONE` if it is suppressed.
+   */
+  telemetry_send_reason_t check(uint8_t key, float value, uint32_t nowMs, bool cycle);
+
+  /**
+   * @brief Records a value as sent, the next changes are measured from it.
+   */
+  void markSent(uint8_t key, float value, uint32_t nowMs);
+
+  /**
+   * @brief Counts a value that `check()` suppressed at a cycle.
+   */
+  void markSuppressed(uint8_t key);
+
+  /**
+   * @brief Forgets the values sent, every key is sent again at the next check.
+   */
+  void reset();
+
+  uint8_t  getCount() const { return _count; }
+  uint32_t getSentCount() const { return _sent; }
+  uint32_t getSuppressedCount() const { return _suppressed; }
+
+private:
+  typedef struct
+  {
+    float    value;  /** Last value sent */
+    uint32_t sentAt; /** millis() of the last send */
+    bool     sent;   /** `false` until the first send */
+  } key_state_t;
+
+  portMUX_TYPE       _lock;
+  uint8_t            _count;
+  telemetry_policy_t _policies[TELEMETRY_FILTER_MAX_KEYS];
+  key_state_t        _states[TELEMETRY_FILTER_MAX_KEYS];
+  uint32_t           _sent;
+  uint32_t           _suppressed;
+};
+
+#endif // TELEMETRY_FILTER_H
+
+/* End of file -------------------------------------------------------- */
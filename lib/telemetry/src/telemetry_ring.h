@@ -0,0 +1,206 @@
+/**
+ * @file       telemetry_ring.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-05
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Telemetry Ring library
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef TELEMETRY_RING_H
+  #define TELEMETRY_RING_H
+
+  /* Includes ----------------------------------------------------------- */
+  // Pure C++, no Arduino or FreeRTOS dependency so the ring builds on the host
+  #include <stddef.h>
+  #include <stdint.h>
+
+/* Public defines ----------------------------------------------------- */
+
+/* Public enumerate/structure ----------------------------------------- */
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Class Declaration -------------------------------------------------- */
+
+/**
+ * @brief Fixed-size store-and-forward ring of samples.
+ *
+ * The `TelemetryRing` class keeps the samples that could not be published yet, so an offline period does
+ * not lose data. Samples are drained oldest first once the link is back.
+ *
+ * ### Features:
+ *
+ * - Static storage of `N` samples, no heap allocation.
+ *
+ * - Oldest-first eviction: pushing into a full ring overwrites the oldest sample and counts it as lost.
+ *
+ * - Backpressure: `peek()` copies a batch without removing it, `drop()` removes it only once the upload was
+ * acknowledged, so a failed publish keeps the samples for the next attempt. A sample that can never be
+ * published is removed with `discard()` and counted as lost.
+ *
+ * ### Usage:
+ *
+ * `push()` a sample every cycle, then while connected `peek()` a batch, publish it and `drop()` the count
+ * that was sent.
+ *
+ * ### Dependencies:
+ *
+ * - None. The ring is not thread-safe, it must be owned by a single task.
+ *
+ * @tparam T Sample type, copied by value.
+ * @tparam N Capacity in samples.
+ */
+template <typename T, size_t N>
+class TelemetryRing
+{
+public:
+  TelemetryRing() : _head(0), _count(0), _overwritten(0), _discarded(0) {}
+
+  /**
+   * @brief Appends a sample, evicting the oldest one if the ring is full.
+   *
+   * @param[in] sample The sample to store.
+   *
+   * @return bool `true` if the oldest sample was evicted to make room, `false` otherwise.
+   */
+  bool push(const T &sample)
+  {
+    bool evicted = false;
+
+    if (_count == N)
+    {
+      _head = (_head + 1) % N;
+      _count--;
+      _overwritten++;
+      evicted = true;
+    }
+
+    _buffer[(_head + _count) % N] = sample;
+    _count++;
+
+    return evicted;
+  }
+
+  /**
+   * @brief Copies the oldest samples without removing them.
+   *
+   * @param[out] out Destination buffer.
+   * @param[in]  max Maximum number of samples to copy.
+   *
+   * @return size_t Number of samples copied.
+   */
+  size_t peek(T *out, size_t max) const
+  {
+    if (out == nullptr)
+    {
+      return 0;
+    }
+
+    size_t n = (max < _count) ? max : _count;
+    for (size_t i = 0; i < n; i++)
+    {
+      out[i] = _buffer[(_head + i) % N];
+    }
+    return n;
+  }
+
+  /**
+   * @brief Removes the oldest samples, typically after they were uploaded.
+   *
+   * @param[in] n Number of samples to remove, clamped to `size()`.
+   *
+   * @return size_t Number of samples removed.
+   */
+  size_t drop(size_t n)
+  {
+    if (n > _count)
+    {
+      n = _count;
+    }
+    _head   = (_head + n) % N;
+    _count -= n;
+    return n;
+  }
+
+  /**
+   * @brief Removes the oldest samples without sending them, they are counted as lost.
+   *
+   * @param[in] n Number of samples to remove, clamped to `size()`.
+   *
+   * @return size_t Number of samples removed.
+   */
+  size_t discard(size_t n)
+  {
+    n           = drop(n);
+    _discarded += n;
+    return n;
+  }
+
+  /**
+   * @brief Removes every sample.
+   */
+  void clear()
+  {
+    _head  = 0;
+    _count = 0;
+  }
+
+  /**
+   * @brief Retrieves the number of stored samples.
+   *
+   * @return size_t The sample count.
+   */
+  size_t size() const { return _count; }
+
+  /**
+   * @brief Retrieves the capacity of the ring.
+   *
+   * @return size_t The capacity in samples.
+   */
+  size_t capacity() const { return N; }
+
+  /**
+   * @brief Checks if the ring holds no sample.
+   *
+   * @return bool `true` if empty.
+   */
+  bool isEmpty() const { return _count == 0; }
+
+  /**
+   * @brief Checks if the next push will evict a sample.
+   *
+   * @return bool `true` if full.
+   */
+  bool isFull() const { return _count == N; }
+
+  /**
+   * @brief Retrieves the number of samples lost to eviction since construction.
+   *
+   * @return uint32_t The eviction count.
+   */
+  uint32_t getOverwritten() const { return _overwritten; }
+
+  /**
+   * @brief Retrieves the number of samples removed with `discard()` since construction.
+   *
+   * @return uint32_t The discard count.
+   */
+  uint32_t getDiscarded() const { return _discarded; }
+
+private:
+  T        _buffer[N];
+  size_t   _head;        /**< Index of the oldest sample */
+  size_t   _count;       /**< Number of stored samples */
+  uint32_t _overwritten; /**< Samples evicted by a push into a full ring */
+  uint32_t _discarded;   /**< Samples removed because they could not be published */
+};
+
+#endif // TELEMETRY_RING_H
+
+/* End of file -------------------------------------------------------- */
@@ -18,12 +18,54 @@
 /* Private enumerate/structure ---------------------------------------- */
 
 /* Private macros ----------------------------------------------------- */
+// One row of 16 table entries, the table is spelled out row by row as C++11 constexpr has no loops
+#define CRC8_ROW(base, bits)                                                                                 \
+  crc8Shift(base + 0x0, bits), crc8Shift(base + 0x1, bits), crc8Shift(base + 0x2, bits),                     \
+      crc8Shift(base + 0x3, bits), crc8Shift(base + 0x4, bits), crc8Shift(base + 0x5, bits),                 \
+      crc8Shift(base + 0x6, bits), crc8Shift(base + 0x7, bits), crc8Shift(base + 0x8, bits),                 \
+      crc8Shift(base + 0x9, bits), crc8Shift(base + 0xA, bits), crc8Shift(base + 0xB, bits),                 \
+      crc8Shift(base + 0xC, bits), crc8Shift(base + 0xD, bits), crc8Shift(base + 0xE, bits),                 \
+      crc8Shift(base + 0xF, bits)
+
+/* Private function prototypes ---------------------------------------- */
+/**
+ * @brief Shifts `bits` bits of `crc` through the CRC-8 polynomial, evaluated at compile time.
+ */
+static constexpr uint8_t crc8Shift(uint8_t crc, uint8_t bits)
+{
+  return (bits == 0) ? crc
+                     : crc8Shift((uint8_t) ((crc & 0x80) ? ((crc << 1) ^ CRC8_POLYNOMIAL) : (crc << 1)),
+                                 (uint8_t) (bits - 1));
+}
 
 /* Public variables --------------------------------------------------- */
 
 /* Private variables -------------------------------------------------- */
+// Entry n is the CRC of byte n with a zero register: crc' = table[crc ^ byte]
+static constexpr uint8_t CRC8_TABLE[256] = {
+  CRC8_ROW(0x00, 8), CRC8_ROW(0x10, 8), CRC8_ROW(0x20, 8), CRC8_ROW(0x30, 8),
+  CRC8_ROW(0x40, 8), CRC8_ROW(0x50, 8), CRC8_ROW(0x60, 8), CRC8_ROW(0x70, 8),
+  CRC8_ROW(0x80, 8), CRC8_ROW(0x90, 8), CRC8_ROW(0xA0, 8), CRC8_ROW(0xB0, 8),
+  CRC8_ROW(0xC0, 8), CRC8_ROW(0xD0, 8), CRC8_ROW(0xE0, 8), CRC8_ROW(0xF0, 8),
+};
+
+// Entry n is the feedback of the high nibble n: crc' = (crc << 4) ^ table[crc >> 4]
+static constexpr uint8_t CRC8_NIBBLE_TABLE[16] = {
+  crc8Shift(0x00, 4), crc8Shift(0x10, 4), crc8Shift(0x20, 4), crc8Shift(0x30, 4),
+  crc8Shift(0x40, 4), crc8Shift(0x50, 4), crc8Shift(0x60, 4), crc8Shift(0x70, 4),
+  crc8Shift(0x80, 4), crc8Shift(0x90, 4), crc8Shift(0xA0, 4), crc8Shift(0xB0, 4),
+  crc8Shift(0xC0, 4), crc8Shift(0xD0, 4), crc8Shift(0xE0, 4), crc8Shift(0xF0, 4),
+};
+
+static constexpr uint8_t crc8NibbleStep(uint8_t crc)
+{
+  return (uint8_t) ((uint8_t) (crc << 4) ^ CRC8_NIBBLE_TABLE[crc >> 4]);
+}
 
-/* Private function prototypes ---------------------------------------- */
+// Datasheet vector {0xBE, 0xEF} -> 0x92, checked on both tables at build time
+static_assert(CRC8_TABLE[CRC8_TABLE[CRC8_INIT ^ 0xBE] ^ 0xEF] == 0x92, "CRC-8 table mismatch");
+static_assert(crc8NibbleStep(crc8NibbleStep(crc8NibbleStep(crc8NibbleStep(CRC8_INIT ^ 0xBE)) ^ 0xEF)) == 0x92,
+              "CRC-8 nibble table mismatch");
 
 /* Function definitions ----------------------------------------------- */
 void scanI2CDevices()
@@ -71,6 +113,17 @@ void scanI2CDevices()
 }
 
 uint8_t crc8(const uint8_t *data, int len)
+{
+#if CRC8_IMPL == CRC8_IMPL_TABLE
+  return crc8Table(data, len);
+#elif CRC8_IMPL == CRC8_IMPL_NIBBLE
+  return crc8Nibble(data, len);
+#else
+  return crc8Bitwise(data, len);
+#endif
+}
+
+uint8_t crc8Bitwise(const uint8_t *data, int len)
 {
   /*
    *
@@ -83,8 +136,7 @@ uint8_t crc8(const uint8_t *data, int len)
    * Final XOR 0x00
    */
 
-  const uint8_t POLYNOMIAL(0x31);
-  uint8_t       crc(0xFF);
+  uint8_t crc(CRC8_INIT);
 
   for (int j = len; j; --j)
   {
@@ -92,30 +144,46 @@ uint8_t crc8(const uint8_t *data, int len)
 
     for (int i = 8; i; --i)
     {
-      crc = (crc & 0x80) ? (crc << 1) ^ POLYNOMIAL : (crc << 1);
+      crc = (crc & 0x80) ? (crc << 1) ^ CRC8_POLYNOMIAL : (crc << 1);
     }
   }
   return crc;
 }
 
-int compareVersion(String v1, String v2)
+uint8_t crc8Nibble(const uint8_t *data, int len)
+{
+  uint8_t crc(CRC8_INIT);
+
+  for (int j = len; j; --j)
+  {
+    crc = crc8NibbleStep(crc8NibbleStep(crc ^ *data++));
+  }
+  return crc;
+}
+
+uint8_t crc8Table(const uint8_t *data, int len)
+{
+  uint8_t crc(CRC8_INIT);
+
+  for (int j = len; j; --j)
+  {
+    crc = CRC8_TABLE[crc ^ *data++];
+  }
+  return crc;
+}
+
+int compareVersion(const char *v1, const char *v2)
 {
   int parts1[3] = {0}, parts2[3] = {0};
 
-  // Helper to parse a version string into 3 int parts
-  auto parseVersion = [](const String &ver, int *parts) {
-    int partIndex = 0;
-    int lastDot   = -1;
-    for (int i = 0; i <= ver.length(); ++i)
+  // Helper to parse a version string into 3 int parts, strtol() stops on the dot
+  auto parseVersion = [](const char *ver, int *parts) {
+    for (int partIndex = 0; ver != nullptr && partIndex < 3; partIndex++)
     {
-      if (ver[i] == '.' || i == ver.length())
-      {
-        if (partIndex < 3)
-        {
-          parts[partIndex++] = ver.substring(lastDot + 1, i).toInt();
-        }
-        lastDot = i;
-      }
+      char *end        = nullptr;
+      parts[partIndex] = (int) strtol(ver, &end, 10);
+      const char *dot  = strchr(end, '.');
+      ver              = (dot != nullptr) ? dot + 1 : nullptr;
     }
   };
 
@@ -23,7 +23,22 @@
 
   #include "Wire.h"
 
-/* Public defines ----------------------------------------------------- */
+  /* Public defines ----------------------------------------------------- */
+  // CRC-8 implementations, pick one for crc8() with -D CRC8_IMPL=<value>
+  #define CRC8_IMPL_BITWISE 0 // 8 shifts per byte, no table
+  #define CRC8_IMPL_NIBBLE  1 // 2 lookups per byte, 16-byte table, for flash-constrained builds
+  #define CRC8_IMPL_TABLE   2 // 1 lookup per byte, 256-byte table
+
+  #ifndef CRC8_IMPL
+    #define CRC8_IMPL CRC8_IMPL_TABLE
+  #endif
+
+  #define CRC8_POLYNOMIAL 0x31 // x^8 + x^5 + x^4 + 1
+  #define CRC8_INIT       0xFF
+
+  #define FNV1A_OFFSET_BASIS 2166136261UL
+  #define FNV1A_PRIME        16777619UL
+
 
 /* Public enumerate/structure ----------------------------------------- */
 
@@ -85,6 +100,10 @@ void scanI2CDevices(void);
  *
  * Example from datasheet: For data bytes {0xBE, 0xEF}, the CRC result is 0x92.
  *
+ * The implementation is selected at compile time with `CRC8_IMPL` (table lookup by default), all of them
+ * return the same value and remain callable on their own as `crc8Bitwise()`, `crc8Nibble()` and
+ * `crc8Table()`.
+ *
  * @param[in]     data  Pointer to the input data buffer.
  * @param[in]     len   Length of the data buffer in bytes.
  *
@@ -96,15 +115,31 @@ void scanI2CDevices(void);
  */
 uint8_t crc8(const uint8_t *data, int len);
 
+/**
+ * @brief  CRC-8 of `crc8()`, computed one bit at a time. Reference implementation, no table.
+ */
+uint8_t crc8Bitwise(const uint8_t *data, int len);
+
+/**
+ * @brief  CRC-8 of `crc8()`, computed one nibble at a time from a 16-entry table.
+ */
+uint8_t crc8Nibble(const uint8_t *data, int len);
+
+/**
+ * @brief  CRC-8 of `crc8()`, computed one byte at a time from a 256-entry table generated at compile time.
+ */
+uint8_t crc8Table(const uint8_t *data, int len);
+
 /**
  * @brief  Compares two firmware version strings.
  *
  * This function compares two version strings (e.g., "1.0", "0.9.3", "2") by parsing up to three levels
  * of semantic versioning: major, minor, and patch. Missing segments are treated as zero, allowing
- * flexible comparison of version formats like "0.1", "0.1.0", or "1".
+ * flexible comparison of version formats like "0.1", "0.1.0", or "1". The strings are parsed in place, no
+ * copy is made.
  *
- * @param[in]     v1  The current firmware version (as a `String`).
- * @param[in]     v2  The incoming/target firmware version (as a `String`).
+ * @param[in]     v1  The current firmware version.
+ * @param[in]     v2  The incoming/target firmware version. `nullptr` is read as "0".
  *
  * @attention  Version strings should be in numeric dot-separated format. Non-numeric parts are ignored.
  *             For example, "1.0a" would parse as "1.0.0". Only the first three segments are considered.
@@ -114,7 +149,23 @@ uint8_t crc8(const uint8_t *data, int len);
  *  - ` 0` if both versions are equal
  *  - ` 1` if `v1` is greater than `v2`
  */
-int compareVersion(String v1, String v2);
+int compareVersion(const char *v1, const char *v2);
+
+/**
+ * @brief  FNV-1a hash of a string, usable at compile time.
+ *
+ * Keys of the constant handler tables (RPC methods, attributes) are hashed by the compiler with it, the
+ * incoming names at run time, so a lookup compares integers instead of strings.
+ *
+ * @param[in]     str   Null-terminated string.
+ * @param[in]     hash  Running hash, leave the default.
+ *
+ * @return uint32_t The 32-bit hash.
+ */
+constexpr uint32_t fnv1a(const char *str, uint32_t hash = FNV1A_OFFSET_BASIS)
+{
+  return (*str == '\0') ? hash : fnv1a(str + 1, (hash ^ (uint8_t) *str) * FNV1A_PRIME);
+}
 
 #endif // UTILITY_H
 
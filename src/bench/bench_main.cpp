@@ -0,0 +1,171 @@
+/**
+ * @file       bench_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-08
+ * @author     Tuan Nguyen
+ *
+ * @brief      Entry point of the benchmark environments: cost per call of the sensor math kernels
+ *
+ * Measures BMP280 compensation and altitude, SHT4X frame decoding and CRC-8, the kernels that run on every
+ * sensor cycle. The CRC-8 implementations are checked against each other over every 2-byte word first.
+ *
+ * - Host: `pio run -e native_bench -t exec`. Set `BENCH_HISTORY=<file.csv>` to append the results to a
+ * history and see the change against the last run, `BENCH_LABEL=<tag>` to tag the rows (e.g. a commit).
+ *
+ * - Target: `pio run -e yolo_uno_bench -t upload -t monitor`. Timing uses the CPU cycle counter, the CSV
+ * rows are printed on the serial port. Needs the BMP280 on the bus for its calibration coefficients.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#ifdef HAL_NATIVE
+  #include "hal_native.h"
+  #include "hal_sim_devices.h"
+
+  #include <stdlib.h>
+#else
+  #include "globals.h"
+#endif
+
+#include "bench.h"
+#include "bmp280.h"
+#include "sht4x.h"
+#include "utility.h"
+
+/* Private defines ---------------------------------------------------- */
+#define BENCH_INPUTS     16 // Power of two, inputs are picked with (i & (BENCH_INPUTS - 1))
+#define BENCH_BLOCK_SIZE 64 // Bytes of the long CRC run
+
+/* Private variables -------------------------------------------------- */
+#ifdef HAL_NATIVE
+static SimBMP280 simBmp;
+#endif
+
+static BMP280 bmp280;
+static SHT4X  sht4x;
+
+static int32_t adcTemperature[BENCH_INPUTS];
+static int32_t adcPressure[BENCH_INPUTS];
+static uint8_t shtFrames[BENCH_INPUTS][6];
+static uint8_t block[BENCH_BLOCK_SIZE + 1]; // Runs start at offset 0 or 1
+
+/* Private function prototypes ---------------------------------------- */
+static void benchPrepareInputs();
+static bool benchCheckCrc();
+static bool benchRun();
+
+/* Function definitions ----------------------------------------------- */
+#ifdef HAL_NATIVE
+int main()
+{
+  halSimReset();
+  halI2CAttach(SIM_BMP280_I2C_ADDR, &simBmp);
+  Serial.begin(115200);
+  Wire.begin(-1, -1, 100000UL);
+
+  // A failed check must fail the run, the implementations are also tested in test/test_utility
+  return benchRun() ? 0 : 1;
+}
+#else
+void setup()
+{
+  Serial.begin(115200);
+  delay(2000);
+  Wire.begin(SDA_PIN, SCL_PIN);
+
+  benchRun();
+}
+
+void loop() { delay(1000); }
+#endif
+
+/* Private definitions ------------------------------------------------ */
+static void benchPrepareInputs()
+{
+  for (uint8_t i = 0; i < BENCH_INPUTS; i++)
+  {
+    // Around the datasheet sample (25.08 C, 100653 Pa)
+    adcTemperature[i] = 519888 + (int32_t) i * 137;
+    adcPressure[i]    = 415148 - (int32_t) i * 211;
+
+    // Valid SHT4X frames, so decode() goes through the scaling and not the checksum error path
+    uint16_t ticksT = (uint16_t) (26000 + i * 97);
+    uint16_t ticksH = (uint16_t) (30000 + i * 131);
+    shtFrames[i][0] = (uint8_t) (ticksT >> 8);
+    shtFrames[i][1] = (uint8_t) ticksT;
+    shtFrames[i][2] = crc8(&shtFrames[i][0], 2);
+    shtFrames[i][3] = (uint8_t) (ticksH >> 8);
+    shtFrames[i][4] = (uint8_t) ticksH;
+    shtFrames[i][5] = crc8(&shtFrames[i][3], 2);
+  }
+
+  for (uint8_t i = 0; i <= BENCH_BLOCK_SIZE; i++)
+  {
+    block[i] = (uint8_t) (i * 37 + 11);
+  }
+}
+
+static bool benchCheckCrc()
+{
+  // Datasheet vector, then every 2-byte word (the SHT4X case) on every implementation
+  const uint8_t vector[2] = { 0xBE, 0xEF };
+  if (crc8Bitwise(vector, 2) != 0x92 || crc8Nibble(vector, 2) != 0x92 || crc8Table(vector, 2) != 0x92)
+  {
+    return false;
+  }
+
+  uint8_t word[2];
+  for (uint32_t value = 0; value <= 0xFFFF; value++)
+  {
+    word[0]          = (uint8_t) (value >> 8);
+    word[1]          = (uint8_t) value;
+    uint8_t expected = crc8Bitwise(word, 2);
+    if (crc8Nibble(word, 2) != expected || crc8Table(word, 2) != expected)
+    {
+      return false;
+    }
+  }
+  return crc8Nibble(block, BENCH_BLOCK_SIZE) == crc8Bitwise(block, BENCH_BLOCK_SIZE) &&
+         crc8Table(block, BENCH_BLOCK_SIZE) == crc8Bitwise(block, BENCH_BLOCK_SIZE);
+}
+
+static bool benchRun()
+{
+  Serial.printf("BMP280 begin: %d\n", bmp280.begin());
+  benchPrepareInputs();
+  if (!benchCheckCrc())
+  {
+    Serial.println("CRC-8 implementations disagree, not benchmarking");
+    return false;
+  }
+
+  Bench bench("sensor_math");
+
+  bench.run("bmp280.compensate", [](uint32_t i) {
+    const uint8_t k = i & (BENCH_INPUTS - 1);
+    benchKeep(bmp280.compensate(adcTemperature[k], adcPressure[k]));
+  });
+  bench.run("bmp280.readAltitude", [](uint32_t i) { benchKeep(bmp280.readAltitude()); });
+  bench.run("sht4x.decode", [](uint32_t i) { benchKeep(sht4x.decode(shtFrames[i & (BENCH_INPUTS - 1)])); });
+  bench.run("crc8 (2 B)", [](uint32_t i) { benchKeep(crc8(shtFrames[i & (BENCH_INPUTS - 1)], 2)); });
+  bench.run("crc8 (64 B)", [](uint32_t i) { benchKeep(crc8(&block[i & 1], BENCH_BLOCK_SIZE)); });
+  bench.run("crc8Bitwise (64 B)", [](uint32_t i) { benchKeep(crc8Bitwise(&block[i & 1], BENCH_BLOCK_SIZE)); });
+  bench.run("crc8Nibble (64 B)", [](uint32_t i) { benchKeep(crc8Nibble(&block[i & 1], BENCH_BLOCK_SIZE)); });
+  bench.run("crc8Table (64 B)", [](uint32_t i) { benchKeep(crc8Table(&block[i & 1], BENCH_BLOCK_SIZE)); });
+
+  bench.report(Serial);
+
+#ifdef HAL_NATIVE
+  const char *history = getenv("BENCH_HISTORY");
+  if (history != nullptr && history[0] != '\0' && bench.appendHistory(history, Serial) != BENCH_OK)
+  {
+    Serial.printf("Cannot write %s\n", history);
+  }
+#endif
+  return true;
+}
+
+/* End of file -------------------------------------------------------- */
@@ -12,8 +12,11 @@ BMP280 bmp280;
 LightSensor lightSensor(LIGHT_SENSOR_PIN);
 #endif
 
+SensorSnapshotStore sensorSnapshot;
+
 #ifdef LCD_MODULE
-LCD_I2C lcd(0x21, 16, 2);
+LCD_I2C  lcd(0x21, 16, 2);
+LcdPages lcdPages(lcd);
 #endif
 
 #ifdef MINI_FAN_MODULE
@@ -21,11 +24,13 @@ MiniFan miniFan(MINI_FAN_PIN);
 #endif
 
 #ifdef SERVO_MODULE
-Servo doorServo;
+Servo       doorServo;
+ServoMotion doorMotion;
 #endif
 
 #ifdef LED_RGB_MODULE
 Adafruit_NeoPixel rgb(4, LED_RGB_PIN, NEO_GRB + NEO_KHZ800);
+LedEffects        ledEffects;
 #endif
 
 #ifdef BUTTON_MODULE
@@ -4,6 +4,7 @@ void setup()
 {
   Serial.begin(9600);
   Wire.begin(SDA_PIN, SCL_PIN, 100000UL);
+  bspI2CEngineBegin();
 
 #ifdef DEBUG_I2C
   while (!Serial)
@@ -38,8 +39,13 @@ void setup()
 #endif // SERVO_MODULE
 
 #ifdef MINI_FAN_MODULE
+  fanSetup();
 #endif // MINI_FAN_MODULE
 
+#ifdef FAN_CONTROL_MODULE
+  fanControlSetup();
+#endif // FAN_CONTROL_MODULE
+
 #ifdef BUTTON_MODULE
   buttonSetup();
 #endif // BUTTON_MODULE
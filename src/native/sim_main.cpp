@@ -0,0 +1,507 @@
+/**
+ * @file       sim_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-07
+ * @author     Tuan Nguyen
+ *
+ * @brief      Entry point of the native environment: drives the lib/ drivers against the device models
+ *
+ * Runs a scripted session on the virtual clock (sensor readings, button presses, light level changes, a
+ * Modbus exchange) and prints what the drivers report together with the I2C traffic they generated.
+ * Build and run with `pio run -e native -t exec`.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "hal_native.h"
+#include "hal_sim_devices.h"
+
+#include "attribute_registry.h"
+#include "bmp280.h"
+#include "bsp_i2c.h"
+#include "bsp_rs485.h"
+#include "button.h"
+#include "lcd_16x2.h"
+#include "led_effects.h"
+#include "light_sensor.h"
+#include "mini_fan.h"
+#include "rpc_router.h"
+#include "servo_motion.h"
+#include "sht4x.h"
+#include "utility.h"
+
+/* Private defines ---------------------------------------------------- */
+// Same pins as the YOLO UNO build, see include/globals.h
+#define SIM_BUTTON_PIN       6
+#define SIM_MINI_FAN_PIN     3
+#define SIM_LIGHT_SENSOR_PIN 1
+
+#define SIM_BUTTON_PERIOD_MS 10
+
+#define SIM_LED_PIXELS   4  // Same strip as globals.cpp
+#define SIM_LED_FRAME_MS 20 // LED_FRAME_MS
+
+// Door servo, same range as doorSetup()
+#define SIM_SERVO_MIN_US 500
+#define SIM_SERVO_MAX_US 1500
+
+/* Private variables -------------------------------------------------- */
+static SimSHT4X   simSht;
+static SimBMP280  simBmp;
+static SimLCD1602 simLcd;
+
+static SHT4X         sht4x;
+static BMP280        bmp280;
+static LCD_I2C       lcd(SIM_LCD1602_I2C_ADDR, SIM_LCD1602_COLUMNS, SIM_LCD1602_ROWS);
+static LightSensor   lightSensor(SIM_LIGHT_SENSOR_PIN);
+static MiniFan       miniFan(SIM_MINI_FAN_PIN);
+static ButtonHandler button(SIM_BUTTON_PIN);
+static ServoMotion   doorMotion;
+static LedEffects    ledEffects;
+
+static uint32_t singleClicks = 0;
+static uint32_t doubleClicks = 0;
+static uint32_t holds        = 0;
+static uint32_t latestCrossings = 0;
+static uint32_t medianCrossings = 0;
+static uint16_t servoPulseUs    = 0;
+static uint32_t servoWrites     = 0;
+static uint32_t servoDoneAt     = 0;
+static int      servoDoneAngle  = -1;
+static led_color_t ledShown[SIM_LED_PIXELS];
+
+/* Private function prototypes ---------------------------------------- */
+static rpc_router_error_t simRpcSetState(const JsonVariantConst &params, JsonDocument &response);
+static rpc_router_error_t simRpcFail(const JsonVariantConst &params, JsonDocument &response);
+static void               simCallRpc(RpcRouter &router, const char *method, const char *params);
+static bool               simSetAttrInt(const attr_value_t &value, void *context);
+static bool               simSetAttrFloat(const attr_value_t &value, void *context);
+static bool               simSetAttrString(const attr_value_t &value, void *context);
+static void simPrintStats(const char *label);
+static void simDumpLcd();
+static void simDrawLcd(float temperature, float humidity);
+static void simPrintLight(const char *label);
+static void simPrintFan(const char *label, uint32_t afterMs);
+static void simPrintServo(const char *label, uint32_t afterMs);
+static void simRunLed(uint32_t durationMs, const char *label);
+static void simPressButton(uint32_t atMs, uint32_t durationMs);
+static void simBounceButton(uint32_t atMs);
+static void simRunButton(uint32_t durationMs);
+static void simRunButtonInterrupt(uint32_t durationMs);
+
+/* Function definitions ----------------------------------------------- */
+int main()
+{
+  halSimReset();
+  halI2CAttach(SIM_SHT4X_I2C_ADDR, &simSht);
+  halI2CAttach(SIM_BMP280_I2C_ADDR, &simBmp);
+  halI2CAttach(SIM_LCD1602_I2C_ADDR, &simLcd);
+
+  Serial.begin(115200);
+  Wire.begin(-1, -1, 100000UL);
+  bspI2CEngineBegin();
+
+  // Sensors
+  Serial.printf("[%6lu ms] SHT4X begin: %d, BMP280 begin: %d\n", millis(), sht4x.begin(), bmp280.begin());
+  halI2CResetStats();
+
+  simSht.setTemperature(28.4f);
+  simSht.setHumidity(63.0f);
+  sht4x.update();
+  Serial.printf("[%6lu ms] SHT4X  %.2f C  %.2f %%RH\n", millis(), sht4x.getTemperature(),
+                sht4x.getHumidity());
+  simPrintStats("SHT4X update");
+
+  bmp280.update();
+  Serial.printf("[%6lu ms] BMP280 %.2f C  %.0f Pa  %.1f m (datasheet sample)\n", millis(),
+                bmp280.getTemperature(), bmp280.getPressure(), bmp280.getAltitude());
+  simBmp.setTemperature(30.0f);
+  simBmp.setPressure(95000.0f);
+  bmp280.update();
+  Serial.printf("[%6lu ms] BMP280 %.2f C  %.0f Pa  %.1f m\n", millis(), bmp280.getTemperature(),
+                bmp280.getPressure(), bmp280.getAltitude());
+  simPrintStats("BMP280 update x2");
+
+  // LCD
+  lcd.begin(&Wire);
+  lcd.backlight();
+  lcd.display();
+  lcd.clear();
+  simPrintStats("LCD init");
+  simDrawLcd(sht4x.getTemperature(), sht4x.getHumidity());
+  simDumpLcd();
+  simPrintStats("LCD clear+redraw");
+
+  // Same refresh through the framebuffer, unchanged then with one value changed
+  lcd.setBuffered(true);
+  simDrawLcd(sht4x.getTemperature(), sht4x.getHumidity());
+  lcd.flush();
+  simPrintStats("LCD flush redraw");
+  simDrawLcd(sht4x.getTemperature() + 0.1f, sht4x.getHumidity());
+  lcd.flush();
+  simDumpLcd();
+  simPrintStats("LCD flush 1 digit");
+
+  // Light screen: the bar glyphs are uploaded by the first refresh only
+  for (uint8_t percentage = 42; percentage <= 43; percentage++)
+  {
+    lcd.clear();
+    lcd.print("Light level: ");
+    lcd.print(percentage);
+    lcd.progressBar(1, percentage);
+    lcd.flush();
+    simPrintStats((percentage == 42) ? "LCD light screen" : "LCD light refresh");
+  }
+  simDumpLcd();
+
+  // Light sensor and fan
+  halAnalogSetInput(SIM_LIGHT_SENSOR_PIN, 1024);
+  lightSensor.read();
+  Serial.printf("[%6lu ms] Light %d (%d %%)\n", millis(), lightSensor.getLightValue(),
+                lightSensor.getLightValuePercentage());
+  halSimSchedule(millis() + 100, []() { halAnalogSetInput(SIM_LIGHT_SENSOR_PIN, 3900); });
+  delay(200);
+  lightSensor.read();
+  Serial.printf("[%6lu ms] Light %d (%d %%)\n", millis(), lightSensor.getLightValue(),
+                lightSensor.getLightValuePercentage());
+
+  // Continuous pipeline: 1 kHz conversions decimated to 100 Hz, an 8 ms shadow then a real drop to darkness
+  // Falling triggers at 2000 with 200 counts of hysteresis, the latest sample sees the shadow, the median not
+  light_sensor_trigger_t dusk = { LIGHT_TRIGGER_FALLING, LIGHT_FILTER_LATEST, 2000, 0, 200, 50 };
+  lightSensor.addTrigger(dusk, [](int, light_sensor_event_t, void *) { latestCrossings++; });
+  dusk.filter = LIGHT_FILTER_MEDIAN;
+  lightSensor.addTrigger(dusk, [](int, light_sensor_event_t, void *) { medianCrossings++; });
+  lightSensor.beginContinuous(1000, 10);
+  delay(500);
+  simPrintLight("steady");
+  halSimSchedule(millis() + 100, []() { halAnalogSetInput(SIM_LIGHT_SENSOR_PIN, 0); });
+  halSimSchedule(millis() + 108, []() { halAnalogSetInput(SIM_LIGHT_SENSOR_PIN, 3900); });
+  delay(300);
+  simPrintLight("shadow");
+  halAnalogSetInput(SIM_LIGHT_SENSOR_PIN, 500);
+  delay(300);
+  simPrintLight("dark");
+  lightSensor.endContinuous();
+  Serial.printf("[%6lu ms] Light %u conversions, %u decimated samples\n", millis(),
+                halAdcContinuousGetConversions(), lightSensor.getSampleCount());
+
+  miniFan.setFanSpeedPercentage(60);
+  Serial.printf("[%6lu ms] Fan duty %u after %u writes\n", millis(), halAnalogGetOutput(SIM_MINI_FAN_PIN),
+                halAnalogGetWriteCount(SIM_MINI_FAN_PIN));
+
+  // Ramp engine: stop slowly, then restart with a kick and an accelerated ramp, then a timed linear ramp
+  miniFan.beginRamp();
+  miniFan.setRampProfile(50, 100);
+  miniFan.setKickStart(100, 150);
+  miniFan.setFanSpeedPercentage(0);
+  simPrintFan("stopping", 500);
+  simPrintFan("stopped", 2000);
+  miniFan.setFanSpeedPercentage(60);
+  simPrintFan("kick", 100);
+  simPrintFan("ramp", 300);
+  simPrintFan("at speed", 2000);
+  uint32_t fanWrites = halAnalogGetWriteCount(SIM_MINI_FAN_PIN);
+  miniFan.rampTo(20, 1000);
+  simPrintFan("rampTo", 500);
+  simPrintFan("rampTo", 600);
+  Serial.printf("[%6lu ms] Fan %u writes for the 1 s ramp\n", millis(),
+                halAnalogGetWriteCount(SIM_MINI_FAN_PIN) - fanWrites);
+
+  // Door: S-curve open over 1.2 s, then a trapezoidal close overtaken halfway by a reopen
+  doorMotion.begin(
+      [](uint16_t pulseUs, void *) {
+        servoPulseUs = pulseUs;
+        servoWrites++;
+      },
+      nullptr, SIM_SERVO_MIN_US, SIM_SERVO_MAX_US, 0);
+  doorMotion.attachDoneCallback([](int angle, void *) {
+    servoDoneAt    = millis();
+    servoDoneAngle = angle;
+  });
+  uint32_t servoWritesBefore = servoWrites;
+  doorMotion.moveTo(180, 1200);
+  simPrintServo("open", 200);
+  simPrintServo("open", 400);
+  simPrintServo("open", 400);
+  simPrintServo("open", 400);
+  Serial.printf("[%6lu ms] Servo open done at %u ms, angle %d, %u writes\n", millis(), servoDoneAt,
+                servoDoneAngle, servoWrites - servoWritesBefore);
+  doorMotion.setProfile(SERVO_PROFILE_TRAPEZOID);
+  doorMotion.moveTo(0, 1200);
+  simPrintServo("close", 600);
+  doorMotion.moveTo(180, 600);
+  simPrintServo("reopen", 300);
+  simPrintServo("reopen", 400);
+  Serial.printf("[%6lu ms] Servo reopen done at %u ms, angle %d\n", millis(), servoDoneAt, servoDoneAngle);
+
+  // LED strip rendered at the LED task frame rate: fade on, hold, breathe, blink, fade off from solid
+  ledEffects.begin(SIM_LED_PIXELS, [](const led_color_t *frame, uint16_t count, void *) {
+    memcpy(ledShown, frame, count * sizeof(led_color_t));
+  });
+  const led_color_t ledOn = LedEffects::fromDisplay(LED_COLOR(255, 102, 0)); // LED_ON_COLOR
+  ledEffects.fadeTo(ledOn, 300);
+  simRunLed(150, "fade");
+  simRunLed(150, "fade");
+  simRunLed(1000, "solid");
+  ledEffects.breathe(LED_COLOR(0, 0, 255), 2000);
+  simRunLed(500, "breathe");
+  simRunLed(500, "breathe");
+  ledEffects.blink(LED_COLOR(255, 0, 0), 250, 250);
+  simRunLed(1000, "blink");
+  ledEffects.solid(ledOn);
+  simRunLed(100, "solid");
+  ledEffects.fadeTo(LED_COLOR_OFF, 300);
+  simRunLed(1000, "fade off");
+
+  // Button: single click, double click, hold
+  button.attachSingleClickCallback([]() { singleClicks++; });
+  button.attachDoubleClickCallback([]() { doubleClicks++; });
+  button.attachHoldStartCallback([]() { holds++; });
+  uint32_t t0 = millis();
+  simPressButton(t0 + 50, 80);
+  simPressButton(t0 + 1000, 80);
+  simPressButton(t0 + 1200, 80);
+  simPressButton(t0 + 2500, 1500);
+  simRunButton(5000);
+  Serial.printf("[%6lu ms] Button polled: single %u, double %u, hold %u, %u update() calls\n", millis(),
+                singleClicks, doubleClicks, holds, 5000 / SIM_BUTTON_PERIOD_MS);
+
+  // Same presses, the first one bouncing, interrupt-driven: update() runs only on edges and deadlines
+  singleClicks = doubleClicks = holds = 0;
+  t0                                  = millis();
+  simBounceButton(t0 + 46);
+  simPressButton(t0 + 50, 80);
+  simPressButton(t0 + 1000, 80);
+  simPressButton(t0 + 1200, 80);
+  simPressButton(t0 + 2500, 1500);
+  simRunButtonInterrupt(5000);
+
+  // RPC router: two good calls, bad params, a failing handler and an unknown method, then the statistics
+  static constexpr rpc_method_t rpcMethods[] = {
+    RPC_METHOD("setLedValue", simRpcSetState),
+    RPC_METHOD("setDoorState", simRpcSetState),
+    RPC_METHOD("reboot", simRpcFail),
+  };
+  static_assert(rpcHashesUnique(rpcMethods, RPC_METHOD_COUNT(rpcMethods)), "RPC method hash collision");
+  RpcRouter rpcRouter(rpcMethods, RPC_METHOD_COUNT(rpcMethods));
+  simCallRpc(rpcRouter, "setLedValue", "true");
+  simCallRpc(rpcRouter, "setDoorState", "0");
+  simCallRpc(rpcRouter, "setDoorState", "\"open\"");
+  simCallRpc(rpcRouter, "reboot", "null");
+  simCallRpc(rpcRouter, "getTime", "null");
+  StaticJsonDocument<RPC_ROUTER_STATS_CAPACITY(RPC_METHOD_COUNT(rpcMethods))> rpcStats;
+  rpcRouter.exportStats(rpcStats.to<JsonObject>());
+  Serial.printf("[%6lu ms] RPC stats %s\n", millis(), rpcStats.as<std::string>().c_str());
+
+  // Attribute registry: one burst with a clamped speed, a rejected setpoint, a bad type and an unknown key
+  static constexpr attr_handler_t attrHandlers[] = {
+    ATTR_HANDLER_CLAMPED("fanSpeed", ATTR_TYPE_INT, 0, 100, simSetAttrInt),
+    ATTR_HANDLER("fanSetpoint", ATTR_TYPE_FLOAT, 10, 50, simSetAttrFloat),
+    ATTR_HANDLER("fanKp", ATTR_TYPE_FLOAT, 0, 1000, simSetAttrFloat),
+    ATTR_HANDLER("fw_version", ATTR_TYPE_STRING, 0, 16, simSetAttrString),
+  };
+  static_assert(attrHashesUnique(attrHandlers, ATTR_HANDLER_COUNT(attrHandlers)), "Attribute hash collision");
+  AttributeRegistry      attributes(attrHandlers, ATTR_HANDLER_COUNT(attrHandlers));
+  StaticJsonDocument<256> attrBurst;
+  deserializeJson(attrBurst, "{\"fanSpeed\":150,\"fanSetpoint\":80,\"fanKp\":\"high\","
+                             "\"fw_version\":\"1.2.0\",\"colour\":1}");
+  uint8_t     applied   = attributes.apply(attrBurst.as<JsonObjectConst>(), nullptr);
+  const char *fwVersion = attrBurst["fw_version"];
+  Serial.printf("[%6lu ms] Attributes %u applied, %u rejected, %u unknown; firmware 1.0.0 vs %s: %d, "
+                "1.10 vs 1.9: %d\n",
+                millis(), applied, attributes.getRejectedCount(), attributes.getUnknownCount(),
+                fwVersion, compareVersion("1.0.0", fwVersion), compareVersion("1.10", "1.9"));
+
+  // RS485: Modbus request, the slave answers 20 ms later
+  rs485Serial1.begin(9600);
+  uint8_t request[8]  = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 0x84, 0x0A };
+  uint8_t response[7] = { 0 };
+  halSimScheduleIn(20000, []() {
+    const uint8_t reply[7] = { 0x01, 0x03, 0x02, 0x01, 0x2C, 0xB8, 0x09 };
+    halUartInject(1, reply, sizeof(reply));
+  });
+  rs485Serial1.sendModbusCommand(request, sizeof(request), response, sizeof(response));
+  Serial.printf("[%6lu ms] Modbus sent %u bytes, register value %u\n", millis(),
+                (unsigned) halUartTakeTx(1).size(), (unsigned) ((response[3] << 8) | response[4]));
+
+  return 0;
+}
+
+/* Private definitions ------------------------------------------------ */
+static void simPrintStats(const char *label)
+{
+  hal_i2c_stats_t stats = halI2CGetStats();
+  Serial.printf("[%6lu ms]   I2C %-18s %5u txn  %5u B out  %4u B in  %u NACK  %llu us on bus\n", millis(),
+                label, stats.transactions, stats.bytesWritten, stats.bytesRead, stats.nacks,
+                (unsigned long long) stats.busTimeUs);
+  halI2CResetStats();
+}
+
+static void simDumpLcd()
+{
+  Serial.println("+----------------+");
+  for (uint8_t row = 0; row < SIM_LCD1602_ROWS; row++)
+  {
+    std::string line = simLcd.getLine(row);
+    for (size_t i = 0; i < line.size(); i++)
+    {
+      // Custom characters (CGRAM 0-7) and the ROM glyphs above 0x7F (e.g. the 0xFF block) are not printable
+      if ((uint8_t) line[i] < 8 || (uint8_t) line[i] > 0x7F)
+      {
+        line[i] = '#';
+      }
+    }
+    Serial.printf("|%s|\n", line.c_str());
+  }
+  Serial.println("+----------------+");
+}
+
+static void simDrawLcd(float temperature, float humidity)
+{
+  // What the LCD task does on every refresh
+  lcd.clear();
+  lcd.print("T:");
+  lcd.print(temperature, 1);
+  lcd.print(" H:");
+  lcd.print(humidity, 1);
+  lcd.setCursor(0, 1);
+  lcd.print("P:");
+  lcd.print(bmp280.getPressure() / 100.0f, 1);
+  lcd.print("hPa");
+}
+
+static void simPrintLight(const char *label)
+{
+  // Read without blocking, whatever the filter
+  Serial.printf("[%6lu ms] Light %-6s latest %4d, average %4d, median %4d, EMA %4d, crossings %u/%u "
+                "(latest/median)\n",
+                millis(), label, lightSensor.getFiltered(LIGHT_FILTER_LATEST),
+                lightSensor.getFiltered(LIGHT_FILTER_AVERAGE), lightSensor.getFiltered(LIGHT_FILTER_MEDIAN),
+                lightSensor.getFiltered(LIGHT_FILTER_EMA), latestCrossings, medianCrossings);
+}
+
+static void simPressButton(uint32_t atMs, uint32_t durationMs)
+{
+  halSimSchedule(atMs, []() { halGpioSetInput(SIM_BUTTON_PIN, LOW); });
+  halSimSchedule(atMs + durationMs, []() { halGpioSetInput(SIM_BUTTON_PIN, HIGH); });
+}
+
+static void simBounceButton(uint32_t atMs)
+{
+  // Contact bounce ahead of a press: a few ms of chatter
+  halSimSchedule(atMs, []() { halGpioSetInput(SIM_BUTTON_PIN, LOW); });
+  halSimSchedule(atMs + 1, []() { halGpioSetInput(SIM_BUTTON_PIN, HIGH); });
+  halSimSchedule(atMs + 3, []() { halGpioSetInput(SIM_BUTTON_PIN, LOW); });
+  halSimSchedule(atMs + 4, []() { halGpioSetInput(SIM_BUTTON_PIN, HIGH); });
+}
+
+static void simRunButton(uint32_t durationMs)
+{
+  // Same polling period as the button task
+  halGpioSetInput(SIM_BUTTON_PIN, HIGH);
+  for (uint32_t elapsed = 0; elapsed < durationMs; elapsed += SIM_BUTTON_PERIOD_MS)
+  {
+    button.update();
+    delay(SIM_BUTTON_PERIOD_MS);
+  }
+}
+
+static void simRunButtonInterrupt(uint32_t durationMs)
+{
+  // Same loop as the button task
+  uint32_t end     = millis() + durationMs;
+  uint32_t wakeups = 0;
+  button.beginInterrupt(xTaskGetCurrentTaskHandle());
+  while ((int32_t) (end - millis()) > 0)
+  {
+    button.update();
+    wakeups++;
+    uint32_t timeoutMs = button.nextTimeout();
+    uint32_t leftMs    = end - millis();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((timeoutMs < leftMs) ? timeoutMs + 1 : leftMs));
+  }
+  button.endInterrupt();
+  Serial.printf("[%6lu ms] Button interrupt: single %u, double %u, hold %u, %u update() calls, %u dropped\n",
+                millis(), singleClicks, doubleClicks, holds, wakeups, button.getDroppedEdges());
+}
+
+static void simPrintFan(const char *label, uint32_t afterMs)
+{
+  delay(afterMs);
+  Serial.printf("[%6lu ms] Fan %-8s target %3d %%, duty %3u, %s\n", millis(), label,
+                miniFan.getFanSpeedPercentage(), halAnalogGetOutput(SIM_MINI_FAN_PIN),
+                miniFan.isRamping() ? "ramping" : "steady");
+}
+
+static void simPrintServo(const char *label, uint32_t afterMs)
+{
+  delay(afterMs);
+  Serial.printf("[%6lu ms] Servo %-6s pulse %4u us, angle %3d, %s\n", millis(), label, servoPulseUs,
+                doorMotion.getAngle(), doorMotion.isMoving() ? "moving" : "stopped");
+}
+
+static rpc_router_error_t simRpcSetState(const JsonVariantConst &params, JsonDocument &response)
+{
+  if (!params.is<bool>() && !params.is<int>())
+  {
+    return RPC_ROUTER_ERR_INVALID_PARAMS;
+  }
+  delay(2); // Posting to the actuator queue
+  response["newState"] = params.as<bool>();
+  return RPC_ROUTER_OK;
+}
+
+static rpc_router_error_t simRpcFail(const JsonVariantConst &params, JsonDocument &response)
+{
+  return RPC_ROUTER_ERR;
+}
+
+static void simCallRpc(RpcRouter &router, const char *method, const char *params)
+{
+  StaticJsonDocument<64> request;
+  StaticJsonDocument<64> response;
+  deserializeJson(request, params);
+  rpc_router_error_t error = router.dispatch(method, request.as<JsonVariantConst>(), response);
+  Serial.printf("[%6lu ms] RPC %-12s %-6s -> %s (%s)\n", millis(), method, params,
+                response.as<std::string>().c_str(), rpcRouterErrorName(error));
+}
+
+static bool simSetAttrInt(const attr_value_t &value, void *context)
+{
+  Serial.printf("[%6lu ms] Attribute int %d\n", millis(), (int) value.i);
+  return true;
+}
+
+static bool simSetAttrFloat(const attr_value_t &value, void *context)
+{
+  Serial.printf("[%6lu ms] Attribute float %.2f\n", millis(), value.f);
+  return true;
+}
+
+static bool simSetAttrString(const attr_value_t &value, void *context)
+{
+  Serial.printf("[%6lu ms] Attribute string %s\n", millis(), value.s);
+  return true;
+}
+
+static void simRunLed(uint32_t durationMs, const char *label)
+{
+  // Same loop as ledTask(), a solid color is not rendered again until a new effect
+  uint32_t shows  = ledEffects.getShowCount();
+  uint32_t frames = 0;
+  for (uint32_t end = millis() + durationMs; (int32_t) (end - millis()) > 0; delay(SIM_LED_FRAME_MS))
+  {
+    if (ledEffects.isAnimating() || frames == 0)
+    {
+      ledEffects.render(millis());
+      frames++;
+    }
+  }
+  Serial.printf("[%6lu ms] LED %-8s rgb %3u %3u %3u, %u frames, %u shown\n", millis(), label, ledShown[0].r,
+                ledShown[0].g, ledShown[0].b, frames, ledEffects.getShowCount() - shows);
+}
+
+/* End of file -------------------------------------------------------- */
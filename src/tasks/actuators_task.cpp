@@ -15,6 +15,8 @@
 #include "actuators_task.h"
 #include "globals.h"
 
+#include "freertos/queue.h"
+
 /* Private enumerate/structure ---------------------------------------- */
 
 /* Private macros ----------------------------------------------------- */
@@ -22,6 +24,7 @@
 /* Public variables --------------------------------------------------- */
 
 /* Private variables -------------------------------------------------- */
+static QueueHandle_t actuatorQueue = NULL;
 
 /* Task definitions-------------------------------------------- */
 #ifdef SERVO_MODULE
@@ -34,8 +37,85 @@ void doorSetup()
   ESP32PWM::allocateTimer(3);
   doorServo.setPeriodHertz(50);           // standard 50 hz servo
   doorServo.attach(SERVO_PIN, 500, 1500); // attaches the servo
+
+  // The planner drives the pulse width itself, the door eases in and out instead of slamming
+  doorMotion.setProfile(SERVO_PROFILE_S_CURVE);
+  doorMotion.attachDoneCallback([](int angle, void *) {
+    // esp_timer task: hand the arrival over to the dispatcher, which publishes the door state
+    actuatorPost(ACTUATOR_CMD_DOOR_DONE, angle == DOOR_OPEN_ANGLE, false);
+  });
+  doorMotion.begin([](uint16_t pulseUs, void *) { doorServo.writeMicroseconds(pulseUs); }, nullptr, 500, 1500,
+                   DOOR_CLOSED_ANGLE);
 }
 #endif // SERVO_MODULE
-       /* Private function prototypes ---------------------------------------- */
+
+#ifdef MINI_FAN_MODULE
+void fanSetup()
+{
+  // Without the engine the fan still works, speed changes just apply at once
+  if (miniFan.beginRamp() == MINI_FAN_OK)
+  {
+    miniFan.setRampProfile(FAN_SLEW_PERCENT_PER_SEC, FAN_ACCEL_PERCENT_PER_SEC2);
+    miniFan.setKickStart(FAN_KICK_PERCENT, FAN_KICK_MS);
+  }
+}
+#endif // MINI_FAN_MODULE
+
+void actuatorQueueSetup()
+{
+  if (actuatorQueue == NULL)
+  {
+    actuatorQueue = xQueueCreate(ACTUATOR_QUEUE_LENGTH, sizeof(actuator_cmd_t));
+  }
+}
+
+bool actuatorPost(actuator_cmd_type_t type, int32_t value, bool report)
+{
+  if (actuatorQueue == NULL || type >= ACTUATOR_CMD_COUNT)
+  {
+    return false;
+  }
+
+  actuator_cmd_t cmd = {type, value, report};
+  if (xQueueSend(actuatorQueue, &cmd, 0) != pdTRUE)
+  {
+#ifdef DEBUG_PRINT
+    Serial.println("Actuator queue full, command dropped");
+#endif // DEBUG_PRINT
+    return false;
+  }
+  return true;
+}
+
+uint8_t actuatorReceive(actuator_cmd_t pending[ACTUATOR_CMD_COUNT], bool valid[ACTUATOR_CMD_COUNT],
+                        TickType_t timeout)
+{
+  actuator_cmd_t cmd;
+  uint8_t        received = 0;
+
+  for (uint8_t i = 0; i < ACTUATOR_CMD_COUNT; i++)
+  {
+    valid[i] = false;
+  }
+
+  if (actuatorQueue == NULL || xQueueReceive(actuatorQueue, &cmd, timeout) != pdTRUE)
+  {
+    return 0;
+  }
+
+  do
+  {
+    // Last command wins, but a report request survives being superseded
+    bool report              = cmd.report || (valid[cmd.type] && pending[cmd.type].report);
+    pending[cmd.type]        = cmd;
+    pending[cmd.type].report = report;
+    valid[cmd.type]          = true;
+    received++;
+  } while (xQueueReceive(actuatorQueue, &cmd, 0) == pdTRUE);
+
+  return received;
+}
+
+/* Private function prototypes ---------------------------------------- */
 
 /* End of file -------------------------------------------------------- */
\ No newline at end of file
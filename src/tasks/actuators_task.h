@@ -22,15 +22,89 @@
   /* Public defines ----------------------------------------------------- */
   #define ACTUATORS_TASK_LIB_VERSION (F("0.1.0"))
 
+  #define ACTUATOR_QUEUE_LENGTH      16
+
+  #define FAN_SLEW_PERCENT_PER_SEC   50  // Full speed reached in about 2 s
+  #define FAN_ACCEL_PERCENT_PER_SEC2 100 // Slew builds up in 0.5 s, no audible step
+  #define FAN_KICK_PERCENT           100 // Pulse that breaks a stopped fan away
+  #define FAN_KICK_MS                150
+  #define FAN_AUTO_RELEASED          (-1) // The local controller hands the fan back to the cloud
+
+  #define DOOR_MOTION_MS             1200 // Full swing, the planner eases in and out over it
+  #define DOOR_OPEN_ANGLE            180
+  #define DOOR_CLOSED_ANGLE          0
+
 /* Public enumerate/structure ----------------------------------------- */
+/**
+ * @brief Actuator addressed by a command. Commands of the same type coalesce, the last one wins.
+ */
+typedef enum
+{
+  ACTUATOR_CMD_LED = 0,   /* value: 0 = OFF, 1 = ON */
+  ACTUATOR_CMD_DOOR,      /* value: 0 = closed, 1 = open */
+  ACTUATOR_CMD_FAN,       /* value: speed in percent (0-100) from the cloud, held while under local control */
+  ACTUATOR_CMD_FAN_AUTO,  /* value: speed in percent from the local controller, or `FAN_AUTO_RELEASED` */
+  ACTUATOR_CMD_DOOR_DONE, /* value: state the door reached, posted by the motion planner */
+  ACTUATOR_CMD_COUNT
+} actuator_cmd_type_t;
+
+typedef struct
+{
+  actuator_cmd_type_t type;   /**< Target actuator */
+  int32_t             value;  /**< New state, meaning depends on `type` */
+  bool                report; /**< Publish the resulting state back to the server once applied */
+} actuator_cmd_t;
 
 /* Public macros ------------------------------------------------------ */
 
 /* Public variables --------------------------------------------------- */
 
 /* Task Declaration -------------------------------------------------- */
+/**
+ * @brief Attaches the door servo and starts its motion planner, closed. Each finished motion posts
+ * `ACTUATOR_CMD_DOOR_DONE`.
+ */
 void doorSetup();
 
+/**
+ * @brief Starts the fan ramp engine, speed changes then slew instead of stepping.
+ */
+void fanSetup();
+
+/**
+ * @brief Creates the actuator command queue. Must be called before any `actuatorPost()`.
+ */
+void actuatorQueueSetup();
+
+/**
+ * @brief Posts a command to the actuator dispatcher without blocking.
+ *
+ * Safe to call from RPC and attribute callbacks. The dispatcher task applies it and coalesces it with any
+ * pending command for the same actuator.
+ *
+ * @param[in] type   Target actuator.
+ * @param[in] value  New state.
+ * @param[in] report `true` to publish the applied state back to the server.
+ *
+ * @return bool `true` if queued, `false` if the queue is missing or full.
+ */
+bool actuatorPost(actuator_cmd_type_t type, int32_t value, bool report = true);
+
+/**
+ * @brief Waits for the next batch of commands and coalesces it.
+ *
+ * Blocks until a command arrives, then drains the queue without blocking. For each actuator only the
+ * last pending command is kept.
+ *
+ * @param[out] pending  One slot per `actuator_cmd_type_t`.
+ * @param[out] valid    `valid[type]` is set when `pending[type]` holds a command.
+ * @param[in]  timeout  Maximum ticks to wait for the first command.
+ *
+ * @return uint8_t Number of commands received, `0` on timeout.
+ */
+uint8_t actuatorReceive(actuator_cmd_t pending[ACTUATOR_CMD_COUNT], bool valid[ACTUATOR_CMD_COUNT],
+                        TickType_t timeout = portMAX_DELAY);
+
 #endif // ACTUATORS_TASK_H
 
 /* End of file -------------------------------------------------------- */
\ No newline at end of file
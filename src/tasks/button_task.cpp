@@ -27,11 +27,21 @@
 /* Task definitions ------------------------------------------- */
 void buttonTask(void *pvParameters)
 {
+  // Edges wake the task, otherwise it sleeps until the next debounce, double-click or hold deadline
+  if (button.beginInterrupt(xTaskGetCurrentTaskHandle()) != BUTTON_OK)
+  {
+    for (;;)
+    {
+      button.update();
+      vTaskDelay(pdMS_TO_TICKS(DELAY_BUTTON));
+    }
+  }
+
   for (;;)
   {
-    // Serial.print(bspGpioDigitalRead(BUTTON_PIN));
     button.update();
-    vTaskDelay(pdMS_TO_TICKS(DELAY_BUTTON));
+    uint32_t timeoutMs = button.nextTimeout();
+    ulTaskNotifyTake(pdTRUE, (timeoutMs == BUTTON_NO_TIMEOUT) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs) + 1);
   }
 }
 
@@ -47,14 +57,31 @@ void buttonSetup()
   #ifdef DEBUG_BUTTON_CALLBACK
     Serial.println("Single Click");
   #endif // DEBUG_BUTTON_CALLBACK
-    lcd.updateScreenState(true);
+  #ifdef LCD_MODULE
+    lcdPages.next();
+    lcdRefresh();
+  #endif // LCD_MODULE
   });
 
   button.attachDoubleClickCallback([]() {
   #ifdef DEBUG_BUTTON_CALLBACK
     Serial.println("Double Click");
   #endif // DEBUG_BUTTON_CALLBACK
-    lcd.updateScreenState(false);
+  #ifdef LCD_MODULE
+    lcdPages.previous();
+    lcdRefresh();
+  #endif // LCD_MODULE
+  });
+
+  button.attachHoldStartCallback([]() {
+  #ifdef DEBUG_BUTTON_CALLBACK
+    Serial.println("Hold");
+  #endif // DEBUG_BUTTON_CALLBACK
+  #ifdef LCD_MODULE
+    // Pages with more lines than the display scroll by one line
+    lcdPages.scroll(1);
+    lcdRefresh();
+  #endif // LCD_MODULE
   });
 
   xTaskCreate(buttonTask, "Button Task", 8192, NULL, 1, NULL);
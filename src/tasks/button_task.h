@@ -21,7 +21,7 @@
   #endif
 
   /* Public defines ----------------------------------------------------- */
-  #define DELAY_BUTTON 10
+  #define DELAY_BUTTON 10 // Polling period when the button pin has no interrupt
 /* Public enumerate/structure ----------------------------------------- */
 
 /* Public macros ------------------------------------------------------ */
@@ -0,0 +1,153 @@
+/**
+ * @file       fan_control_task.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-16
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for Fan Control Task
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "fan_control_task.h"
+#include "globals.h"
+
+#ifdef FAN_CONTROL_MODULE
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+// Written by the attribute callbacks, read by the control task
+static portMUX_TYPE         fanControlLock    = portMUX_INITIALIZER_UNLOCKED;
+static fan_control_config_t fanControlConfig  = FAN_CONTROL_CONFIG_DEFAULT;
+static bool                 fanControlChanged = false;
+static bool                 fanControlAuto    = FAN_CONTROL_AUTO_DEFAULT;
+
+/* Task definitions ------------------------------------------- */
+void fanControlTask(void *pvParameters)
+{
+  FanController controller;
+  TickType_t    lastWakeTime = xTaskGetTickCount();
+  uint32_t      lastCount    = 0;
+  uint32_t      lastSampleAt = millis();
+  int           lastSpeed    = -1;
+
+  controller.configure(fanControlGetConfig());
+
+  for (;;)
+  {
+    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(DELAY_FAN_CONTROL));
+
+    portENTER_CRITICAL(&fanControlLock);
+    fan_control_config_t config  = fanControlConfig;
+    bool                 changed = fanControlChanged;
+    bool                 enabled = fanControlAuto;
+    fanControlChanged            = false;
+    portEXIT_CRITICAL(&fanControlLock);
+
+    if (changed)
+    {
+      controller.configure(config);
+    }
+    if (!enabled)
+    {
+      // Manual mode, the dispatcher put the speed from the cloud back on the fan when control went off
+      controller.reset();
+      lastSpeed = -1;
+      continue;
+    }
+
+    // Runs on the sensor cadence, whatever the state of the MQTT link
+    // A read that overlapped a publish skips the source, the age counts from the last sample seen
+    sensor_snapshot_t snapshot;
+    sensorSnapshot.read(snapshot);
+    bool fresh = SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_SHT4X) &&
+                 snapshot.sampleCount[SNAPSHOT_SOURCE_SHT4X] != lastCount;
+    if (fresh)
+    {
+      lastSampleAt = snapshot.updatedAt[SNAPSHOT_SOURCE_SHT4X];
+    }
+
+    int speed;
+    if (millis() - lastSampleAt > FAN_CONTROL_STALE_MS)
+    {
+      // Blind, cool at full speed and restart the loop cleanly once samples come back
+      controller.reset();
+      speed = FAN_CONTROL_FAILSAFE_PERCENT;
+    }
+    else if (fresh)
+    {
+      lastCount = snapshot.sampleCount[SNAPSHOT_SOURCE_SHT4X];
+      speed     = (int) lroundf(
+          controller.update(snapshot.temperature, snapshot.updatedAt[SNAPSHOT_SOURCE_SHT4X]));
+    }
+    else
+    {
+      continue;
+    }
+
+    // The actuator dispatcher owns the fan, a speed it could not queue is posted again on the next sample
+    if (speed != lastSpeed && actuatorPost(ACTUATOR_CMD_FAN_AUTO, speed, false))
+    {
+      lastSpeed = speed;
+  #ifdef DEBUG_PRINT
+      Serial.printf("Fan control: %.2f °C -> %d %%\n", snapshot.temperature, speed);
+  #endif // DEBUG_PRINT
+    }
+  }
+}
+
+void fanControlSetup() { xTaskCreate(fanControlTask, "Fan Control Task", 3072, NULL, 1, NULL); }
+
+bool fanControlSetConfig(const fan_control_config_t &config)
+{
+  if (!FanController::validate(config))
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&fanControlLock);
+  fanControlConfig  = config;
+  fanControlChanged = true;
+  portEXIT_CRITICAL(&fanControlLock);
+  return true;
+}
+
+fan_control_config_t fanControlGetConfig()
+{
+  portENTER_CRITICAL(&fanControlLock);
+  fan_control_config_t config = fanControlConfig;
+  portEXIT_CRITICAL(&fanControlLock);
+  return config;
+}
+
+void fanControlSetAuto(bool enabled)
+{
+  portENTER_CRITICAL(&fanControlLock);
+  bool released  = fanControlAuto && !enabled;
+  fanControlAuto = enabled;
+  portEXIT_CRITICAL(&fanControlLock);
+
+  // Wakes the dispatcher, which puts the speed from the cloud back on the fan
+  if (released)
+  {
+    actuatorPost(ACTUATOR_CMD_FAN_AUTO, FAN_AUTO_RELEASED, false);
+  }
+}
+
+bool fanControlIsAuto()
+{
+  portENTER_CRITICAL(&fanControlLock);
+  bool enabled = fanControlAuto;
+  portEXIT_CRITICAL(&fanControlLock);
+  return enabled;
+}
+#endif // FAN_CONTROL_MODULE
+
+/* End of file -------------------------------------------------------- */
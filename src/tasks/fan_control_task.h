@@ -0,0 +1,60 @@
+/**
+ * @file       fan_control_task.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-16
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for Fan Control Task
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef FAN_CONTROL_TASK_H
+  #define FAN_CONTROL_TASK_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  #include "fan_control.h"
+
+  /* Public defines ----------------------------------------------------- */
+  #define DELAY_FAN_CONTROL            1000              // Snapshot polling, control runs once per sample
+  #define FAN_CONTROL_STALE_MS         (3 * DELAY_SHT4X) // Older temperature, the fan goes to failsafe
+  #define FAN_CONTROL_FAILSAFE_PERCENT 100
+  #define FAN_CONTROL_AUTO_DEFAULT     false             // Cloud speed until local control is turned on
+
+/* Public enumerate/structure ----------------------------------------- */
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Funtions Declaration -------------------------------------------------- */
+void fanControlTask(void *pvParameters);
+void fanControlSetup();
+
+/**
+ * @brief Replaces the controller settings, applied on the next control cycle. Safe from any task.
+ *
+ * @return bool `false` if `FanController::validate()` rejects them.
+ */
+bool fanControlSetConfig(const fan_control_config_t &config);
+
+fan_control_config_t fanControlGetConfig();
+
+/**
+ * @brief Switches between local closed-loop control and manual speed from the cloud. Safe from any task.
+ *
+ * The controller posts its speeds to the actuator dispatcher, which owns the fan. Switching control off posts
+ * `FAN_AUTO_RELEASED`: the dispatcher then applies the last speed from the cloud again.
+ */
+void fanControlSetAuto(bool enabled);
+bool fanControlIsAuto();
+#endif // FAN_CONTROL_TASK_H
+
+/* End of file -------------------------------------------------------- */
@@ -12,7 +12,12 @@
 /* Includes ----------------------------------------------------------- */
 #include "iot_server_task.h"
 #include "bsp_gpio.h"
+#include "attribute_registry.h"
 #include "globals.h"
+#include "rpc_router.h"
+#include "telemetry_batch.h"
+#include "telemetry_filter.h"
+#include "telemetry_ring.h"
 
 #include <Arduino_MQTT_Client.h>
 #include <WiFi.h>
@@ -28,6 +33,25 @@
 /* Private defines ---------------------------------------------------- */
 
 /* Private enumerate/structure ---------------------------------------- */
+// Telemetry keys, each filtered by its own policy
+typedef enum
+{
+  TELEMETRY_KEY_TEMPERATURE = 0, // SHT4X
+  TELEMETRY_KEY_HUMIDITY,        // SHT4X
+  TELEMETRY_KEY_PRESSURE,        // BMP280
+  TELEMETRY_KEY_ALTITUDE,        // BMP280
+  TELEMETRY_KEY_ILLUMINANCE,     // Light sensor
+  TELEMETRY_KEY_COUNT
+} telemetry_key_t;
+
+// The keys of one capture that passed their policy, as buffered until they can be uploaded
+typedef struct
+{
+  uint32_t capturedAt;                  // millis() at capture
+  uint64_t epochMs;                     // Epoch time at capture, 0 if the clock was not synchronized yet
+  float    values[TELEMETRY_KEY_COUNT]; // Indexed by telemetry_key_t
+  uint8_t  keyMask;                     // Bit n set when key n is sent
+} telemetry_sample_t;
 
 /* Private macros ----------------------------------------------------- */
 
@@ -53,8 +77,8 @@ constexpr uint16_t COREIOT_PORT     = 1883U;
 // Maximum size packets will ever be sent or received by the underlying MQTT client,
 // if the size is to small messages might not be sent or received messages will be discarded
 constexpr uint16_t MAX_MESSAGE_SEND_SIZE    = 512U;
-constexpr uint16_t MAX_MESSAGE_RECEIVE_SIZE = 512U;
-constexpr size_t   MAX_ATTRIBUTES           = 10U;
+constexpr uint16_t MAX_MESSAGE_RECEIVE_SIZE = 1024U; // Room for the telemetry policies of a request
+constexpr size_t   MAX_ATTRIBUTES           = 16U;
 
 constexpr const char RPC_SWITCH_METHOD[]                = "setSwitchState";
 constexpr char       RPC_REQUEST_CALLBACK_METHOD_NAME[] = "getCurrentTime";
@@ -64,6 +88,18 @@ constexpr uint64_t   REQUEST_TIMEOUT_MICROSECONDS       = 15000U * 1000U;
 
 constexpr int16_t telemetrySendInterval = 30000U;
 
+// Snapshot check between cycles, a key past its excursion threshold is sent without waiting for the cycle
+constexpr uint16_t TELEMETRY_POLL_MS = 1000U;
+
+// Minimum RSSI change before the attribute is published again
+constexpr int8_t RSSI_DEADBAND_DB = 3;
+
+// Store-and-forward buffer: two hours of samples at the telemetry interval
+constexpr size_t   TELEMETRY_RING_CAPACITY      = 240U;
+constexpr size_t   TELEMETRY_DRAIN_BATCH        = 3U;  // Samples per message, keeps it below MAX_MESSAGE_SEND_SIZE
+constexpr uint8_t  TELEMETRY_DRAIN_MAX_MESSAGES = 10U; // Messages per cycle while catching up
+constexpr uint16_t TELEMETRY_DRAIN_GAP_MS       = 200U;
+
 // DHT20 / SHT40
 constexpr char TEMPERATURE_KEY[] = "temperature";
 constexpr char HUMIDITY_KEY[]    = "humidity";
@@ -75,22 +111,46 @@ constexpr char ILLUMINANCE_KEY[] = "illuminance";
 constexpr char PRESSURE_KEY[] = "pressure";
 constexpr char ALTITUDE_KEY[] = "altitude";
 
+// Indexed by telemetry_key_t
+constexpr const char *TELEMETRY_KEYS[TELEMETRY_KEY_COUNT] = {TEMPERATURE_KEY, HUMIDITY_KEY, PRESSURE_KEY,
+                                                            ALTITUDE_KEY, ILLUMINANCE_KEY};
+
+// Default policies: {deadband, excursion, max silence}. A stable room sends each key every 5 minutes
+constexpr telemetry_policy_t TELEMETRY_POLICIES[TELEMETRY_KEY_COUNT] = {
+    {0.2f, 1.0f, 300000UL},    // Temperature, °C
+    {1.0f, 5.0f, 300000UL},    // Humidity, %
+    {50.0f, 300.0f, 300000UL}, // Pressure, Pa
+    {4.0f, 25.0f, 300000UL},   // Altitude, m, derived from the pressure: 50 Pa is about 4 m
+    {5.0f, 20.0f, 300000UL},   // Illuminance, %
+};
+
 // Attribute names
 constexpr char LED_STATE_ATTR[]  = "ledState";
 constexpr char FAN_SPEED_ATTR[]  = "fanSpeed";
 constexpr char DOOR_STATE_ATTR[] = "doorState";
 constexpr char FW_TITLE_ATTR[]   = "fw_title";
 constexpr char FW_VERSION_ATTR[] = "fw_version";
-
-// Flag to handle devices state and values
-volatile bool ledStateChanged  = false;
-volatile bool fanSpeedChanged  = false;
-volatile bool doorStateChanged = false;
-
-// Current devices states/values
-volatile bool ledState  = false;
-volatile int  fanSpeed  = 0;
-volatile bool doorState = false;
+constexpr char RSSI_ATTR[]       = "rssi";
+constexpr char RPC_STATS_ATTR[]  = "rpcStats";
+
+// Fan control attributes, shared: the setpoint in °C, the PID gains and the mode
+constexpr char FAN_AUTO_ATTR[]     = "fanAuto";
+constexpr char FAN_SETPOINT_ATTR[] = "fanSetpoint";
+constexpr char FAN_KP_ATTR[]       = "fanKp";
+constexpr char FAN_KI_ATTR[]       = "fanKi";
+constexpr char FAN_KD_ATTR[]       = "fanKd";
+
+// Telemetry policies, shared: {"deadband", "excursion", "maxSilence"} per key, members left out are kept
+constexpr char TEMPERATURE_POLICY_ATTR[] = "temperaturePolicy";
+constexpr char HUMIDITY_POLICY_ATTR[]    = "humidityPolicy";
+constexpr char PRESSURE_POLICY_ATTR[]    = "pressurePolicy";
+constexpr char ALTITUDE_POLICY_ATTR[]    = "altitudePolicy";
+constexpr char ILLUMINANCE_POLICY_ATTR[] = "illuminancePolicy";
+
+// Current devices states/values, only written by updateDevicesStateTask
+bool ledState  = false;
+int  fanSpeed  = 0;
+bool doorState = false;
 
 // Statuses for updating
 bool currentFWSent = false;
@@ -104,8 +164,12 @@ Shared_Attribute_Update<3U, MAX_ATTRIBUTES>             shared_update;
 const std::array<IAPI_Implementation *, 4U> apis = {&ota, &rpc, &attr_request, &shared_update};
 
 // List of shared attributes for subscribing to their updates
-constexpr std::array<const char *, 8U> SHARED_ATTRIBUTES_LIST = {FAN_SPEED_ATTR, FW_TITLE_ATTR,
-                                                                 FW_VERSION_ATTR};
+constexpr std::array<const char *, 13U> SHARED_ATTRIBUTES_LIST = {
+    FAN_SPEED_ATTR,          FW_TITLE_ATTR,        FW_VERSION_ATTR,      FAN_AUTO_ATTR,
+    FAN_SETPOINT_ATTR,       FAN_KP_ATTR,          FAN_KI_ATTR,          FAN_KD_ATTR,
+    TEMPERATURE_POLICY_ATTR, HUMIDITY_POLICY_ATTR, PRESSURE_POLICY_ATTR, ALTITUDE_POLICY_ATTR,
+    ILLUMINANCE_POLICY_ATTR};
+static_assert(SHARED_ATTRIBUTES_LIST.size() <= MAX_ATTRIBUTES, "Raise MAX_ATTRIBUTES");
 
 // List of client attributes for requesting them (Using to initialize device states)
 constexpr std::array<const char *, 2U> CLIENT_ATTRIBUTES_LIST = {LED_STATE_ATTR, DOOR_STATE_ATTR};
@@ -117,6 +181,11 @@ Espressif_Updater<> updater;
 
 bool subscribed = false;
 
+TelemetryRing<telemetry_sample_t, TELEMETRY_RING_CAPACITY> telemetryRing;
+
+// Deadband and silence policies per key, changed from the shared attributes
+TelemetryFilter telemetryFilter(TELEMETRY_POLICIES, TELEMETRY_KEY_COUNT);
+
 /* Private function definitions ------------------------------------------- */
 #ifdef OTA_UPDATE_MODULE
 void update_starting_callback()
@@ -161,167 +230,280 @@ void progress_callback(const size_t &current, const size_t &total)
 }
 #endif // OTA_UPDATE_MODULE
 
-void processSetLedState(const JsonVariantConst &data, JsonDocument &response)
+#ifdef LED_RGB_MODULE
+/// @brief Fades the NeoPixel strip to the given LED state, the LED task renders it
+/// @param state true = ON, false = OFF
+void applyLedState(bool state)
+{
+  // The effects work in linear light, the on color is converted once so the strip shows it as before
+  static const led_color_t onColor = LedEffects::fromDisplay(LED_ON_COLOR);
+  ledEffects.fadeTo(state ? onColor : LED_COLOR_OFF, LED_FADE_MS);
+  ledRefresh();
+}
+#endif // LED_RGB_MODULE
+
+/// @brief RPC setLedValue: params is the new state, answered with {"newState": <state>}
+rpc_router_error_t processSetLedState(const JsonVariantConst &params, JsonDocument &response)
 {
-  ledState = data;
+  if (!params.is<bool>() && !params.is<int>())
+  {
+    return RPC_ROUTER_ERR_INVALID_PARAMS;
+  }
+  bool newState = params.as<bool>();
 
 #ifdef DEBUG_PRINT
   Serial.print("Received set led state RPC. New state: ");
-  Serial.println(ledState);
+  Serial.println(newState);
 #endif // DEBUG_PRINT
 
-  StaticJsonDocument<1> response_doc;
-  // Returning current state as response
-  response_doc["newState"] = (bool) ledState;
-  response.set(response_doc);
-
-  ledStateChanged = true;
+  // Returning requested state as response, written straight into the reply
+  response["newState"] = newState;
+  return actuatorPost(ACTUATOR_CMD_LED, newState) ? RPC_ROUTER_OK : RPC_ROUTER_ERR;
 }
 
-void processSetDoorState(const JsonVariantConst &data, JsonDocument &response)
+/// @brief RPC setDoorState: params is the new state, answered with {"newState": <state>}
+rpc_router_error_t processSetDoorState(const JsonVariantConst &params, JsonDocument &response)
 {
-  doorState = data;
+  if (!params.is<bool>() && !params.is<int>())
+  {
+    return RPC_ROUTER_ERR_INVALID_PARAMS;
+  }
+  bool newState = params.as<bool>();
 
 #ifdef DEBUG_PRINT
   Serial.print("Received set door state RPC. New state: ");
-  Serial.println(doorState);
+  Serial.println(newState);
 #endif // DEBUG_PRINT
 
-  StaticJsonDocument<1> response_doc;
-  // Returning current state as response
-  response_doc["newState"] = (bool) doorState;
-  response.set(response_doc);
-
-  doorStateChanged = true;
+  // Returning requested state as response, written straight into the reply
+  response["newState"] = newState;
+  return actuatorPost(ACTUATOR_CMD_DOOR, newState) ? RPC_ROUTER_OK : RPC_ROUTER_ERR;
 }
 
-const std::array<RPC_Callback, 4U> rpcCallbacks = {RPC_Callback{"setLedValue", processSetLedState},
-                                                   RPC_Callback{"setDoorState", processSetDoorState}};
+// RPC methods, hashed by the compiler. A new method only needs a line here
+constexpr rpc_method_t RPC_METHODS[] = {
+    RPC_METHOD("setLedValue", processSetLedState),
+    RPC_METHOD("setDoorState", processSetDoorState),
+};
+constexpr size_t RPC_METHODS_COUNT = RPC_METHOD_COUNT(RPC_METHODS);
+static_assert(rpcHashesUnique(RPC_METHODS, RPC_METHODS_COUNT), "Two RPC method names share a hash");
+static_assert(RPC_METHODS_COUNT <= MAX_RPC_SUBSCRIPTIONS, "Raise MAX_RPC_SUBSCRIPTIONS");
 
-/// @brief Shared attribute update callback
-/// @param data New value of shared attributes which is changed
-void processSharedAttributes(const JsonObjectConst &data)
+RpcRouter rpcRouter(RPC_METHODS, RPC_METHODS_COUNT);
+
+// One subscription per method, each forwarding to the router by index
+std::array<RPC_Callback, RPC_METHODS_COUNT> rpcCallbacks;
+
+// RPC statistics attribute, {"<method>": {"calls", "errors", "avgUs", "maxUs"}}
+constexpr size_t RPC_STATS_CAPACITY = JSON_OBJECT_SIZE(1) + RPC_ROUTER_STATS_CAPACITY(RPC_METHODS_COUNT);
+
+// State gathered over one shared attribute update, acted on once every key was applied
+typedef struct
 {
-  for (auto it = data.begin(); it != data.end(); ++it)
-  {
-    const char *key = it->key().c_str();
-    // OTA UPDATE
-    if (strcmp(key, "fw_title") == 0 || strcmp(key, "fw_version") == 0)
-    {
-      String fwTitle   = data["fw_title"] | "";
-      String fwVersion = data["fw_version"] | "";
+  const char *fwTitle;   // Points into the update document, valid during processSharedAttributes()
+  const char *fwVersion;
+#ifdef FAN_CONTROL_MODULE
+  fan_control_config_t fanConfig; // Gains may arrive together, they are applied as one configuration
+  bool                 fanChanged;
+#endif // FAN_CONTROL_MODULE
+} shared_update_t;
+
+static bool setFwTitle(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fwTitle = value.s;
+  return true;
+}
 
-      if (fwTitle == CURRENT_FIRMWARE_TITLE && compareVersion(CURRENT_FIRMWARE_VERSION, fwVersion) < 0)
-      {
+static bool setFwVersion(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fwVersion = value.s;
+  return true;
+}
+
+static bool setFanSpeed(const attr_value_t &value, void *context)
+{
 #ifdef DEBUG_PRINT
-        Serial.println("New firmware available! Initiating OTA update...");
+  Serial.printf("Fan speed is set to: %d\n", (int) value.i);
 #endif // DEBUG_PRINT
 
-        const OTA_Update_Callback callback(CURRENT_FIRMWARE_TITLE, CURRENT_FIRMWARE_VERSION, &updater,
-                                           &finished_callback, &progress_callback, &update_starting_callback,
-                                           FIRMWARE_FAILURE_RETRIES, FIRMWARE_PACKET_SIZE);
-        ota.Start_Firmware_Update(callback);
-      }
-    }
-    // FAN SPEED
-    else if (strcmp(key, FAN_SPEED_ATTR) == 0)
-    {
-      const uint8_t newFanSpeed = it->value().as<uint8_t>();
-      if (newFanSpeed <= 100)
-      {
-        fanSpeed = newFanSpeed;
-      }
-      else
-      {
-        fanSpeed = 100;
-      }
+  // Under local control the dispatcher holds it, and applies it once the controller hands the fan back
+  return actuatorPost(ACTUATOR_CMD_FAN, value.i, false);
+}
+
+static bool setDoorState(const attr_value_t &value, void *context)
+{
 #ifdef DEBUG_PRINT
-      Serial.printf("Fan speed is set to: %d\n", fanSpeed);
+  Serial.printf("Door state updated: %d \n", value.b);
 #endif // DEBUG_PRINT
 
-      fanSpeedChanged = true;
-    }
-    // DOOR STATE
-    else if (strcmp(key, DOOR_STATE_ATTR) == 0)
-    {
-      doorState        = it->value().as<bool>();
-      doorStateChanged = true;
+  return actuatorPost(ACTUATOR_CMD_DOOR, value.b);
+}
 
+#ifdef FAN_CONTROL_MODULE
+static bool setFanAuto(const attr_value_t &value, void *context)
+{
+  fanControlSetAuto(value.b);
+  return true;
+}
+
+static bool setFanSetpoint(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fanConfig.setpoint = value.f;
+  ((shared_update_t *) context)->fanChanged         = true;
+  return true;
+}
+
+static bool setFanKp(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fanConfig.kp = value.f;
+  ((shared_update_t *) context)->fanChanged   = true;
+  return true;
+}
+
+static bool setFanKi(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fanConfig.ki = value.f;
+  ((shared_update_t *) context)->fanChanged   = true;
+  return true;
+}
+
+static bool setFanKd(const attr_value_t &value, void *context)
+{
+  ((shared_update_t *) context)->fanConfig.kd = value.f;
+  ((shared_update_t *) context)->fanChanged   = true;
+  return true;
+}
+#endif // FAN_CONTROL_MODULE
+
+/// @brief Merges a policy object into the current policy of a key, applied only if the result is valid
+static bool setTelemetryPolicy(telemetry_key_t key, const attr_value_t &value)
+{
+  telemetry_policy_t policy;
+  telemetryFilter.getPolicy(key, policy);
+  if (telemetryPolicyFromJson(value.o->as<JsonObjectConst>(), policy) != TELEMETRY_OK)
+  {
 #ifdef DEBUG_PRINT
-      Serial.printf("Door state updated: %d \n", doorState);
+    Serial.printf("Telemetry policy of %s rejected\n", TELEMETRY_KEYS[key]);
 #endif // DEBUG_PRINT
-    }
+    return false;
   }
+  return telemetryFilter.setPolicy(key, policy) == TELEMETRY_OK;
 }
 
-void processClientAttributes(const JsonObjectConst &data)
+static bool setTemperaturePolicy(const attr_value_t &value, void *context)
 {
-  for (auto it = data.begin(); it != data.end(); ++it)
-  {
-    if (strcmp(it->key().c_str(), LED_STATE_ATTR) == 0)
-    {
-      ledState = it->value().as<bool>();
-      switch ((int) ledState)
-      {
-        case 0:
-          /*
-            // BUILT-IN LED
-            bspGpioDigitalWrite(LED_BUILTIN, HIGH); // OFF
-          */
-          // NEOPIXEL --- OFF
-          rgb.setPixelColor(0, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(1, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(2, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(3, rgb.Color(0, 0, 0));
-          rgb.show();
+  return setTelemetryPolicy(TELEMETRY_KEY_TEMPERATURE, value);
+}
 
-          break;
-        case 1:
-          /*
-            // BUILT-IN LED
-            bspGpioDigitalWrite(LED_BUILTIN, LOW); // ON
-          */
-          // NEOPIXEL --- ON
-          rgb.setPixelColor(0, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(1, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(2, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(3, rgb.Color(255, 102, 0));
-          rgb.show();
+static bool setHumidityPolicy(const attr_value_t &value, void *context)
+{
+  return setTelemetryPolicy(TELEMETRY_KEY_HUMIDITY, value);
+}
 
-          break;
-        default:
-          /*
-          // BUILT-IN LED
-          bspGpioDigitalWrite(LED_BUILTIN, HIGH); // Fail-safe
-          */
-          // NEOPIXEL --- OFF
-          rgb.setPixelColor(0, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(1, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(2, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(3, rgb.Color(0, 0, 0));
-          rgb.show();
+static bool setPressurePolicy(const attr_value_t &value, void *context)
+{
+  return setTelemetryPolicy(TELEMETRY_KEY_PRESSURE, value);
+}
 
-          break;
-      }
-    }
+static bool setAltitudePolicy(const attr_value_t &value, void *context)
+{
+  return setTelemetryPolicy(TELEMETRY_KEY_ALTITUDE, value);
+}
+
+static bool setIlluminancePolicy(const attr_value_t &value, void *context)
+{
+  return setTelemetryPolicy(TELEMETRY_KEY_ILLUMINANCE, value);
+}
+
+// Shared attributes, hashed by the compiler. Type and range are checked before the setter runs
+constexpr attr_handler_t SHARED_ATTRIBUTE_HANDLERS[] = {
+    ATTR_HANDLER(FW_TITLE_ATTR, ATTR_TYPE_STRING, 0, 32, setFwTitle),
+    ATTR_HANDLER(FW_VERSION_ATTR, ATTR_TYPE_STRING, 0, 16, setFwVersion),
+    ATTR_HANDLER_CLAMPED(FAN_SPEED_ATTR, ATTR_TYPE_INT, 0, 100, setFanSpeed),
+    ATTR_HANDLER(DOOR_STATE_ATTR, ATTR_TYPE_BOOL, 0, 1, setDoorState),
+#ifdef FAN_CONTROL_MODULE
+    ATTR_HANDLER(FAN_AUTO_ATTR, ATTR_TYPE_BOOL, 0, 1, setFanAuto),
+    ATTR_HANDLER(FAN_SETPOINT_ATTR, ATTR_TYPE_FLOAT, 10, 50, setFanSetpoint),
+    ATTR_HANDLER(FAN_KP_ATTR, ATTR_TYPE_FLOAT, 0, 1000, setFanKp),
+    ATTR_HANDLER(FAN_KI_ATTR, ATTR_TYPE_FLOAT, 0, 100, setFanKi),
+    ATTR_HANDLER(FAN_KD_ATTR, ATTR_TYPE_FLOAT, 0, 1000, setFanKd),
+#endif // FAN_CONTROL_MODULE
+    ATTR_HANDLER(TEMPERATURE_POLICY_ATTR, ATTR_TYPE_OBJECT, 0, 0, setTemperaturePolicy),
+    ATTR_HANDLER(HUMIDITY_POLICY_ATTR, ATTR_TYPE_OBJECT, 0, 0, setHumidityPolicy),
+    ATTR_HANDLER(PRESSURE_POLICY_ATTR, ATTR_TYPE_OBJECT, 0, 0, setPressurePolicy),
+    ATTR_HANDLER(ALTITUDE_POLICY_ATTR, ATTR_TYPE_OBJECT, 0, 0, setAltitudePolicy),
+    ATTR_HANDLER(ILLUMINANCE_POLICY_ATTR, ATTR_TYPE_OBJECT, 0, 0, setIlluminancePolicy),
+};
+static_assert(attrHashesUnique(SHARED_ATTRIBUTE_HANDLERS, ATTR_HANDLER_COUNT(SHARED_ATTRIBUTE_HANDLERS)),
+              "Two shared attribute names share a hash");
+
+AttributeRegistry sharedAttributes(SHARED_ATTRIBUTE_HANDLERS, ATTR_HANDLER_COUNT(SHARED_ATTRIBUTE_HANDLERS));
+
+/// @brief Shared attribute update callback
+/// @param data New value of shared attributes which is changed
+void processSharedAttributes(const JsonObjectConst &data)
+{
+  shared_update_t update = {};
+#ifdef FAN_CONTROL_MODULE
+  update.fanConfig = fanControlGetConfig();
+#endif // FAN_CONTROL_MODULE
+
+  sharedAttributes.apply(data, &update);
 
-    else if (strcmp(it->key().c_str(), DOOR_STATE_ATTR) == 0)
+  // OTA UPDATE
+  if (update.fwTitle != nullptr || update.fwVersion != nullptr)
+  {
+    const char *fwTitle   = (update.fwTitle != nullptr) ? update.fwTitle : "";
+    const char *fwVersion = (update.fwVersion != nullptr) ? update.fwVersion : "";
+
+    if (strcmp(fwTitle, CURRENT_FIRMWARE_TITLE) == 0 &&
+        compareVersion(CURRENT_FIRMWARE_VERSION, fwVersion) < 0)
     {
-      doorState = it->value().as<bool>();
-      if (doorState)
-      {
-        doorServo.setDoorStatus(doorState);
-        doorServo.writePos(180);
-        vTaskDelay(pdMS_TO_TICKS(15));
-      }
-      else
-      {
-        doorServo.setDoorStatus(doorState);
-        doorServo.writePos(0);
-        vTaskDelay(pdMS_TO_TICKS(15));
-      }
+#ifdef DEBUG_PRINT
+      Serial.println("New firmware available! Initiating OTA update...");
+#endif // DEBUG_PRINT
+
+      const OTA_Update_Callback callback(CURRENT_FIRMWARE_TITLE, CURRENT_FIRMWARE_VERSION, &updater,
+                                         &finished_callback, &progress_callback, &update_starting_callback,
+                                         FIRMWARE_FAILURE_RETRIES, FIRMWARE_PACKET_SIZE);
+      ota.Start_Firmware_Update(callback);
     }
   }
+
+#ifdef FAN_CONTROL_MODULE
+  if (update.fanChanged && !fanControlSetConfig(update.fanConfig))
+  {
+  #ifdef DEBUG_PRINT
+    Serial.println("Fan control settings rejected");
+  #endif // DEBUG_PRINT
+  }
+#endif // FAN_CONTROL_MODULE
+}
+
+static bool restoreLedState(const attr_value_t &value, void *context)
+{
+  return actuatorPost(ACTUATOR_CMD_LED, value.b, false);
+}
+
+static bool restoreDoorState(const attr_value_t &value, void *context)
+{
+  return actuatorPost(ACTUATOR_CMD_DOOR, value.b, false);
+}
+
+// Client attributes, the last reported states
+constexpr attr_handler_t CLIENT_ATTRIBUTE_HANDLERS[] = {
+    ATTR_HANDLER(LED_STATE_ATTR, ATTR_TYPE_BOOL, 0, 1, restoreLedState),
+    ATTR_HANDLER(DOOR_STATE_ATTR, ATTR_TYPE_BOOL, 0, 1, restoreDoorState),
+};
+static_assert(attrHashesUnique(CLIENT_ATTRIBUTE_HANDLERS, ATTR_HANDLER_COUNT(CLIENT_ATTRIBUTE_HANDLERS)),
+              "Two client attribute names share a hash");
+
+AttributeRegistry clientAttributes(CLIENT_ATTRIBUTE_HANDLERS, ATTR_HANDLER_COUNT(CLIENT_ATTRIBUTE_HANDLERS));
+
+void processClientAttributes(const JsonObjectConst &data)
+{
+  // Restore the last reported states, no need to echo them back to the server
+  clientAttributes.apply(data, nullptr);
 }
 
 // Attribute request did not receive a response in the expected amount of microseconds
@@ -344,6 +526,164 @@ attribute_shared_request_callback(&processSharedAttributes, REQUEST_TIMEOUT_MICR
 const Attribute_Request_Callback<MAX_ATTRIBUTES>
 attribute_client_request_callback(&processClientAttributes, REQUEST_TIMEOUT_MICROSECONDS, &requestTimedOut,
                                   CLIENT_ATTRIBUTES_LIST);
+/// @brief Copies the keys of a snapshot that pass their policy into a telemetry sample. The ring keeps the
+/// sample until it is uploaded, so its keys count as sent
+/// @param sample Destination sample, stamped with the current time
+/// @param snapshot Latest sensor snapshot
+/// @param cycle true at a telemetry cycle, false between cycles where only excursions are kept
+/// @return true if at least one key is to be sent
+static bool captureTelemetrySample(telemetry_sample_t &sample, const sensor_snapshot_t &snapshot, bool cycle)
+{
+  uint8_t validMask = 0;
+  sample.capturedAt = millis();
+  sample.epochMs    = telemetryGetEpochMs();
+  sample.keyMask    = 0;
+
+#ifdef SHT4X_MODULE
+  if (SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_SHT4X))
+  {
+    sample.values[TELEMETRY_KEY_TEMPERATURE]  = snapshot.temperature;
+    sample.values[TELEMETRY_KEY_HUMIDITY]     = snapshot.humidity;
+    validMask                                |= (1U << TELEMETRY_KEY_TEMPERATURE);
+    validMask                                |= (1U << TELEMETRY_KEY_HUMIDITY);
+  }
+#endif // SHT4X_MODULE
+
+#ifdef BMP280_MODULE
+  if (SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_BMP280))
+  {
+    // The snapshot only carries the pressure, the altitude is cached until the next sample
+    sample.values[TELEMETRY_KEY_PRESSURE]  = snapshot.pressure;
+    sample.values[TELEMETRY_KEY_ALTITUDE]  = bmp280AltitudeFromPressure(snapshot.pressure);
+    validMask                             |= (1U << TELEMETRY_KEY_PRESSURE);
+    validMask                             |= (1U << TELEMETRY_KEY_ALTITUDE);
+  }
+#endif // BMP280_MODULE
+
+#ifdef LIGHT_SENSOR_MODULE
+  if (SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_LIGHT))
+  {
+    sample.values[TELEMETRY_KEY_ILLUMINANCE]  = snapshot.lightPercentage;
+    validMask                                |= (1U << TELEMETRY_KEY_ILLUMINANCE);
+  }
+#endif // LIGHT_SENSOR_MODULE
+
+  for (uint8_t key = 0; key < TELEMETRY_KEY_COUNT; key++)
+  {
+    if (!(validMask & (1U << key)))
+    {
+      continue;
+    }
+
+    telemetry_send_reason_t reason = telemetryFilter.check(key, sample.values[key], sample.capturedAt, cycle);
+    if (reason == TELEMETRY_SEND_NONE)
+    {
+      if (cycle)
+      {
+        telemetryFilter.markSuppressed(key);
+      }
+      continue;
+    }
+    sample.keyMask |= (1U << key);
+    telemetryFilter.markSent(key, sample.values[key], sample.capturedAt);
+#ifdef DEBUG_PRINT
+    Serial.printf("%s: %.2f%s\n", TELEMETRY_KEYS[key], sample.values[key],
+                  (reason == TELEMETRY_SEND_EXCURSION) ? " (excursion)" : "");
+#endif // DEBUG_PRINT
+  }
+
+  return sample.keyMask != 0;
+}
+
+/// @brief Adds the keys of a sample to the current batch entry
+static void addTelemetrySampleKeys(TelemetryBatch &batch, const telemetry_sample_t &sample)
+{
+  for (uint8_t key = 0; key < TELEMETRY_KEY_COUNT; key++)
+  {
+    if (sample.keyMask & (1U << key))
+    {
+      batch.add(TELEMETRY_KEYS[key], sample.values[key]);
+    }
+  }
+}
+
+/// @brief Uploads the buffered samples oldest first, a few per message. A sample is only removed from the
+/// ring once its message was accepted, a failed publish leaves the rest for the next cycle
+/// @param batch Scratch batch used to build each message
+static void drainTelemetryRing(TelemetryBatch &batch)
+{
+  telemetry_sample_t samples[TELEMETRY_DRAIN_BATCH];
+  uint8_t            messages = 0;
+
+  while (!telemetryRing.isEmpty() && messages < TELEMETRY_DRAIN_MAX_MESSAGES)
+  {
+    size_t   count    = telemetryRing.peek(samples, TELEMETRY_DRAIN_BATCH);
+    uint64_t nowEpoch = telemetryGetEpochMs();
+    uint32_t nowMs    = millis();
+
+    if (samples[0].epochMs == 0 && nowEpoch == 0)
+    {
+      // Clock never synchronized, the server stamps the sample on arrival
+      count = 1;
+      batch.begin();
+      addTelemetrySampleKeys(batch, samples[0]);
+    }
+    else
+    {
+      size_t i;
+      batch.beginSeries();
+      for (i = 0; i < count; i++)
+      {
+        uint64_t timestamp = samples[i].epochMs;
+        if (timestamp == 0)
+        {
+          if (nowEpoch == 0)
+          {
+            break;
+          }
+          // Captured before SNTP synchronized, rebuild the epoch from its age
+          timestamp = nowEpoch - (uint32_t) (nowMs - samples[i].capturedAt);
+        }
+
+        if (batch.addEntry(timestamp) != TELEMETRY_OK)
+        {
+          break;
+        }
+        addTelemetrySampleKeys(batch, samples[i]);
+      }
+      count = i;
+    }
+
+    if (count == 0 || batch.isEmpty())
+    {
+      // The oldest sample does not fit an empty message, it never will: count it lost rather than block
+      telemetryRing.discard(count == 0 ? 1 : count);
+#ifdef DEBUG_PRINT
+      Serial.printf("Telemetry sample not publishable, discarded (%u lost)\n",
+                    (unsigned) telemetryRing.getDiscarded());
+#endif // DEBUG_PRINT
+      continue;
+    }
+
+    if (!tb.sendTelemetryJson(batch.getJson(), batch.measure()))
+    {
+#ifdef DEBUG_PRINT
+      Serial.printf("Failed to send telemetry, %u samples kept\n", (unsigned) telemetryRing.size());
+#endif // DEBUG_PRINT
+      return;
+    }
+
+    telemetryRing.drop(count);
+    messages++;
+
+    if (!telemetryRing.isEmpty())
+    {
+      // Let the MQTT loop task run between back-to-back uploads
+      vTaskDelay(pdMS_TO_TICKS(TELEMETRY_DRAIN_GAP_MS));
+    }
+  }
+}
+
 /* Task definitions ------------------------------------------- */
 
 void iotServerTask(void *pvParameters)
@@ -432,163 +772,184 @@ void iotServerTask(void *pvParameters)
 
 void sendTelemetryTask(void *pvParameters)
 {
-  TickType_t lastWakeTime = xTaskGetTickCount();
+  TickType_t     lastWakeTime = xTaskGetTickCount();
+  TelemetryBatch batch;
+  int8_t         lastRssi     = 0;
+  bool           rssiSent     = false;
+  uint32_t       rpcCallsSent = 0;
+  uint32_t       lastCycle    = millis() - telemetrySendInterval; // First cycle right away
 
   for (;;)
   {
-    if (WiFi.status() == WL_CONNECTED)
+    // Polled every TELEMETRY_POLL_MS, the deadband and silence policies only run once per interval
+    uint32_t now   = millis();
+    bool     cycle = (now - lastCycle) >= (uint32_t) telemetrySendInterval;
+    if (cycle)
     {
-      if (tb.connected())
-      {
-#ifdef SHT4X_MODULE
-        sht40.update();
-        float temperature = sht40.getTemperature();
-        float humidity    = sht40.getHumidity();
+      lastCycle = now;
+    }
 
-        if (!(isnan(temperature) || isnan(humidity)))
-        {
-  #ifdef DEBUG_PRINT
-          Serial.print("Temperature: ");
-          Serial.print(temperature);
-          Serial.print(" °C, Humidity: ");
-          Serial.print(humidity);
-          Serial.println(" %");
-  #endif // DEBUG_PRINT
+    // Sensor tasks own the bus, telemetry only reads their latest samples
+    sensor_snapshot_t snapshot;
+    sensorSnapshot.read(snapshot);
 
-          tb.sendTelemetryData(TEMPERATURE_KEY, temperature);
-          tb.sendTelemetryData(HUMIDITY_KEY, humidity);
-        }
-#endif // SHT4X_MODULE
+    // Every sample goes through the ring, so nothing is lost while offline
+    telemetry_sample_t sample;
+    bool               captured = captureTelemetrySample(sample, snapshot, cycle);
+    if (captured && telemetryRing.push(sample))
+    {
+#ifdef DEBUG_PRINT
+      Serial.printf("Telemetry buffer full, oldest sample dropped (%u lost)\n",
+                    (unsigned) telemetryRing.getOverwritten());
+#endif // DEBUG_PRINT
+    }
 
-#ifdef BMP280_MODULE
-        bmp280.update();
-        float pressure = bmp280.getPressure();
-        float altitude = bmp280.getAltitude();
-        // float temperature = bmp280.getTemperature();
-        if (!(isnan(pressure) || isnan(altitude)))
-        {
-  #ifdef DEBUG_PRINT
-          Serial.print("Pressure: ");
-          Serial.print(pressure);
-          Serial.print(" Pa, Altitude: ");
-          Serial.print(altitude);
-          Serial.println(" m");
-  #endif // DEBUG_PRINT
-          tb.sendTelemetryData(PRESSURE_KEY, pressure);
-          tb.sendTelemetryData(ALTITUDE_KEY, altitude);
-        }
-#endif // BMP280_MODULE
+    bool connected = WiFi.status() == WL_CONNECTED && tb.connected();
+    if (!connected)
+    {
+      // Re-send the RSSI attribute after a reconnection
+      rssiSent = false;
+    }
+    else if (captured && !cycle)
+    {
+      // Excursion between cycles, uploaded at once
+      drainTelemetryRing(batch);
+    }
+    else if (cycle)
+    {
+      drainTelemetryRing(batch);
 
-#ifdef LIGHT_SENSOR_MODULE
-        lightSensor.read();
-        float illuminance = lightSensor.getLightValuePercentage();
-        if (!(isnan(illuminance)))
+      // RPC counters, published when calls happened since the last export
+      uint32_t rpcCalls = rpcRouter.getTotalCalls();
+      if (rpcCalls != rpcCallsSent)
+      {
+        StaticJsonDocument<RPC_STATS_CAPACITY> rpcStats;
+        rpcRouter.exportStats(rpcStats.createNestedObject(RPC_STATS_ATTR));
+        if (tb.sendAttributeJson(rpcStats, measureJson(rpcStats)))
         {
-  #ifdef DEBUG_PRINT
-          Serial.print("Illuminance: ");
-          Serial.print(illuminance);
-          Serial.println(" lux");
-  #endif // DEBUG_PRINT
-          tb.sendTelemetryData(ILLUMINANCE_KEY, illuminance);
+          rpcCallsSent = rpcCalls;
         }
-#endif // LIGHT_SENSOR_MODULE
+      }
 
-        // Send WiFi signal strength
-        tb.sendAttributeData("rssi", WiFi.RSSI());
+      // WiFi signal strength is an attribute, only re-send it when it actually moved
+      int8_t rssi = WiFi.RSSI();
+      if (!rssiSent || abs(rssi - lastRssi) >= RSSI_DEADBAND_DB)
+      {
+        rssiSent = tb.sendAttributeData(RSSI_ATTR, rssi);
+        lastRssi = rssi;
       }
     }
-    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(telemetrySendInterval));
+    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(TELEMETRY_POLL_MS));
   }
 }
 
 void updateDevicesStateTask(void *pvParameters)
 {
+  actuator_cmd_t pending[ACTUATOR_CMD_COUNT];
+  bool           valid[ACTUATOR_CMD_COUNT];
+  bool           applied[ACTUATOR_CMD_COUNT] = {false};
+#ifdef SERVO_MODULE
+  bool doorReportPending = false; // Door state is published once the motion ends
+#endif
+
   for (;;)
   {
-    // Update LED
-    if (ledStateChanged)
+    // Sleep until a callback posts a command, then handle everything queued meanwhile at once
+    if (actuatorReceive(pending, valid) == 0)
     {
-      ledStateChanged = false;
+      continue;
+    }
 
-      switch ((int) ledState)
+    // Update LED
+#ifdef LED_RGB_MODULE
+    if (valid[ACTUATOR_CMD_LED])
+    {
+      const bool newState = pending[ACTUATOR_CMD_LED].value != 0;
+      if (!applied[ACTUATOR_CMD_LED] || newState != ledState)
       {
-        case 0:
-          /*
-            // BUILT-IN LED
-            bspGpioDigitalWrite(LED_BUILTIN, HIGH); // OFF
-          */
-          // NEOPIXEL --- OFF
-          rgb.setPixelColor(0, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(1, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(2, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(3, rgb.Color(0, 0, 0));
-          rgb.show();
-
-          break;
-        case 1:
-          /*
-            // BUILT-IN LED
-            bspGpioDigitalWrite(LED_BUILTIN, LOW); // ON
-          */
-          // NEOPIXEL --- ON
-          rgb.setPixelColor(0, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(1, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(2, rgb.Color(255, 102, 0));
-          rgb.setPixelColor(3, rgb.Color(255, 102, 0));
-          rgb.show();
-
-          break;
-        default:
-          /*
-          // BUILT-IN LED
-          bspGpioDigitalWrite(LED_BUILTIN, HIGH); // Fail-safe
-          */
-          // NEOPIXEL --- OFF
-          rgb.setPixelColor(0, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(1, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(2, rgb.Color(0, 0, 0));
-          rgb.setPixelColor(3, rgb.Color(0, 0, 0));
-          rgb.show();
+        ledState                  = newState;
+        applied[ACTUATOR_CMD_LED] = true;
+        applyLedState(ledState);
+      }
 
-          break;
+      if (pending[ACTUATOR_CMD_LED].report)
+      {
+        tb.sendAttributeData(LED_STATE_ATTR, ledState);
       }
-      tb.sendAttributeData(LED_STATE_ATTR, ledState);
     }
+#endif // LED_RGB_MODULE
 
     // Update Door
 #ifdef SERVO_MODULE
-    if (doorStateChanged)
+    if (valid[ACTUATOR_CMD_DOOR])
     {
-      doorStateChanged = false;
-
-      if (doorState)
+      const bool newState = pending[ACTUATOR_CMD_DOOR].value != 0;
+      if (!applied[ACTUATOR_CMD_DOOR] || newState != doorState)
       {
-        doorServo.setDoorStatus(doorState);
-        doorServo.writePos(180);
-        vTaskDelay(pdMS_TO_TICKS(15));
+        doorState                  = newState;
+        applied[ACTUATOR_CMD_DOOR] = true;
+
+        // Non-blocking, the planner posts ACTUATOR_CMD_DOOR_DONE once the door got there
+        doorMotion.moveTo(doorState ? DOOR_OPEN_ANGLE : DOOR_CLOSED_ANGLE, DOOR_MOTION_MS);
       }
-      else
+
+      if (pending[ACTUATOR_CMD_DOOR].report)
       {
-        doorServo.setDoorStatus(doorState);
-        doorServo.writePos(0);
-        vTaskDelay(pdMS_TO_TICKS(15));
+        if (doorMotion.isMoving())
+        {
+          doorReportPending = true;
+        }
+        else
+        {
+          tb.sendAttributeData(DOOR_STATE_ATTR, doorState);
+        }
       }
+    }
 
-      tb.sendAttributeData(DOOR_STATE_ATTR, doorState);
+    // Door arrived: only now is its state real. A stale arrival, overtaken by a newer command, is ignored
+    if (valid[ACTUATOR_CMD_DOOR_DONE] && !doorMotion.isMoving() &&
+        (pending[ACTUATOR_CMD_DOOR_DONE].value != 0) == doorState)
+    {
+      doorServo.setDoorStatus(doorState);
+      if (doorReportPending)
+      {
+        doorReportPending = false;
+        tb.sendAttributeData(DOOR_STATE_ATTR, doorState);
+      }
     }
 #endif // SERVO_MODULE
 
 // Update Fan
 #ifdef MINI_FAN_MODULE
-    if (fanSpeedChanged)
+    // Only this task writes the fan. The speed from the cloud is kept while the local controller owns it.
+    if (valid[ACTUATOR_CMD_FAN] &&
+        (!applied[ACTUATOR_CMD_FAN] || pending[ACTUATOR_CMD_FAN].value != fanSpeed))
     {
-      fanSpeedChanged = false;
+      fanSpeed                  = pending[ACTUATOR_CMD_FAN].value;
+      applied[ACTUATOR_CMD_FAN] = false;
+    }
 
+  #ifdef FAN_CONTROL_MODULE
+    const bool fanAuto = fanControlIsAuto();
+  #else
+    const bool fanAuto = false;
+  #endif // FAN_CONTROL_MODULE
+    if (fanAuto)
+    {
+      if (valid[ACTUATOR_CMD_FAN_AUTO] && pending[ACTUATOR_CMD_FAN_AUTO].value != FAN_AUTO_RELEASED)
+      {
+        // The cloud speed no longer is on the fan, it is applied again once the controller lets go
+        applied[ACTUATOR_CMD_FAN] = false;
+        miniFan.setFanSpeedPercentage(pending[ACTUATOR_CMD_FAN_AUTO].value);
+      }
+    }
+    else if ((valid[ACTUATOR_CMD_FAN] || valid[ACTUATOR_CMD_FAN_AUTO]) && !applied[ACTUATOR_CMD_FAN])
+    {
+      // A late speed of the controller, posted before it was switched off, is dropped here
+      applied[ACTUATOR_CMD_FAN] = true;
       miniFan.setFanSpeedPercentage(fanSpeed);
     }
 #endif // MINI_FAN_MODULE
-
-    vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
 
@@ -603,6 +964,18 @@ void thingsboardLoopTask(void *pvParameters)
 
 void iotServerSetup()
 {
+  // Callbacks post into the queue as soon as the IoT tasks run
+  actuatorQueueSetup();
+
+  // The capture is one index, it fits in std::function without an allocation
+  for (uint8_t i = 0; i < RPC_METHODS_COUNT; i++)
+  {
+    rpcCallbacks[i] = RPC_Callback{RPC_METHODS[i].name,
+                                   [i](const JsonVariantConst &params, JsonDocument &response) {
+                                     rpcRouter.dispatch(i, params, response);
+                                   }};
+  }
+
   xTaskCreate(iotServerTask, "IOT Server Task", 8192, NULL, 1, NULL);
   xTaskCreate(sendTelemetryTask, "Send Telemetry Task", 8192, NULL, 1, NULL);
   xTaskCreate(thingsboardLoopTask, "ThingsBoard Loop Task", 8192, NULL, 1, NULL);
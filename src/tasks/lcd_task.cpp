@@ -14,6 +14,8 @@
 #include "globals.h"
 
 /* Private defines ---------------------------------------------------- */
+#define LCD_STATUS_ROWS    2
+#define LCD_STATUS_COLUMNS 16
 
 /* Private enumerate/structure ---------------------------------------- */
 
@@ -22,86 +24,129 @@
 /* Public variables --------------------------------------------------- */
 
 /* Private variables -------------------------------------------------- */
-
-/* Task definitions ------------------------------------------- */
 #ifdef LCD_MODULE
-void lcdTask(void *pvParameters)
-{
-  for (;;)
-  {
-    if (wifiConnected)
-    {
-      switch (lcd.getScreenState())
-      {
+static TaskHandle_t lcdTaskHandle = NULL;
+
+// Written by lcdShowStatus() from other tasks, drawn by the LCD task
+static portMUX_TYPE lcdStatusLock = portMUX_INITIALIZER_UNLOCKED;
+static char         lcdStatus[LCD_STATUS_ROWS][LCD_STATUS_COLUMNS + 1];
+static bool         lcdStatusPending = false;
+
   #ifdef SERVO_MODULE
-        case LCD_SCREEN_DOOR:
-          lcd.clear();
-          lcd.print("Door Status: ");
-          lcd.setCursor(0, 1);
-          if (doorServo.getDoorStatus())
-          {
-            lcd.print("Opened");
-          }
-          else
-          {
-            lcd.print("Closed");
-          }
-          break;
+static float doorStatus() { return doorServo.getDoorStatus() ? 1.0f : 0.0f; }
+
+static const char *const doorChoices[] = { "Closed", "Opened" };
+
+static const lcd_line_t doorLines[] = {
+  { "Door Status: ", LCD_BIND_STATIC, LCD_FORMAT_NUMBER, 0, nullptr, LCD_NO_CHOICES },
+  { nullptr, LCD_BIND_FN(doorStatus), LCD_FORMAT_CHOICE, 0, nullptr, LCD_CHOICES(doorChoices) },
+};
+static const lcd_page_t doorPage = { "door", LCD_PAGE_LINES(doorLines), 0 };
   #endif // SERVO_MODULE
 
   #ifdef SHT4X_MODULE
-        case LCD_SCREEN_SHT4X:
-          lcd.clear();
-          lcd.print("Hum: ");
-          lcd.print(sht40.getHumidity());
-          lcd.print(" %");
-          lcd.setCursor(0, 1);
-          lcd.print("Temp: ");
-          lcd.print(sht40.getTemperature());
-          lcd.print(" *C");
-          break;
-  #endif
+static const lcd_line_t sht4xLines[] = {
+  { "Hum: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_SHT4X, humidity), LCD_FORMAT_NUMBER, 2, " %", LCD_NO_CHOICES },
+  { "Temp: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_SHT4X, temperature), LCD_FORMAT_NUMBER, 2, " *C",
+    LCD_NO_CHOICES },
+};
+static const lcd_page_t sht4xPage = { "sht4x", LCD_PAGE_LINES(sht4xLines), 0 };
+  #endif // SHT4X_MODULE
 
   #ifdef BMP280_MODULE
-        case LCD_SCREEN_BMP280:
-          lcd.clear();
-          lcd.print("Pres.: ");
-          lcd.print(bmp280.getPressure());
-          lcd.print(" atm");
-          lcd.setCursor(0, 1);
-          lcd.print("Alt.: ");
-          lcd.print(bmp280.getAltitude());
-          lcd.print(" m");
-          break;
-  #endif
+// Only evaluated while the page is shown, shares the cached altitude of the telemetry
+static float bmp280Altitude()
+{
+  float values[SNAPSHOT_MAX_FIELDS];
+
+  if (!sensorSnapshot.readSource(SNAPSHOT_SOURCE_BMP280, values))
+  {
+    return NAN;
+  }
+  return bmp280AltitudeFromPressure(values[SNAPSHOT_BMP280_PRESSURE]);
+}
+
+static const lcd_line_t bmp280Lines[] = {
+  { "Pres.: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_BMP280, pressure), LCD_FORMAT_NUMBER, 0, " Pa",
+    LCD_NO_CHOICES },
+  { "Alt.: ", LCD_BIND_FN(bmp280Altitude), LCD_FORMAT_NUMBER, 2, " m", LCD_NO_CHOICES },
+};
+static const lcd_page_t bmp280Page = { "bmp280", LCD_PAGE_LINES(bmp280Lines), 0 };
+  #endif // BMP280_MODULE
 
   #ifdef LIGHT_SENSOR_MODULE
-        case LCD_SCREEN_LIGHT:
-          lcd.clear();
-          lcd.print("Light level: ");
-          lcd.print(lightSensor.getLightValuePercentage());
-          lcd.progressBar(1, lightSensor.getLightValuePercentage());
-          break;
-  #endif
+static const lcd_line_t lightLines[] = {
+  { "Light level: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_LIGHT, lightPercentage), LCD_FORMAT_NUMBER, 0, nullptr,
+    LCD_NO_CHOICES },
+  { nullptr, LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_LIGHT, lightPercentage), LCD_FORMAT_BAR, 0, nullptr,
+    LCD_NO_CHOICES },
+};
+static const lcd_page_t lightPage = { "light", LCD_PAGE_LINES(lightLines), 0 };
+  #endif // LIGHT_SENSOR_MODULE
 
   #ifdef MINI_FAN_MODULE
-        case LCD_SCREEN_MINIFAN:
-          lcd.clear();
-          lcd.print("Fan Speed: ");
-          lcd.print(miniFan.getFanSpeedPercentage());
-          lcd.print("%");
-          lcd.setCursor(0, 1);
-          lcd.print(miniFan.getFanSpeed());
-          break;
-  #endif
+static float fanSpeedPercentage() { return (float) miniFan.getFanSpeedPercentage(); }
+static float fanSpeed() { return (float) miniFan.getFanSpeed(); }
+
+static const lcd_line_t miniFanLines[] = {
+  { "Fan Speed: ", LCD_BIND_FN(fanSpeedPercentage), LCD_FORMAT_NUMBER, 0, "%", LCD_NO_CHOICES },
+  { nullptr, LCD_BIND_FN(fanSpeed), LCD_FORMAT_NUMBER, 0, nullptr, LCD_NO_CHOICES },
+};
+static const lcd_page_t miniFanPage = { "mini_fan", LCD_PAGE_LINES(miniFanLines), 0 };
+  #endif // MINI_FAN_MODULE
+#endif // LCD_MODULE
+
+/* Task definitions ------------------------------------------- */
+#ifdef LCD_MODULE
+void lcdTask(void *pvParameters)
+{
+  uint32_t statusShownAt = 0;
+  bool     statusShown   = false;
+
+  for (;;)
+  {
+    char status[LCD_STATUS_ROWS][LCD_STATUS_COLUMNS + 1];
+    bool pending;
+
+    portENTER_CRITICAL(&lcdStatusLock);
+    pending = lcdStatusPending;
+    if (pending)
+    {
+      memcpy(status, lcdStatus, sizeof(status));
+      lcdStatusPending = false;
+    }
+    portEXIT_CRITICAL(&lcdStatusLock);
 
-        default:
-          lcd.clear();
-          lcd.print("Blank screen");
-          break;
+    if (pending)
+    {
+      lcd.clear();
+      for (uint8_t row = 0; row < LCD_STATUS_ROWS; row++)
+      {
+        lcd.setCursor(0, row);
+        lcd.print(status[row]);
       }
+      lcd.flush();
+      statusShownAt = millis();
+      statusShown   = true;
     }
-    vTaskDelay(pdMS_TO_TICKS(DELAY_LCD));
+    else if (statusShown && millis() - statusShownAt >= LCD_STATUS_HOLD)
+    {
+      // The status covered the page, draw it again in full
+      statusShown = false;
+      lcdPages.invalidate();
+    }
+
+    if (wifiConnected && !statusShown)
+    {
+      sensor_snapshot_t snapshot;
+      sensorSnapshot.read(snapshot);
+
+      // Redraws only if a value shown on the page changed, or on a page switch or scroll
+      lcdPages.update(snapshot, millis());
+    }
+
+    // Woken early by lcdRefresh()
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DELAY_LCD));
   }
 }
 
@@ -111,11 +156,55 @@ void lcdSetup()
   lcd.display();
   lcd.backlight();
   lcd.clear();
-  xTaskCreate(lcdTask, "LCD Task", 8192, NULL, 2, NULL);
+  // The pages redraw into the framebuffer, only the cells that changed go on the bus
+  lcd.setBuffered(true);
+
+  // Shown in this order
+  #ifdef SERVO_MODULE
+  lcdPages.addPage(&doorPage);
+  #endif
+  #ifdef SHT4X_MODULE
+  lcdPages.addPage(&sht4xPage);
+  #endif
+  #ifdef BMP280_MODULE
+  lcdPages.addPage(&bmp280Page);
+  #endif
+  #ifdef LIGHT_SENSOR_MODULE
+  lcdPages.addPage(&lightPage);
+  #endif
+  #ifdef MINI_FAN_MODULE
+  lcdPages.addPage(&miniFanPage);
+  #endif
+
+  xTaskCreate(lcdTask, "LCD Task", 8192, NULL, 2, &lcdTaskHandle);
+}
+
+void lcdRefresh()
+{
+  if (lcdTaskHandle != NULL)
+  {
+    xTaskNotifyGive(lcdTaskHandle);
+  }
+}
+
+void lcdShowStatus(const char *line0, const char *line1)
+{
+  const char *lines[LCD_STATUS_ROWS] = { line0, line1 };
+
+  portENTER_CRITICAL(&lcdStatusLock);
+  for (uint8_t row = 0; row < LCD_STATUS_ROWS; row++)
+  {
+    lcdStatus[row][0] = '\0';
+    if (lines[row] != nullptr)
+    {
+      strncat(lcdStatus[row], lines[row], LCD_STATUS_COLUMNS);
+    }
+  }
+  lcdStatusPending = true;
+  portEXIT_CRITICAL(&lcdStatusLock);
+
+  lcdRefresh();
 }
 #endif // LCD_MODULE
 
-#ifdef LED_RGB_MODULE
-void ledRgbSetup() { rgb.begin(); }
-#endif // LED_RGB_MODULE
        /* End of file -------------------------------------------------------- */
\ No newline at end of file
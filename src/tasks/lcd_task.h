@@ -21,7 +21,8 @@
   #endif
 
   /* Public defines ----------------------------------------------------- */
-  #define DELAY_LCD 1000
+  #define DELAY_LCD       250  // Period of the check for changed values, the page is redrawn only on a change
+  #define LCD_STATUS_HOLD 3000 // Time a status message stays over the pages, in ms
 /* Public enumerate/structure ----------------------------------------- */
 
 /* Public macros ------------------------------------------------------ */
@@ -32,7 +33,21 @@
 void lcdTask(void *pvParameters);
 void lcdSetup();
 
-void ledRgbSetup();
+/**
+ * @brief Wakes the LCD task so a page switch or scroll requested on `lcdPages` shows without waiting for the
+ * next period.
+ */
+void lcdRefresh();
+
+/**
+ * @brief Shows a two-line status message (e.g. the WiFi state) over the pages for `LCD_STATUS_HOLD` ms.
+ *
+ * Only copies the text and wakes the LCD task, which owns the display. Safe to call from any task.
+ *
+ * @param[in] line0 Text of the first row, may be null.
+ * @param[in] line1 Text of the second row, may be null.
+ */
+void lcdShowStatus(const char *line0, const char *line1);
 
 #endif // LCD_TASK_H
 
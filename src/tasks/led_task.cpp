@@ -0,0 +1,80 @@
+/**
+ * @file       led_task.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-20
+ * @author     Tuan Nguyen
+ *
+ * @brief      Source file for LED Task
+ *
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "led_task.h"
+#include "globals.h"
+
+#ifdef LED_RGB_MODULE
+/* Private defines ---------------------------------------------------- */
+
+/* Private enumerate/structure ---------------------------------------- */
+
+/* Private macros ----------------------------------------------------- */
+
+/* Public variables --------------------------------------------------- */
+
+/* Private variables -------------------------------------------------- */
+static TaskHandle_t ledTaskHandle = NULL;
+
+/* Private function prototypes ---------------------------------------- */
+static void showOnStrip(const led_color_t *frame, uint16_t count, void *arg);
+
+/* Task definitions ------------------------------------------- */
+void ledTask(void *pvParameters)
+{
+  TickType_t lastWakeTime = xTaskGetTickCount();
+
+  for (;;)
+  {
+    ledEffects.render(millis());
+
+    if (ledEffects.isAnimating())
+    {
+      vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(LED_FRAME_MS));
+    }
+    else
+    {
+      // Nothing moves on the strip, sleep until ledRefresh()
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      lastWakeTime = xTaskGetTickCount();
+    }
+  }
+}
+
+void ledRgbSetup()
+{
+  rgb.begin();
+  ledEffects.begin(rgb.numPixels(), showOnStrip);
+  ledEffects.setBrightness(LED_BRIGHTNESS);
+  xTaskCreate(ledTask, "LED Task", 2048, NULL, 1, &ledTaskHandle);
+}
+
+void ledRefresh()
+{
+  if (ledTaskHandle != NULL)
+  {
+    xTaskNotifyGive(ledTaskHandle);
+  }
+}
+
+/* Private definitions ------------------------------------------------ */
+static void showOnStrip(const led_color_t *frame, uint16_t count, void *arg)
+{
+  for (uint16_t i = 0; i < count; i++)
+  {
+    rgb.setPixelColor(i, frame[i].r, frame[i].g, frame[i].b);
+  }
+  rgb.show();
+}
+#endif // LED_RGB_MODULE
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,50 @@
+/**
+ * @file       led_task.h
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-20
+ * @author     Tuan Nguyen
+ *
+ * @brief      Header file for LED Task
+ *
+ */
+
+/* Define to prevent recursive inclusion ------------------------------ */
+#ifndef LED_TASK_H
+  #define LED_TASK_H
+
+  /* Includes ----------------------------------------------------------- */
+  #if ARDUINO >= 100
+    #include "Arduino.h"
+  #else
+    #include "WProgram.h"
+  #endif
+
+  /* Public defines ----------------------------------------------------- */
+  #define LED_FRAME_MS    20 // 50 frames per second while an effect runs, a solid color sleeps
+  #define LED_FADE_MS     300
+  #define LED_ON_COLOR    LED_COLOR(255, 102, 0) // As shown on the strip, see LedEffects::fromDisplay()
+  #define LED_BRIGHTNESS  255
+
+/* Public enumerate/structure ----------------------------------------- */
+
+/* Public macros ------------------------------------------------------ */
+
+/* Public variables --------------------------------------------------- */
+
+/* Funtions Declaration -------------------------------------------------- */
+void ledTask(void *pvParameters);
+
+/**
+ * @brief Starts the strip and the LED task, the only one writing to it.
+ */
+void ledRgbSetup();
+
+/**
+ * @brief Wakes the LED task after a change on `ledEffects`, so it shows without waiting for the next frame.
+ */
+void ledRefresh();
+
+#endif // LED_TASK_H
+
+/* End of file -------------------------------------------------------- */
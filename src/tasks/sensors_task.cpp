@@ -22,6 +22,22 @@
 /* Public variables --------------------------------------------------- */
 
 /* Private variables -------------------------------------------------- */
+#ifdef BMP280_MODULE
+// Last result of bmp280AltitudeFromPressure()
+static portMUX_TYPE altitudeLock     = portMUX_INITIALIZER_UNLOCKED;
+static float        altitudePressure = NAN;
+static float        altitudeSeaLevel = NAN;
+static float        altitude         = NAN;
+#endif
+
+#ifdef LIGHT_SENSOR_MODULE
+static TaskHandle_t lightSensorTaskHandle = NULL;
+#endif
+
+/* Private function prototypes ---------------------------------------- */
+#ifdef LIGHT_SENSOR_MODULE
+static void lightSensorOnDarkness(int value, light_sensor_event_t event, void *arg);
+#endif
 
 /* Task definitions ------------------------------------------- */
 #ifdef SHT4X_MODULE
@@ -29,7 +45,13 @@ void sht40Task(void *pvParameters)
 {
   for (;;)
   {
-    sht40.update();
+    if (sht40.update() == SHT4X_OK)
+    {
+      float values[SNAPSHOT_MAX_FIELDS];
+      values[SNAPSHOT_SHT4X_TEMPERATURE] = sht40.getTemperature();
+      values[SNAPSHOT_SHT4X_HUMIDITY]    = sht40.getHumidity();
+      sensorSnapshot.publish(SNAPSHOT_SOURCE_SHT4X, values, 2, millis());
+    }
     vTaskDelay(DELAY_SHT4X / portTICK_PERIOD_MS);
   }
 }
@@ -47,7 +69,14 @@ void bmp280Task(void *pvParameters)
 {
   for (;;)
   {
-    bmp280.update();
+    if (bmp280.update() == BMP280_OK)
+    {
+      float values[SNAPSHOT_MAX_FIELDS];
+      // Pressure only, the altitude pow() is left to the consumers that show or send it
+      values[SNAPSHOT_BMP280_PRESSURE]    = bmp280.getPressure();
+      values[SNAPSHOT_BMP280_TEMPERATURE] = bmp280.getTemperature();
+      sensorSnapshot.publish(SNAPSHOT_SOURCE_BMP280, values, 2, millis());
+    }
     vTaskDelay(DELAY_BMP280 / portTICK_PERIOD_MS);
   }
 }
@@ -62,6 +91,31 @@ void bmp280Setup()
                      STANDBY_MS_500); /* Standby time. */
   xTaskCreate(bmp280Task, "BMP280 Task", 4096, NULL, 1, NULL);
 }
+
+float bmp280AltitudeFromPressure(float pressure)
+{
+  float seaLevel = bmp280.getSeaLevelPressure();
+  float result;
+  bool  cached;
+
+  portENTER_CRITICAL(&altitudeLock);
+  cached = (pressure == altitudePressure && seaLevel == altitudeSeaLevel);
+  result = altitude;
+  portEXIT_CRITICAL(&altitudeLock);
+
+  if (!cached)
+  {
+    // Outside of the lock, the pow() is too long for a critical section
+    result = BMP280::altitudeFromPressure(pressure, seaLevel);
+
+    portENTER_CRITICAL(&altitudeLock);
+    altitudePressure = pressure;
+    altitudeSeaLevel = seaLevel;
+    altitude         = result;
+    portEXIT_CRITICAL(&altitudeLock);
+  }
+  return result;
+}
 #endif // BMP280_MODULE
 
 #if defined(SHT4X_MODULE) && defined(BMP280_MODULE)
@@ -77,12 +131,50 @@ void lightSensorTask(void *pvParameters)
 {
   for (;;)
   {
-    lightSensor.read();
-    vTaskDelay(DELAY_LIGHT_SENSOR / portTICK_PERIOD_MS);
+    if (lightSensor.read() == LIGHT_SENSOR_OK)
+    {
+      float values[SNAPSHOT_MAX_FIELDS];
+      values[SNAPSHOT_LIGHT_RAW]        = lightSensor.getLightValue();
+      values[SNAPSHOT_LIGHT_PERCENTAGE] = lightSensor.getLightValuePercentage();
+      sensorSnapshot.publish(SNAPSHOT_SOURCE_LIGHT, values, 2, millis());
+    }
+
+    // Woken early when the room gets dark or light, the snapshot then carries the edge to the LCD and to the
+    // excursion check of the telemetry instead of waiting for the next period
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DELAY_LIGHT_SENSOR));
   }
 }
 
-void lightSensorSetup() { xTaskCreate(lightSensorTask, "Light Sensor Task", 4096, NULL, 1, NULL); }
+void lightSensorSetup()
+{
+  // The ADC streams in the background, read() returns the filtered value at once. If the pin cannot stream,
+  // read() falls back to a one-shot conversion.
+  lightSensor.beginContinuous(LIGHT_SENSOR_SAMPLE_RATE, LIGHT_SENSOR_DECIMATION, LIGHT_SENSOR_FRAME);
+
+  // Dark is the band [0, LIGHT_SENSOR_DARK_LEVEL] of the median, a passing shadow does not enter it
+  light_sensor_trigger_t dark = {};
+  dark.type                   = LIGHT_TRIGGER_BAND;
+  dark.filter                 = LIGHT_FILTER_MEDIAN;
+  dark.threshold              = 0;
+  dark.upper                  = LIGHT_SENSOR_DARK_LEVEL;
+  dark.hysteresis             = LIGHT_SENSOR_DARK_HYST;
+  dark.holdOffMs              = LIGHT_SENSOR_DARK_HOLD;
+  lightSensor.addTrigger(dark, lightSensorOnDarkness);
+
+  xTaskCreate(lightSensorTask, "Light Sensor Task", 4096, NULL, 1, &lightSensorTaskHandle);
+}
 #endif // LIGHT_SENSOR_MODULE
 
+/* Private definitions ------------------------------------------------ */
+#ifdef LIGHT_SENSOR_MODULE
+static void lightSensorOnDarkness(int, light_sensor_event_t, void *)
+{
+  // Runs in the ADC reader task. In one-shot mode it runs in the light task itself, which publishes anyway.
+  if (lightSensorTaskHandle != NULL && xTaskGetCurrentTaskHandle() != lightSensorTaskHandle)
+  {
+    xTaskNotifyGive(lightSensorTaskHandle);
+  }
+}
+#endif
+
 /* End of file -------------------------------------------------------- */
\ No newline at end of file
@@ -22,14 +22,21 @@
 
   /* Public defines ----------------------------------------------------- */
   #define DELAY_DHT20        60000
-  #define DELAY_SHT4X        60000
-  #define DELAY_BMP280       60000
+  #define DELAY_SHT4X        30000
+  #define DELAY_BMP280       30000
   #define DELAY_LIGHT_SENSOR 10000
   #define DELAY_ULTRASONIC   1000
   #define DELAY_PIRSENSOR    1000
   #define DELAY_MOISTURE     60000
   #define DELAY_SOIL_RS485   60000
 
+  #define LIGHT_SENSOR_SAMPLE_RATE 1000 // ADC conversions per second of the continuous pipeline
+  #define LIGHT_SENSOR_DECIMATION  20   // Conversions averaged per filtered sample (50 Hz)
+  #define LIGHT_SENSOR_FRAME       500  // Conversions per DMA frame, the ADC reader wakes twice a second
+  #define LIGHT_SENSOR_DARK_LEVEL  800  // Raw median under which the room is dark (about 20 %)
+  #define LIGHT_SENSOR_DARK_HYST   100  // Raw counts to move back by before the next dark/light edge
+  #define LIGHT_SENSOR_DARK_HOLD   2000 // ms, a flickering light is published at most this often
+
 /* Public enumerate/structure ----------------------------------------- */
 
 /* Public macros ------------------------------------------------------ */
@@ -45,6 +52,18 @@ void sht40Setup();
 void bmp280Setup();
 void unitENVIVSetup();
 void lightSensorSetup();
+
+/**
+ * @brief Altitude of a BMP280 pressure from the snapshot, at the sea level pressure set on `bmp280`.
+ *
+ * Shared by the consumers of the snapshot (telemetry, LCD). The `pow()` runs once per new pressure sample or
+ * sea level pressure, repeated calls return the cached result. Safe to call from any task.
+ *
+ * @param[in] pressure The pressure in Pascals.
+ *
+ * @return float The altitude in meters.
+ */
+float bmp280AltitudeFromPressure(float pressure);
 #endif // SENSORS_TASK_H
 
 /* End of file -------------------------------------------------------- */
\ No newline at end of file
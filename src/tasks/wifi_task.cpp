@@ -15,6 +15,8 @@
 #include <WiFi.h>
 
 /* Private defines ---------------------------------------------------- */
+#define NTP_SERVER_PRIMARY   "pool.ntp.org"
+#define NTP_SERVER_SECONDARY "time.google.com"
 
 /* Private enumerate/structure ---------------------------------------- */
 
@@ -46,12 +48,15 @@ void wifiTask(void *pvParameters)
         Serial.println("Connected to WiFi");
 #endif // DEBUG_PRINT
 
+        // Keep the clock in UTC so telemetry can be timestamped on the device
+        configTime(0, 0, NTP_SERVER_PRIMARY, NTP_SERVER_SECONDARY);
+
 #ifdef LCD_MODULE
-        lcd.clear();
-        lcd.print("WiFi connected");
-        lcd.setCursor(0, 1);
-        lcd.print("IP: ");
-        lcd.print(WiFi.localIP());
+        // Drawn by the LCD task, it owns the display
+        IPAddress ip = WiFi.localIP();
+        char      line[24];
+        snprintf(line, sizeof(line), "IP: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+        lcdShowStatus("WiFi connected", line);
 #endif // LCD_MODULE
       }
       else
@@ -63,10 +68,7 @@ void wifiTask(void *pvParameters)
 #endif // DEBUG_PRINT
 
 #ifdef LCD_MODULE
-          lcd.clear();
-          lcd.print("WiFi Failed");
-          lcd.setCursor(0, 1);
-          lcd.print("Retrying...");
+          lcdShowStatus("WiFi Failed", "Retrying...");
 #endif // LCD_MODULE
         }
       }
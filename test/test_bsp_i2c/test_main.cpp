@@ -0,0 +1,269 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the bsp_i2c transaction engine, run with `pio test -e native`
+ *
+ * The engine is begun without its owner task and served with `bspI2CEngineStep()`, so each test decides
+ * exactly what sits in the queue when a batch is drained.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "bsp_i2c.h"
+#include "hal_native.h"
+
+#include <unity.h>
+
+#include <string.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_DEVICE_ADDR 0x30
+#define TEST_ABSENT_ADDR 0x31
+
+/* Private enumerate/structure ---------------------------------------- */
+/**
+ * @brief Register file with an auto-incrementing pointer, counting the transactions it sees.
+ */
+class RegisterDevice : public HalI2CDevice
+{
+public:
+  uint8_t  regs[16];
+  uint8_t  pointer;
+  uint32_t writes;
+  uint32_t reads;
+
+  void clear()
+  {
+    memset(regs, 0, sizeof(regs));
+    pointer = 0;
+    writes  = 0;
+    reads   = 0;
+  }
+
+  bool onWrite(const uint8_t *data, size_t len) override
+  {
+    writes++;
+    if (len > 0)
+    {
+      pointer = data[0] & 0x0F;
+    }
+    for (size_t i = 1; i < len; i++)
+    {
+      regs[(pointer + i - 1) & 0x0F] = data[i];
+    }
+    return true;
+  }
+
+  size_t onRead(uint8_t *data, size_t len) override
+  {
+    reads++;
+    for (size_t i = 0; i < len; i++)
+    {
+      data[i] = regs[(pointer + i) & 0x0F];
+    }
+    return len;
+  }
+};
+
+/* Private variables -------------------------------------------------- */
+static RegisterDevice device;
+static uint8_t        completions[BSP_I2C_ENGINE_QUEUE_LENGTH];
+static uint8_t        completionCount;
+
+/* Private function prototypes ---------------------------------------- */
+static void onComplete(bsp_i2c_transaction_t *txn);
+static void prepare(bsp_i2c_transaction_t &txn, bsp_i2c_txn_type_t type, uint8_t address, uint8_t reg,
+                    uint8_t *buffer, uint16_t len, uint8_t id);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  halSimReset();
+  device.clear();
+  halI2CAttach(TEST_DEVICE_ADDR, &device);
+  Wire.begin(-1, -1, 100000UL);
+  bspI2CResetStats();
+  completionCount = 0;
+}
+
+void tearDown() { halI2CDetach(TEST_DEVICE_ADDR); }
+
+void test_helpers_run_inline_without_engine()
+{
+  uint8_t value = 0x5A;
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CWriteByte(TEST_DEVICE_ADDR, 0x02, value));
+  value = 0;
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CReadByte(TEST_DEVICE_ADDR, 0x02, value));
+  TEST_ASSERT_EQUAL_HEX8(0x5A, value);
+  TEST_ASSERT_EQUAL_UINT32(1, device.reads);
+}
+
+void test_submit_waits_in_queue_until_step()
+{
+  uint8_t               buffer[2];
+  bsp_i2c_transaction_t txn;
+  prepare(txn, BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0x04, buffer, sizeof(buffer), 1);
+  device.regs[4] = 0x12;
+  device.regs[5] = 0x34;
+
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&txn, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, halI2CGetStats().transactions);
+  TEST_ASSERT_EQUAL_UINT8(0, completionCount);
+
+  TEST_ASSERT_EQUAL_UINT8(1, bspI2CEngineStep(0));
+  TEST_ASSERT_EQUAL_UINT8(1, completionCount);
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, txn.result);
+  TEST_ASSERT_EQUAL_HEX8(0x12, buffer[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x34, buffer[1]);
+
+  // Empty queue, nothing to serve
+  TEST_ASSERT_EQUAL_UINT8(0, bspI2CEngineStep(0));
+}
+
+void test_identical_reads_are_coalesced_until_a_write()
+{
+  uint8_t               first[2], same[2], written[1] = {0x77}, after[2];
+  bsp_i2c_transaction_t txns[4];
+  device.regs[0] = 0x11;
+  device.regs[1] = 0x22;
+
+  prepare(txns[0], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0x00, first, 2, 1);
+  prepare(txns[1], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0x00, same, 2, 2);
+  prepare(txns[2], BSP_I2C_TXN_WRITE, TEST_DEVICE_ADDR, 0x00, written, 1, 3);
+  prepare(txns[3], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0x00, after, 2, 4);
+  for (bsp_i2c_transaction_t &txn : txns)
+  {
+    TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&txn, 0));
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(4, bspI2CEngineStep(0));
+
+  // The second read never reached the bus, the one behind the write did and sees the new value
+  TEST_ASSERT_EQUAL_UINT32(2, device.reads);
+  TEST_ASSERT_EQUAL_HEX8(0x11, same[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x22, same[1]);
+  TEST_ASSERT_EQUAL_HEX8(0x77, after[0]);
+
+  // Completion order: the coalesced read right after the read that served it
+  const uint8_t order[] = {2, 1, 3, 4};
+  TEST_ASSERT_EQUAL_UINT8(4, completionCount);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(order, completions, 4);
+
+  bsp_i2c_device_stats_t stats;
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CGetDeviceStats(TEST_DEVICE_ADDR, stats));
+  TEST_ASSERT_EQUAL_UINT32(4, stats.transactions);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.coalesced);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.errors);
+}
+
+void test_step_drains_one_batch_at_a_time()
+{
+  uint8_t               buffers[BSP_I2C_ENGINE_BATCH_SIZE + 2];
+  bsp_i2c_transaction_t txns[BSP_I2C_ENGINE_BATCH_SIZE + 2];
+
+  // Different registers, nothing to coalesce
+  for (uint8_t i = 0; i < BSP_I2C_ENGINE_BATCH_SIZE + 2; i++)
+  {
+    prepare(txns[i], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, i, &buffers[i], 1, i);
+    TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&txns[i], 0));
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(BSP_I2C_ENGINE_BATCH_SIZE, bspI2CEngineStep(0));
+  TEST_ASSERT_EQUAL_UINT8(2, bspI2CEngineStep(0));
+  TEST_ASSERT_EQUAL_UINT32(BSP_I2C_ENGINE_BATCH_SIZE + 2, device.reads);
+}
+
+void test_full_queue_times_out()
+{
+  uint8_t               buffer;
+  bsp_i2c_transaction_t txns[BSP_I2C_ENGINE_QUEUE_LENGTH + 1];
+
+  for (uint8_t i = 0; i < BSP_I2C_ENGINE_QUEUE_LENGTH; i++)
+  {
+    prepare(txns[i], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0, &buffer, 1, i);
+    TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&txns[i], 0));
+  }
+  prepare(txns[BSP_I2C_ENGINE_QUEUE_LENGTH], BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0, &buffer, 1, 0);
+  TEST_ASSERT_EQUAL(BSP_I2C_TIMEOUT, bspI2CSubmit(&txns[BSP_I2C_ENGINE_QUEUE_LENGTH], 0));
+
+  while (bspI2CEngineStep(0) > 0)
+  {
+  }
+  TEST_ASSERT_EQUAL_UINT8(BSP_I2C_ENGINE_QUEUE_LENGTH, completionCount);
+}
+
+void test_errors_are_reported_and_counted()
+{
+  uint8_t               buffer;
+  bsp_i2c_transaction_t read, write;
+  prepare(read, BSP_I2C_TXN_READ, TEST_ABSENT_ADDR, 0, &buffer, 1, 1);
+  prepare(write, BSP_I2C_TXN_WRITE, TEST_ABSENT_ADDR, 0, &buffer, 1, 2);
+
+  TEST_ASSERT_EQUAL(BSP_I2C_ERR, bspI2CSubmit(nullptr, 0));
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&read, 0));
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CSubmit(&write, 0));
+  TEST_ASSERT_EQUAL_UINT8(2, bspI2CEngineStep(0));
+  TEST_ASSERT_EQUAL(BSP_I2C_ERR_READ, read.result);
+  TEST_ASSERT_EQUAL(BSP_I2C_ERR_WRITE, write.result);
+
+  bsp_i2c_device_stats_t stats;
+  bspI2CGetDeviceStats(TEST_ABSENT_ADDR, stats);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.errors);
+}
+
+void test_transfer_without_owner_task_runs_inline()
+{
+  // A synchronous call nobody would serve must not block on the queue
+  uint8_t               buffer = 0;
+  bsp_i2c_transaction_t txn;
+  prepare(txn, BSP_I2C_TXN_READ, TEST_DEVICE_ADDR, 0x03, &buffer, 1, 0);
+  device.regs[3] = 0x42;
+
+  TEST_ASSERT_EQUAL(BSP_I2C_OK, bspI2CTransfer(&txn, 0));
+  TEST_ASSERT_EQUAL_HEX8(0x42, buffer);
+  TEST_ASSERT_EQUAL_UINT8(0, bspI2CEngineStep(0));
+}
+
+/* Private definitions ------------------------------------------------ */
+static void onComplete(bsp_i2c_transaction_t *txn)
+{
+  completions[completionCount++] = (uint8_t) (uintptr_t) txn->arg;
+}
+
+static void prepare(bsp_i2c_transaction_t &txn, bsp_i2c_txn_type_t type, uint8_t address, uint8_t reg,
+                    uint8_t *buffer, uint16_t len, uint8_t id)
+{
+  memset(&txn, 0, sizeof(txn));
+  txn.type        = type;
+  txn.address     = address;
+  txn.hasRegister = true;
+  txn.reg         = reg;
+  txn.buffer      = buffer;
+  txn.len         = len;
+  txn.callback    = onComplete;
+  txn.arg         = (void *) (uintptr_t) id;
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_helpers_run_inline_without_engine);
+
+  // From here on transactions submitted asynchronously wait for bspI2CEngineStep()
+  bspI2CEngineBegin(BSP_I2C_ENGINE_QUEUE_LENGTH, BSP_I2C_ENGINE_PRIORITY, false);
+  RUN_TEST(test_submit_waits_in_queue_until_step);
+  RUN_TEST(test_identical_reads_are_coalesced_until_a_write);
+  RUN_TEST(test_step_drains_one_batch_at_a_time);
+  RUN_TEST(test_full_queue_times_out);
+  RUN_TEST(test_errors_are_reported_and_counted);
+  RUN_TEST(test_transfer_without_owner_task_runs_inline);
+  return UNITY_END();
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,205 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of ButtonGroup clicks, holds and chords, run with `pio test -e native`
+ *
+ * Presses are scheduled on the pins of HAL Native and the group is scanned every `DELAY_BUTTON` ms on the
+ * virtual clock, like the button task does. Every event is recorded with the time it was reported.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "button_group.h"
+#include "hal_native.h"
+
+#include <unity.h>
+
+#include <vector>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_PIN_A       10
+#define TEST_PIN_B       11
+#define TEST_PIN_C       12
+#define TEST_PERIOD_MS   10 // DELAY_BUTTON
+#define TEST_DEBOUNCE_MS 50 // ButtonGroup defaults
+#define TEST_DOUBLE_MS   400
+#define TEST_HOLD_MS     800
+
+/* Private enumerate/structure ---------------------------------------- */
+typedef struct
+{
+  uint8_t        id;
+  button_event_t event;
+  uint32_t       at;
+} test_event_t;
+
+/* Private variables -------------------------------------------------- */
+static ButtonGroup              *group;
+static std::vector<test_event_t> events;
+static uint8_t                   idA, idB, idC, chordAB;
+
+/* Private function prototypes ---------------------------------------- */
+static void testPress(uint8_t pin, uint32_t atMs, uint32_t durationMs);
+static void testRun(uint32_t durationMs);
+static void testExpect(size_t index, uint8_t id, button_event_t event);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  halSimReset();
+  events.clear();
+  group = new ButtonGroup();
+  group->addButton(TEST_PIN_A, true, true, &idA);
+  group->addButton(TEST_PIN_B, true, true, &idB);
+  group->addButton(TEST_PIN_C, true, true, &idC);
+  group->addChord((uint8_t) ((1U << idA) | (1U << idB)), &chordAB);
+  group->attachCallback(
+      [](uint8_t id, button_event_t event) { events.push_back({ id, event, (uint32_t) millis() }); });
+  halGpioSetInput(TEST_PIN_A, HIGH);
+  halGpioSetInput(TEST_PIN_B, HIGH);
+  halGpioSetInput(TEST_PIN_C, HIGH);
+}
+
+void tearDown() { delete group; }
+
+void test_single_click_is_reported_after_the_double_click_interval()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_A, t0 + 50, 80);
+  testRun(1000);
+
+  TEST_ASSERT_EQUAL(1, events.size());
+  testExpect(0, idA, BUTTON_EVENT_SINGLE_CLICK);
+  // Released at 130, debounced at 180, then the double click interval
+  TEST_ASSERT_UINT32_WITHIN(TEST_PERIOD_MS, t0 + 130 + TEST_DEBOUNCE_MS + TEST_DOUBLE_MS, events[0].at);
+}
+
+void test_double_click()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_B, t0 + 50, 80);
+  testPress(TEST_PIN_B, t0 + 250, 80);
+  testRun(1000);
+
+  TEST_ASSERT_EQUAL(1, events.size());
+  testExpect(0, idB, BUTTON_EVENT_DOUBLE_CLICK);
+}
+
+void test_hold_start_and_release()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_C, t0 + 50, 1200);
+  testRun(2000);
+
+  TEST_ASSERT_EQUAL(2, events.size());
+  testExpect(0, idC, BUTTON_EVENT_HOLD_START);
+  testExpect(1, idC, BUTTON_EVENT_HOLD_RELEASE);
+  TEST_ASSERT_UINT32_WITHIN(TEST_PERIOD_MS, t0 + 50 + TEST_DEBOUNCE_MS + TEST_HOLD_MS, events[0].at);
+}
+
+void test_bounce_shorter_than_debounce_is_ignored()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_A, t0 + 50, 20);
+  testPress(TEST_PIN_A, t0 + 100, 30);
+  testRun(1000);
+
+  TEST_ASSERT_EQUAL(0, events.size());
+  TEST_ASSERT_EQUAL_UINT8(0, group->getPressedMask());
+}
+
+void test_chord_reports_press_and_hold_but_no_button_events()
+{
+  // B joins A 30 ms later, within the debounce of A: both are seen pressed together
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_A, t0 + 50, 1500);
+  testPress(TEST_PIN_B, t0 + 80, 1450);
+  testRun(2500);
+
+  TEST_ASSERT_EQUAL(2, events.size());
+  testExpect(0, chordAB, BUTTON_EVENT_CHORD);
+  testExpect(1, chordAB, BUTTON_EVENT_CHORD_HOLD);
+  TEST_ASSERT_UINT32_WITHIN(TEST_PERIOD_MS, events[0].at + TEST_HOLD_MS, events[1].at);
+}
+
+void test_buttons_of_a_released_chord_click_again()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_A, t0 + 50, 300);
+  testPress(TEST_PIN_B, t0 + 60, 300);
+  testPress(TEST_PIN_A, t0 + 1000, 80);
+  testRun(2000);
+
+  TEST_ASSERT_EQUAL(2, events.size());
+  testExpect(0, chordAB, BUTTON_EVENT_CHORD);
+  testExpect(1, idA, BUTTON_EVENT_SINGLE_CLICK);
+}
+
+void test_other_button_during_a_chord_is_independent()
+{
+  uint32_t t0 = millis();
+  testPress(TEST_PIN_A, t0 + 50, 300);
+  testPress(TEST_PIN_B, t0 + 50, 300);
+  testPress(TEST_PIN_C, t0 + 500, 1200);
+  testRun(2500);
+
+  TEST_ASSERT_EQUAL(3, events.size());
+  testExpect(0, chordAB, BUTTON_EVENT_CHORD);
+  testExpect(1, idC, BUTTON_EVENT_HOLD_START);
+  testExpect(2, idC, BUTTON_EVENT_HOLD_RELEASE);
+}
+
+void test_chord_needs_two_known_buttons()
+{
+  TEST_ASSERT_EQUAL(BUTTON_ERR_INVALID_PARAM, group->addChord((uint8_t) (1U << idA)));
+  TEST_ASSERT_EQUAL(BUTTON_ERR_INVALID_PARAM, group->addChord((uint8_t) ((1U << idA) | (1U << 5))));
+  TEST_ASSERT_EQUAL(BUTTON_OK, group->addChord((uint8_t) ((1U << idB) | (1U << idC))));
+  TEST_ASSERT_EQUAL(BUTTON_OK, group->addChord((uint8_t) ((1U << idA) | (1U << idC))));
+  TEST_ASSERT_EQUAL(BUTTON_OK, group->addChord((uint8_t) ((1U << idA) | (1U << idB) | (1U << idC))));
+  TEST_ASSERT_EQUAL(BUTTON_ERR_FULL, group->addChord((uint8_t) ((1U << idB) | (1U << idC))));
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_single_click_is_reported_after_the_double_click_interval);
+  RUN_TEST(test_double_click);
+  RUN_TEST(test_hold_start_and_release);
+  RUN_TEST(test_bounce_shorter_than_debounce_is_ignored);
+  RUN_TEST(test_chord_reports_press_and_hold_but_no_button_events);
+  RUN_TEST(test_buttons_of_a_released_chord_click_again);
+  RUN_TEST(test_other_button_during_a_chord_is_independent);
+  RUN_TEST(test_chord_needs_two_known_buttons);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static void testPress(uint8_t pin, uint32_t atMs, uint32_t durationMs)
+{
+  halSimSchedule(atMs, [pin]() { halGpioSetInput(pin, LOW); });
+  halSimSchedule(atMs + durationMs, [pin]() { halGpioSetInput(pin, HIGH); });
+}
+
+static void testRun(uint32_t durationMs)
+{
+  // One scan per period for all the buttons, like the button task
+  for (uint32_t elapsed = 0; elapsed < durationMs; elapsed += TEST_PERIOD_MS)
+  {
+    group->update();
+    delay(TEST_PERIOD_MS);
+  }
+}
+
+static void testExpect(size_t index, uint8_t id, button_event_t event)
+{
+  TEST_ASSERT_TRUE(index < events.size());
+  TEST_ASSERT_EQUAL_UINT8(id, events[index].id);
+  TEST_ASSERT_EQUAL(event, events[index].event);
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,201 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the fan PID controller, run with `pio test -e native`
+ *
+ * The first tests check the hysteresis, the rate limit and the settings one sample at a time. The others
+ * close the loop on a room model: a heat load, losses to the ambient growing with the airflow of the fan, and
+ * the controller sampling every `DELAY_SHT4X` like the fan control task.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "fan_control.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+// Room model: heat load, losses growing with the airflow
+#define TEST_ROOM_AMBIENT     25.0f   // °C
+#define TEST_ROOM_CAPACITY    2000.0f // J/°C
+#define TEST_ROOM_LOSS        1.0f    // W/°C, fan stopped
+#define TEST_ROOM_FAN_LOSS    4.0f    // W/°C added at full speed
+#define TEST_SAMPLE_PERIOD_S  30      // DELAY_SHT4X
+#define TEST_SETTLE_S         7200    // Long enough for the integral to settle
+#define TEST_WINDOW_S         1800    // Extremes are checked over the last half hour
+
+/* Private enumerate/structure ---------------------------------------- */
+typedef struct
+{
+  float    lowest;     /**< Over the last `TEST_WINDOW_S` */
+  float    highest;    /**< Over the last `TEST_WINDOW_S` */
+  uint32_t fullSpeedS; /**< Seconds at full speed over the whole run */
+  uint32_t starts;     /**< Times the fan started */
+} test_run_t;
+
+/* Private variables -------------------------------------------------- */
+static FanController       *controller;
+static fan_control_config_t config;
+static float                room;
+static uint32_t             nowS;
+
+/* Private function prototypes ---------------------------------------- */
+static test_run_t testRun(float heatW, uint32_t durationS);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  fan_control_config_t defaults = FAN_CONTROL_CONFIG_DEFAULT;
+  config                        = defaults;
+  controller                    = new FanController();
+  room                          = TEST_ROOM_AMBIENT;
+  nowS                          = 0;
+}
+
+void tearDown() { delete controller; }
+
+void test_hysteresis_starts_and_stops_the_fan()
+{
+  // Start above setpoint + hysteresis, stop below setpoint - hysteresis, nothing in between
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, controller->update(28.4f, 0));
+  TEST_ASSERT_FALSE(controller->isRunning());
+  TEST_ASSERT_TRUE(controller->update(28.6f, 30000) >= config.minOutput);
+  TEST_ASSERT_TRUE(controller->isRunning());
+  TEST_ASSERT_TRUE(controller->update(27.6f, 60000) >= config.minOutput);
+  TEST_ASSERT_TRUE(controller->isRunning());
+  controller->update(27.4f, 90000);
+  TEST_ASSERT_FALSE(controller->isRunning());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, controller->getIntegral());
+}
+
+void test_rate_limit_bounds_each_step()
+{
+  // A 12 °C jump would ask for full speed at once, 2 %/s lets 20 % through in 10 s
+  controller->update(28.0f, 0);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, controller->update(40.0f, 10000));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 80.0f, controller->update(40.0f, 40000));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, controller->update(40.0f, 70000));
+}
+
+void test_non_finite_sample_is_ignored()
+{
+  controller->update(30.0f, 0);
+  float output = controller->update(30.0f, 30000);
+  TEST_ASSERT_EQUAL_FLOAT(output, controller->update(NAN, 60000));
+  TEST_ASSERT_EQUAL_FLOAT(output, controller->update(INFINITY, 90000));
+  TEST_ASSERT_TRUE(controller->isRunning());
+}
+
+void test_invalid_settings_keep_the_previous_ones()
+{
+  fan_control_config_t bad = config;
+  bad.minOutput            = 60.0f;
+  bad.maxOutput            = 50.0f;
+  TEST_ASSERT_EQUAL(FAN_CONTROL_ERR_INVALID_ARG, controller->configure(bad));
+  bad    = config;
+  bad.kp = -1.0f;
+  TEST_ASSERT_EQUAL(FAN_CONTROL_ERR_INVALID_ARG, controller->configure(bad));
+  bad          = config;
+  bad.setpoint = NAN;
+  TEST_ASSERT_EQUAL(FAN_CONTROL_ERR_INVALID_ARG, controller->configure(bad));
+  TEST_ASSERT_EQUAL_FLOAT(config.setpoint, controller->getConfig().setpoint);
+
+  bad.setpoint = 26.0f;
+  TEST_ASSERT_EQUAL(FAN_CONTROL_OK, controller->configure(bad));
+  TEST_ASSERT_EQUAL_FLOAT(26.0f, controller->getConfig().setpoint);
+}
+
+void test_moderate_load_settles_on_the_setpoint()
+{
+  // 8 W: 33 °C without the fan, held at 28 °C with about 42 % of airflow
+  test_run_t run = testRun(8.0f, TEST_SETTLE_S);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, config.setpoint, run.lowest);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, config.setpoint, run.highest);
+  TEST_ASSERT_FLOAT_WITHIN(2.0f, 41.7f, controller->getOutput());
+  TEST_ASSERT_EQUAL_UINT32(0, run.fullSpeedS);
+  TEST_ASSERT_EQUAL_UINT32(1, run.starts);
+}
+
+void test_heat_wave_saturates_then_recovers_without_windup()
+{
+  testRun(8.0f, TEST_SETTLE_S);
+
+  // 30 W: even at full speed the room settles at 31 °C
+  test_run_t run = testRun(30.0f, 3600);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 31.0f, run.highest);
+  TEST_ASSERT_EQUAL_FLOAT(config.maxOutput, controller->getOutput());
+  TEST_ASSERT_TRUE(controller->getIntegral() <= config.maxOutput);
+
+  // Back to 8 W: the integral did not grow while saturated, the fan leaves full speed within minutes
+  run = testRun(8.0f, TEST_SETTLE_S);
+  TEST_ASSERT_TRUE(run.fullSpeedS <= 300);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, config.setpoint, run.lowest);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, config.setpoint, run.highest);
+}
+
+void test_light_load_stops_the_fan()
+{
+  testRun(8.0f, TEST_SETTLE_S);
+
+  // 2 W: 27 °C without the fan, below setpoint - hysteresis, the fan must stop and stay stopped
+  test_run_t run = testRun(2.0f, 3600);
+  TEST_ASSERT_FALSE(controller->isRunning());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, controller->getOutput());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, controller->getIntegral());
+  TEST_ASSERT_EQUAL_UINT32(0, run.starts);
+  TEST_ASSERT_TRUE(run.highest < config.setpoint - config.hysteresis);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_hysteresis_starts_and_stops_the_fan);
+  RUN_TEST(test_rate_limit_bounds_each_step);
+  RUN_TEST(test_non_finite_sample_is_ignored);
+  RUN_TEST(test_invalid_settings_keep_the_previous_ones);
+  RUN_TEST(test_moderate_load_settles_on_the_setpoint);
+  RUN_TEST(test_heat_wave_saturates_then_recovers_without_windup);
+  RUN_TEST(test_light_load_stops_the_fan);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static test_run_t testRun(float heatW, uint32_t durationS)
+{
+  // Explicit Euler at 1 s, the controller runs on every sample and its output is the airflow
+  test_run_t run     = { room, room, 0, 0 };
+  bool       running = controller->isRunning();
+  for (uint32_t second = 1; second <= durationS; second++)
+  {
+    float fan  = controller->getOutput() / 100.0f;
+    float loss = (TEST_ROOM_LOSS + TEST_ROOM_FAN_LOSS * fan) * (room - TEST_ROOM_AMBIENT);
+    room      += (heatW - loss) / TEST_ROOM_CAPACITY;
+    nowS++;
+
+    if (second % TEST_SAMPLE_PERIOD_S == 0)
+    {
+      float speed     = controller->update(room, nowS * 1000UL);
+      run.fullSpeedS += (speed >= config.maxOutput) ? TEST_SAMPLE_PERIOD_S : 0;
+      run.starts     += (!running && controller->isRunning()) ? 1 : 0;
+      running         = controller->isRunning();
+    }
+    if (second + TEST_WINDOW_S == durationS)
+    {
+      run.lowest  = room;
+      run.highest = room;
+    }
+    else if (second + TEST_WINDOW_S > durationS)
+    {
+      run.lowest  = min(run.lowest, room);
+      run.highest = max(run.highest, room);
+    }
+  }
+  return run;
+}
+
+/* End of file -------------------------------------------------------- */
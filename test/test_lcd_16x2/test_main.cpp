@@ -0,0 +1,201 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the LCD 16x2 streaming path, run with `pio test -e native`
+ *
+ * Streaming only packs the expander bytes into fewer I2C transactions, the controller must see the very same
+ * bytes in the same order. Each test records them for the streamed path and for the per-command path, one
+ * transaction per expander write, and compares the two.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "hal_native.h"
+#include "hal_sim_devices.h"
+#include "lcd_16x2.h"
+#include "lcd_16x2_glyphs.h"
+
+#include <unity.h>
+
+#include <functional>
+#include <vector>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_CLOCK_STREAMED  LCD_STREAM_MAX_CLOCK
+#define TEST_CLOCK_PER_WRITE 400000UL // Above LCD_STREAM_MAX_CLOCK, streaming falls back
+
+/* Private enumerate/structure ---------------------------------------- */
+/**
+ * @brief LCD model recording every expander byte and transaction it receives.
+ */
+class RecordingLCD1602 : public SimLCD1602
+{
+public:
+  std::vector<uint8_t> bytes;
+  uint32_t             transactions = 0;
+
+  bool onWrite(const uint8_t *data, size_t len) override
+  {
+    bytes.insert(bytes.end(), data, data + len);
+    transactions++;
+    return SimLCD1602::onWrite(data, len);
+  }
+};
+
+typedef struct
+{
+  std::vector<uint8_t> bytes;
+  uint32_t             transactions;
+  std::string          lines[SIM_LCD1602_ROWS];
+} recording_t;
+
+/* Private variables -------------------------------------------------- */
+static uint8_t arrow[8] = {0x00, 0x04, 0x06, 0x1F, 0x06, 0x04, 0x00, 0x00};
+
+/* Private function prototypes ---------------------------------------- */
+static recording_t record(uint32_t clock, const std::function<void(LCD_I2C &)> &draw);
+static void        assertSameBytes(const recording_t &expected, const recording_t &actual);
+
+/* Test definitions --------------------------------------------------- */
+void setUp() { halSimReset(); }
+
+void tearDown() { halI2CDetach(SIM_LCD1602_I2C_ADDR); }
+
+void test_string_matches_per_character_writes()
+{
+  recording_t streamed = record(TEST_CLOCK_STREAMED, [](LCD_I2C &lcd) {
+    lcd.setCursor(0, 0);
+    lcd.print("Temp: 23.50 *C");
+  });
+  recording_t perChar = record(TEST_CLOCK_STREAMED, [](LCD_I2C &lcd) {
+    lcd.setCursor(0, 0);
+    for (const char *c = "Temp: 23.50 *C"; *c != '\0'; c++)
+    {
+      lcd.write((uint8_t) *c);
+    }
+  });
+
+  assertSameBytes(perChar, streamed);
+  TEST_ASSERT_EQUAL_STRING("Temp: 23.50 *C  ", streamed.lines[0].c_str());
+  // The cursor command goes out on its own, then 14 characters of 4 expander bytes as few Wire buffers
+  TEST_ASSERT_EQUAL_UINT32(4 + 14 * 4, streamed.bytes.size());
+  TEST_ASSERT_EQUAL_UINT32(4 + (14 * 4 + LCD_STREAM_LENGTH - 1) / LCD_STREAM_LENGTH, streamed.transactions);
+  TEST_ASSERT_EQUAL_UINT32(perChar.bytes.size(), perChar.transactions);
+}
+
+void test_custom_char_matches_per_write_path()
+{
+  std::function<void(LCD_I2C &)> draw = [](LCD_I2C &lcd) {
+    lcd.createChar(2, arrow);
+    lcd.setCursor(3, 1);
+    lcd.write((uint8_t) 2);
+  };
+  recording_t streamed = record(TEST_CLOCK_STREAMED, draw);
+  recording_t perWrite = record(TEST_CLOCK_PER_WRITE, draw);
+
+  assertSameBytes(perWrite, streamed);
+  TEST_ASSERT_EQUAL_UINT32(perWrite.bytes.size(), perWrite.transactions);
+  TEST_ASSERT_LESS_THAN(perWrite.transactions, streamed.transactions);
+}
+
+void test_progress_bar_matches_per_write_path()
+{
+  std::function<void(LCD_I2C &)> draw = [](LCD_I2C &lcd) {
+    lcd.progressBar(1, 40);
+    lcd.progressBar(1, 75);
+  };
+  recording_t streamed = record(TEST_CLOCK_STREAMED, draw);
+  recording_t perWrite = record(TEST_CLOCK_PER_WRITE, draw);
+
+  assertSameBytes(perWrite, streamed);
+  TEST_ASSERT_EQUAL_STRING(perWrite.lines[1].c_str(), streamed.lines[1].c_str());
+}
+
+void test_flush_matches_per_write_path()
+{
+  std::function<void(LCD_I2C &)> draw = [](LCD_I2C &lcd) {
+    lcd.setBuffered(true);
+    lcd.clear();
+    lcd.print("Hum: 40.00 %");
+    lcd.setCursor(0, 1);
+    lcd.print("Temp: 21.00 *C");
+    lcd.flush();
+
+    // Only the changed digits go out
+    lcd.setCursor(5, 0);
+    lcd.print("41.25");
+    lcd.flush();
+  };
+  recording_t streamed = record(TEST_CLOCK_STREAMED, draw);
+  recording_t perWrite = record(TEST_CLOCK_PER_WRITE, draw);
+
+  assertSameBytes(perWrite, streamed);
+  TEST_ASSERT_EQUAL_STRING("Hum: 41.25 %    ", streamed.lines[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("Temp: 21.00 *C  ", streamed.lines[1].c_str());
+}
+
+void test_fast_bus_sends_one_transaction_per_write()
+{
+  recording_t perWrite = record(TEST_CLOCK_PER_WRITE, [](LCD_I2C &lcd) {
+    lcd.setCursor(0, 0);
+    lcd.print("400 kHz");
+  });
+
+  TEST_ASSERT_EQUAL_UINT32(perWrite.bytes.size(), perWrite.transactions);
+  TEST_ASSERT_EQUAL_STRING("400 kHz         ", perWrite.lines[0].c_str());
+}
+
+/* Private definitions ------------------------------------------------ */
+static recording_t record(uint32_t clock, const std::function<void(LCD_I2C &)> &draw)
+{
+  RecordingLCD1602 model;
+  LCD_I2C          lcd(SIM_LCD1602_I2C_ADDR, SIM_LCD1602_COLUMNS, SIM_LCD1602_ROWS);
+
+  halI2CDetach(SIM_LCD1602_I2C_ADDR);
+  halI2CAttach(SIM_LCD1602_I2C_ADDR, &model);
+  Wire.begin(-1, -1, clock);
+  lcd.begin(&Wire);
+  lcd.display();
+  lcd.backlight();
+
+  // Only what the drawing sends is compared, the initialization is the same on both paths
+  model.bytes.clear();
+  model.transactions = 0;
+  draw(lcd);
+
+  recording_t result;
+  result.bytes        = model.bytes;
+  result.transactions = model.transactions;
+  for (uint8_t row = 0; row < SIM_LCD1602_ROWS; row++)
+  {
+    result.lines[row] = model.getLine(row);
+  }
+  halI2CDetach(SIM_LCD1602_I2C_ADDR);
+  return result;
+}
+
+static void assertSameBytes(const recording_t &expected, const recording_t &actual)
+{
+  TEST_ASSERT_GREATER_THAN(0, expected.bytes.size());
+  TEST_ASSERT_EQUAL_UINT32(expected.bytes.size(), actual.bytes.size());
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected.bytes.data(), actual.bytes.data(), expected.bytes.size());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_string_matches_per_character_writes);
+  RUN_TEST(test_custom_char_matches_per_write_path);
+  RUN_TEST(test_progress_bar_matches_per_write_path);
+  RUN_TEST(test_flush_matches_per_write_path);
+  RUN_TEST(test_fast_bus_sends_one_transaction_per_write);
+  return UNITY_END();
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,274 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the LCD page engine, run with `pio test -e native`
+ *
+ * The pages are drawn on the `SimLCD1602` model and read back row by row, the I2C statistics tell whether an
+ * `update()` touched the bus. The virtual clock drives the periodic scrolling.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "hal_native.h"
+#include "hal_sim_devices.h"
+#include "lcd_16x2.h"
+#include "lcd_pages.h"
+#include "sensor_snapshot.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_SCROLL_PERIOD_MS 2000
+#define TEST_LCD_PERIOD_MS    250 // DELAY_LCD
+
+/* Private variables -------------------------------------------------- */
+static SimLCD1602          *model;
+static LCD_I2C             *lcd;
+static LcdPages            *pages;
+static SensorSnapshotStore *snapshots;
+
+static float getterValue = NAN;
+
+// A page longer than the display, scrolling every 2 s, and a two-line page
+static const lcd_line_t envLines[] = {
+  { "Temp: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_SHT4X, temperature), LCD_FORMAT_NUMBER, 1, " C",
+    LCD_NO_CHOICES },
+  { "Hum: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_SHT4X, humidity), LCD_FORMAT_NUMBER, 1, " %", LCD_NO_CHOICES },
+  { "Pres: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_BMP280, pressure), LCD_FORMAT_NUMBER, 0, " Pa",
+    LCD_NO_CHOICES },
+  { "Light: ", LCD_BIND_SNAPSHOT(SNAPSHOT_SOURCE_LIGHT, lightPercentage), LCD_FORMAT_NUMBER, 0, " %",
+    LCD_NO_CHOICES },
+};
+static const lcd_page_t envPage = { "env", LCD_PAGE_LINES(envLines), TEST_SCROLL_PERIOD_MS };
+
+static const char *const doorChoices[] = { "closed", "open" };
+static const lcd_line_t  stateLines[]  = {
+  { "Door: ", LCD_BIND_FN([]() { return getterValue; }), LCD_FORMAT_CHOICE, 0, nullptr,
+    LCD_CHOICES(doorChoices) },
+  { "Manual scroll", LCD_BIND_STATIC, LCD_FORMAT_NUMBER, 0, nullptr, LCD_NO_CHOICES },
+  { "Last line", LCD_BIND_STATIC, LCD_FORMAT_NUMBER, 0, nullptr, LCD_NO_CHOICES },
+};
+static const lcd_page_t statePage = { "state", LCD_PAGE_LINES(stateLines), 0 };
+
+/* Private function prototypes ---------------------------------------- */
+static bool        testUpdate(uint32_t now = millis());
+static std::string testRow(uint8_t row);
+static void        testPublishSht(float temperature, float humidity);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  halSimReset();
+  model     = new SimLCD1602();
+  lcd       = new LCD_I2C(SIM_LCD1602_I2C_ADDR, SIM_LCD1602_COLUMNS, SIM_LCD1602_ROWS);
+  pages     = new LcdPages(*lcd);
+  snapshots = new SensorSnapshotStore();
+  halI2CAttach(SIM_LCD1602_I2C_ADDR, model);
+  Wire.begin(-1, -1, 100000UL);
+  lcd->begin(&Wire);
+
+  float bmp[2]   = { 95000.0f, 30.0f };
+  float light[2] = { 1024.0f, 25.0f };
+  testPublishSht(28.4f, 63.0f);
+  snapshots->publish(SNAPSHOT_SOURCE_BMP280, bmp, 2, millis());
+  snapshots->publish(SNAPSHOT_SOURCE_LIGHT, light, 2, millis());
+  pages->addPage(&envPage);
+  pages->addPage(&statePage);
+  getterValue = NAN;
+  halI2CResetStats();
+}
+
+void tearDown()
+{
+  halI2CDetach(SIM_LCD1602_I2C_ADDR);
+  delete pages;
+  delete lcd;
+  delete model;
+  delete snapshots;
+}
+
+void test_first_update_draws_the_first_rows()
+{
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Temp: 28.4 C", testRow(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("Hum: 63.0 %", testRow(1).c_str());
+  TEST_ASSERT_EQUAL_UINT32(1, pages->getRenderCount());
+}
+
+void test_unchanged_values_leave_the_bus_idle()
+{
+  testUpdate();
+  halI2CResetStats();
+  // Every LCD period until just before the first scroll
+  for (uint32_t elapsed = TEST_LCD_PERIOD_MS; elapsed < TEST_SCROLL_PERIOD_MS; elapsed += TEST_LCD_PERIOD_MS)
+  {
+    delay(TEST_LCD_PERIOD_MS);
+    TEST_ASSERT_FALSE(testUpdate());
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, halI2CGetStats().transactions);
+  TEST_ASSERT_EQUAL_UINT32(1, pages->getRenderCount());
+}
+
+void test_redraws_only_at_the_displayed_precision()
+{
+  testUpdate();
+  testPublishSht(28.42f, 63.0f);
+  TEST_ASSERT_FALSE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Temp: 28.4 C", testRow(0).c_str());
+
+  testPublishSht(28.46f, 63.0f);
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Temp: 28.5 C", testRow(0).c_str());
+}
+
+void test_long_page_scrolls_every_period_and_wraps()
+{
+  // The period counts from the `now` of the update that drew, not from the end of the drawing
+  uint32_t drawnAt = millis();
+  testUpdate(drawnAt);
+  TEST_ASSERT_FALSE(testUpdate(drawnAt + TEST_SCROLL_PERIOD_MS - 1));
+
+  // Four lines on two rows: three scroll positions, then back to the top
+  static const char *const expected[][SIM_LCD1602_ROWS] = {
+    { "Hum: 63.0 %", "Pres: 95000 Pa" },
+    { "Pres: 95000 Pa", "Light: 25 %" },
+    { "Temp: 28.4 C", "Hum: 63.0 %" },
+  };
+  for (uint8_t step = 0; step < 3; step++)
+  {
+    TEST_ASSERT_TRUE(testUpdate(drawnAt + (step + 1) * TEST_SCROLL_PERIOD_MS));
+    TEST_ASSERT_EQUAL_UINT8((step + 1) % 3, pages->getScroll());
+    TEST_ASSERT_EQUAL_STRING(expected[step][0], testRow(0).c_str());
+    TEST_ASSERT_EQUAL_STRING(expected[step][1], testRow(1).c_str());
+  }
+}
+
+void test_manual_scroll_wraps_both_ways()
+{
+  pages->next();
+  getterValue = 1.0f;
+  testUpdate();
+  TEST_ASSERT_EQUAL_STRING("Door: open", testRow(0).c_str());
+
+  // No period: the page stays put until asked
+  delay(10 * TEST_SCROLL_PERIOD_MS);
+  TEST_ASSERT_FALSE(testUpdate());
+
+  pages->scroll(-1);
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_UINT8(1, pages->getScroll());
+  TEST_ASSERT_EQUAL_STRING("Manual scroll", testRow(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("Last line", testRow(1).c_str());
+
+  pages->scroll(1);
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_UINT8(0, pages->getScroll());
+}
+
+void test_page_switch_wraps_and_resets_the_scroll()
+{
+  uint32_t drawnAt = millis();
+  testUpdate(drawnAt);
+  testUpdate(drawnAt + TEST_SCROLL_PERIOD_MS);
+  TEST_ASSERT_EQUAL_UINT8(1, pages->getScroll());
+
+  pages->previous();
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_UINT8(1, pages->getPageIndex());
+  TEST_ASSERT_EQUAL_UINT8(0, pages->getScroll());
+
+  pages->next();
+  pages->next();
+  pages->next();
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_UINT8(0, pages->getPageIndex());
+  TEST_ASSERT_EQUAL_STRING("Temp: 28.4 C", testRow(0).c_str());
+}
+
+void test_missing_values_are_drawn_as_dashes()
+{
+  // The getter has nothing to show yet, then a value, then nothing again
+  pages->next();
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: --", testRow(0).c_str());
+
+  getterValue = 0.0f;
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: closed", testRow(0).c_str());
+
+  getterValue = NAN;
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: --", testRow(0).c_str());
+}
+
+void test_choice_out_of_range_is_drawn_as_dashes()
+{
+  // A state without a text in the table is not looked up past its end
+  pages->next();
+  getterValue = 1.0f;
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: open", testRow(0).c_str());
+
+  getterValue = 2.0f;
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: --", testRow(0).c_str());
+
+  getterValue = -1.0f;
+  TEST_ASSERT_TRUE(testUpdate());
+  TEST_ASSERT_EQUAL_STRING("Door: --", testRow(0).c_str());
+}
+
+void test_unpublished_source_is_drawn_as_dashes()
+{
+  sensor_snapshot_t snapshot;
+  snapshots->read(snapshot);
+  snapshot.validMask &= ~(1U << SNAPSHOT_SOURCE_SHT4X);
+  TEST_ASSERT_TRUE(pages->update(snapshot, millis()));
+  TEST_ASSERT_EQUAL_STRING("Temp: --", testRow(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("Hum: --", testRow(1).c_str());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_first_update_draws_the_first_rows);
+  RUN_TEST(test_unchanged_values_leave_the_bus_idle);
+  RUN_TEST(test_redraws_only_at_the_displayed_precision);
+  RUN_TEST(test_long_page_scrolls_every_period_and_wraps);
+  RUN_TEST(test_manual_scroll_wraps_both_ways);
+  RUN_TEST(test_page_switch_wraps_and_resets_the_scroll);
+  RUN_TEST(test_missing_values_are_drawn_as_dashes);
+  RUN_TEST(test_choice_out_of_range_is_drawn_as_dashes);
+  RUN_TEST(test_unpublished_source_is_drawn_as_dashes);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static bool testUpdate(uint32_t now)
+{
+  // Same as one iteration of the LCD task
+  sensor_snapshot_t snapshot;
+  snapshots->read(snapshot);
+  return pages->update(snapshot, now);
+}
+
+static std::string testRow(uint8_t row)
+{
+  std::string line = model->getLine(row);
+  line.erase(line.find_last_not_of(' ') + 1);
+  return line;
+}
+
+static void testPublishSht(float temperature, float humidity)
+{
+  float values[2] = { temperature, humidity };
+  snapshots->publish(SNAPSHOT_SOURCE_SHT4X, values, 2, millis());
+}
+
+/* End of file -------------------------------------------------------- */
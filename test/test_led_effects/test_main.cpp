@@ -0,0 +1,91 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-20
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the LED effects engine, run with `pio test -e native`
+ *
+ * Frames are captured by the show callback, the time of each frame is passed to `render()` explicitly.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "led_effects.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_PIXELS   4
+#define TEST_FRAME_MS 20 // LED_FRAME_MS
+
+/* Private variables -------------------------------------------------- */
+static LedEffects *effects;
+static led_color_t shown[TEST_PIXELS];
+
+/* Private function prototypes ---------------------------------------- */
+static void testShow(const led_color_t *frame, uint16_t count, void *arg);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  effects = new LedEffects();
+  memset(shown, 0, sizeof(shown));
+  effects->begin(TEST_PIXELS, testShow);
+}
+
+void tearDown() { delete effects; }
+
+void test_legacy_on_color_is_shown_unchanged()
+{
+  // LED_ON_COLOR, written as is to the strip before the effects engine
+  effects->solid(LedEffects::fromDisplay(LED_COLOR(255, 102, 0)));
+  TEST_ASSERT_TRUE(effects->render(0));
+  for (uint8_t i = 0; i < TEST_PIXELS; i++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(255, shown[i].r);
+    TEST_ASSERT_EQUAL_UINT8(102, shown[i].g);
+    TEST_ASSERT_EQUAL_UINT8(0, shown[i].b);
+  }
+}
+
+void test_every_display_level_survives_the_gamma()
+{
+  // Not every level exists after the gamma curve, the closest one is shown
+  uint32_t now = 0;
+  for (uint16_t level = 0; level <= 255; level++)
+  {
+    uint8_t value = (uint8_t) level;
+    effects->solid(LedEffects::fromDisplay(LED_COLOR(value, value, value)));
+    effects->render(now += TEST_FRAME_MS);
+    TEST_ASSERT_INT_WITHIN(1, value, shown[0].r);
+  }
+}
+
+void test_static_color_is_shown_once()
+{
+  effects->solid(LedEffects::fromDisplay(LED_COLOR(0, 0, 255)));
+  TEST_ASSERT_TRUE(effects->render(0));
+  TEST_ASSERT_FALSE(effects->isAnimating());
+  TEST_ASSERT_FALSE(effects->render(TEST_FRAME_MS));
+  TEST_ASSERT_EQUAL_UINT32(1, effects->getShowCount());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_legacy_on_color_is_shown_unchanged);
+  RUN_TEST(test_every_display_level_survives_the_gamma);
+  RUN_TEST(test_static_color_is_shown_once);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static void testShow(const led_color_t *frame, uint16_t count, void *arg)
+{
+  memcpy(shown, frame, count * sizeof(led_color_t));
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,199 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the ADC stream and the light sensor pipeline, run with `pio test -e native`
+ *
+ * The continuous ADC model of HAL Native converts the level set with `halAnalogSetInput()` on the virtual
+ * clock and hands the conversions over frame by frame, like the DMA reader task on the board. The triggers
+ * are tested in one-shot mode, where each `read()` is one sample.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "bsp_adc.h"
+#include "hal_native.h"
+#include "light_sensor.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_PIN         1    // LIGHT_SENSOR_PIN
+#define TEST_SAMPLE_RATE 1000 // LIGHT_SENSOR_SAMPLE_RATE
+#define TEST_DECIMATION  20   // LIGHT_SENSOR_DECIMATION
+#define TEST_FRAME       500  // LIGHT_SENSOR_FRAME
+
+/* Private variables -------------------------------------------------- */
+static LightSensor *sensor;
+static uint32_t     frames;
+static size_t       lastFrameLength;
+static int          crossings;
+static bool         lastAbove;
+static uint32_t     legacyCalls;
+
+/* Private function prototypes ---------------------------------------- */
+static void testCountFrame(const uint16_t *samples, size_t count, void *arg);
+static void testRead(uint16_t level);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  halSimReset();
+  halAnalogSetInput(TEST_PIN, 1024);
+  sensor          = new LightSensor(TEST_PIN);
+  frames          = 0;
+  lastFrameLength = 0;
+  crossings       = 0;
+  lastAbove       = false;
+  legacyCalls     = 0;
+}
+
+void tearDown()
+{
+  sensor->endContinuous();
+  bspAdcContinuousEnd();
+  delete sensor;
+}
+
+void test_frame_size_is_bounded()
+{
+  TEST_ASSERT_EQUAL(BSP_ADC_ERR_FRAME,
+                    bspAdcContinuousBegin(TEST_PIN, TEST_SAMPLE_RATE, testCountFrame, NULL, 0));
+  TEST_ASSERT_EQUAL(BSP_ADC_ERR_FRAME, bspAdcContinuousBegin(TEST_PIN, TEST_SAMPLE_RATE, testCountFrame, NULL,
+                                                             BSP_ADC_MAX_FRAME_SAMPLES + 1));
+  TEST_ASSERT_EQUAL(BSP_ADC_OK, bspAdcContinuousBegin(TEST_PIN, TEST_SAMPLE_RATE, testCountFrame, NULL,
+                                                      BSP_ADC_MAX_FRAME_SAMPLES));
+}
+
+void test_reader_wakes_once_per_frame()
+{
+  // 1 kHz in frames of 500: two wake-ups a second instead of about 16 with the default frame
+  TEST_ASSERT_EQUAL(BSP_ADC_OK,
+                    bspAdcContinuousBegin(TEST_PIN, TEST_SAMPLE_RATE, testCountFrame, NULL, TEST_FRAME));
+  delay(10000);
+  TEST_ASSERT_EQUAL_UINT32(20, frames);
+  TEST_ASSERT_EQUAL(TEST_FRAME, lastFrameLength);
+  TEST_ASSERT_EQUAL_UINT32(10000, halAdcContinuousGetConversions());
+}
+
+void test_sensor_filters_each_frame_when_it_completes()
+{
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK, sensor->beginContinuous(TEST_SAMPLE_RATE, TEST_DECIMATION, TEST_FRAME));
+
+  // Nothing until the first frame completes, then the 25 decimated samples of the frame at once
+  delay(TEST_FRAME - 10);
+  TEST_ASSERT_EQUAL_UINT32(0, sensor->getSampleCount());
+  delay(20);
+  TEST_ASSERT_EQUAL_UINT32(TEST_FRAME / TEST_DECIMATION, sensor->getSampleCount());
+  TEST_ASSERT_INT_WITHIN(2, 1024, sensor->getFiltered(LIGHT_FILTER_AVERAGE));
+
+  delay(10000);
+  TEST_ASSERT_EQUAL_UINT32(10500 / TEST_DECIMATION, sensor->getSampleCount());
+}
+
+void test_threshold_callback_reports_both_directions()
+{
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK,
+                    sensor->addThresholdCallback(2000, LIGHT_FILTER_LATEST, [](int value, bool above) {
+                      crossings++;
+                      lastAbove = above;
+                    }));
+
+  // The first sample only sets the side, then one call per crossing
+  testRead(1000);
+  testRead(1500);
+  TEST_ASSERT_EQUAL(0, crossings);
+  testRead(2001);
+  TEST_ASSERT_EQUAL(1, crossings);
+  TEST_ASSERT_TRUE(lastAbove);
+  testRead(3000);
+  TEST_ASSERT_EQUAL(1, crossings);
+  testRead(2000);
+  TEST_ASSERT_EQUAL(2, crossings);
+  TEST_ASSERT_FALSE(lastAbove);
+}
+
+void test_threshold_callback_is_validated()
+{
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_ERR, sensor->addThresholdCallback(2000, LIGHT_FILTER_LATEST, nullptr));
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_ERR,
+                    sensor->addThresholdCallback(-1, LIGHT_FILTER_LATEST, [](int, bool) { crossings++; }));
+}
+
+void test_band_trigger_with_hysteresis_and_hold_off()
+{
+  // The dark trigger of the light task: below 800, back above 900, at most one edge per 2 s
+  light_sensor_trigger_t dark = { LIGHT_TRIGGER_BAND, LIGHT_FILTER_LATEST, 0, 800, 100, 2000 };
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK, sensor->addTrigger(dark, [](int, light_sensor_event_t event, void *) {
+    crossings++;
+    lastAbove = (event == LIGHT_EVENT_LEAVE_BAND);
+  }));
+
+  testRead(2000);
+  testRead(700);
+  TEST_ASSERT_EQUAL(1, crossings);
+  TEST_ASSERT_FALSE(lastAbove);
+
+  // Within the hysteresis nothing happens, past it the hold-off still holds the edge back
+  delay(2500);
+  testRead(850);
+  TEST_ASSERT_EQUAL(1, crossings);
+  testRead(950);
+  TEST_ASSERT_EQUAL(2, crossings);
+  TEST_ASSERT_TRUE(lastAbove);
+  testRead(500);
+  TEST_ASSERT_EQUAL(2, crossings);
+  delay(2500);
+  testRead(500);
+  TEST_ASSERT_EQUAL(3, crossings);
+}
+
+void test_legacy_callback_fires_on_each_rise()
+{
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK, sensor->onThresholdCross(2000, []() { legacyCalls++; }));
+  testRead(3000);
+  TEST_ASSERT_EQUAL_UINT32(0, legacyCalls);
+  testRead(1000);
+  testRead(3000);
+  testRead(3500);
+  TEST_ASSERT_EQUAL_UINT32(1, legacyCalls);
+
+  // Replacing the threshold keeps one slot and starts over from the next sample
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK, sensor->onThresholdCross(3800, []() { legacyCalls += 10; }));
+  testRead(3500);
+  testRead(3900);
+  TEST_ASSERT_EQUAL_UINT32(11, legacyCalls);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_size_is_bounded);
+  RUN_TEST(test_reader_wakes_once_per_frame);
+  RUN_TEST(test_sensor_filters_each_frame_when_it_completes);
+  RUN_TEST(test_threshold_callback_reports_both_directions);
+  RUN_TEST(test_threshold_callback_is_validated);
+  RUN_TEST(test_band_trigger_with_hysteresis_and_hold_off);
+  RUN_TEST(test_legacy_callback_fires_on_each_rise);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static void testCountFrame(const uint16_t *samples, size_t count, void *arg)
+{
+  frames++;
+  lastFrameLength = count;
+}
+
+static void testRead(uint16_t level)
+{
+  // One-shot mode: each read() is one sample through the filters and the triggers
+  halAnalogSetInput(TEST_PIN, level);
+  TEST_ASSERT_EQUAL(LIGHT_SENSOR_OK, sensor->read());
+}
+
+/* End of file -------------------------------------------------------- */
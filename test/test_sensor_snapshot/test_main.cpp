@@ -0,0 +1,193 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the Sensor Snapshot library, run with `pio test -e native`
+ *
+ * One writer thread per source publishes generation after generation while reader threads copy the store.
+ * Every field of a sample is derived from its generation, so a torn read shows up as fields that disagree.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "sensor_snapshot.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_PUBLISHES_PER_WRITER 200000
+#define TEST_READERS              3
+
+/* Private enumerate/structure ---------------------------------------- */
+typedef struct
+{
+  uint32_t reads;    // Coherent copies checked
+  uint32_t skipped;  // Sources given up after too many retries
+  uint32_t torn;     // Copies whose fields come from different generations
+  uint32_t backward; // Generations older than one already seen by the same reader
+} reader_result_t;
+
+/* Private variables -------------------------------------------------- */
+static SensorSnapshotStore *store;
+
+/* Private function prototypes ---------------------------------------- */
+static void publishGeneration(snapshot_source_t source, uint32_t generation);
+static bool isCoherent(float first, float second, float third, uint32_t timestamp, uint32_t count);
+
+/* Test definitions --------------------------------------------------- */
+void setUp() { store = new SensorSnapshotStore(); }
+
+void tearDown() { delete store; }
+
+void test_empty_store_is_not_valid()
+{
+  sensor_snapshot_t snapshot;
+  float             values[SNAPSHOT_MAX_FIELDS];
+
+  TEST_ASSERT_EQUAL_UINT32(0, store->read(snapshot));
+  TEST_ASSERT_EQUAL_UINT8(0, snapshot.validMask);
+  TEST_ASSERT_FALSE(store->readSource(SNAPSHOT_SOURCE_SHT4X, values));
+}
+
+void test_publish_is_read_back()
+{
+  const float values[] = {21.5f, 40.0f};
+  TEST_ASSERT_EQUAL(SNAPSHOT_OK, store->publish(SNAPSHOT_SOURCE_SHT4X, values, 2, 1234));
+  TEST_ASSERT_EQUAL(SNAPSHOT_ERR_INVALID_ARG, store->publish(SNAPSHOT_SOURCE_COUNT, values, 2, 0));
+  TEST_ASSERT_EQUAL(SNAPSHOT_ERR_INVALID_ARG,
+                    store->publish(SNAPSHOT_SOURCE_SHT4X, values, SNAPSHOT_MAX_FIELDS + 1, 0));
+
+  sensor_snapshot_t snapshot;
+  TEST_ASSERT_EQUAL_UINT32(1, store->read(snapshot));
+  TEST_ASSERT_TRUE(SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_SHT4X));
+  TEST_ASSERT_FALSE(SNAPSHOT_IS_VALID(snapshot, SNAPSHOT_SOURCE_BMP280));
+  TEST_ASSERT_EQUAL_FLOAT(21.5f, snapshot.temperature);
+  TEST_ASSERT_EQUAL_FLOAT(40.0f, snapshot.humidity);
+  TEST_ASSERT_EQUAL_UINT32(1234, snapshot.updatedAt[SNAPSHOT_SOURCE_SHT4X]);
+  TEST_ASSERT_EQUAL_UINT32(1, snapshot.sampleCount[SNAPSHOT_SOURCE_SHT4X]);
+}
+
+void test_concurrent_readers_never_see_torn_samples()
+{
+  const snapshot_source_t sources[] = {SNAPSHOT_SOURCE_SHT4X, SNAPSHOT_SOURCE_BMP280};
+  std::atomic<bool>       writing(true);
+  std::vector<std::thread> writers;
+  std::vector<std::thread> readers;
+  reader_result_t          results[TEST_READERS] = {};
+
+  for (snapshot_source_t source : sources)
+  {
+    writers.emplace_back([source]() {
+      for (uint32_t generation = 1; generation <= TEST_PUBLISHES_PER_WRITER; generation++)
+      {
+        publishGeneration(source, generation);
+      }
+    });
+  }
+
+  for (uint8_t r = 0; r < TEST_READERS; r++)
+  {
+    readers.emplace_back([&writing, &sources, &results, r]() {
+      reader_result_t &result = results[r];
+      uint32_t         last[SNAPSHOT_SOURCE_COUNT] = {};
+
+      while (writing.load())
+      {
+        // Odd readers copy the whole store, even readers one source at a time
+        for (snapshot_source_t source : sources)
+        {
+          float    values[SNAPSHOT_MAX_FIELDS];
+          uint32_t timestamp = 0;
+          uint32_t count     = 0;
+          bool     valid;
+
+          if (r & 1U)
+          {
+            sensor_snapshot_t snapshot;
+            store->read(snapshot);
+            valid     = SNAPSHOT_IS_VALID(snapshot, source);
+            values[0] = (source == SNAPSHOT_SOURCE_SHT4X) ? snapshot.temperature : snapshot.pressure;
+            values[1] = (source == SNAPSHOT_SOURCE_SHT4X) ? snapshot.humidity : snapshot.bmpTemperature;
+            // No third field in the snapshot, the check on it is left to readSource()
+            values[2] = -2.0f * values[0];
+            timestamp = snapshot.updatedAt[source];
+            count     = snapshot.sampleCount[source];
+          }
+          else
+          {
+            valid = store->readSource(source, values, &timestamp);
+            count = timestamp;
+          }
+
+          if (!valid)
+          {
+            // Before the first publish, or skipped after overlapping too many publishes
+            result.skipped += (last[source] > 0) ? 1 : 0;
+            continue;
+          }
+          result.reads++;
+          result.torn += isCoherent(values[0], values[1], values[2], timestamp, count) ? 0 : 1;
+          result.backward += (timestamp < last[source]) ? 1 : 0;
+          last[source] = timestamp;
+        }
+      }
+    });
+  }
+
+  for (std::thread &writer : writers)
+  {
+    writer.join();
+  }
+  writing.store(false);
+  for (std::thread &reader : readers)
+  {
+    reader.join();
+  }
+
+  uint32_t reads = 0;
+  for (uint8_t r = 0; r < TEST_READERS; r++)
+  {
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, results[r].torn, "Torn read");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, results[r].backward, "Generation went backwards");
+    reads += results[r].reads;
+  }
+  TEST_ASSERT_GREATER_THAN_UINT32(0, reads);
+
+  // Every publish landed, and the final state is the last generation of each writer
+  sensor_snapshot_t snapshot;
+  TEST_ASSERT_EQUAL_UINT32(2 * TEST_PUBLISHES_PER_WRITER, store->read(snapshot));
+  TEST_ASSERT_EQUAL_UINT32(TEST_PUBLISHES_PER_WRITER, snapshot.sampleCount[SNAPSHOT_SOURCE_SHT4X]);
+  TEST_ASSERT_EQUAL_FLOAT((float) TEST_PUBLISHES_PER_WRITER, snapshot.pressure);
+}
+
+/* Private definitions ------------------------------------------------ */
+// Generation g publishes {g, -g, -2g} with timestamp g, the sample count then also equals g
+static void publishGeneration(snapshot_source_t source, uint32_t generation)
+{
+  const float values[SNAPSHOT_MAX_FIELDS] = {(float) generation, -(float) generation, -2.0f * generation};
+  store->publish(source, values, SNAPSHOT_MAX_FIELDS, generation);
+}
+
+static bool isCoherent(float first, float second, float third, uint32_t timestamp, uint32_t count)
+{
+  return first == (float) timestamp && second == -first && third == -2.0f * first && count == timestamp;
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_store_is_not_valid);
+  RUN_TEST(test_publish_is_read_back);
+  RUN_TEST(test_concurrent_readers_never_see_torn_samples);
+  return UNITY_END();
+}
+
+/* End of file -------------------------------------------------------- */
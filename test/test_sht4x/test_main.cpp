@@ -0,0 +1,198 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the SHT4x non-blocking state machine, run with `pio test -e native`
+ *
+ * The virtual clock of HAL Native stands in for `millis()` and the `SimSHT4X` model for the sensor, so each
+ * test steps through a conversion deadline to the millisecond and checks every byte put on the bus.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "hal_native.h"
+#include "hal_sim_devices.h"
+#include "sht4x.h"
+
+#include <unity.h>
+
+/* Private enumerate/structure ---------------------------------------- */
+/**
+ * @brief Sensor model whose responses get a corrupted CRC on demand.
+ */
+class CorruptingSHT4X : public SimSHT4X
+{
+public:
+  bool corrupt = false;
+
+  size_t onRead(uint8_t *data, size_t len) override
+  {
+    size_t count = SimSHT4X::onRead(data, len);
+    if (corrupt && count == len && len >= 3)
+    {
+      data[2] ^= 0xFF;
+    }
+    return count;
+  }
+};
+
+/* Private variables -------------------------------------------------- */
+static CorruptingSHT4X *model;
+static SHT4X           *sensor;
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  halSimReset();
+  model  = new CorruptingSHT4X();
+  sensor = new SHT4X();
+  halI2CAttach(SHT40_I2C_ADDR_44, model);
+  Wire.begin(-1, -1, 100000UL);
+  halI2CResetStats();
+}
+
+void tearDown()
+{
+  halI2CDetach(SHT40_I2C_ADDR_44);
+  delete sensor;
+  delete model;
+}
+
+void test_start_sends_the_command_byte_only()
+{
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+
+  hal_i2c_stats_t stats = halI2CGetStats();
+  TEST_ASSERT_EQUAL_UINT32(1, stats.transactions);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.bytesWritten);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.nacks);
+  TEST_ASSERT_EQUAL_UINT32(1, model->getMeasurementCount());
+  TEST_ASSERT_EQUAL(SHT4X_STATE_MEASURING, sensor->poll());
+}
+
+void test_poll_follows_the_conversion_deadline()
+{
+  TEST_ASSERT_EQUAL(SHT4X_STATE_IDLE, sensor->poll());
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL_UINT32(9, sensor->getRemainingTime());
+
+  halSimAdvance(8);
+  TEST_ASSERT_EQUAL(SHT4X_STATE_MEASURING, sensor->poll());
+  TEST_ASSERT_EQUAL_UINT32(1, sensor->getRemainingTime());
+
+  halSimAdvance(1);
+  TEST_ASSERT_EQUAL(SHT4X_STATE_READY, sensor->poll());
+  TEST_ASSERT_EQUAL_UINT32(0, sensor->getRemainingTime());
+
+  // Polling never touches the bus
+  TEST_ASSERT_EQUAL_UINT32(1, halI2CGetStats().transactions);
+}
+
+void test_calls_out_of_order_are_refused()
+{
+  TEST_ASSERT_EQUAL(SHT4X_ERR, sensor->fetch());
+
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL(SHT4X_BUSY, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL(SHT4X_BUSY, sensor->fetch());
+  TEST_ASSERT_EQUAL_UINT32(1, model->getMeasurementCount());
+}
+
+void test_fetch_decodes_and_returns_to_idle()
+{
+  model->setTemperature(23.5f);
+  model->setHumidity(61.0f);
+
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  halSimAdvance(sensor->getRemainingTime());
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->fetch());
+
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.5f, sensor->getTemperature());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 61.0f, sensor->getHumidity());
+  TEST_ASSERT_EQUAL(SHT4X_STATE_IDLE, sensor->poll());
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+}
+
+void test_heater_modes_wait_longer()
+{
+  sensor->setHeater(SHT4X_HIGH_HEATER_100MS);
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL_UINT32(110, sensor->getRemainingTime());
+
+  halSimAdvance(109);
+  TEST_ASSERT_EQUAL(SHT4X_BUSY, sensor->fetch());
+  halSimAdvance(1);
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->fetch());
+}
+
+void test_precision_sets_the_deadline()
+{
+  sensor->setPrecision(SHT4X_LOW_PRECISION);
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL_UINT32(2, sensor->getRemainingTime());
+  halSimAdvance(2);
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->fetch());
+}
+
+void test_deadline_survives_millis_rollover()
+{
+  // Park the clock 4 ms before millis() wraps, the 9 ms conversion ends after it
+  halSimAdvanceMicros((uint64_t) (UINT32_MAX - 3) * 1000U);
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+
+  halSimAdvance(8);
+  TEST_ASSERT_EQUAL(SHT4X_STATE_MEASURING, sensor->poll());
+  halSimAdvance(1);
+  TEST_ASSERT_EQUAL(SHT4X_STATE_READY, sensor->poll());
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->fetch());
+}
+
+void test_missing_sensor_reports_i2c_error()
+{
+  halI2CDetach(SHT40_I2C_ADDR_44);
+
+  TEST_ASSERT_EQUAL(SHT4X_ERR_I2C, sensor->begin());
+  TEST_ASSERT_EQUAL(SHT4X_ERR_I2C, sensor->startMeasurement());
+  TEST_ASSERT_EQUAL(SHT4X_STATE_IDLE, sensor->poll());
+}
+
+void test_corrupted_frame_reports_checksum_error()
+{
+  model->corrupt = true;
+
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->startMeasurement());
+  halSimAdvance(sensor->getRemainingTime());
+  TEST_ASSERT_EQUAL(SHT4X_ERR_CHECKSUM, sensor->fetch());
+  TEST_ASSERT_EQUAL(SHT4X_STATE_IDLE, sensor->poll());
+}
+
+void test_update_blocks_through_the_conversion()
+{
+  uint32_t start = millis();
+  TEST_ASSERT_EQUAL(SHT4X_OK, sensor->update());
+  TEST_ASSERT_EQUAL_UINT32(9, millis() - start);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, sensor->getTemperature());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_start_sends_the_command_byte_only);
+  RUN_TEST(test_poll_follows_the_conversion_deadline);
+  RUN_TEST(test_calls_out_of_order_are_refused);
+  RUN_TEST(test_fetch_decodes_and_returns_to_idle);
+  RUN_TEST(test_heater_modes_wait_longer);
+  RUN_TEST(test_precision_sets_the_deadline);
+  RUN_TEST(test_deadline_survives_millis_rollover);
+  RUN_TEST(test_missing_sensor_reports_i2c_error);
+  RUN_TEST(test_corrupted_frame_reports_checksum_error);
+  RUN_TEST(test_update_blocks_through_the_conversion);
+  return UNITY_END();
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,189 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-22
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the batched telemetry message, run with `pio test -e native`
+ *
+ * The messages are serialized and compared with the JSON ThingsBoard expects, the series sizes are the ones
+ * `drainTelemetryRing()` builds: up to `TELEMETRY_BATCH_MAX_ENTRIES` samples of the five telemetry keys.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "telemetry_batch.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_KEY_COUNT 5 // TELEMETRY_KEY_COUNT
+#define TEST_JSON_SIZE 512
+#define TEST_EPOCH_MS  1750000000000ULL
+#define TEST_PERIOD_MS 30000ULL
+
+/* Private variables -------------------------------------------------- */
+static TelemetryBatch *batch;
+static char            json[TEST_JSON_SIZE];
+
+static const char *const keys[TEST_KEY_COUNT] = { "temperature", "humidity", "pressure", "altitude",
+                                                  "illuminance" };
+
+// Names of the keys of a full flat message, stored by pointer so they must outlive the batch
+static const char *const manyKeys[TELEMETRY_BATCH_MAX_KEYS + 1] = {
+  "k0",  "k1",  "k2",  "k3",  "k4",  "k5",  "k6",  "k7",  "k8",  "k9",  "k10", "k11", "k12",
+  "k13", "k14", "k15", "k16", "k17", "k18", "k19", "k20", "k21", "k22", "k23", "k24",
+};
+
+/* Private function prototypes ---------------------------------------- */
+static const char *testSerialize();
+static void        testAddSample(float base);
+
+/* Test definitions --------------------------------------------------- */
+void setUp() { batch = new TelemetryBatch(); }
+
+void tearDown() { delete batch; }
+
+void test_flat_message_shape()
+{
+  batch->begin();
+  TEST_ASSERT_TRUE(batch->isEmpty());
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("temperature", 21.5f));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("fanSpeed", 40));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("doorOpened", true));
+
+  TEST_ASSERT_EQUAL_STRING("{\"temperature\":21.5,\"fanSpeed\":40,\"doorOpened\":true}", testSerialize());
+  TEST_ASSERT_EQUAL(strlen(json), batch->measure());
+  TEST_ASSERT_EQUAL_UINT8(3, batch->getCount());
+  TEST_ASSERT_EQUAL_UINT8(0, batch->getEntryCount());
+  TEST_ASSERT_TRUE(batch->getTimestamp() == 0);
+}
+
+void test_timestamped_message_shape()
+{
+  batch->begin(TEST_EPOCH_MS);
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("humidity", 55.25f));
+
+  TEST_ASSERT_EQUAL_STRING("{\"ts\":1750000000000,\"values\":{\"humidity\":55.25}}", testSerialize());
+  TEST_ASSERT_EQUAL(strlen(json), batch->measure());
+  TEST_ASSERT_TRUE(batch->getTimestamp() == TEST_EPOCH_MS);
+
+  // begin() starts over with the flat shape
+  batch->begin();
+  TEST_ASSERT_TRUE(batch->isEmpty());
+  TEST_ASSERT_EQUAL_STRING("{}", testSerialize());
+}
+
+void test_series_message_shape()
+{
+  batch->beginSeries();
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->addEntry(TEST_EPOCH_MS));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("temperature", 21.5f));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->addEntry(TEST_EPOCH_MS + TEST_PERIOD_MS));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("temperature", 22.0f));
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add("humidity", 50.0f));
+
+  TEST_ASSERT_EQUAL_STRING("[{\"ts\":1750000000000,\"values\":{\"temperature\":21.5}},"
+                           "{\"ts\":1750000030000,\"values\":{\"temperature\":22,\"humidity\":50}}]",
+                           testSerialize());
+  TEST_ASSERT_EQUAL(strlen(json), batch->measure());
+  TEST_ASSERT_EQUAL_UINT8(2, batch->getEntryCount());
+  TEST_ASSERT_EQUAL_UINT8(3, batch->getCount());
+}
+
+void test_full_series_fits_the_pool()
+{
+  // The largest message of the drain: every entry with every key
+  batch->beginSeries();
+  for (uint8_t entry = 0; entry < TELEMETRY_BATCH_MAX_ENTRIES; entry++)
+  {
+    TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->addEntry(TEST_EPOCH_MS + entry * TEST_PERIOD_MS));
+    testAddSample(10.0f * entry);
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_BATCH_MAX_ENTRIES, batch->getEntryCount());
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_BATCH_MAX_ENTRIES * TEST_KEY_COUNT, batch->getCount());
+  TEST_ASSERT_FALSE(batch->isOverflowed());
+
+  // Every entry made it in full, nothing was dropped by the pool
+  JsonArrayConst entries = batch->getJson().as<JsonArrayConst>();
+  TEST_ASSERT_EQUAL(TELEMETRY_BATCH_MAX_ENTRIES, entries.size());
+  for (JsonObjectConst entry : entries)
+  {
+    TEST_ASSERT_EQUAL(TEST_KEY_COUNT, entry["values"].as<JsonObjectConst>().size());
+  }
+  TEST_ASSERT_TRUE(testSerialize()[0] == '[');
+  TEST_ASSERT_EQUAL(strlen(json), batch->measure());
+
+  // One more entry does not fit the message
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_FULL, batch->addEntry(TEST_EPOCH_MS + 10 * TEST_PERIOD_MS));
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_BATCH_MAX_ENTRIES, batch->getEntryCount());
+  TEST_ASSERT_FALSE(batch->isOverflowed());
+}
+
+void test_add_entry_edge_cases()
+{
+  // Not a series
+  batch->begin();
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR, batch->addEntry(TEST_EPOCH_MS));
+  batch->begin(TEST_EPOCH_MS);
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR, batch->addEntry(TEST_EPOCH_MS));
+
+  // A series takes keys only once an entry is started
+  batch->beginSeries();
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR, batch->add("temperature", 21.5f));
+  TEST_ASSERT_TRUE(batch->isEmpty());
+  TEST_ASSERT_EQUAL_STRING("[]", testSerialize());
+}
+
+void test_add_edge_cases()
+{
+  batch->begin();
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, batch->add(nullptr, 1.0f));
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, batch->add(nullptr, 1));
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, batch->add("temperature", NAN));
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, batch->add("temperature", INFINITY));
+  TEST_ASSERT_TRUE(batch->isEmpty());
+
+  // TELEMETRY_BATCH_MAX_KEYS keys, the next one is refused and the message is left as it was
+  for (uint8_t i = 0; i < TELEMETRY_BATCH_MAX_KEYS; i++)
+  {
+    TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add(manyKeys[i], (int) i));
+  }
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_FULL, batch->add(manyKeys[TELEMETRY_BATCH_MAX_KEYS], 1.0f));
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_BATCH_MAX_KEYS, batch->getCount());
+  TEST_ASSERT_EQUAL(TELEMETRY_BATCH_MAX_KEYS, batch->getJson().as<JsonObjectConst>().size());
+  TEST_ASSERT_TRUE(batch->getJson()[manyKeys[TELEMETRY_BATCH_MAX_KEYS]].isNull());
+  TEST_ASSERT_FALSE(batch->isOverflowed());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_flat_message_shape);
+  RUN_TEST(test_timestamped_message_shape);
+  RUN_TEST(test_series_message_shape);
+  RUN_TEST(test_full_series_fits_the_pool);
+  RUN_TEST(test_add_entry_edge_cases);
+  RUN_TEST(test_add_edge_cases);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static const char *testSerialize()
+{
+  serializeJson(batch->getJson(), json, sizeof(json));
+  return json;
+}
+
+static void testAddSample(float base)
+{
+  for (uint8_t key = 0; key < TEST_KEY_COUNT; key++)
+  {
+    TEST_ASSERT_EQUAL(TELEMETRY_OK, batch->add(keys[key], base + key));
+  }
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,252 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-02
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the telemetry deadband filter, run with `pio test -e native`
+ *
+ * Each test feeds values with explicit timestamps, polled every `TELEMETRY_POLL_MS` with a cycle every
+ * `telemetrySendInterval`, and checks the reason `check()` gives for sending or suppressing them.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "attribute_registry.h"
+#include "telemetry_filter.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_POLL_MS  1000  // TELEMETRY_POLL_MS
+#define TEST_CYCLE_MS 30000 // telemetrySendInterval
+
+#define TEST_KEY_TEMPERATURE 0
+#define TEST_KEY_HUMIDITY    1
+
+/* Private variables -------------------------------------------------- */
+// Temperature as in TELEMETRY_POLICIES, the second key without deadband, excursion or silence
+static const telemetry_policy_t policies[] = {
+  { 0.2f, 1.0f, 300000UL },
+  { 0.0f, 0.0f, 0 },
+};
+
+static TelemetryFilter *filter;
+
+/* Private function prototypes ---------------------------------------- */
+static telemetry_send_reason_t testOffer(uint8_t key, float value, uint32_t nowMs, bool cycle);
+static bool                    testSetPolicy(const attr_value_t &value, void *context);
+
+/* Test definitions --------------------------------------------------- */
+void setUp() { filter = new TelemetryFilter(policies, 2); }
+
+void tearDown() { delete filter; }
+
+void test_first_value_is_always_sent()
+{
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_FIRST, testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, false));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_TEMPERATURE, 24.0f, TEST_CYCLE_MS, true));
+
+  filter->reset();
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_FIRST, testOffer(TEST_KEY_TEMPERATURE, 24.0f, 2 * TEST_CYCLE_MS, true));
+}
+
+void test_deadband_suppresses_small_changes_at_a_cycle()
+{
+  testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, true);
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_TEMPERATURE, 24.125f, TEST_CYCLE_MS, true));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_TEMPERATURE, 23.875f, 2 * TEST_CYCLE_MS, true));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_DEADBAND,
+                    testOffer(TEST_KEY_TEMPERATURE, 24.25f, 3 * TEST_CYCLE_MS, true));
+  TEST_ASSERT_EQUAL_UINT32(2, filter->getSentCount());
+  TEST_ASSERT_EQUAL_UINT32(2, filter->getSuppressedCount());
+}
+
+void test_deadband_change_waits_for_the_cycle()
+{
+  testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, true);
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_TEMPERATURE, 24.5f, TEST_POLL_MS, false));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_DEADBAND, testOffer(TEST_KEY_TEMPERATURE, 24.5f, TEST_CYCLE_MS, true));
+}
+
+void test_slow_drift_is_measured_from_the_last_value_sent()
+{
+  // 0.0625 °C per cycle never moves past the deadband from one cycle to the next, it adds up
+  testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, true);
+  uint8_t cycle = 1;
+  for (; cycle <= 10; cycle++)
+  {
+    if (testOffer(TEST_KEY_TEMPERATURE, 24.0f + 0.0625f * cycle, cycle * TEST_CYCLE_MS, true) !=
+        TELEMETRY_SEND_NONE)
+    {
+      break;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT8(4, cycle);
+}
+
+void test_excursion_is_sent_between_cycles()
+{
+  testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, true);
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_TEMPERATURE, 23.5f, TEST_POLL_MS, false));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_EXCURSION,
+                    testOffer(TEST_KEY_TEMPERATURE, 23.0f, 2 * TEST_POLL_MS, false));
+}
+
+void test_max_silence_sends_an_unchanged_value()
+{
+  testOffer(TEST_KEY_TEMPERATURE, 24.0f, 0, true);
+  uint32_t sentAt = 0;
+  for (uint32_t t = TEST_CYCLE_MS; t <= 600000UL && sentAt == 0; t += TEST_CYCLE_MS)
+  {
+    if (testOffer(TEST_KEY_TEMPERATURE, 24.0f, t, true) == TELEMETRY_SEND_SILENCE)
+    {
+      sentAt = t;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(300000UL, sentAt);
+}
+
+void test_zero_deadband_sends_every_cycle()
+{
+  testOffer(TEST_KEY_HUMIDITY, 50.0f, 0, true);
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, testOffer(TEST_KEY_HUMIDITY, 50.0f, TEST_POLL_MS, false));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_DEADBAND, testOffer(TEST_KEY_HUMIDITY, 50.0f, TEST_CYCLE_MS, true));
+}
+
+void test_non_finite_value_and_unknown_key_are_never_sent()
+{
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, filter->check(TEST_KEY_TEMPERATURE, NAN, 0, true));
+  TEST_ASSERT_EQUAL(TELEMETRY_SEND_NONE, filter->check(2, 24.0f, 0, true));
+}
+
+void test_stable_room_hour_suppresses_most_cycles()
+{
+  // A stable room slowly drifting with a little noise, an open window drops it 3 °C at 40 min
+  uint32_t cycles = 0, cycleSends = 0, excursionAt = 0;
+  for (uint32_t t = 0; t < 3600000UL; t += TEST_POLL_MS)
+  {
+    float room  = 24.0f + 0.0001f * (t / 1000) + ((t / 1000) % 7 == 0 ? 0.05f : 0.0f);
+    room       -= (t >= 2400000UL) ? 3.0f * min(t - 2400000UL, 20000UL) / 20000.0f : 0.0f;
+    bool cycle  = (t % TEST_CYCLE_MS) == 0;
+    cycles     += cycle ? 1 : 0;
+
+    telemetry_send_reason_t reason = testOffer(TEST_KEY_TEMPERATURE, room, t, cycle);
+    cycleSends += (cycle && reason != TELEMETRY_SEND_NONE) ? 1 : 0;
+    if (reason == TELEMETRY_SEND_EXCURSION && excursionAt == 0)
+    {
+      excursionAt = t;
+    }
+  }
+
+  // Every cycle either sends or is counted as suppressed, and few of them send
+  TEST_ASSERT_EQUAL_UINT32(120, cycles);
+  TEST_ASSERT_EQUAL_UINT32(cycles, cycleSends + filter->getSuppressedCount());
+  TEST_ASSERT_TRUE(filter->getSentCount() <= cycles / 4);
+  // The window is reported within seconds, not at the next cycle
+  TEST_ASSERT_TRUE(excursionAt > 2400000UL && excursionAt - 2400000UL < 10000UL);
+}
+
+void test_policy_from_json_keeps_missing_members()
+{
+  StaticJsonDocument<128> document;
+  telemetry_policy_t      policy = policies[TEST_KEY_TEMPERATURE];
+  deserializeJson(document, "{\"deadband\":0.5,\"maxSilence\":600}");
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, telemetryPolicyFromJson(document.as<JsonObjectConst>(), policy));
+  TEST_ASSERT_EQUAL_FLOAT(0.5f, policy.deadband);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, policy.excursion);
+  TEST_ASSERT_EQUAL_UINT32(600000UL, policy.maxSilenceMs);
+  TEST_ASSERT_EQUAL(TELEMETRY_OK, filter->setPolicy(TEST_KEY_TEMPERATURE, policy));
+}
+
+void test_policy_from_json_rejects_bad_values()
+{
+  static const char *const updates[] = {
+    "{\"excursion\":0.1}",     // Inside the deadband
+    "{\"deadband\":\"high\"}", // Wrong type
+    "{\"deadband\":-1}",       // Negative
+    "{\"maxSilence\":100000}", // Above one day
+  };
+  for (size_t i = 0; i < sizeof(updates) / sizeof(updates[0]); i++)
+  {
+    StaticJsonDocument<128> document;
+    telemetry_policy_t      policy = policies[TEST_KEY_TEMPERATURE];
+    deserializeJson(document, updates[i]);
+    TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG,
+                      telemetryPolicyFromJson(document.as<JsonObjectConst>(), policy));
+    TEST_ASSERT_EQUAL_FLOAT(policies[TEST_KEY_TEMPERATURE].deadband, policy.deadband);
+    TEST_ASSERT_EQUAL_FLOAT(policies[TEST_KEY_TEMPERATURE].excursion, policy.excursion);
+  }
+
+  telemetry_policy_t invalid = { 0.5f, 0.1f, 0 };
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, filter->setPolicy(TEST_KEY_TEMPERATURE, invalid));
+  TEST_ASSERT_EQUAL(TELEMETRY_ERR_INVALID_ARG, filter->setPolicy(2, policies[0]));
+}
+
+void test_policy_update_through_a_shared_attribute()
+{
+  // Same path as the shared attribute of the firmware: the registry hands the object to the filter
+  static constexpr attr_handler_t handlers[] = {
+    ATTR_HANDLER("temperaturePolicy", ATTR_TYPE_OBJECT, 0, 0, testSetPolicy),
+  };
+  AttributeRegistry       attributes(handlers, ATTR_HANDLER_COUNT(handlers));
+  StaticJsonDocument<256> update;
+  deserializeJson(update, "{\"temperaturePolicy\":{\"deadband\":0.5,\"maxSilence\":600}}");
+  TEST_ASSERT_EQUAL_UINT8(1, attributes.apply(update.as<JsonObjectConst>(), filter));
+  deserializeJson(update, "{\"temperaturePolicy\":{\"excursion\":0.1}}");
+  TEST_ASSERT_EQUAL_UINT8(0, attributes.apply(update.as<JsonObjectConst>(), filter));
+  TEST_ASSERT_EQUAL_UINT32(1, attributes.getRejectedCount());
+
+  telemetry_policy_t policy;
+  filter->getPolicy(TEST_KEY_TEMPERATURE, policy);
+  TEST_ASSERT_EQUAL_FLOAT(0.5f, policy.deadband);
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, policy.excursion);
+  TEST_ASSERT_EQUAL_UINT32(600000UL, policy.maxSilenceMs);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_first_value_is_always_sent);
+  RUN_TEST(test_deadband_suppresses_small_changes_at_a_cycle);
+  RUN_TEST(test_deadband_change_waits_for_the_cycle);
+  RUN_TEST(test_slow_drift_is_measured_from_the_last_value_sent);
+  RUN_TEST(test_excursion_is_sent_between_cycles);
+  RUN_TEST(test_max_silence_sends_an_unchanged_value);
+  RUN_TEST(test_zero_deadband_sends_every_cycle);
+  RUN_TEST(test_non_finite_value_and_unknown_key_are_never_sent);
+  RUN_TEST(test_stable_room_hour_suppresses_most_cycles);
+  RUN_TEST(test_policy_from_json_keeps_missing_members);
+  RUN_TEST(test_policy_from_json_rejects_bad_values);
+  RUN_TEST(test_policy_update_through_a_shared_attribute);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static telemetry_send_reason_t testOffer(uint8_t key, float value, uint32_t nowMs, bool cycle)
+{
+  // What the telemetry task does with each value it polls
+  telemetry_send_reason_t reason = filter->check(key, value, nowMs, cycle);
+  if (reason != TELEMETRY_SEND_NONE)
+  {
+    filter->markSent(key, value, nowMs);
+  }
+  else if (cycle)
+  {
+    filter->markSuppressed(key);
+  }
+  return reason;
+}
+
+static bool testSetPolicy(const attr_value_t &value, void *context)
+{
+  TelemetryFilter   *target = (TelemetryFilter *) context;
+  telemetry_policy_t policy;
+  target->getPolicy(TEST_KEY_TEMPERATURE, policy);
+  return telemetryPolicyFromJson(value.o->as<JsonObjectConst>(), policy) == TELEMETRY_OK &&
+         target->setPolicy(TEST_KEY_TEMPERATURE, policy) == TELEMETRY_OK;
+}
+
+/* End of file -------------------------------------------------------- */
@@ -0,0 +1,210 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-22
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the store-and-forward telemetry ring, run with `pio test -e native`
+ *
+ * The peek/drop/discard contract is the one `drainTelemetryRing()` relies on: a batch is only removed once
+ * it was published, the oldest samples are evicted when the ring is full.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "telemetry_ring.h"
+
+#include <deque>
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_CAPACITY   8
+#define TEST_RANDOM_OPS 20000
+#define TEST_PEEK_MAX   (TEST_CAPACITY + 2) // Also asks for more than stored
+
+/* Private variables -------------------------------------------------- */
+static TelemetryRing<int, TEST_CAPACITY> *ring;
+static uint32_t                           randomState;
+
+/* Private function prototypes ---------------------------------------- */
+static uint32_t testRandom();
+static void     testPushRange(int first, int last);
+static void     testAssertContents(const int *expected, size_t count);
+
+/* Test definitions --------------------------------------------------- */
+void setUp()
+{
+  ring        = new TelemetryRing<int, TEST_CAPACITY>();
+  randomState = 0x2545F491;
+}
+
+void tearDown() { delete ring; }
+
+void test_push_evicts_the_oldest_when_full()
+{
+  TEST_ASSERT_TRUE(ring->isEmpty());
+  testPushRange(0, TEST_CAPACITY - 1);
+  TEST_ASSERT_TRUE(ring->isFull());
+  TEST_ASSERT_EQUAL_UINT32(0, ring->getOverwritten());
+
+  // Each push into the full ring loses the oldest sample
+  TEST_ASSERT_TRUE(ring->push(100));
+  TEST_ASSERT_TRUE(ring->push(101));
+  TEST_ASSERT_TRUE(ring->push(102));
+  TEST_ASSERT_EQUAL(TEST_CAPACITY, ring->size());
+  TEST_ASSERT_EQUAL_UINT32(3, ring->getOverwritten());
+
+  const int expected[TEST_CAPACITY] = { 3, 4, 5, 6, 7, 100, 101, 102 };
+  testAssertContents(expected, TEST_CAPACITY);
+
+  // Removing makes room again without eviction
+  TEST_ASSERT_EQUAL(1, ring->drop(1));
+  TEST_ASSERT_FALSE(ring->push(103));
+  TEST_ASSERT_EQUAL_UINT32(3, ring->getOverwritten());
+}
+
+void test_peek_and_drop_across_the_wrap()
+{
+  // Move the head to the middle of the storage, then fill past the end of it
+  testPushRange(0, 5);
+  TEST_ASSERT_EQUAL(5, ring->drop(5));
+  testPushRange(6, 12);
+  TEST_ASSERT_EQUAL(TEST_CAPACITY, ring->size());
+
+  const int expected[TEST_CAPACITY] = { 5, 6, 7, 8, 9, 10, 11, 12 };
+  testAssertContents(expected, TEST_CAPACITY);
+
+  // A partial peek does not remove anything, a drop removes exactly what was sent
+  int batch[3];
+  TEST_ASSERT_EQUAL(3, ring->peek(batch, 3));
+  TEST_ASSERT_EQUAL(5, batch[0]);
+  TEST_ASSERT_EQUAL(7, batch[2]);
+  TEST_ASSERT_EQUAL(TEST_CAPACITY, ring->size());
+  TEST_ASSERT_EQUAL(3, ring->drop(3));
+  testAssertContents(expected + 3, TEST_CAPACITY - 3);
+  TEST_ASSERT_EQUAL(0, ring->peek(nullptr, 3));
+}
+
+void test_drop_and_discard_are_clamped()
+{
+  testPushRange(1, 3);
+  TEST_ASSERT_EQUAL(0, ring->drop(0));
+  TEST_ASSERT_EQUAL(3, ring->drop(10));
+  TEST_ASSERT_TRUE(ring->isEmpty());
+  TEST_ASSERT_EQUAL(0, ring->drop(1));
+
+  // Only what was actually removed counts as lost
+  testPushRange(1, 4);
+  TEST_ASSERT_EQUAL(1, ring->discard(1));
+  TEST_ASSERT_EQUAL_UINT32(1, ring->getDiscarded());
+  TEST_ASSERT_EQUAL(3, ring->discard(10));
+  TEST_ASSERT_EQUAL_UINT32(4, ring->getDiscarded());
+  TEST_ASSERT_EQUAL(0, ring->discard(1));
+  TEST_ASSERT_EQUAL_UINT32(4, ring->getDiscarded());
+
+  // drop() is an acknowledged upload, not a loss
+  testPushRange(1, 2);
+  ring->drop(2);
+  TEST_ASSERT_EQUAL_UINT32(4, ring->getDiscarded());
+  TEST_ASSERT_EQUAL_UINT32(0, ring->getOverwritten());
+}
+
+void test_random_operations_match_a_deque()
+{
+  std::deque<int> reference;
+  uint32_t        overwritten = 0;
+  uint32_t        discarded   = 0;
+  int             next        = 0;
+  int             batch[TEST_PEEK_MAX];
+
+  for (int op = 0; op < TEST_RANDOM_OPS; op++)
+  {
+    switch (testRandom() % 4)
+    {
+      case 0:
+      case 1:
+      {
+        bool evicted = (reference.size() == TEST_CAPACITY);
+        if (evicted)
+        {
+          reference.pop_front();
+          overwritten++;
+        }
+        reference.push_back(next);
+        TEST_ASSERT_EQUAL(evicted, ring->push(next));
+        next++;
+        break;
+      }
+
+      case 2:
+      {
+        size_t n        = testRandom() % (TEST_CAPACITY + 3);
+        size_t expected = (n < reference.size()) ? n : reference.size();
+        bool   lost     = (testRandom() % 4 == 0);
+        TEST_ASSERT_EQUAL(expected, lost ? ring->discard(n) : ring->drop(n));
+        reference.erase(reference.begin(), reference.begin() + expected);
+        discarded += lost ? expected : 0;
+        break;
+      }
+
+      default:
+      {
+        size_t max      = testRandom() % (TEST_PEEK_MAX + 1);
+        size_t expected = (max < reference.size()) ? max : reference.size();
+        TEST_ASSERT_EQUAL(expected, ring->peek(batch, max));
+        for (size_t i = 0; i < expected; i++)
+        {
+          TEST_ASSERT_EQUAL(reference[i], batch[i]);
+        }
+        break;
+      }
+    }
+
+    TEST_ASSERT_EQUAL(reference.size(), ring->size());
+    TEST_ASSERT_EQUAL(reference.empty(), ring->isEmpty());
+    TEST_ASSERT_EQUAL(reference.size() == TEST_CAPACITY, ring->isFull());
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(overwritten, ring->getOverwritten());
+  TEST_ASSERT_EQUAL_UINT32(discarded, ring->getDiscarded());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_push_evicts_the_oldest_when_full);
+  RUN_TEST(test_peek_and_drop_across_the_wrap);
+  RUN_TEST(test_drop_and_discard_are_clamped);
+  RUN_TEST(test_random_operations_match_a_deque);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static uint32_t testRandom()
+{
+  // xorshift32, the same sequence on every run
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+static void testPushRange(int first, int last)
+{
+  for (int value = first; value <= last; value++)
+  {
+    ring->push(value);
+  }
+}
+
+static void testAssertContents(const int *expected, size_t count)
+{
+  int contents[TEST_PEEK_MAX];
+  TEST_ASSERT_EQUAL(count, ring->peek(contents, TEST_PEEK_MAX));
+  for (size_t i = 0; i < count; i++)
+  {
+    TEST_ASSERT_EQUAL(expected[i], contents[i]);
+  }
+}
+
+/* End of file -------------------------------------------------------- */
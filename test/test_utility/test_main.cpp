@@ -0,0 +1,135 @@
+/**
+ * @file       test_main.cpp
+ * @license    This library is released under the MIT License.
+ * @version    0.1.0
+ * @date       2025-06-22
+ * @author     Tuan Nguyen
+ *
+ * @brief      Host tests of the utility functions, run with `pio test -e native`
+ *
+ * The table and nibble CRC-8 implementations are compared with the bitwise reference over every 2-byte word,
+ * the SHT4X case, and over buffers of random length and content.
+ */
+
+/* Includes ----------------------------------------------------------- */
+#include "Arduino.h"
+
+#include "utility.h"
+
+#include <unity.h>
+
+/* Private defines ---------------------------------------------------- */
+#define TEST_RANDOM_BUFFERS 200
+#define TEST_RANDOM_MAX_LEN 257 // Longer than the 256-entry table, odd so it does not end on a nibble pair
+
+/* Private variables -------------------------------------------------- */
+static uint32_t randomState;
+
+/* Private function prototypes ---------------------------------------- */
+static uint32_t testRandom();
+
+/* Test definitions --------------------------------------------------- */
+void setUp() { randomState = 0x12345678; }
+
+void tearDown() {}
+
+void test_crc8_datasheet_vector()
+{
+  // Sensirion datasheet: CRC of 0xBEEF is 0x92
+  const uint8_t vector[2] = { 0xBE, 0xEF };
+  TEST_ASSERT_EQUAL_HEX8(0x92, crc8Bitwise(vector, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x92, crc8Nibble(vector, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x92, crc8Table(vector, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x92, crc8(vector, 2));
+}
+
+void test_crc8_every_two_byte_word()
+{
+  uint8_t word[2];
+  for (uint32_t value = 0; value <= 0xFFFF; value++)
+  {
+    word[0]          = (uint8_t) (value >> 8);
+    word[1]          = (uint8_t) value;
+    uint8_t expected = crc8Bitwise(word, 2);
+    TEST_ASSERT_EQUAL_HEX8(expected, crc8Nibble(word, 2));
+    TEST_ASSERT_EQUAL_HEX8(expected, crc8Table(word, 2));
+  }
+}
+
+void test_crc8_random_buffers()
+{
+  uint8_t buffer[TEST_RANDOM_MAX_LEN];
+  for (int run = 0; run < TEST_RANDOM_BUFFERS; run++)
+  {
+    int len = (int) (testRandom() % (TEST_RANDOM_MAX_LEN + 1));
+    for (int i = 0; i < len; i++)
+    {
+      buffer[i] = (uint8_t) testRandom();
+    }
+
+    uint8_t expected = crc8Bitwise(buffer, len);
+    TEST_ASSERT_EQUAL_HEX8(expected, crc8Nibble(buffer, len));
+    TEST_ASSERT_EQUAL_HEX8(expected, crc8Table(buffer, len));
+  }
+}
+
+void test_crc8_empty_buffer_is_the_init_value()
+{
+  // Init 0xFF, no final XOR
+  TEST_ASSERT_EQUAL_HEX8(0xFF, crc8Bitwise(nullptr, 0));
+  TEST_ASSERT_EQUAL_HEX8(0xFF, crc8Nibble(nullptr, 0));
+  TEST_ASSERT_EQUAL_HEX8(0xFF, crc8Table(nullptr, 0));
+}
+
+void test_compare_version()
+{
+  TEST_ASSERT_EQUAL(0, compareVersion("1.2.3", "1.2.3"));
+  TEST_ASSERT_EQUAL(-1, compareVersion("1.2.3", "1.2.4"));
+  TEST_ASSERT_EQUAL(1, compareVersion("1.10.0", "1.9.9"));
+  TEST_ASSERT_EQUAL(-1, compareVersion("0.9", "1.0.0"));
+
+  // Missing segments are 0, only three segments count, non-numeric parts are ignored
+  TEST_ASSERT_EQUAL(0, compareVersion("1.0", "1.0.0"));
+  TEST_ASSERT_EQUAL(0, compareVersion("1.0.0.7", "1.0.0"));
+  TEST_ASSERT_EQUAL(0, compareVersion("1.0a", "1.0.0"));
+  TEST_ASSERT_EQUAL(0, compareVersion(nullptr, "0"));
+  TEST_ASSERT_EQUAL(-1, compareVersion(nullptr, "0.0.1"));
+}
+
+void test_fnv1a()
+{
+  // Reference values of 32-bit FNV-1a
+  TEST_ASSERT_EQUAL_HEX32(0x811C9DC5, fnv1a(""));
+  TEST_ASSERT_EQUAL_HEX32(0xE40C292C, fnv1a("a"));
+  TEST_ASSERT_EQUAL_HEX32(0xBF9CF968, fnv1a("foobar"));
+
+  // Evaluated by the compiler for the handler tables
+  static_assert(fnv1a("a") == 0xE40C292C, "fnv1a() must be usable at compile time");
+  char name[] = "foobar";
+  TEST_ASSERT_EQUAL_HEX32(fnv1a("foobar"), fnv1a(name));
+  TEST_ASSERT_NOT_EQUAL(fnv1a("setFanSpeed"), fnv1a("setFanspeed"));
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_crc8_datasheet_vector);
+  RUN_TEST(test_crc8_every_two_byte_word);
+  RUN_TEST(test_crc8_random_buffers);
+  RUN_TEST(test_crc8_empty_buffer_is_the_init_value);
+  RUN_TEST(test_compare_version);
+  RUN_TEST(test_fnv1a);
+  return UNITY_END();
+}
+
+/* Private definitions ------------------------------------------------ */
+static uint32_t testRandom()
+{
+  // xorshift32, the same buffers on every run
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+/* End of file -------------------------------------------------------- */